@@ -0,0 +1,304 @@
+#include "arena/arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "arena";
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+#define ARENA_LOCK()   portENTER_CRITICAL(&s_lock)
+#define ARENA_UNLOCK() portEXIT_CRITICAL(&s_lock)
+#define ARENA_LOG(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define ARENA_WARN(fmt, ...) ESP_LOGW(TAG, fmt, ##__VA_ARGS__)
+#else
+// Sur hôte, l'arène n'est utilisée que depuis un seul fil
+#define ARENA_LOCK()   ((void)0)
+#define ARENA_UNLOCK() ((void)0)
+#define ARENA_LOG(fmt, ...) printf("[arena] " fmt "\n", ##__VA_ARGS__)
+#define ARENA_WARN(fmt, ...) printf("[arena] " fmt "\n", ##__VA_ARGS__)
+#endif
+
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t top;
+} region_t;
+
+typedef struct {
+    const char *name;
+    size_t in_use[ARENA_REGION_COUNT];
+    size_t high_water[ARENA_REGION_COUNT];
+    uint32_t allocations;
+    uint32_t failures;
+} user_t;
+
+static region_t s_regions[ARENA_REGION_COUNT];
+static user_t s_users[ARENA_MAX_USERS];
+static uint8_t s_user_count;
+static uint8_t s_depth;
+// Occupation par utilisateur à l'ouverture de chaque portée, restaurée à la fermeture
+static size_t s_scope_in_use[ARENA_MAX_DEPTH][ARENA_MAX_USERS][ARENA_REGION_COUNT];
+static bool s_ready;
+
+static const char *const k_region_names[ARENA_REGION_COUNT] = {"SRAM", "PSRAM"};
+
+static void *reserve(arena_region_t region, size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+#ifdef ESP_PLATFORM
+    const uint32_t caps = (region == ARENA_REGION_INTERNAL) ? (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+                                                            : (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return heap_caps_aligned_alloc(ARENA_DEFAULT_ALIGN, size, caps);
+#else
+    (void)region;
+    return aligned_alloc(ARENA_DEFAULT_ALIGN, (size + ARENA_DEFAULT_ALIGN - 1) & ~(size_t)(ARENA_DEFAULT_ALIGN - 1));
+#endif
+}
+
+static void release(void *p)
+{
+#ifdef ESP_PLATFORM
+    heap_caps_free(p);
+#else
+    free(p);
+#endif
+}
+
+bool arena_init(const arena_config_t *config)
+{
+    if (!config || s_ready) {
+        return s_ready;
+    }
+    const size_t sizes[ARENA_REGION_COUNT] = {config->internal_bytes, config->psram_bytes};
+    for (int r = 0; r < ARENA_REGION_COUNT; ++r) {
+        s_regions[r] = (region_t){0};
+        if (sizes[r] == 0) {
+            continue;
+        }
+        s_regions[r].base = reserve((arena_region_t)r, sizes[r]);
+        if (!s_regions[r].base) {
+            ARENA_WARN("réservation %s de %u octets impossible", k_region_names[r], (unsigned)sizes[r]);
+            continue;
+        }
+        s_regions[r].size = sizes[r];
+    }
+    s_depth = 0;
+    s_ready = s_regions[ARENA_REGION_INTERNAL].base || s_regions[ARENA_REGION_PSRAM].base;
+    if (s_ready) {
+        ARENA_LOG("zones réservées : SRAM %u Kio, PSRAM %u Kio",
+                  (unsigned)(s_regions[ARENA_REGION_INTERNAL].size / 1024),
+                  (unsigned)(s_regions[ARENA_REGION_PSRAM].size / 1024));
+    }
+    return s_ready;
+}
+
+void arena_deinit(void)
+{
+    for (int r = 0; r < ARENA_REGION_COUNT; ++r) {
+        release(s_regions[r].base);
+        s_regions[r] = (region_t){0};
+    }
+    memset(s_users, 0, sizeof(s_users));
+    s_user_count = 0;
+    s_depth = 0;
+    s_ready = false;
+}
+
+bool arena_ready(void)
+{
+    return s_ready;
+}
+
+arena_user_t arena_register_user(const char *name)
+{
+    ARENA_LOCK();
+    for (uint8_t i = 0; i < s_user_count; ++i) {
+        if (strcmp(s_users[i].name, name) == 0) {
+            ARENA_UNLOCK();
+            return i;
+        }
+    }
+    // Table pleine : les suivants partagent la dernière entrée
+    const uint8_t id = (s_user_count < ARENA_MAX_USERS) ? s_user_count++ : ARENA_MAX_USERS - 1;
+    if (!s_users[id].name) {
+        s_users[id].name = name;
+        // N'occupait rien dans les portées déjà ouvertes
+        for (int d = 0; d < ARENA_MAX_DEPTH; ++d) {
+            memset(s_scope_in_use[d][id], 0, sizeof(s_scope_in_use[d][id]));
+        }
+    }
+    ARENA_UNLOCK();
+    return id;
+}
+
+arena_mark_t arena_begin(void)
+{
+    arena_mark_t mark = {0};
+    ARENA_LOCK();
+    for (int r = 0; r < ARENA_REGION_COUNT; ++r) {
+        mark.top[r] = s_regions[r].top;
+    }
+    if (s_depth < ARENA_MAX_DEPTH) {
+        for (uint8_t u = 0; u < s_user_count; ++u) {
+            memcpy(s_scope_in_use[s_depth][u], s_users[u].in_use, sizeof(s_users[u].in_use));
+        }
+    }
+    mark.depth = ++s_depth;
+    ARENA_UNLOCK();
+    return mark;
+}
+
+void arena_end(const arena_mark_t *mark)
+{
+    if (mark->depth == 0 || mark->depth > s_depth) {
+        ARENA_WARN("portée %u déjà fermée", mark->depth);
+        return;
+    }
+    ARENA_LOCK();
+    const uint8_t open_depth = s_depth;
+    for (int r = 0; r < ARENA_REGION_COUNT; ++r) {
+        if (mark->top[r] <= s_regions[r].top) {
+            s_regions[r].top = mark->top[r];
+        }
+    }
+    const uint8_t level = mark->depth - 1;
+    if (level < ARENA_MAX_DEPTH) {
+        for (uint8_t u = 0; u < s_user_count; ++u) {
+            memcpy(s_users[u].in_use, s_scope_in_use[level][u], sizeof(s_users[u].in_use));
+        }
+    }
+    s_depth = level;
+    ARENA_UNLOCK();
+    if (mark->depth != open_depth) {
+        ARENA_WARN("portée %u fermée alors que %u est ouverte", mark->depth, open_depth);
+    }
+}
+
+static void *bump(arena_region_t r, size_t size, size_t align)
+{
+    region_t *reg = &s_regions[r];
+    if (!reg->base) {
+        return NULL;
+    }
+    const uintptr_t base = (uintptr_t)reg->base;
+    const uintptr_t start = (base + reg->top + align - 1) & ~(uintptr_t)(align - 1);
+    const size_t new_top = (size_t)(start - base) + size;
+    if (new_top > reg->size) {
+        return NULL;
+    }
+    reg->top = new_top;
+    return (void *)start;
+}
+
+void *arena_alloc(arena_user_t user, size_t size, size_t align, arena_placement_t placement)
+{
+    align = align ? align : ARENA_DEFAULT_ALIGN;
+    if (!s_ready || size == 0 || (align & (align - 1)) != 0 || user >= ARENA_MAX_USERS) {
+        return NULL;
+    }
+    const arena_region_t first = (placement == ARENA_BULK) ? ARENA_REGION_PSRAM : ARENA_REGION_INTERNAL;
+    const arena_region_t second = (first == ARENA_REGION_PSRAM) ? ARENA_REGION_INTERNAL : ARENA_REGION_PSRAM;
+
+    ARENA_LOCK();
+    arena_region_t used = first;
+    size_t before = s_regions[first].top;
+    void *p = bump(first, size, align);
+    if (!p && placement != ARENA_HOT_ONLY) {
+        used = second;
+        before = s_regions[second].top;
+        p = bump(second, size, align);
+    }
+    user_t *u = &s_users[user];
+    if (p) {
+        // Le remplissage d'alignement est compté avec l'allocation
+        u->in_use[used] += s_regions[used].top - before;
+        if (u->in_use[used] > u->high_water[used]) {
+            u->high_water[used] = u->in_use[used];
+        }
+        u->allocations++;
+    } else {
+        u->failures++;
+    }
+    ARENA_UNLOCK();
+    if (!p) {
+        ARENA_WARN("%s : %u octets refusés (SRAM libre %u, PSRAM libre %u)",
+                   u->name ? u->name : "?",
+                   (unsigned)size,
+                   (unsigned)arena_available(ARENA_REGION_INTERNAL),
+                   (unsigned)arena_available(ARENA_REGION_PSRAM));
+    }
+    return p;
+}
+
+void *arena_calloc(arena_user_t user, size_t size, size_t align, arena_placement_t placement)
+{
+    void *p = arena_alloc(user, size, align, placement);
+    if (p) {
+        memset(p, 0, size);
+    }
+    return p;
+}
+
+arena_region_t arena_region_of(const void *ptr)
+{
+    for (int r = 0; r < ARENA_REGION_COUNT; ++r) {
+        const uint8_t *b = s_regions[r].base;
+        if (b && (const uint8_t *)ptr >= b && (const uint8_t *)ptr < b + s_regions[r].size) {
+            return (arena_region_t)r;
+        }
+    }
+    return ARENA_REGION_COUNT;
+}
+
+size_t arena_available(arena_region_t region)
+{
+    return region < ARENA_REGION_COUNT ? s_regions[region].size - s_regions[region].top : 0;
+}
+
+size_t arena_capacity(arena_region_t region)
+{
+    return region < ARENA_REGION_COUNT ? s_regions[region].size : 0;
+}
+
+bool arena_get_stats(arena_user_t user, arena_user_stats_t *out)
+{
+    if (!out || user >= s_user_count) {
+        return false;
+    }
+    ARENA_LOCK();
+    const user_t *u = &s_users[user];
+    out->name = u->name;
+    memcpy(out->in_use, u->in_use, sizeof(out->in_use));
+    memcpy(out->high_water, u->high_water, sizeof(out->high_water));
+    out->allocations = u->allocations;
+    out->failures = u->failures;
+    ARENA_UNLOCK();
+    return true;
+}
+
+void arena_log_stats(void)
+{
+    ARENA_LOG("SRAM %u/%u Kio, PSRAM %u/%u Kio, portées ouvertes %u",
+              (unsigned)(s_regions[ARENA_REGION_INTERNAL].top / 1024),
+              (unsigned)(s_regions[ARENA_REGION_INTERNAL].size / 1024),
+              (unsigned)(s_regions[ARENA_REGION_PSRAM].top / 1024),
+              (unsigned)(s_regions[ARENA_REGION_PSRAM].size / 1024),
+              s_depth);
+    for (uint8_t i = 0; i < s_user_count; ++i) {
+        arena_user_stats_t st;
+        arena_get_stats(i, &st);
+        ARENA_LOG("  %-10s pic SRAM %6u o, pic PSRAM %8u o, %u alloc., %u refus",
+                  st.name,
+                  (unsigned)st.high_water[ARENA_REGION_INTERNAL],
+                  (unsigned)st.high_water[ARENA_REGION_PSRAM],
+                  (unsigned)st.allocations,
+                  (unsigned)st.failures);
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARENA_MAX_USERS   8
+#define ARENA_MAX_DEPTH   8
+#define ARENA_DEFAULT_ALIGN 16
+
+/**
+ * @brief Zones réservées une fois pour toutes au démarrage.
+ */
+typedef enum {
+    ARENA_REGION_INTERNAL = 0, /*!< SRAM interne : rapide, rare (données chaudes, tuiles). */
+    ARENA_REGION_PSRAM,        /*!< PSRAM : volumineuse, plus lente (grilles, tampons en masse). */
+    ARENA_REGION_COUNT
+} arena_region_t;
+
+/**
+ * @brief Placement demandé ; la zone préférée est essayée d'abord, l'autre en repli.
+ */
+typedef enum {
+    ARENA_HOT = 0,    /*!< SRAM interne, repli PSRAM. */
+    ARENA_BULK,       /*!< PSRAM, repli SRAM interne. */
+    ARENA_HOT_ONLY,   /*!< SRAM interne, échec plutôt que PSRAM. */
+} arena_placement_t;
+
+typedef struct {
+    size_t internal_bytes;  /*!< Taille de la zone SRAM interne. */
+    size_t psram_bytes;     /*!< Taille de la zone PSRAM (0 si pas de PSRAM). */
+} arena_config_t;
+
+/** Identifiant d'utilisateur (module de calcul) pour la comptabilité. */
+typedef uint8_t arena_user_t;
+
+/**
+ * @brief Point de reprise : tout ce qui est alloué après arena_begin() est
+ * rendu d'un coup par arena_end(). Les portées s'imbriquent (pile).
+ */
+typedef struct {
+    size_t top[ARENA_REGION_COUNT];
+    uint8_t depth;
+} arena_mark_t;
+
+typedef struct {
+    const char *name;
+    size_t in_use[ARENA_REGION_COUNT];
+    size_t high_water[ARENA_REGION_COUNT];
+    uint32_t allocations;
+    uint32_t failures;
+} arena_user_stats_t;
+
+/**
+ * Réserve les deux zones (heap_caps sur cible, malloc sur hôte). Les
+ * allocations suivantes ne touchent plus au tas général : pas de
+ * fragmentation possible, libération en O(1) par portée.
+ */
+bool arena_init(const arena_config_t *config);
+void arena_deinit(void);
+bool arena_ready(void);
+
+/** Enregistre un utilisateur ; le même nom renvoie le même identifiant. */
+arena_user_t arena_register_user(const char *name);
+
+arena_mark_t arena_begin(void);
+/** Rend tout ce qui a été alloué depuis `mark` ; doit fermer la portée la plus récente. */
+void arena_end(const arena_mark_t *mark);
+
+/**
+ * Allocation alignée (puissance de deux, 0 = ARENA_DEFAULT_ALIGN) dans la
+ * portée ouverte la plus récente. Hors de toute portée, l'allocation dure
+ * jusqu'à arena_deinit() : à réserver aux tampons permanents créés au démarrage.
+ */
+void *arena_alloc(arena_user_t user, size_t size, size_t align, arena_placement_t placement);
+void *arena_calloc(arena_user_t user, size_t size, size_t align, arena_placement_t placement);
+/** Zone effective d'un pointeur issu de l'arène (ARENA_REGION_COUNT sinon). */
+arena_region_t arena_region_of(const void *ptr);
+
+size_t arena_available(arena_region_t region);
+size_t arena_capacity(arena_region_t region);
+bool arena_get_stats(arena_user_t user, arena_user_stats_t *out);
+/** Journalise l'occupation et les pics par utilisateur. */
+void arena_log_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
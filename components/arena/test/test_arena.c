@@ -0,0 +1,82 @@
+#include "arena/arena.h"
+
+#include "unity.h"
+
+#include <stdint.h>
+
+static void setup_arena(size_t internal_bytes, size_t psram_bytes)
+{
+    arena_deinit();
+    const arena_config_t cfg = {.internal_bytes = internal_bytes, .psram_bytes = psram_bytes};
+    TEST_ASSERT_TRUE(arena_init(&cfg));
+}
+
+TEST_CASE("scope releases everything allocated inside", "[arena]")
+{
+    setup_arena(4096, 16384);
+    const arena_user_t user = arena_register_user("test");
+    const size_t free_before = arena_available(ARENA_REGION_PSRAM);
+
+    arena_mark_t mark = arena_begin();
+    TEST_ASSERT_NOT_NULL(arena_alloc(user, 1000, 0, ARENA_BULK));
+    TEST_ASSERT_NOT_NULL(arena_alloc(user, 3000, 0, ARENA_BULK));
+    TEST_ASSERT_LESS_THAN(free_before - 3999, arena_available(ARENA_REGION_PSRAM));
+    arena_end(&mark);
+
+    TEST_ASSERT_EQUAL(free_before, arena_available(ARENA_REGION_PSRAM));
+    arena_user_stats_t st;
+    TEST_ASSERT_TRUE(arena_get_stats(user, &st));
+    TEST_ASSERT_EQUAL(0, st.in_use[ARENA_REGION_PSRAM]);
+    TEST_ASSERT_GREATER_OR_EQUAL(4000, st.high_water[ARENA_REGION_PSRAM]);
+    arena_deinit();
+}
+
+TEST_CASE("nested scopes keep per-user high-water marks", "[arena]")
+{
+    setup_arena(4096, 16384);
+    const arena_user_t a = arena_register_user("a");
+    const arena_user_t b = arena_register_user("b");
+    TEST_ASSERT_EQUAL(a, arena_register_user("a"));
+
+    arena_mark_t outer = arena_begin();
+    TEST_ASSERT_NOT_NULL(arena_alloc(a, 2048, 0, ARENA_BULK));
+    arena_mark_t inner = arena_begin();
+    TEST_ASSERT_NOT_NULL(arena_alloc(b, 8192, 0, ARENA_BULK));
+    arena_end(&inner);
+
+    arena_user_stats_t sa;
+    arena_user_stats_t sb;
+    arena_get_stats(a, &sa);
+    arena_get_stats(b, &sb);
+    TEST_ASSERT_EQUAL(2048, sa.in_use[ARENA_REGION_PSRAM]);
+    TEST_ASSERT_EQUAL(0, sb.in_use[ARENA_REGION_PSRAM]);
+    TEST_ASSERT_EQUAL(8192, sb.high_water[ARENA_REGION_PSRAM]);
+    arena_end(&outer);
+    arena_get_stats(a, &sa);
+    TEST_ASSERT_EQUAL(0, sa.in_use[ARENA_REGION_PSRAM]);
+    arena_deinit();
+}
+
+TEST_CASE("placement prefers its region and falls back", "[arena]")
+{
+    setup_arena(1024, 8192);
+    const arena_user_t user = arena_register_user("place");
+    arena_mark_t mark = arena_begin();
+
+    void *hot = arena_alloc(user, 512, 64, ARENA_HOT);
+    TEST_ASSERT_NOT_NULL(hot);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)hot % 64);
+    TEST_ASSERT_EQUAL(ARENA_REGION_INTERNAL, arena_region_of(hot));
+
+    // Plus de place en SRAM : repli PSRAM, sauf pour HOT_ONLY
+    void *spill = arena_alloc(user, 1024, 0, ARENA_HOT);
+    TEST_ASSERT_NOT_NULL(spill);
+    TEST_ASSERT_EQUAL(ARENA_REGION_PSRAM, arena_region_of(spill));
+    TEST_ASSERT_NULL(arena_alloc(user, 1024, 0, ARENA_HOT_ONLY));
+
+    arena_user_stats_t st;
+    arena_get_stats(user, &st);
+    TEST_ASSERT_EQUAL(1, st.failures);
+    arena_end(&mark);
+    arena_deinit();
+}
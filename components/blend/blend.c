@@ -0,0 +1,390 @@
+#include "blend/blend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "blend";
+#define BLEND_LOG(fmt, ...)  ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BLEND_WARN(fmt, ...) ESP_LOGW(TAG, fmt, ##__VA_ARGS__)
+#define BLEND_ALLOC(bytes)   heap_caps_aligned_alloc(16, (bytes), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define BLEND_FREE(p)        heap_caps_free(p)
+#if CONFIG_IDF_TARGET_ESP32S3
+#define BLEND_HAVE_PIE 1
+#endif
+#else
+#include <time.h>
+
+#define BLEND_LOG(fmt, ...)  printf("[blend] " fmt "\n", ##__VA_ARGS__)
+#define BLEND_WARN(fmt, ...) printf("[blend] " fmt "\n", ##__VA_ARGS__)
+#define BLEND_ALLOC(bytes)   aligned_alloc(16, ((bytes) + 15u) & ~(size_t)15u)
+#define BLEND_FREE(p)        free(p)
+// Sur hôte, blend_pie_model.c remplace l'assembleur (vérification de la méthode)
+#ifdef BLEND_PIE_MODEL
+#define BLEND_HAVE_PIE 1
+#endif
+#endif
+
+#ifndef BLEND_HAVE_PIE
+#define BLEND_HAVE_PIE 0
+#endif
+
+#if BLEND_HAVE_PIE
+#include "blend_pie.h"
+#endif
+
+#define ROW(p, stride, y) ((uint16_t *)((uint8_t *)(p) + (size_t)(y) * (size_t)(stride)))
+#define CROW(p, stride, y) ((const uint16_t *)((const uint8_t *)(p) + (size_t)(y) * (size_t)(stride)))
+
+static bool s_simd;
+
+static int64_t now_us(void)
+{
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+void blend_ref_fill_rgb565(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color)
+{
+    for (int32_t y = 0; y < h; ++y) {
+        uint16_t *row = ROW(dst, dst_stride, y);
+        for (int32_t x = 0; x < w; ++x) {
+            row[x] = color;
+        }
+    }
+}
+
+void blend_ref_fill_rgb565_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color, uint8_t opa)
+{
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    // Comme LVGL : un fond uni ne coûte qu'un mélange
+    uint32_t last_bg = (uint32_t)dst[0] + 1u;
+    uint16_t last_res = 0;
+    for (int32_t y = 0; y < h; ++y) {
+        uint16_t *row = ROW(dst, dst_stride, y);
+        for (int32_t x = 0; x < w; ++x) {
+            if (row[x] != last_bg) {
+                last_bg = row[x];
+                last_res = blend_mix_rgb565(color, row[x], opa);
+            }
+            row[x] = last_res;
+        }
+    }
+}
+
+void blend_ref_rgb565_opa(uint16_t *dst,
+                          int32_t w,
+                          int32_t h,
+                          int32_t dst_stride,
+                          const uint16_t *src,
+                          int32_t src_stride,
+                          uint8_t opa)
+{
+    for (int32_t y = 0; y < h; ++y) {
+        uint16_t *row = ROW(dst, dst_stride, y);
+        const uint16_t *srow = CROW(src, src_stride, y);
+        for (int32_t x = 0; x < w; ++x) {
+            row[x] = blend_mix_rgb565(srow[x], row[x], opa);
+        }
+    }
+}
+
+#if BLEND_HAVE_PIE
+static void pie_consts(blend_pie_k_t *k, uint16_t color, uint8_t opa)
+{
+    const uint16_t mix = (uint16_t)(((uint32_t)opa + 4u) >> 3);
+    for (int i = 0; i < 8; ++i) {
+        k->mix[i] = mix;
+        k->mask_g[i] = 0x07E0;
+        k->mask_b[i] = 0x001F;
+        k->mask_r[i] = 0xF800;
+        k->c16[i] = 16;
+        k->c64[i] = 64;
+        k->floor_g[i] = 0xFFE0;
+        k->floor_r[i] = 0xFC00;
+        k->fg_g[i] = color & 0x07E0;
+        k->fg_b[i] = color & 0x001F;
+        k->fg_r[i] = (uint16_t)((color & 0xF800) >> 1);
+        k->color[i] = color;
+    }
+}
+
+// Pixels à traiter un par un avant le premier bloc aligné sur 16 octets
+static int32_t head_px(const uint16_t *row)
+{
+    return (int32_t)(((16u - ((uintptr_t)row & 15u)) & 15u) / 2u);
+}
+
+static bool simd_rows(const void *dst, int32_t w)
+{
+    // Pixels 16 bits mal alignés : jamais d'alignement sur 16 octets possible
+    return s_simd && w >= BLEND_MIN_SIMD_WIDTH && ((uintptr_t)dst & 1u) == 0;
+}
+#endif
+
+void blend_fill_rgb565(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color)
+{
+#if BLEND_HAVE_PIE
+    if (simd_rows(dst, w) && (dst_stride & 1) == 0) {
+        blend_pie_k_t k;
+        pie_consts(&k, color, 255);
+        for (int32_t y = 0; y < h; ++y) {
+            uint16_t *row = ROW(dst, dst_stride, y);
+            const int32_t head = head_px(row);
+            const uint32_t blocks = (uint32_t)(w - head) / BLEND_PIE_BLOCK_PX;
+            const int32_t tail = head + (int32_t)blocks * BLEND_PIE_BLOCK_PX;
+            blend_ref_fill_rgb565(row, head, 1, 0, color);
+            blend_pie_fill_row(row + head, blocks, &k);
+            blend_ref_fill_rgb565(row + tail, w - tail, 1, 0, color);
+        }
+        return;
+    }
+#endif
+    blend_ref_fill_rgb565(dst, w, h, dst_stride, color);
+}
+
+void blend_fill_rgb565_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color, uint8_t opa)
+{
+#if BLEND_HAVE_PIE
+    if (simd_rows(dst, w) && (dst_stride & 1) == 0) {
+        blend_pie_k_t k;
+        pie_consts(&k, color, opa);
+        for (int32_t y = 0; y < h; ++y) {
+            uint16_t *row = ROW(dst, dst_stride, y);
+            const int32_t head = head_px(row);
+            const uint32_t blocks = (uint32_t)(w - head) / BLEND_PIE_BLOCK_PX;
+            const int32_t tail = head + (int32_t)blocks * BLEND_PIE_BLOCK_PX;
+            blend_ref_fill_rgb565_opa(row, head, 1, 0, color, opa);
+            blend_pie_fill_opa_row(row + head, blocks, &k);
+            blend_ref_fill_rgb565_opa(row + tail, w - tail, 1, 0, color, opa);
+        }
+        return;
+    }
+#endif
+    blend_ref_fill_rgb565_opa(dst, w, h, dst_stride, color, opa);
+}
+
+void blend_rgb565_opa(uint16_t *dst,
+                      int32_t w,
+                      int32_t h,
+                      int32_t dst_stride,
+                      const uint16_t *src,
+                      int32_t src_stride,
+                      uint8_t opa)
+{
+#if BLEND_HAVE_PIE
+    if (simd_rows(dst, w) && ((dst_stride | src_stride) & 1) == 0) {
+        blend_pie_k_t k;
+        pie_consts(&k, 0, opa);
+        for (int32_t y = 0; y < h; ++y) {
+            uint16_t *row = ROW(dst, dst_stride, y);
+            const uint16_t *srow = CROW(src, src_stride, y);
+            const int32_t head = head_px(row);
+            // Source et destination doivent s'aligner ensemble
+            if (((uintptr_t)(srow + head) & 15u) != 0) {
+                blend_ref_rgb565_opa(row, w, 1, 0, srow, 0, opa);
+                continue;
+            }
+            const uint32_t blocks = (uint32_t)(w - head) / BLEND_PIE_BLOCK_PX;
+            const int32_t tail = head + (int32_t)blocks * BLEND_PIE_BLOCK_PX;
+            blend_ref_rgb565_opa(row, head, 1, 0, srow, 0, opa);
+            blend_pie_image_opa_row(row + head, srow + head, blocks, &k);
+            blend_ref_rgb565_opa(row + tail, w - tail, 1, 0, srow + tail, 0, opa);
+        }
+        return;
+    }
+#endif
+    blend_ref_rgb565_opa(dst, w, h, dst_stride, src, src_stride, opa);
+}
+
+bool blend_simd_enabled(void)
+{
+    return s_simd;
+}
+
+static uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+#if BLEND_HAVE_PIE
+// Zone de test : 80 pixels par rangée plus une marge, pas impair en pixels
+#define CHECK_STRIDE_PX 83
+#define CHECK_ROWS      3
+#define CHECK_PX        (CHECK_STRIDE_PX * CHECK_ROWS)
+
+static uint16_t s_check_a[CHECK_PX] __attribute__((aligned(16)));
+static uint16_t s_check_b[CHECK_PX] __attribute__((aligned(16)));
+static uint16_t s_check_src[CHECK_PX] __attribute__((aligned(16)));
+
+static bool check_case(uint32_t *seed, int kernel, int32_t dst_off, int32_t src_off, int32_t w, uint8_t opa)
+{
+    for (int i = 0; i < CHECK_PX; ++i) {
+        s_check_a[i] = (uint16_t)xorshift32(seed);
+        s_check_src[i] = (uint16_t)xorshift32(seed);
+    }
+    // Quelques fonds unis pour exercer le cache de la référence
+    if ((*seed & 3u) == 0) {
+        for (int i = 0; i < CHECK_PX; ++i) {
+            s_check_a[i] = s_check_a[0];
+        }
+    }
+    memcpy(s_check_b, s_check_a, sizeof(s_check_b));
+    const uint16_t color = (uint16_t)xorshift32(seed);
+    const int32_t stride = CHECK_STRIDE_PX * 2;
+    const int32_t h = CHECK_ROWS - 1;
+    switch (kernel) {
+    case 0:
+        blend_fill_rgb565(s_check_a + dst_off, w, h, stride, color);
+        blend_ref_fill_rgb565(s_check_b + dst_off, w, h, stride, color);
+        break;
+    case 1:
+        blend_fill_rgb565_opa(s_check_a + dst_off, w, h, stride, color, opa);
+        blend_ref_fill_rgb565_opa(s_check_b + dst_off, w, h, stride, color, opa);
+        break;
+    default:
+        blend_rgb565_opa(s_check_a + dst_off, w, h, stride, s_check_src + src_off, stride, opa);
+        blend_ref_rgb565_opa(s_check_b + dst_off, w, h, stride, s_check_src + src_off, stride, opa);
+        break;
+    }
+    // Comparaison de tout le tampon : détecte aussi les débordements
+    return memcmp(s_check_a, s_check_b, sizeof(s_check_a)) == 0;
+}
+#endif
+
+bool blend_init(void)
+{
+#if BLEND_HAVE_PIE
+    static const int32_t widths[] = {16, 17, 23, 40, 64, 67, 80};
+    static const uint8_t opas[] = {0, 1, 3, 4, 60, 127, 128, 178, 204, 250, 252, 255};
+    uint32_t seed = 0x2545F491u;
+    uint32_t cases = 0;
+    s_simd = true;
+    for (int kernel = 0; kernel < 3 && s_simd; ++kernel) {
+        for (size_t wi = 0; wi < sizeof(widths) / sizeof(widths[0]) && s_simd; ++wi) {
+            for (int32_t off = 0; off < 8 && s_simd; ++off) {
+                for (size_t oi = 0; oi < sizeof(opas) / sizeof(opas[0]); ++oi) {
+                    // Source tantôt co-alignée, tantôt non (repli par rangée)
+                    const int32_t src_off = (oi & 1u) ? off : (off + 3) & 7;
+                    const int32_t room = CHECK_STRIDE_PX - (off > src_off ? off : src_off);
+                    const int32_t w = widths[wi] < room ? widths[wi] : room;
+                    cases++;
+                    if (!check_case(&seed, kernel, off, src_off, w, opas[oi])) {
+                        BLEND_WARN("Noyau %d différent de la référence (largeur %d, décalage %d, opacité %u) : "
+                                   "chemin vectoriel désactivé",
+                                   kernel,
+                                   (int)w,
+                                   (int)off,
+                                   (unsigned)opas[oi]);
+                        s_simd = false;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    if (s_simd) {
+        BLEND_LOG("Mélanges vectoriels actifs (%u cas identiques à la référence)", (unsigned)cases);
+    }
+#endif
+    return s_simd;
+}
+
+typedef enum {
+    BENCH_FILL = 0,
+    BENCH_FILL_OPA,
+    BENCH_IMAGE_OPA,
+    BENCH_COUNT
+} bench_kernel_t;
+
+static double bench_mpx(bench_kernel_t kernel, bool accelerated, uint16_t *dst, const uint16_t *src, uint32_t rows)
+{
+    const int32_t w = 1024;
+    const int32_t stride = w * 2;
+    const uint32_t reps = 8;
+    const int64_t t0 = now_us();
+    for (uint32_t r = 0; r < reps; ++r) {
+        // LV_OPA_80 / LV_OPA_70 des cartes translucides
+        const uint8_t opa = (r & 1u) ? 204 : 178;
+        const uint16_t color = (uint16_t)(0x18E3u + r * 0x0841u);
+        switch (kernel) {
+        case BENCH_FILL:
+            if (accelerated) {
+                blend_fill_rgb565(dst, w, (int32_t)rows, stride, color);
+            } else {
+                blend_ref_fill_rgb565(dst, w, (int32_t)rows, stride, color);
+            }
+            break;
+        case BENCH_FILL_OPA:
+            if (accelerated) {
+                blend_fill_rgb565_opa(dst, w, (int32_t)rows, stride, color, opa);
+            } else {
+                blend_ref_fill_rgb565_opa(dst, w, (int32_t)rows, stride, color, opa);
+            }
+            break;
+        default:
+            if (accelerated) {
+                blend_rgb565_opa(dst, w, (int32_t)rows, stride, src, stride, opa);
+            } else {
+                blend_ref_rgb565_opa(dst, w, (int32_t)rows, stride, src, stride, opa);
+            }
+            break;
+        }
+    }
+    const int64_t dt = now_us() - t0;
+    return dt > 0 ? (double)reps * (double)rows * (double)w / (double)dt : 0.0;
+}
+
+void blend_run_bench(uint32_t rows)
+{
+    static const char *const names[BENCH_COUNT] = {"remplissage", "remplissage translucide", "image translucide"};
+    if (rows == 0) {
+        return;
+    }
+    const size_t bytes = (size_t)rows * 1024u * sizeof(uint16_t);
+    uint16_t *dst = BLEND_ALLOC(bytes);
+    uint16_t *src = BLEND_ALLOC(bytes);
+    if (!dst || !src) {
+        BLEND_WARN("Banc des mélanges : %u octets indisponibles", (unsigned)(2 * bytes));
+        BLEND_FREE(dst);
+        BLEND_FREE(src);
+        return;
+    }
+    // Fond et source variés : pas de raccourci sur fond uni pour la référence
+    uint32_t seed = 0x9E3779B9u;
+    for (size_t i = 0; i < bytes / sizeof(uint16_t); ++i) {
+        src[i] = (uint16_t)xorshift32(&seed);
+    }
+    for (int k = 0; k < BENCH_COUNT; ++k) {
+        memcpy(dst, src, bytes);
+        const double ref = bench_mpx((bench_kernel_t)k, false, dst, src, rows);
+        memcpy(dst, src, bytes);
+        const double acc = bench_mpx((bench_kernel_t)k, true, dst, src, rows);
+        BLEND_LOG("%s : référence %.1f Mpx/s, %s %.1f Mpx/s (x%.2f)",
+                  names[k],
+                  ref,
+                  s_simd ? "vectoriel" : "repli",
+                  acc,
+                  ref > 0.0 ? acc / ref : 0.0);
+    }
+    BLEND_FREE(dst);
+    BLEND_FREE(src);
+}
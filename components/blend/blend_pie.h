@@ -0,0 +1,60 @@
+#pragma once
+
+/*
+ * Interface des noyaux PIE (blend_pie.S) : une table de constantes diffusées
+ * sur les huit voies 16 bits, préparée en C par appel, et trois boucles sur des
+ * blocs de huit pixels alignés sur 16 octets. Les décalages sont partagés avec
+ * l'assembleur.
+ *
+ * Chaque canal est mélangé à sa place dans le pixel, en arithmétique signée
+ * 16 bits avec SAR = 5 : fond + plancher((premier plan − fond) · m / 32),
+ * le plancher étant obtenu par le décalage arithmétique (B) ou un masque (G).
+ * Le rouge (bits 11-15) est d'abord divisé par deux pour que la différence
+ * tienne sur 16 bits signés, puis remultiplié par deux.
+ */
+
+#define BLEND_PIE_K_MIX      0    /* m = (opa + 4) >> 3 */
+#define BLEND_PIE_K_MASK_G   16   /* 0x07E0 */
+#define BLEND_PIE_K_MASK_B   32   /* 0x001F */
+#define BLEND_PIE_K_MASK_R   48   /* 0xF800 */
+#define BLEND_PIE_K_C16      64   /* ·16 >> 5 : champ R / 2 */
+#define BLEND_PIE_K_C64      80   /* ·64 >> 5 : × 2 */
+#define BLEND_PIE_K_FLOOR_G  96   /* 0xFFE0 */
+#define BLEND_PIE_K_FLOOR_R  112  /* 0xFC00 */
+#define BLEND_PIE_K_FG_G     128  /* couleur : champ G */
+#define BLEND_PIE_K_FG_B     144  /* couleur : champ B */
+#define BLEND_PIE_K_FG_R     160  /* couleur : champ R / 2 */
+#define BLEND_PIE_K_COLOR    176  /* couleur brute (remplissage opaque) */
+#define BLEND_PIE_K_SIZE     192
+
+#define BLEND_PIE_BLOCK_PX   8
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+typedef struct {
+    uint16_t mix[8];
+    uint16_t mask_g[8];
+    uint16_t mask_b[8];
+    uint16_t mask_r[8];
+    uint16_t c16[8];
+    uint16_t c64[8];
+    uint16_t floor_g[8];
+    uint16_t floor_r[8];
+    uint16_t fg_g[8];
+    uint16_t fg_b[8];
+    uint16_t fg_r[8];
+    uint16_t color[8];
+} __attribute__((aligned(16))) blend_pie_k_t;
+
+_Static_assert(sizeof(blend_pie_k_t) == BLEND_PIE_K_SIZE, "table PIE");
+_Static_assert(__builtin_offsetof(blend_pie_k_t, fg_g) == BLEND_PIE_K_FG_G, "table PIE");
+_Static_assert(__builtin_offsetof(blend_pie_k_t, color) == BLEND_PIE_K_COLOR, "table PIE");
+
+/* `dst` et `src` alignés sur 16 octets ; `blocks` blocs de huit pixels. */
+void blend_pie_fill_row(uint16_t *dst, uint32_t blocks, const blend_pie_k_t *k);
+void blend_pie_fill_opa_row(uint16_t *dst, uint32_t blocks, const blend_pie_k_t *k);
+void blend_pie_image_opa_row(uint16_t *dst, const uint16_t *src, uint32_t blocks, const blend_pie_k_t *k);
+
+#endif
@@ -0,0 +1,174 @@
+// Transcription C de blend_pie.S, instruction par instruction, pour l'hôte :
+// même table de constantes, mêmes registres, même sémantique des opérations
+// PIE (saturation des additions 16 bits, produit 32 bits décalé de SAR puis
+// tronqué à 16 bits). Compilé à la place de l'assembleur hors ESP32-S3 quand
+// BLEND_PIE_MODEL est défini, pour vérifier la méthode au bit près.
+
+#include "blend_pie.h"
+
+#include <string.h>
+
+#define SAR 5
+
+typedef struct {
+    uint16_t l[8];
+} q_t;
+
+static q_t vld(const void *p)
+{
+    q_t q;
+    memcpy(q.l, p, sizeof(q.l));
+    return q;
+}
+
+static void vst(void *p, q_t q)
+{
+    memcpy(p, q.l, sizeof(q.l));
+}
+
+static q_t andq(q_t x, q_t y)
+{
+    for (int i = 0; i < 8; ++i) {
+        x.l[i] &= y.l[i];
+    }
+    return x;
+}
+
+static q_t orq(q_t x, q_t y)
+{
+    for (int i = 0; i < 8; ++i) {
+        x.l[i] |= y.l[i];
+    }
+    return x;
+}
+
+static int16_t sat16(int32_t v)
+{
+    return (int16_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+// ee.vadds.s16 / ee.vsubs.s16
+static q_t vadds_s16(q_t x, q_t y)
+{
+    for (int i = 0; i < 8; ++i) {
+        x.l[i] = (uint16_t)sat16((int32_t)(int16_t)x.l[i] + (int16_t)y.l[i]);
+    }
+    return x;
+}
+
+static q_t vsubs_s16(q_t x, q_t y)
+{
+    for (int i = 0; i < 8; ++i) {
+        x.l[i] = (uint16_t)sat16((int32_t)(int16_t)x.l[i] - (int16_t)y.l[i]);
+    }
+    return x;
+}
+
+// ee.vmul.s16 / ee.vmul.u16 : produit 32 bits >> SAR, 16 bits de poids faible
+static q_t vmul_s16(q_t x, q_t y)
+{
+    for (int i = 0; i < 8; ++i) {
+        x.l[i] = (uint16_t)(((int32_t)(int16_t)x.l[i] * (int16_t)y.l[i]) >> SAR);
+    }
+    return x;
+}
+
+static q_t vmul_u16(q_t x, q_t y)
+{
+    for (int i = 0; i < 8; ++i) {
+        x.l[i] = (uint16_t)(((uint32_t)x.l[i] * y.l[i]) >> SAR);
+    }
+    return x;
+}
+
+void blend_pie_fill_row(uint16_t *dst, uint32_t blocks, const blend_pie_k_t *k)
+{
+    const q_t q0 = vld(k->color);
+    for (uint32_t i = 0; i < blocks; ++i, dst += BLEND_PIE_BLOCK_PX) {
+        vst(dst, q0);
+    }
+}
+
+void blend_pie_fill_opa_row(uint16_t *dst, uint32_t blocks, const blend_pie_k_t *k)
+{
+    const q_t q0 = vld(k->mix);
+    const q_t q1 = vld(k->mask_g);
+    const q_t q2 = vld(k->mask_b);
+    for (uint32_t i = 0; i < blocks; ++i, dst += BLEND_PIE_BLOCK_PX) {
+        q_t q3, q4, q6, q7;
+        q_t q5 = vld(dst);
+        // G
+        q3 = vld(k->fg_g);
+        q4 = andq(q5, q1);
+        q3 = vsubs_s16(q3, q4);
+        q3 = vmul_s16(q3, q0);
+        q7 = vld(k->floor_g);
+        q3 = andq(q3, q7);
+        q7 = vadds_s16(q3, q4);
+        // B
+        q3 = vld(k->fg_b);
+        q4 = andq(q5, q2);
+        q3 = vsubs_s16(q3, q4);
+        q3 = vmul_s16(q3, q0);
+        q3 = vadds_s16(q3, q4);
+        q7 = orq(q7, q3);
+        // R
+        q3 = vld(k->mask_r);
+        q5 = andq(q5, q3);
+        q3 = vld(k->c16);
+        q5 = vmul_u16(q5, q3);
+        q6 = vld(k->fg_r);
+        q6 = vsubs_s16(q6, q5);
+        q6 = vmul_s16(q6, q0);
+        q3 = vld(k->floor_r);
+        q6 = andq(q6, q3);
+        q6 = vadds_s16(q6, q5);
+        q3 = vld(k->c64);
+        q6 = vmul_u16(q6, q3);
+        q7 = orq(q7, q6);
+        vst(dst, q7);
+    }
+}
+
+void blend_pie_image_opa_row(uint16_t *dst, const uint16_t *src, uint32_t blocks, const blend_pie_k_t *k)
+{
+    const q_t q0 = vld(k->mix);
+    const q_t q1 = vld(k->mask_g);
+    const q_t q2 = vld(k->mask_b);
+    for (uint32_t i = 0; i < blocks; ++i, dst += BLEND_PIE_BLOCK_PX, src += BLEND_PIE_BLOCK_PX) {
+        q_t q3, q4, q7;
+        q_t q5 = vld(dst);
+        q_t q6 = vld(src);
+        // G
+        q3 = andq(q6, q1);
+        q4 = andq(q5, q1);
+        q3 = vsubs_s16(q3, q4);
+        q3 = vmul_s16(q3, q0);
+        q7 = vld(k->floor_g);
+        q3 = andq(q3, q7);
+        q7 = vadds_s16(q3, q4);
+        // B
+        q3 = andq(q6, q2);
+        q4 = andq(q5, q2);
+        q3 = vsubs_s16(q3, q4);
+        q3 = vmul_s16(q3, q0);
+        q3 = vadds_s16(q3, q4);
+        q7 = orq(q7, q3);
+        // R
+        q3 = vld(k->mask_r);
+        q5 = andq(q5, q3);
+        q6 = andq(q6, q3);
+        q3 = vld(k->c16);
+        q5 = vmul_u16(q5, q3);
+        q6 = vmul_u16(q6, q3);
+        q6 = vsubs_s16(q6, q5);
+        q6 = vmul_s16(q6, q0);
+        q3 = vld(k->floor_r);
+        q6 = andq(q6, q3);
+        q6 = vadds_s16(q6, q5);
+        q3 = vld(k->c64);
+        q6 = vmul_u16(q6, q3);
+        q7 = orq(q7, q6);
+        vst(dst, q7);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Mélanges RGB565 du rendu logiciel LVGL : remplissage opaque, remplissage
+ * translucide et image translucide. Chaque noyau existe en version de
+ * référence, transcription directe du code C de LVGL, et en version accélérée
+ * (instructions vectorielles PIE sur ESP32-S3, huit pixels par instruction)
+ * dont le résultat est identique au bit près. Les pas (`stride`) sont en octets.
+ */
+
+// En deçà, une rangée est traitée par la référence (tête et queue dominent)
+#define BLEND_MIN_SIMD_WIDTH 16
+
+/**
+ * Mélange de deux pixels RGB565, identique à lv_color_16_16_mix() de LVGL :
+ * opacité ramenée sur 5 bits, puis fond + (premier plan − fond) · m / 32 par
+ * canal, les trois canaux traités d'un coup dans un mot de 32 bits.
+ */
+static inline uint16_t blend_mix_rgb565(uint16_t fg, uint16_t bg, uint8_t opa)
+{
+    if (opa == 255 || fg == bg) {
+        return fg;
+    }
+    if (opa == 0) {
+        return bg;
+    }
+    const uint32_t mix = ((uint32_t)opa + 4u) >> 3;
+    const uint32_t b = ((uint32_t)bg | ((uint32_t)bg << 16)) & 0x07E0F81Fu;
+    const uint32_t f = ((uint32_t)fg | ((uint32_t)fg << 16)) & 0x07E0F81Fu;
+    const uint32_t r = ((((f - b) * mix) >> 5) + b) & 0x07E0F81Fu;
+    return (uint16_t)((r >> 16) | r);
+}
+
+/** Références portables (chemin C de LVGL 9.4). */
+void blend_ref_fill_rgb565(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color);
+void blend_ref_fill_rgb565_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color, uint8_t opa);
+void blend_ref_rgb565_opa(uint16_t *dst,
+                          int32_t w,
+                          int32_t h,
+                          int32_t dst_stride,
+                          const uint16_t *src,
+                          int32_t src_stride,
+                          uint8_t opa);
+
+/**
+ * Versions accélérées : rangées découpées en tête et queue (référence) et blocs
+ * de huit pixels alignés sur 16 octets (noyaux vectoriels). Se replient sur la
+ * référence tant que blend_init() n'a pas validé le chemin vectoriel.
+ */
+void blend_fill_rgb565(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color);
+void blend_fill_rgb565_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color, uint8_t opa);
+void blend_rgb565_opa(uint16_t *dst,
+                      int32_t w,
+                      int32_t h,
+                      int32_t dst_stride,
+                      const uint16_t *src,
+                      int32_t src_stride,
+                      uint8_t opa);
+
+/**
+ * Compare les versions accélérées à la référence sur des motifs pseudo-
+ * aléatoires (largeurs, décalages et opacités variés) et n'active le chemin
+ * vectoriel que si tout est identique. À appeler avant le premier rendu.
+ * @return true si le chemin vectoriel est actif.
+ */
+bool blend_init(void);
+
+/** Vrai si le chemin vectoriel existe sur cette cible et a passé blend_init(). */
+bool blend_simd_enabled(void);
+
+/**
+ * Micro-bancs : `rows` rangées de 1024 pixels pour chaque noyau, référence puis
+ * version accélérée ; journalise les Mpx/s de chacune.
+ */
+void blend_run_bench(uint32_t rows);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+/*
+ * Point d'entrée du rendu logiciel de LVGL (LV_USE_DRAW_SW_ASM =
+ * LV_DRAW_SW_ASM_CUSTOM, CONFIG_LV_DRAW_SW_ASM_CUSTOM_INCLUDE="blend/blend_lvgl.h").
+ * Inclus par les sources lv_draw_sw_blend_to_*.c de LVGL, après leurs propres
+ * en-têtes : les descripteurs de mélange y sont déjà déclarés. Seuls les cas
+ * RGB565 sans masque sont repris ; LV_RESULT_INVALID rend la main au code C de
+ * LVGL (chemin vectoriel inactif, zone trop étroite).
+ */
+
+#include "blend/blend.h"
+
+static inline lv_result_t blend_lv_fill(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!blend_simd_enabled() || dsc->dest_w < BLEND_MIN_SIMD_WIDTH) {
+        return LV_RESULT_INVALID;
+    }
+    blend_fill_rgb565(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, lv_color_to_u16(dsc->color));
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t blend_lv_fill_opa(lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!blend_simd_enabled() || dsc->dest_w < BLEND_MIN_SIMD_WIDTH) {
+        return LV_RESULT_INVALID;
+    }
+    blend_fill_rgb565_opa(dsc->dest_buf,
+                          dsc->dest_w,
+                          dsc->dest_h,
+                          dsc->dest_stride,
+                          lv_color_to_u16(dsc->color),
+                          dsc->opa);
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t blend_lv_image_opa(lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!blend_simd_enabled() || dsc->dest_w < BLEND_MIN_SIMD_WIDTH) {
+        return LV_RESULT_INVALID;
+    }
+    blend_rgb565_opa(dsc->dest_buf,
+                     dsc->dest_w,
+                     dsc->dest_h,
+                     dsc->dest_stride,
+                     dsc->src_buf,
+                     dsc->src_stride,
+                     dsc->opa);
+    return LV_RESULT_OK;
+}
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc)                  blend_lv_fill(dsc)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc)         blend_lv_fill_opa(dsc)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) blend_lv_image_opa(dsc)
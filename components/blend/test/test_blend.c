@@ -0,0 +1,79 @@
+#include "blend/blend.h"
+
+#include "sdkconfig.h"
+#include "unity.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define ROW_PX   1024
+#define ROWS     4
+#define STRIDE   ((ROW_PX + 8) * 2)
+
+static uint16_t s_a[(ROW_PX + 8) * ROWS] __attribute__((aligned(16)));
+static uint16_t s_b[(ROW_PX + 8) * ROWS] __attribute__((aligned(16)));
+static uint16_t s_src[(ROW_PX + 8) * ROWS] __attribute__((aligned(16)));
+
+static uint32_t s_seed = 0xC0FFEEu;
+
+static uint16_t rnd16(void)
+{
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 17;
+    s_seed ^= s_seed << 5;
+    return (uint16_t)s_seed;
+}
+
+static void randomize(void)
+{
+    for (size_t i = 0; i < sizeof(s_a) / sizeof(s_a[0]); ++i) {
+        s_a[i] = rnd16();
+        s_src[i] = rnd16();
+    }
+    memcpy(s_b, s_a, sizeof(s_b));
+}
+
+TEST_CASE("mix matches LVGL 16-bit blending", "[blend]")
+{
+    TEST_ASSERT_EQUAL_HEX16(0x7BEF, blend_mix_rgb565(0xFFFF, 0x0000, 128));
+    TEST_ASSERT_EQUAL_HEX16(0xC805, blend_mix_rgb565(0xF800, 0x001F, 204));
+    TEST_ASSERT_EQUAL_HEX16(0x4FE9, blend_mix_rgb565(0x07E0, 0xFFFF, 178));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, blend_mix_rgb565(0x1234, 0xABCD, 255));
+    TEST_ASSERT_EQUAL_HEX16(0xABCD, blend_mix_rgb565(0x1234, 0xABCD, 0));
+}
+
+TEST_CASE("vector kernels are bit-exact on full rows", "[blend]")
+{
+    const bool simd = blend_init();
+#if CONFIG_IDF_TARGET_ESP32S3
+    TEST_ASSERT_TRUE(simd);
+#else
+    TEST_ASSERT_FALSE(simd);
+#endif
+    static const uint8_t opas[] = {1, 64, 178, 204, 252};
+    for (int32_t off = 0; off < 8; ++off) {
+        const int32_t w = ROW_PX - off;
+        for (size_t i = 0; i < sizeof(opas) / sizeof(opas[0]); ++i) {
+            const uint16_t color = rnd16();
+            randomize();
+            blend_fill_rgb565_opa(s_a + off, w, ROWS, STRIDE, color, opas[i]);
+            blend_ref_fill_rgb565_opa(s_b + off, w, ROWS, STRIDE, color, opas[i]);
+            TEST_ASSERT_EQUAL_MEMORY(s_b, s_a, sizeof(s_a));
+
+            randomize();
+            blend_rgb565_opa(s_a + off, w, ROWS, STRIDE, s_src + off, STRIDE, opas[i]);
+            blend_ref_rgb565_opa(s_b + off, w, ROWS, STRIDE, s_src + off, STRIDE, opas[i]);
+            TEST_ASSERT_EQUAL_MEMORY(s_b, s_a, sizeof(s_a));
+        }
+        randomize();
+        blend_fill_rgb565(s_a + off, w, ROWS, STRIDE, 0x18E3);
+        blend_ref_fill_rgb565(s_b + off, w, ROWS, STRIDE, 0x18E3);
+        TEST_ASSERT_EQUAL_MEMORY(s_b, s_a, sizeof(s_a));
+    }
+}
+
+TEST_CASE("micro-benchmarks run", "[blend][bench]")
+{
+    blend_init();
+    blend_run_bench(10);
+}
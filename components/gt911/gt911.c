@@ -277,12 +277,38 @@ esp_err_t gt911_read_touch(gt911_handle_t *handle, uint16_t *x, uint16_t *y, boo
     return ESP_OK;
 }
 
+esp_err_t gt911_enable_irq(gt911_handle_t *handle, gt911_irq_cb_t cb, void *arg)
+{
+    if (!handle || !handle->initialized || !cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->irq_io == GPIO_NUM_NC) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    // Le service peut déjà avoir été installé par un autre pilote
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    ESP_RETURN_ON_ERROR(gpio_set_intr_type(handle->irq_io, GPIO_INTR_ANYEDGE), TAG, "IRQ type config failed");
+    ESP_RETURN_ON_ERROR(gpio_isr_handler_add(handle->irq_io, cb, arg), TAG, "IRQ handler install failed");
+    handle->irq_enabled = true;
+    return ESP_OK;
+}
+
 esp_err_t gt911_deinit(gt911_handle_t *handle)
 {
     if (!handle || !handle->initialized) {
         return ESP_ERR_INVALID_ARG;
     }
 
+    if (handle->irq_enabled) {
+        gpio_isr_handler_remove(handle->irq_io);
+        gpio_set_intr_type(handle->irq_io, GPIO_INTR_DISABLE);
+        handle->irq_enabled = false;
+    }
+
     if (handle->driver_owned) {
         esp_err_t err = i2c_driver_delete(handle->i2c_port);
         if (err != ESP_OK) {
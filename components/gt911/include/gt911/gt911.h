@@ -41,11 +41,23 @@ typedef struct {
     bool invert_y;
     bool swap_xy;
     bool driver_owned;
+    bool irq_enabled;
     bool initialized;
 } gt911_handle_t;
 
+/** Appelé en contexte d'interruption à chaque impulsion INT du contrôleur. */
+typedef void (*gt911_irq_cb_t)(void *arg);
+
 esp_err_t gt911_init(const gt911_config_t *config, gt911_handle_t *handle);
 esp_err_t gt911_read_touch(gt911_handle_t *handle, uint16_t *x, uint16_t *y, bool *touched);
+/**
+ * Arme l'interruption INT : le GT911 la pulse à chaque rapport de points
+ * (~100 Hz tant qu'un doigt est posé, puis une dernière fois au relâcher).
+ * Les deux fronts sont surveillés, la polarité dépendant de la configuration
+ * chargée dans le contrôleur. Installe le service ISR GPIO si besoin.
+ * @return ESP_ERR_NOT_SUPPORTED si irq_io n'est pas câblé.
+ */
+esp_err_t gt911_enable_irq(gt911_handle_t *handle, gt911_irq_cb_t cb, void *arg);
 esp_err_t gt911_deinit(gt911_handle_t *handle);
 
 #ifdef __cplusplus
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JOBS_MAX_WORKERS      8
+#define JOBS_DEQUE_CAPACITY   64
+// Au-delà de cette durée de calcul continu, jobs_yield() cède réellement le cœur
+#define JOBS_YIELD_SLICE_US   20000
+// Un ouvrier inactif se réveille au moins à cette période pour nourrir le watchdog
+#define JOBS_IDLE_WAIT_MS     1000
+// Sans tranche à voler, jobs_parallel_for() dort jusqu'à la fin de sa boucle,
+// ou au plus ce délai (au moins un tick) avant de chercher de nouvelles tranches
+#define JOBS_HELP_WAIT_MS     1
+#define JOBS_DEFAULT_STACK    4096
+// Sous la tâche LVGL (4) : l'interface reste prioritaire sur son cœur
+#define JOBS_DEFAULT_PRIORITY 3
+
+typedef struct {
+    uint8_t workers;       /*!< 0 = un ouvrier par cœur. */
+    uint32_t stack_bytes;  /*!< Pile des ouvriers (0 = JOBS_DEFAULT_STACK ; défaut système sur hôte). */
+    uint8_t priority;      /*!< Priorité FreeRTOS (0 = JOBS_DEFAULT_PRIORITY ; ignorée sur hôte). */
+} jobs_config_t;
+
+/**
+ * @brief Jeton d'annulation partagé entre le demandeur et les tranches en cours.
+ * Initialiser à zéro ; une demande d'annulation est définitive.
+ */
+typedef struct {
+    volatile uint32_t requested;
+} jobs_cancel_t;
+
+/** Traite les indices [begin, end) ; `ctx` est celui passé à jobs_parallel_for(). */
+typedef void (*jobs_range_fn_t)(void *ctx, uint32_t begin, uint32_t end);
+
+/**
+ * Démarre les ouvriers : sur ESP32-S3, une tâche épinglée par cœur ; sur hôte,
+ * un fil POSIX par processeur en ligne. Chaque ouvrier possède une file à deux
+ * bouts : il empile et dépile ses propres tranches par le bas, les ouvriers
+ * inoccupés volent les plus grosses par le haut. `config` peut être NULL.
+ */
+bool jobs_init(const jobs_config_t *config);
+void jobs_deinit(void);
+bool jobs_ready(void);
+/** Nombre d'ouvriers démarrés (0 si jobs_init() n'a pas été appelé). */
+uint8_t jobs_worker_count(void);
+
+/**
+ * Exécute `fn` sur [begin, end) découpé en tranches d'au moins `grain` indices
+ * (0 = découpage automatique), en parallèle sur les ouvriers. Bloquant : le fil
+ * appelant participe au travail en attendant la fin, ce qui rend les appels
+ * imbriqués sûrs. Sans ouvriers, s'exécute en série dans l'appelant.
+ * @return false si `cancel` a été levé avant la fin (tranches restantes sautées).
+ */
+bool jobs_parallel_for(uint32_t begin,
+                       uint32_t end,
+                       uint32_t grain,
+                       jobs_range_fn_t fn,
+                       void *ctx,
+                       jobs_cancel_t *cancel);
+
+void jobs_cancel_request(jobs_cancel_t *cancel);
+bool jobs_cancelled(const jobs_cancel_t *cancel);
+
+/**
+ * Point de coopération pour les boucles longues : nourrit le watchdog si la
+ * tâche courante y est inscrite et cède le cœur (tâche IDLE comprise) après
+ * JOBS_YIELD_SLICE_US de calcul continu. Bon marché : appelable à chaque tranche.
+ */
+void jobs_yield(void);
+
+typedef struct {
+    uint32_t executed;  /*!< Tranches exécutées par l'ouvrier. */
+    uint32_t stolen;    /*!< Dont tranches volées dans la file d'un autre. */
+} jobs_worker_stats_t;
+
+bool jobs_get_stats(uint8_t worker, jobs_worker_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
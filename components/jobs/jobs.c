@@ -0,0 +1,559 @@
+#include "jobs/jobs.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#include "esp_task_wdt.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+static const char *TAG = "jobs";
+typedef portMUX_TYPE lock_t;
+#define LOCK_INIT(l) portMUX_INITIALIZE(l)
+#define LOCK(l)      portENTER_CRITICAL(l)
+#define UNLOCK(l)    portEXIT_CRITICAL(l)
+#define JOBS_LOG(fmt, ...)  ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define JOBS_WARN(fmt, ...) ESP_LOGW(TAG, fmt, ##__VA_ARGS__)
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t lock_t;
+#define LOCK_INIT(l) pthread_mutex_init(l, NULL)
+#define LOCK(l)      pthread_mutex_lock(l)
+#define UNLOCK(l)    pthread_mutex_unlock(l)
+#define JOBS_LOG(fmt, ...)  printf("[jobs] " fmt "\n", ##__VA_ARGS__)
+#define JOBS_WARN(fmt, ...) printf("[jobs] " fmt "\n", ##__VA_ARGS__)
+#endif
+
+// Une boucle parallèle en cours ; vit sur la pile de l'appelant jusqu'à ce que
+// la tranche qui amène pending à 0 ait signalé done
+typedef struct {
+    jobs_range_fn_t fn;
+    void *ctx;
+    uint32_t grain;
+    jobs_cancel_t *cancel;
+    atomic_uint pending;
+#ifdef ESP_PLATFORM
+    StaticSemaphore_t done_buf;
+    SemaphoreHandle_t done;
+#else
+    pthread_mutex_t done_lock;
+    pthread_cond_t done_cv;
+    bool done;
+#endif
+} group_t;
+
+typedef struct {
+    group_t *group;
+    uint32_t begin;
+    uint32_t end;
+} job_t;
+
+// File à deux bouts : le propriétaire travaille par le bas (LIFO, données encore
+// en cache), les voleurs prennent par le haut les tranches les plus grosses.
+typedef struct {
+    lock_t lock;
+    uint32_t top;
+    uint32_t bottom;
+    job_t ring[JOBS_DEQUE_CAPACITY];
+} deque_t;
+
+typedef struct {
+#ifdef ESP_PLATFORM
+    TaskHandle_t task;
+#else
+    pthread_t thread;
+    sem_t wake;
+#endif
+    atomic_uint executed;
+    atomic_uint stolen;
+} worker_t;
+
+// Une file par ouvrier, plus une partagée par les fils extérieurs (app_main, LVGL…)
+#define EXTERNAL_SLOT JOBS_MAX_WORKERS
+
+static deque_t s_deques[JOBS_MAX_WORKERS + 1];
+static worker_t s_workers[JOBS_MAX_WORKERS];
+// Publié ouvrier par ouvrier : les premiers démarrés le lisent pendant jobs_init()
+static atomic_uint s_worker_count;
+static atomic_bool s_running;
+static atomic_int s_sleepers;
+static atomic_int s_alive;
+static bool s_ready;
+
+static _Thread_local int t_slot = EXTERNAL_SLOT;
+static _Thread_local int64_t t_slice_start;
+static _Thread_local uint32_t t_nesting;
+
+static int64_t now_us(void)
+{
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+#ifndef ESP_PLATFORM
+static struct timespec deadline_ms(uint32_t ms)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+#endif
+
+static void group_done_init(group_t *g)
+{
+#ifdef ESP_PLATFORM
+    g->done = xSemaphoreCreateBinaryStatic(&g->done_buf);
+#else
+    pthread_mutex_init(&g->done_lock, NULL);
+    pthread_cond_init(&g->done_cv, NULL);
+    g->done = false;
+#endif
+}
+
+static void group_done_deinit(group_t *g)
+{
+#ifdef ESP_PLATFORM
+    vSemaphoreDelete(g->done);
+#else
+    pthread_cond_destroy(&g->done_cv);
+    pthread_mutex_destroy(&g->done_lock);
+#endif
+}
+
+// Dernier accès au groupe par la tranche qui termine la boucle
+static void group_done_signal(group_t *g)
+{
+#ifdef ESP_PLATFORM
+    xSemaphoreGive(g->done);
+#else
+    pthread_mutex_lock(&g->done_lock);
+    g->done = true;
+    pthread_cond_broadcast(&g->done_cv);
+    pthread_mutex_unlock(&g->done_lock);
+#endif
+}
+
+// Vrai une fois le signal de fin reçu ; wait_ms < 0 : attente sans limite
+static bool group_done_wait(group_t *g, int32_t wait_ms)
+{
+#ifdef ESP_PLATFORM
+    TickType_t ticks = portMAX_DELAY;
+    if (wait_ms >= 0) {
+        ticks = pdMS_TO_TICKS(wait_ms);
+        ticks = ticks ? ticks : 1;
+    }
+    return xSemaphoreTake(g->done, ticks) == pdTRUE;
+#else
+    pthread_mutex_lock(&g->done_lock);
+    if (wait_ms < 0) {
+        while (!g->done) {
+            pthread_cond_wait(&g->done_cv, &g->done_lock);
+        }
+    } else if (!g->done) {
+        const struct timespec ts = deadline_ms((uint32_t)wait_ms);
+        pthread_cond_timedwait(&g->done_cv, &g->done_lock, &ts);
+    }
+    const bool done = g->done;
+    pthread_mutex_unlock(&g->done_lock);
+    return done;
+#endif
+}
+
+static bool push(deque_t *d, const job_t *job)
+{
+    LOCK(&d->lock);
+    const bool ok = d->bottom - d->top < JOBS_DEQUE_CAPACITY;
+    if (ok) {
+        d->ring[d->bottom % JOBS_DEQUE_CAPACITY] = *job;
+        d->bottom++;
+    }
+    UNLOCK(&d->lock);
+    return ok;
+}
+
+static bool pop(deque_t *d, job_t *out)
+{
+    LOCK(&d->lock);
+    const bool ok = d->bottom != d->top;
+    if (ok) {
+        d->bottom--;
+        *out = d->ring[d->bottom % JOBS_DEQUE_CAPACITY];
+    }
+    UNLOCK(&d->lock);
+    return ok;
+}
+
+static bool steal(deque_t *d, job_t *out)
+{
+    LOCK(&d->lock);
+    const bool ok = d->bottom != d->top;
+    if (ok) {
+        *out = d->ring[d->top % JOBS_DEQUE_CAPACITY];
+        d->top++;
+    }
+    UNLOCK(&d->lock);
+    return ok;
+}
+
+static void wake_sleepers(void)
+{
+    if (atomic_load(&s_sleepers) == 0) {
+        return;
+    }
+    const uint32_t count = atomic_load(&s_worker_count);
+    for (uint32_t i = 0; i < count; ++i) {
+#ifdef ESP_PLATFORM
+        xTaskNotifyGive(s_workers[i].task);
+#else
+        sem_post(&s_workers[i].wake);
+#endif
+    }
+}
+
+// Sa propre file d'abord, puis vol chez les autres en partant du voisin
+static bool find_job(int slot, job_t *out, bool *stolen)
+{
+    if (pop(&s_deques[slot], out)) {
+        *stolen = false;
+        return true;
+    }
+    const int workers = (int)atomic_load(&s_worker_count);
+    const int n = workers + 1;
+    const int self = (slot == EXTERNAL_SLOT) ? workers : slot;
+    for (int k = 1; k < n; ++k) {
+        const int victim = (self + k) % n;
+        if (steal(&s_deques[victim == workers ? EXTERNAL_SLOT : victim], out)) {
+            *stolen = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void run_job(job_t job)
+{
+    group_t *g = job.group;
+    deque_t *own = &s_deques[t_slot];
+    // Découpage binaire paresseux : la moitié haute est offerte aux voleurs
+    while (job.end - job.begin > g->grain && !jobs_cancelled(g->cancel)) {
+        const uint32_t mid = job.begin + (job.end - job.begin) / 2;
+        const job_t half = {.group = g, .begin = mid, .end = job.end};
+        atomic_fetch_add(&g->pending, 1);
+        if (!push(own, &half)) {
+            // File pleine : le reste est traité ici, tranche par tranche
+            atomic_fetch_sub(&g->pending, 1);
+            break;
+        }
+        wake_sleepers();
+        job.end = mid;
+    }
+    for (uint32_t b = job.begin; b < job.end && !jobs_cancelled(g->cancel); b += g->grain) {
+        const uint32_t e = (job.end - b > g->grain) ? b + g->grain : job.end;
+        g->fn(g->ctx, b, e);
+        jobs_yield();
+    }
+    if (atomic_fetch_sub_explicit(&g->pending, 1, memory_order_acq_rel) == 1) {
+        group_done_signal(g);
+    }
+}
+
+static void wait_for_work(worker_t *w)
+{
+#ifdef ESP_PLATFORM
+    (void)w;
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(JOBS_IDLE_WAIT_MS));
+#else
+    const struct timespec ts = deadline_ms(JOBS_IDLE_WAIT_MS);
+    sem_timedwait(&w->wake, &ts);
+#endif
+}
+
+static void worker_loop(int slot)
+{
+    worker_t *w = &s_workers[slot];
+    t_slot = slot;
+#ifdef ESP_PLATFORM
+    const bool wdt = esp_task_wdt_add(NULL) == ESP_OK;
+#endif
+    while (atomic_load(&s_running)) {
+        job_t job;
+        bool stolen;
+        t_slice_start = now_us();
+        if (find_job(slot, &job, &stolen)) {
+            atomic_fetch_add_explicit(&w->executed, 1, memory_order_relaxed);
+            if (stolen) {
+                atomic_fetch_add_explicit(&w->stolen, 1, memory_order_relaxed);
+            }
+            run_job(job);
+            continue;
+        }
+        // Inscription avant la seconde recherche : un empilement concurrent
+        // voit soit le dormeur, soit sa tranche est trouvée ici.
+        atomic_fetch_add(&s_sleepers, 1);
+        if (find_job(slot, &job, &stolen)) {
+            atomic_fetch_sub(&s_sleepers, 1);
+            atomic_fetch_add_explicit(&w->executed, 1, memory_order_relaxed);
+            if (stolen) {
+                atomic_fetch_add_explicit(&w->stolen, 1, memory_order_relaxed);
+            }
+            run_job(job);
+            continue;
+        }
+        wait_for_work(w);
+        atomic_fetch_sub(&s_sleepers, 1);
+#ifdef ESP_PLATFORM
+        if (wdt) {
+            esp_task_wdt_reset();
+        }
+#endif
+    }
+#ifdef ESP_PLATFORM
+    if (wdt) {
+        esp_task_wdt_delete(NULL);
+    }
+#endif
+    atomic_fetch_sub(&s_alive, 1);
+}
+
+#ifdef ESP_PLATFORM
+static void worker_task(void *arg)
+{
+    worker_loop((int)(intptr_t)arg);
+    vTaskDelete(NULL);
+}
+#else
+static void *worker_thread(void *arg)
+{
+    worker_loop((int)(intptr_t)arg);
+    return NULL;
+}
+#endif
+
+bool jobs_init(const jobs_config_t *config)
+{
+    if (s_ready) {
+        return true;
+    }
+    const jobs_config_t def = {0};
+    const jobs_config_t *cfg = config ? config : &def;
+#ifdef ESP_PLATFORM
+    uint32_t count = cfg->workers ? cfg->workers : portNUM_PROCESSORS;
+#else
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t count = cfg->workers ? cfg->workers : (online > 0 ? (uint32_t)online : 1u);
+#endif
+    count = count > JOBS_MAX_WORKERS ? JOBS_MAX_WORKERS : count;
+
+    for (int i = 0; i <= JOBS_MAX_WORKERS; ++i) {
+        LOCK_INIT(&s_deques[i].lock);
+        s_deques[i].top = 0;
+        s_deques[i].bottom = 0;
+    }
+    atomic_store(&s_running, true);
+    atomic_store(&s_sleepers, 0);
+    atomic_store(&s_alive, 0);
+    atomic_store(&s_worker_count, 0);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        worker_t *w = &s_workers[i];
+        atomic_store(&w->executed, 0);
+        atomic_store(&w->stolen, 0);
+        atomic_fetch_add(&s_alive, 1);
+#ifdef ESP_PLATFORM
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "jobs%u", (unsigned)i);
+        const BaseType_t ok = xTaskCreatePinnedToCore(worker_task,
+                                                      name,
+                                                      cfg->stack_bytes ? cfg->stack_bytes : JOBS_DEFAULT_STACK,
+                                                      (void *)(intptr_t)i,
+                                                      cfg->priority ? cfg->priority : JOBS_DEFAULT_PRIORITY,
+                                                      &w->task,
+                                                      (BaseType_t)(i % portNUM_PROCESSORS));
+        if (ok != pdPASS) {
+            atomic_fetch_sub(&s_alive, 1);
+            JOBS_WARN("ouvrier %u non créé", (unsigned)i);
+            break;
+        }
+#else
+        sem_init(&w->wake, 0, 0);
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (cfg->stack_bytes) {
+            pthread_attr_setstacksize(&attr, cfg->stack_bytes);
+        }
+        const int err = pthread_create(&w->thread, &attr, worker_thread, (void *)(intptr_t)i);
+        pthread_attr_destroy(&attr);
+        if (err != 0) {
+            atomic_fetch_sub(&s_alive, 1);
+            sem_destroy(&w->wake);
+            JOBS_WARN("ouvrier %u non créé (%s)", (unsigned)i, strerror(err));
+            break;
+        }
+#endif
+        atomic_fetch_add(&s_worker_count, 1);
+    }
+    s_ready = atomic_load(&s_worker_count) > 0;
+    if (s_ready) {
+        JOBS_LOG("ouvriers démarrés : %u", (unsigned)atomic_load(&s_worker_count));
+    } else {
+        atomic_store(&s_running, false);
+    }
+    return s_ready;
+}
+
+void jobs_deinit(void)
+{
+    if (!s_ready) {
+        return;
+    }
+    atomic_store(&s_running, false);
+    const uint32_t count = atomic_load(&s_worker_count);
+    for (uint32_t i = 0; i < count; ++i) {
+#ifdef ESP_PLATFORM
+        xTaskNotifyGive(s_workers[i].task);
+#else
+        sem_post(&s_workers[i].wake);
+#endif
+    }
+#ifdef ESP_PLATFORM
+    while (atomic_load(&s_alive) > 0) {
+        vTaskDelay(1);
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i) {
+        pthread_join(s_workers[i].thread, NULL);
+        sem_destroy(&s_workers[i].wake);
+    }
+#endif
+    atomic_store(&s_worker_count, 0);
+    s_ready = false;
+}
+
+bool jobs_ready(void)
+{
+    return s_ready;
+}
+
+uint8_t jobs_worker_count(void)
+{
+    return (uint8_t)atomic_load(&s_worker_count);
+}
+
+bool jobs_parallel_for(uint32_t begin,
+                       uint32_t end,
+                       uint32_t grain,
+                       jobs_range_fn_t fn,
+                       void *ctx,
+                       jobs_cancel_t *cancel)
+{
+    if (!fn || end <= begin) {
+        return !jobs_cancelled(cancel);
+    }
+    const uint32_t count = end - begin;
+    if (grain == 0) {
+        // Environ quatre tranches par participant pour lisser les écarts de charge
+        grain = count / (4u * (atomic_load(&s_worker_count) + 1u));
+        grain = grain ? grain : 1u;
+    }
+    if (t_nesting++ == 0) {
+        t_slice_start = now_us();
+    }
+
+    if (!s_ready || count <= grain) {
+        for (uint32_t b = begin; b < end && !jobs_cancelled(cancel); b += grain) {
+            fn(ctx, b, (end - b > grain) ? b + grain : end);
+            jobs_yield();
+        }
+        t_nesting--;
+        return !jobs_cancelled(cancel);
+    }
+
+    group_t g = {.fn = fn, .ctx = ctx, .grain = grain, .cancel = cancel};
+    atomic_init(&g.pending, 1);
+    group_done_init(&g);
+    run_job((job_t){.group = &g, .begin = begin, .end = end});
+    // L'appelant aide jusqu'à la fin, y compris sur d'autres boucles en cours.
+    // Sans rien à voler, il dort au lieu de tourner : une tâche plus
+    // prioritaire que l'ouvrier de son cœur (LVGL) l'empêcherait sinon de
+    // finir la tranche qu'il tient.
+    bool signalled = false;
+    while (atomic_load_explicit(&g.pending, memory_order_acquire) != 0) {
+        job_t job;
+        bool stolen;
+        if (find_job(t_slot, &job, &stolen)) {
+            run_job(job);
+        } else if (group_done_wait(&g, JOBS_HELP_WAIT_MS)) {
+            signalled = true;
+            break;
+        }
+    }
+    // Le signal suit toujours la dernière décrémentation : l'attendre avant
+    // de rendre le groupe, qui vit sur cette pile
+    if (!signalled) {
+        group_done_wait(&g, -1);
+    }
+    group_done_deinit(&g);
+    t_nesting--;
+    return !jobs_cancelled(cancel);
+}
+
+void jobs_cancel_request(jobs_cancel_t *cancel)
+{
+    if (cancel) {
+        __atomic_store_n(&cancel->requested, 1u, __ATOMIC_RELEASE);
+    }
+}
+
+bool jobs_cancelled(const jobs_cancel_t *cancel)
+{
+    return cancel && __atomic_load_n(&cancel->requested, __ATOMIC_ACQUIRE) != 0;
+}
+
+void jobs_yield(void)
+{
+    const int64_t now = now_us();
+    if (now - t_slice_start < JOBS_YIELD_SLICE_US) {
+        return;
+    }
+#ifdef ESP_PLATFORM
+    if (esp_task_wdt_status(NULL) == ESP_OK) {
+        esp_task_wdt_reset();
+    }
+    // Un tick complet : laisse tourner IDLE (surveillée par le watchdog) et les tâches moins prioritaires
+    vTaskDelay(1);
+#else
+    sched_yield();
+#endif
+    t_slice_start = now_us();
+}
+
+bool jobs_get_stats(uint8_t worker, jobs_worker_stats_t *out)
+{
+    if (!out || worker >= atomic_load(&s_worker_count)) {
+        return false;
+    }
+    out->executed = atomic_load_explicit(&s_workers[worker].executed, memory_order_relaxed);
+    out->stolen = atomic_load_explicit(&s_workers[worker].stolen, memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,87 @@
+#include "jobs/jobs.h"
+
+#include "unity.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define N_ITEMS 10000
+
+static uint8_t s_hits[N_ITEMS];
+
+static void mark_range(void *ctx, uint32_t begin, uint32_t end)
+{
+    (void)ctx;
+    for (uint32_t i = begin; i < end; ++i) {
+        __atomic_add_fetch(&s_hits[i], 1, __ATOMIC_RELAXED);
+    }
+}
+
+typedef struct {
+    jobs_cancel_t cancel;
+    uint32_t done;
+} cancel_ctx_t;
+
+static void cancel_after_first(void *ctx, uint32_t begin, uint32_t end)
+{
+    cancel_ctx_t *c = ctx;
+    __atomic_add_fetch(&c->done, end - begin, __ATOMIC_RELAXED);
+    jobs_cancel_request(&c->cancel);
+}
+
+static void nested_outer(void *ctx, uint32_t begin, uint32_t end)
+{
+    (void)ctx;
+    for (uint32_t row = begin; row < end; ++row) {
+        // Boucle interne lancée depuis un ouvrier : l'appelant aide, pas d'interblocage
+        jobs_parallel_for(row * 100u, row * 100u + 100u, 10, mark_range, NULL, NULL);
+    }
+}
+
+TEST_CASE("parallel_for visits every index exactly once", "[jobs]")
+{
+    TEST_ASSERT_TRUE(jobs_init(&(jobs_config_t){.workers = 2}));
+    memset(s_hits, 0, sizeof(s_hits));
+    TEST_ASSERT_TRUE(jobs_parallel_for(0, N_ITEMS, 0, mark_range, NULL, NULL));
+    for (uint32_t i = 0; i < N_ITEMS; ++i) {
+        TEST_ASSERT_EQUAL(1, s_hits[i]);
+    }
+
+    // Bornes non nulles et grain plus grand que la plage
+    memset(s_hits, 0, sizeof(s_hits));
+    TEST_ASSERT_TRUE(jobs_parallel_for(17, 40, 64, mark_range, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, s_hits[16]);
+    TEST_ASSERT_EQUAL(1, s_hits[17]);
+    TEST_ASSERT_EQUAL(1, s_hits[39]);
+    TEST_ASSERT_EQUAL(0, s_hits[40]);
+    jobs_deinit();
+}
+
+TEST_CASE("cancellation skips the remaining slices", "[jobs]")
+{
+    TEST_ASSERT_TRUE(jobs_init(&(jobs_config_t){.workers = 2}));
+    cancel_ctx_t c = {0};
+    TEST_ASSERT_FALSE(jobs_parallel_for(0, N_ITEMS, 100, cancel_after_first, &c, &c.cancel));
+    TEST_ASSERT_TRUE(jobs_cancelled(&c.cancel));
+    // Au plus une tranche par participant a pu démarrer avant de voir l'annulation
+    TEST_ASSERT_LESS_OR_EQUAL(100u * (jobs_worker_count() + 1u), c.done);
+    jobs_deinit();
+}
+
+TEST_CASE("nested parallel_for and serial fallback", "[jobs]")
+{
+    TEST_ASSERT_TRUE(jobs_init(&(jobs_config_t){.workers = 2}));
+    memset(s_hits, 0, sizeof(s_hits));
+    TEST_ASSERT_TRUE(jobs_parallel_for(0, N_ITEMS / 100, 1, nested_outer, NULL, NULL));
+    for (uint32_t i = 0; i < N_ITEMS; ++i) {
+        TEST_ASSERT_EQUAL(1, s_hits[i]);
+    }
+    jobs_deinit();
+
+    // Sans ouvriers : même résultat, exécuté dans l'appelant
+    TEST_ASSERT_FALSE(jobs_ready());
+    memset(s_hits, 0, sizeof(s_hits));
+    TEST_ASSERT_TRUE(jobs_parallel_for(0, N_ITEMS, 0, mark_range, NULL, NULL));
+    TEST_ASSERT_EQUAL(1, s_hits[0]);
+    TEST_ASSERT_EQUAL(1, s_hits[N_ITEMS - 1]);
+}
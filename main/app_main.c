@@ -5,7 +5,11 @@
 #include <string.h>
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
+#include "esp_async_memcpy.h"
+#include "esp_attr.h"
+#include "esp_cache.h"
 #include "esp_check.h"
 #include "esp_err.h"
 #include "esp_heap_caps.h"
@@ -20,22 +24,39 @@
 #endif
 #include "lvgl.h"
 
+#include "arena/arena.h"
+#include "blend/blend.h"
 #include "board_waveshare_7b.h"
+#include "calc_airflow.h"
+#include "calc_calibration.h"
+#include "calc_floor_stack.h"
 #include "calc_heating_cable.h"
 #include "calc_heating_pad.h"
 #include "calc_lighting.h"
 #include "calc_misting.h"
+#include "calc_misting_network.h"
+#include "calc_species.h"
+#include "calc_spectrum.h"
 #include "calc_substrate.h"
 #include "gt911/gt911.h"
+#include "jobs/jobs.h"
 #include "storage.h"
+#include "perf_hud.h"
 #include "ui_main.h"
 
 __attribute__((weak)) void board_ch422g_enable(void) {}
 
 static const char *TAG = "app";
 
+// Zones de calcul (arène) réservées après les tampons d'affichage LVGL
+#define ARENA_INTERNAL_BYTES (48 * 1024)
+#define ARENA_PSRAM_BYTES    (4 * 1024 * 1024)
+
 static esp_lcd_panel_handle_t s_panel_handle;
-static esp_timer_handle_t s_lvgl_tick_timer;
+// Interruption GT911 vue au moins une fois : la lecture tactile peut être
+// suspendue au repos. Tant qu'aucune n'est arrivée (INT non câblée ou
+// non configurée dans le contrôleur), LVGL continue de scruter.
+static volatile bool s_touch_irq_seen;
 static gt911_handle_t s_touch_handle;
 static TaskHandle_t s_lvgl_task_handle;
 static lv_display_t *s_display;
@@ -48,10 +69,131 @@ static bool s_psram_available;
 typedef struct {
     lv_color_t *buf1;
     lv_color_t *buf2;
+    uint16_t lines;   /*!< Lignes pleine largeur par tampon (mode partiel). */
+    bool in_psram;
 } lvgl_buffers_t;
 
 static lvgl_buffers_t s_lvgl_buffers;
 
+#define LCD_BOUNCE_ENABLED    (CONFIG_TERRARIUM_LCD_BOUNCE_LINES > 0)
+// Options booléennes ramenées à 0/1 : utilisables hors des #if
+#if CONFIG_TERRARIUM_LVGL_RENDER_PARTIAL && CONFIG_TERRARIUM_LCD_TEAR_FREE
+#define LCD_TEAR_FREE_PARTIAL 1
+#else
+#define LCD_TEAR_FREE_PARTIAL 0
+#endif
+#if CONFIG_TERRARIUM_LVGL_RENDER_PARTIAL && CONFIG_TERRARIUM_LCD_ASYNC_FLUSH
+#define LCD_ASYNC_FLUSH 1
+#else
+#define LCD_ASYNC_FLUSH 0
+#endif
+// L'application écrit elle-même dans les framebuffers du panneau
+#define LCD_FB_COPY           (LCD_TEAR_FREE_PARTIAL || LCD_ASYNC_FLUSH)
+#if CONFIG_TERRARIUM_LVGL_RENDER_DIRECT || LCD_TEAR_FREE_PARTIAL
+#define LCD_FB_COUNT 2
+#else
+#define LCD_FB_COUNT 1
+#endif
+#define LCD_BYTES_PER_PX 2
+#define LCD_FB_STRIDE    ((size_t)BOARD_LCD_H_RES * LCD_BYTES_PER_PX)
+
+// Au-delà, la trame est présentée sans attendre (panneau arrêté ou horloge absente)
+#define VSYNC_TIMEOUT_MS 100
+// Période de rafraîchissement LVGL : la trame dalle arrondie à la ms la plus
+// proche (47 ms à 18 MHz). Arrondir au-dessus ferait perdre une trame sur
+// quelques-unes une fois ajoutée la granularité du tick FreeRTOS.
+#define LCD_FRAME_PERIOD_MS ((BOARD_LCD_FRAME_PERIOD_US + 500u) / 1000u)
+// Sommeil maximal de la tâche LVGL sans minuteur actif, pour nourrir le watchdog
+#define LVGL_IDLE_WAIT_MS 1000
+// Fenêtre du bilan trames rendues / affichées, en ticks du minuteur de 1 s
+#define LCD_PACING_REPORT_S 10
+// Donné à chaque synchro verticale par l'interruption LCD
+static SemaphoreHandle_t s_vsync_sem;
+// Compteurs mis à jour depuis l'interruption ou le flush, journalisés chaque seconde
+static volatile uint32_t s_vsync_count;
+static volatile uint32_t s_tear_count;
+// Trames complètes envoyées par LVGL, comparées aux synchros (trames affichées)
+static volatile uint32_t s_rendered_count;
+static esp_timer_handle_t s_lcd_stats_timer;
+
+#if LCD_BOUNCE_ENABLED
+// Le pilote exige un nombre entier de paires de tampons par trame
+_Static_assert(BOARD_LCD_V_RES % (2 * CONFIG_TERRARIUM_LCD_BOUNCE_LINES) == 0,
+               "2 x TERRARIUM_LCD_BOUNCE_LINES doit diviser BOARD_LCD_V_RES");
+// Trame dont les tampons de rebond n'ont pas tous été rechargés avant la synchro
+// verticale suivante : le LCD a relu des lignes périmées (sous-alimentation)
+static volatile bool s_bb_frame_filled = true;
+static volatile uint32_t s_bb_underruns;
+#endif
+
+#if LCD_FB_COPY
+static uint8_t *s_fbs[2];
+
+typedef enum {
+    COPY_DONE_NONE,
+    COPY_DONE_FLUSH_READY,  /*!< Rend le tampon de rendu à LVGL. */
+    COPY_DONE_NOTIFY,       /*!< Réveille fb_copy_wait(). */
+    COPY_DONE_FRAME_READY,  /*!< Dernière zone d'une trame copiée dans l'image balayée : contrôle de déchirure, puis comme FLUSH_READY. */
+} copy_done_t;
+#endif
+
+#if LCD_ASYNC_FLUSH
+// Zones alignées sur 32 pixels : 64 octets, l'alignement exigé par la GDMA en PSRAM
+#define ASYNC_COPY_ALIGN_PX    32
+#define ASYNC_COPY_ALIGN_BYTES (ASYNC_COPY_ALIGN_PX * LCD_BYTES_PER_PX)
+// Lignes en vol par zone : de quoi enchaîner les transferts sans attendre l'interruption
+#define ASYNC_COPY_BACKLOG     4
+#define ASYNC_COPY_QUEUE_LEN   24
+_Static_assert(BOARD_LCD_H_RES % ASYNC_COPY_ALIGN_PX == 0, "BOARD_LCD_H_RES doit être multiple de 32");
+
+// Une zone à recopier : `rows` transferts de `row_bytes`, ou un seul si la zone
+// est contiguë des deux côtés (pleine largeur)
+typedef struct {
+    uint8_t *dst;
+    const uint8_t *src;
+    size_t dst_stride;
+    size_t src_stride;
+    size_t row_bytes;
+    uint32_t rows;
+    uint32_t submitted;
+    uint32_t completed;
+    uint8_t *dst_lines;      /*!< Lignes entières du framebuffer couvertes par la zone. */
+    size_t dst_lines_bytes;
+    copy_done_t done;
+} copy_job_t;
+
+static async_memcpy_handle_t s_copy_dma;
+static copy_job_t s_copy_jobs[ASYNC_COPY_QUEUE_LEN];
+static uint32_t s_copy_head;
+static uint32_t s_copy_count;
+static portMUX_TYPE s_copy_lock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t s_copy_done_sem;
+static volatile uint32_t s_copy_errors;
+#endif
+
+#if CONFIG_TERRARIUM_LVGL_RENDER_PARTIAL
+// Un dixième d'écran, sauf réglage enregistré
+#define DRAW_BUF_DEFAULT_LINES (BOARD_LCD_V_RES / 10)
+#define DRAW_BUF_TUNE_FRAMES   4
+// SRAM interne laissée libre quoi qu'il arrive (piles, pilotes, Wi-Fi éventuel)
+#define DRAW_BUF_SRAM_RESERVE  (64 * 1024)
+// Tampons issus d'un réglage enregistré : pas de nouvelle mesure
+static bool s_draw_buf_tuned;
+#endif
+
+#if LCD_TEAR_FREE_PARTIAL
+// Au-delà, la trame entière est recopiée dans l'autre framebuffer
+#define TEAR_FREE_MAX_AREAS 16
+// Le panneau affiche fbs[0] au démarrage : LVGL remplit d'abord fbs[1]
+static uint8_t s_back_fb = 1;
+static lv_area_t s_frame_areas[TEAR_FREE_MAX_AREAS];
+static uint32_t s_frame_area_count;
+#elif !CONFIG_TERRARIUM_LVGL_RENDER_DIRECT
+// Synchro verticale vue au premier fragment de la trame en cours
+static uint32_t s_frame_vsync;
+static bool s_frame_open;
+#endif
+
 static bool query_psram_once(void);
 static esp_err_t init_touch(void);
 static void deinit_touch(void);
@@ -130,6 +272,353 @@ static bool query_psram_once(void)
 }
 #endif
 
+#if LCD_BOUNCE_ENABLED
+static bool IRAM_ATTR rgb_panel_bounce_frame_cb(esp_lcd_panel_handle_t panel,
+                                                const esp_lcd_rgb_panel_event_data_t *edata,
+                                                void *user_data)
+{
+    (void)panel;
+    (void)edata;
+    (void)user_data;
+    s_bb_frame_filled = true;
+    return false;
+}
+#endif
+
+static bool IRAM_ATTR rgb_panel_vsync_cb(esp_lcd_panel_handle_t panel,
+                                         const esp_lcd_rgb_panel_event_data_t *edata,
+                                         void *user_data)
+{
+    (void)panel;
+    (void)edata;
+    (void)user_data;
+    s_vsync_count++;
+#if LCD_BOUNCE_ENABLED
+    if (!s_bb_frame_filled) {
+        s_bb_underruns++;
+    }
+    s_bb_frame_filled = false;
+#endif
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(s_vsync_sem, &woken);
+    return woken == pdTRUE;
+}
+
+static void lcd_stats_report_cb(void *arg)
+{
+    (void)arg;
+    static uint32_t s_last_tears;
+    const uint32_t tears = s_tear_count;
+    if (tears != s_last_tears) {
+        ESP_LOGW(TAG, "LCD : %u trame(s) déchirée(s)/s (total %u)", (unsigned)(tears - s_last_tears), (unsigned)tears);
+        s_last_tears = tears;
+    }
+#if LCD_BOUNCE_ENABLED
+    static uint32_t s_last_underruns;
+    const uint32_t underruns = s_bb_underruns;
+    if (underruns != s_last_underruns) {
+        ESP_LOGW(TAG,
+                 "LCD : %u sous-alimentation(s)/s des tampons de rebond (total %u)",
+                 (unsigned)(underruns - s_last_underruns),
+                 (unsigned)underruns);
+        s_last_underruns = underruns;
+    }
+#endif
+#if LCD_ASYNC_FLUSH
+    static uint32_t s_last_copy_errors;
+    const uint32_t copy_errors = s_copy_errors;
+    if (copy_errors != s_last_copy_errors) {
+        ESP_LOGW(TAG, "LCD : %u copie(s) DMA refusée(s)/s (total %u)", (unsigned)(copy_errors - s_last_copy_errors), (unsigned)copy_errors);
+        s_last_copy_errors = copy_errors;
+    }
+#endif
+
+    static uint32_t s_window_s;
+    static uint32_t s_last_rendered;
+    static uint32_t s_last_vsync;
+    if (++s_window_s < LCD_PACING_REPORT_S) {
+        return;
+    }
+    s_window_s = 0;
+    const uint32_t rendered = s_rendered_count;
+    const uint32_t vsyncs = s_vsync_count;
+    // Écran figé : LVGL ne rend rien, inutile de journaliser
+    if (rendered != s_last_rendered) {
+        ESP_LOGI(TAG,
+                 "LCD : %u trames rendues pour %u affichées en %u s",
+                 (unsigned)(rendered - s_last_rendered),
+                 (unsigned)(vsyncs - s_last_vsync),
+                 (unsigned)LCD_PACING_REPORT_S);
+    }
+    s_last_rendered = rendered;
+    s_last_vsync = vsyncs;
+}
+
+#if LCD_FB_COUNT == 2
+// Temps cumulé passé à attendre la synchro verticale (tâche LVGL seule)
+static int64_t s_present_wait_us;
+
+// Présente un framebuffer du panneau (sans copie) à la prochaine synchro
+// verticale et attend qu'elle ait eu lieu, pour que LVGL ne redessine pas le
+// tampon encore affiché. Une synchro manquée laisse la bascule au hasard du
+// balayage, une bascule refusée laisse à l'écran l'ancienne trame : les deux
+// comptent comme déchirure.
+static void present_at_vsync(const void *fb)
+{
+    const int64_t t0 = esp_timer_get_time();
+    esp_err_t err = esp_lcd_panel_draw_bitmap(s_panel_handle, 0, 0, BOARD_LCD_H_RES, BOARD_LCD_V_RES, fb);
+    if (err != ESP_OK) {
+        s_tear_count++;
+        ESP_LOGE(TAG, "Panel frame buffer switch failed: %s", esp_err_to_name(err));
+        return;
+    }
+    // Seule une synchro comptée après la bascule la valide : un don resté
+    // d'une trame précédente ne fait que relancer l'attente
+    const uint32_t armed = s_vsync_count;
+    const TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(VSYNC_TIMEOUT_MS);
+    while (s_vsync_count == armed) {
+        const TickType_t left = deadline - xTaskGetTickCount();
+        if ((int32_t)left <= 0 || xSemaphoreTake(s_vsync_sem, left) != pdTRUE) {
+            s_tear_count++;
+            break;
+        }
+    }
+    s_present_wait_us += esp_timer_get_time() - t0;
+}
+#endif
+
+#if CONFIG_TERRARIUM_LVGL_RENDER_DIRECT
+static void lvgl_flush_area(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    // LVGL dessine dans un framebuffer du panneau : rien à copier, la trame est
+    // présentée au dernier fragment. Les zones modifiées sont recopiées dans
+    // l'autre tampon par LVGL lui-même (synchronisation du mode direct double tampon).
+    if (lv_display_flush_is_last(disp)) {
+        present_at_vsync(px_map);
+        s_rendered_count++;
+    }
+    lv_display_flush_ready(disp);
+}
+#else
+#if LCD_ASYNC_FLUSH
+static void copy_job_finish(copy_job_t *job, BaseType_t *woken)
+{
+#if LCD_BOUNCE_ENABLED
+    // L'interruption de rebond lit le framebuffer à travers le cache : invalider
+    // les lignes écrites par la DMA. Lignes entières, donc alignées, et jamais
+    // sales puisque le CPU n'écrit pas les framebuffers dans ce mode.
+    if (job->dst_lines_bytes > 0) {
+        esp_cache_msync(job->dst_lines, job->dst_lines_bytes, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+    }
+#endif
+#if !LCD_TEAR_FREE_PARTIAL
+    // Trame complète dans l'image balayée à la fin de ce transfert : une synchro
+    // passée depuis son premier fragment a montré une trame à moitié copiée.
+    // Lu avant flush_ready, LVGL n'ouvre pas la trame suivante d'ici là.
+    if (job->done == COPY_DONE_FRAME_READY && s_vsync_count != s_frame_vsync) {
+        s_tear_count++;
+    }
+#endif
+    if (job->done == COPY_DONE_FLUSH_READY || job->done == COPY_DONE_FRAME_READY) {
+        lv_display_flush_ready(s_display);
+    } else if (job->done == COPY_DONE_NOTIFY) {
+        xSemaphoreGiveFromISR(s_copy_done_sem, woken);
+    }
+}
+
+static bool copy_done_cb(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args);
+
+// Alimente la GDMA avec les lignes de la zone en tête de file, appelé sous
+// s_copy_lock depuis le flush (file vide) ou l'interruption de fin de transfert
+static void copy_pump_locked(BaseType_t *woken)
+{
+    while (s_copy_count > 0) {
+        copy_job_t *job = &s_copy_jobs[s_copy_head];
+        while (job->submitted < job->rows && job->submitted - job->completed < ASYNC_COPY_BACKLOG) {
+            const uint32_t row = job->submitted;
+            esp_err_t err = esp_async_memcpy(s_copy_dma,
+                                             job->dst + (size_t)row * job->dst_stride,
+                                             (void *)(job->src + (size_t)row * job->src_stride),
+                                             job->row_bytes,
+                                             copy_done_cb,
+                                             NULL);
+            if (err != ESP_OK) {
+                // Lignes restantes abandonnées : la zone reste fausse jusqu'à son prochain rendu
+                s_copy_errors++;
+                job->rows = row;
+                break;
+            }
+            job->submitted++;
+        }
+        if (job->completed < job->rows) {
+            return;
+        }
+        copy_job_finish(job, woken);
+        s_copy_head = (s_copy_head + 1) % ASYNC_COPY_QUEUE_LEN;
+        s_copy_count--;
+    }
+}
+
+static bool copy_done_cb(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args)
+{
+    (void)mcp;
+    (void)event;
+    (void)cb_args;
+    BaseType_t woken = pdFALSE;
+    portENTER_CRITICAL_ISR(&s_copy_lock);
+    s_copy_jobs[s_copy_head].completed++;
+    copy_pump_locked(&woken);
+    portEXIT_CRITICAL_ISR(&s_copy_lock);
+    return woken == pdTRUE;
+}
+
+static bool in_framebuffer(const uint8_t *p)
+{
+    for (size_t i = 0; i < LCD_FB_COUNT; ++i) {
+        if (p >= s_fbs[i] && p < s_fbs[i] + LCD_FB_STRIDE * BOARD_LCD_V_RES) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void copy_enqueue(const copy_job_t *job)
+{
+    for (;;) {
+        portENTER_CRITICAL(&s_copy_lock);
+        if (s_copy_count < ASYNC_COPY_QUEUE_LEN) {
+            break;
+        }
+        portEXIT_CRITICAL(&s_copy_lock);
+        vTaskDelay(1);
+    }
+    s_copy_jobs[(s_copy_head + s_copy_count) % ASYNC_COPY_QUEUE_LEN] = *job;
+    s_copy_count++;
+    if (s_copy_count == 1) {
+        // File vide jusque-là : aucune interruption en attente pour la relancer
+        copy_pump_locked(NULL);
+    }
+    portEXIT_CRITICAL(&s_copy_lock);
+}
+
+// Mise en file d'une copie de zone vers un framebuffer ; retourne aussitôt,
+// LVGL rend la tranche suivante pendant le transfert
+static void fb_copy(uint8_t *dst_fb, const uint8_t *src, size_t src_stride, const lv_area_t *a, copy_done_t done)
+{
+    const size_t row_bytes = (size_t)lv_area_get_width(a) * LCD_BYTES_PER_PX;
+    const uint32_t rows = (uint32_t)lv_area_get_height(a);
+    if (!in_framebuffer(src)) {
+        // Tampon de rendu écrit par le CPU : vider ses lignes de cache avant la DMA
+        esp_cache_msync((void *)src,
+                        (size_t)(rows - 1) * src_stride + row_bytes,
+                        ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    }
+    copy_job_t job = {
+        .dst = dst_fb + (size_t)a->y1 * LCD_FB_STRIDE + (size_t)a->x1 * LCD_BYTES_PER_PX,
+        .src = src,
+        .dst_stride = LCD_FB_STRIDE,
+        .src_stride = src_stride,
+        .row_bytes = row_bytes,
+        .rows = rows,
+        .dst_lines = dst_fb + (size_t)a->y1 * LCD_FB_STRIDE,
+        .dst_lines_bytes = (size_t)rows * LCD_FB_STRIDE,
+        .done = done,
+    };
+    if (row_bytes == LCD_FB_STRIDE && src_stride == LCD_FB_STRIDE) {
+        job.row_bytes = row_bytes * rows;
+        job.dst_stride = job.row_bytes;
+        job.src_stride = job.row_bytes;
+        job.rows = 1;
+    }
+    copy_enqueue(&job);
+}
+
+// Attend la fin de toutes les copies en file (trame prête à présenter)
+static void fb_copy_wait(void)
+{
+    // Marqueur sans ligne : terminé dès que les copies qui le précèdent le sont
+    const copy_job_t marker = {.done = COPY_DONE_NOTIFY};
+    xSemaphoreTake(s_copy_done_sem, 0);
+    copy_enqueue(&marker);
+    if (xSemaphoreTake(s_copy_done_sem, pdMS_TO_TICKS(VSYNC_TIMEOUT_MS)) != pdTRUE) {
+        s_copy_errors++;
+    }
+}
+
+// LVGL n'invalide que des zones alignées sur 32 pixels : chaque ligne de zone
+// commence et finit sur une frontière de 64 octets, côté rendu comme côté écran
+static void round_area_cb(lv_event_t *e)
+{
+    lv_area_t *area = lv_event_get_param(e);
+    area->x1 &= ~(int32_t)(ASYNC_COPY_ALIGN_PX - 1);
+    area->x2 |= (int32_t)(ASYNC_COPY_ALIGN_PX - 1);
+}
+#elif LCD_TEAR_FREE_PARTIAL
+static void fb_copy(uint8_t *dst_fb, const uint8_t *src, size_t src_stride, const lv_area_t *a, copy_done_t done)
+{
+    const size_t row_bytes = (size_t)lv_area_get_width(a) * LCD_BYTES_PER_PX;
+    uint8_t *dst = dst_fb + (size_t)a->y1 * LCD_FB_STRIDE + (size_t)a->x1 * LCD_BYTES_PER_PX;
+    for (int32_t y = a->y1; y <= a->y2; ++y) {
+        memcpy(dst, src, row_bytes);
+        dst += LCD_FB_STRIDE;
+        src += src_stride;
+    }
+#if !LCD_BOUNCE_ENABLED
+    // Sans tampons de rebond, la DMA LCD lit la PSRAM : écrire le cache des lignes touchées
+    esp_cache_msync(dst_fb + (size_t)a->y1 * LCD_FB_STRIDE,
+                    (size_t)lv_area_get_height(a) * LCD_FB_STRIDE,
+                    ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+#endif
+    if (done == COPY_DONE_FLUSH_READY) {
+        lv_display_flush_ready(s_display);
+    }
+}
+
+static void fb_copy_wait(void)
+{
+}
+#endif
+
+#if LCD_TEAR_FREE_PARTIAL
+static void lvgl_flush_area(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    // Chaque zone va dans le framebuffer caché ; la trame complète est présentée
+    // d'un bloc à la synchro verticale, puis ses zones sont reportées dans
+    // l'autre framebuffer, qui devient le tampon caché de la trame suivante.
+    const size_t stride = (size_t)lv_area_get_width(area) * LCD_BYTES_PER_PX;
+    if (s_frame_area_count < TEAR_FREE_MAX_AREAS) {
+        s_frame_areas[s_frame_area_count] = *area;
+    }
+    s_frame_area_count++;
+
+    if (!lv_display_flush_is_last(disp)) {
+        fb_copy(s_fbs[s_back_fb], px_map, stride, area, COPY_DONE_FLUSH_READY);
+        return;
+    }
+
+    fb_copy(s_fbs[s_back_fb], px_map, stride, area, COPY_DONE_NONE);
+    fb_copy_wait();
+    present_at_vsync(s_fbs[s_back_fb]);
+    s_rendered_count++;
+    const uint8_t *front = s_fbs[s_back_fb];
+    s_back_fb ^= 1;
+    // Report vers le nouveau tampon caché : en file derrière, avant toute zone de la trame suivante
+    if (s_frame_area_count > TEAR_FREE_MAX_AREAS) {
+        const lv_area_t full = {0, 0, BOARD_LCD_H_RES - 1, BOARD_LCD_V_RES - 1};
+        fb_copy(s_fbs[s_back_fb], front, LCD_FB_STRIDE, &full, COPY_DONE_NONE);
+    } else {
+        for (uint32_t i = 0; i < s_frame_area_count; ++i) {
+            const lv_area_t *a = &s_frame_areas[i];
+            const uint8_t *src = front + (size_t)a->y1 * LCD_FB_STRIDE + (size_t)a->x1 * LCD_BYTES_PER_PX;
+            fb_copy(s_fbs[s_back_fb], src, LCD_FB_STRIDE, a, COPY_DONE_NONE);
+        }
+    }
+    s_frame_area_count = 0;
+    lv_display_flush_ready(disp);
+}
+#else
+#if !LCD_ASYNC_FLUSH
 static bool rgb_panel_color_trans_cb(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *edata, void *user_data)
 {
     (void)panel;
@@ -140,25 +629,111 @@ static bool rgb_panel_color_trans_cb(esp_lcd_panel_handle_t panel, const esp_lcd
     }
     return false;
 }
+#endif
 
-static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+static void lvgl_flush_area(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
 {
-    const int32_t x1 = area->x1;
-    const int32_t y1 = area->y1;
-    const int32_t x2 = area->x2;
-    const int32_t y2 = area->y2;
-
-    esp_err_t err = esp_lcd_panel_draw_bitmap(s_panel_handle, x1, y1, x2 + 1, y2 + 1, px_map);
+    if (!s_frame_open) {
+        s_frame_vsync = s_vsync_count;
+        s_frame_open = true;
+    }
+    const bool last = lv_display_flush_is_last(disp);
+#if LCD_ASYNC_FLUSH
+    // Déchirure contrôlée par copy_job_finish() à la fin du dernier transfert
+    fb_copy(s_fbs[0],
+            px_map,
+            (size_t)lv_area_get_width(area) * LCD_BYTES_PER_PX,
+            area,
+            last ? COPY_DONE_FRAME_READY : COPY_DONE_FLUSH_READY);
+#else
+    esp_err_t err = esp_lcd_panel_draw_bitmap(s_panel_handle, area->x1, area->y1, area->x2 + 1, area->y2 + 1, px_map);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Panel draw bitmap failed: %s", esp_err_to_name(err));
         lv_display_flush_ready(disp);
     }
+#endif
+    // Copie directe dans l'image balayée : si une synchro est passée entre le
+    // premier et le dernier fragment, l'écran a montré une trame à moitié copiée
+    if (last) {
+        s_frame_open = false;
+        s_rendered_count++;
+#if !LCD_ASYNC_FLUSH
+        if (s_vsync_count != s_frame_vsync) {
+            s_tear_count++;
+        }
+#endif
+    }
 }
+#endif
+#endif
+
+#if CONFIG_TERRARIUM_ENABLE_LV_PERF
+// Mesures de la trame en cours pour la surimpression de performance
+static int64_t s_perf_frame_start_us;
+static int64_t s_perf_flush_us;
+static int64_t s_perf_wait_start_us;
 
-static void lvgl_tick_cb(void *arg)
+static int64_t present_wait_total_us(void)
 {
-    (void)arg;
-    lv_tick_inc(5);
+#if LCD_FB_COUNT == 2
+    return s_present_wait_us;
+#else
+    return 0;
+#endif
+}
+#endif
+
+static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+#if CONFIG_TERRARIUM_ENABLE_LV_PERF
+    const int64_t t0 = esp_timer_get_time();
+    lvgl_flush_area(disp, area, px_map);
+    s_perf_flush_us += esp_timer_get_time() - t0;
+#else
+    lvgl_flush_area(disp, area, px_map);
+#endif
+}
+
+#if CONFIG_TERRARIUM_ENABLE_LV_PERF
+// Découpe chaque trame en rendu, flush et attente de synchro. L'attente de
+// synchro a lieu dans le flush du dernier fragment : elle est retirée du flush.
+// En copie GDMA, l'attente de la fin des copies par LVGL compte comme rendu.
+static void perf_render_event_cb(lv_event_t *e)
+{
+    const int64_t now = esp_timer_get_time();
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        s_perf_frame_start_us = now;
+        s_perf_flush_us = 0;
+        s_perf_wait_start_us = present_wait_total_us();
+        return;
+    }
+    const int64_t total = now - s_perf_frame_start_us;
+    const int64_t wait = present_wait_total_us() - s_perf_wait_start_us;
+    const int64_t render = total - s_perf_flush_us;
+    const int64_t flush = s_perf_flush_us - wait;
+    const perf_frame_t frame = {
+        .render_us = render > 0 ? (uint32_t)render : 0,
+        .flush_us = flush > 0 ? (uint32_t)flush : 0,
+        .vsync_wait_us = (uint32_t)wait,
+    };
+    perf_hud_frame(&frame);
+}
+#endif
+
+// Après le banc de rendu et l'auto-réglage, pour ne mesurer que l'usage réel
+static void init_perf_hud(void)
+{
+#if CONFIG_TERRARIUM_ENABLE_LV_PERF
+    perf_hud_init();
+    lv_display_add_event_cb(s_display, perf_render_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(s_display, perf_render_event_cb, LV_EVENT_RENDER_READY, NULL);
+    ESP_LOGI(TAG, "Performance overlay enabled");
+#endif
+}
+
+static uint32_t lvgl_tick_get_cb(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
 }
 
 static void configure_task_wdt(void)
@@ -178,7 +753,6 @@ static void configure_task_wdt(void)
 
 static void lvgl_touch_read_cb(lv_indev_t *indev_drv, lv_indev_data_t *data)
 {
-    (void)indev_drv;
     uint16_t x = 0;
     uint16_t y = 0;
     bool pressed = false;
@@ -193,6 +767,23 @@ static void lvgl_touch_read_cb(lv_indev_t *indev_drv, lv_indev_data_t *data)
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
     }
+    // Doigt levé et plus de défilement inertiel : plus rien à lire jusqu'à la
+    // prochaine interruption, qui relance la lecture depuis la tâche LVGL
+    if (s_touch_irq_seen && data->state == LV_INDEV_STATE_RELEASED && lv_indev_get_scroll_obj(indev_drv) == NULL) {
+        lv_timer_pause(lv_indev_get_read_timer(indev_drv));
+    }
+}
+
+static void IRAM_ATTR touch_irq_cb(void *arg)
+{
+    (void)arg;
+    s_touch_irq_seen = true;
+    TaskHandle_t task = s_lvgl_task_handle;
+    if (task) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
 }
 
 static void lvgl_task(void *arg)
@@ -206,11 +797,22 @@ static void lvgl_task(void *arg)
         ESP_LOGW(TAG, "Failed to register LVGL task to WDT: %s", esp_err_to_name(wdt_err));
     }
     while (true) {
-        lv_timer_handler();
+        // Dort exactement jusqu'au prochain minuteur LVGL (arrondi au tick
+        // supérieur), ou jusqu'à une notification de l'interruption tactile
+        uint32_t wait_ms = lv_timer_handler();
         if (s_lvgl_task_wdt_registered) {
             esp_task_wdt_reset();
         }
-        vTaskDelay(pdMS_TO_TICKS(10));
+        if (wait_ms > LVGL_IDLE_WAIT_MS) {
+            wait_ms = LVGL_IDLE_WAIT_MS;
+        }
+        const TickType_t ticks = (wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+        if (ulTaskNotifyTake(pdTRUE, ticks) > 0 && s_touch_indev) {
+            // Lecture immédiate : le rapport du GT911 est prêt
+            lv_timer_t *read_timer = lv_indev_get_read_timer(s_touch_indev);
+            lv_timer_resume(read_timer);
+            lv_timer_ready(read_timer);
+        }
     }
 }
 
@@ -236,8 +838,42 @@ static void enable_backlight(void)
     }
 }
 
+typedef struct {
+    const esp_lcd_rgb_panel_config_t *config;
+    TaskHandle_t caller;
+    esp_err_t err;
+} panel_create_args_t;
+
+static void panel_create_task(void *arg)
+{
+    panel_create_args_t *args = (panel_create_args_t *)arg;
+    args->err = esp_lcd_new_rgb_panel(args->config, &s_panel_handle);
+    xTaskNotifyGive(args->caller);
+    vTaskDelete(NULL);
+}
+
+// L'interruption LCD (synchro verticale, recharge des tampons de rebond) est
+// installée sur le cœur qui crée le panneau : création déléguée à une tâche épinglée
+static esp_err_t new_rgb_panel_on_core(const esp_lcd_rgb_panel_config_t *config, BaseType_t core)
+{
+    panel_create_args_t args = {
+        .config = config,
+        .caller = xTaskGetCurrentTaskHandle(),
+        .err = ESP_FAIL,
+    };
+    if (xTaskCreatePinnedToCore(panel_create_task, "lcd_init", 4096, &args, uxTaskPriorityGet(NULL), NULL, core) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return args.err;
+}
+
 static esp_err_t init_display(void)
 {
+    s_vsync_sem = xSemaphoreCreateBinary();
+    if (!s_vsync_sem) {
+        return ESP_ERR_NO_MEM;
+    }
     board_ch422g_enable();
     init_backlight();
 
@@ -286,18 +922,41 @@ static esp_err_t init_display(void)
     panel_config.timings.flags.de_idle_high = false;
     bool has_psram = query_psram_once();
     panel_config.flags.fb_in_psram = has_psram;
+    // Deux framebuffers : l'un est affiché pendant que l'autre est rempli
+    panel_config.num_fbs = LCD_FB_COUNT;
+#if LCD_BOUNCE_ENABLED
+    // Tampons de rebond alloués par le pilote en SRAM interne compatible DMA
+    panel_config.bounce_buffer_size_px = BOARD_LCD_H_RES * CONFIG_TERRARIUM_LCD_BOUNCE_LINES;
+#endif
 
     if (!has_psram) {
         ESP_LOGE(TAG, "PSRAM non initialisée : impossible d'allouer le framebuffer %ux%u RGB16", BOARD_LCD_H_RES, BOARD_LCD_V_RES);
         return ESP_ERR_NO_MEM;
     }
 
-    ESP_LOGI(TAG, "Initialising RGB panel with framebuffer in PSRAM (%ux%u RGB16)", BOARD_LCD_H_RES, BOARD_LCD_V_RES);
+    ESP_LOGI(TAG,
+             "Initialising RGB panel with %u framebuffer(s) in PSRAM (%ux%u RGB16)",
+             (unsigned)LCD_FB_COUNT,
+             BOARD_LCD_H_RES,
+             BOARD_LCD_V_RES);
 
-    esp_err_t err = esp_lcd_new_rgb_panel(&panel_config, &s_panel_handle);
+    esp_err_t err = new_rgb_panel_on_core(&panel_config, CONFIG_TERRARIUM_LCD_ISR_CORE);
     if (err != ESP_OK) {
         return err;
     }
+#if LCD_BOUNCE_ENABLED
+    ESP_LOGI(TAG,
+             "Bounce buffers: 2 x %u lines in internal DMA RAM, refilled on core %d",
+             (unsigned)CONFIG_TERRARIUM_LCD_BOUNCE_LINES,
+             CONFIG_TERRARIUM_LCD_ISR_CORE);
+#endif
+    const esp_timer_create_args_t report_args = {
+        .callback = &lcd_stats_report_cb,
+        .name = "lcd_stats",
+    };
+    if (esp_timer_create(&report_args, &s_lcd_stats_timer) == ESP_OK) {
+        esp_timer_start_periodic(s_lcd_stats_timer, 1000 * 1000);
+    }
     err = esp_lcd_panel_reset(s_panel_handle);
     if (err != ESP_OK) {
         return err;
@@ -316,6 +975,11 @@ static esp_err_t init_display(void)
 
 static void deinit_display(void)
 {
+    if (s_lcd_stats_timer) {
+        esp_timer_stop(s_lcd_stats_timer);
+        esp_timer_delete(s_lcd_stats_timer);
+        s_lcd_stats_timer = NULL;
+    }
     if (s_panel_handle) {
         esp_lcd_panel_disp_on_off(s_panel_handle, false);
         esp_lcd_panel_del(s_panel_handle);
@@ -326,80 +990,365 @@ static void deinit_display(void)
     }
 }
 
-static esp_err_t init_lvgl(void)
+#if CONFIG_TERRARIUM_LVGL_RENDER_DIRECT
+static esp_err_t init_lvgl_buffers(void)
 {
-    lv_init();
-
-    size_t buffer_pixels = (BOARD_LCD_H_RES * BOARD_LCD_V_RES) / 10;
-    size_t buffer_bytes = buffer_pixels * sizeof(lv_color_t);
+    void *fb0 = NULL;
+    void *fb1 = NULL;
+    esp_err_t err = esp_lcd_rgb_panel_get_frame_buffer(s_panel_handle, 2, &fb0, &fb1);
+    if (err != ESP_OK) {
+        return err;
+    }
+    const size_t fb_bytes = (size_t)BOARD_LCD_H_RES * BOARD_LCD_V_RES * lv_color_format_get_size(LV_COLOR_FORMAT_RGB565);
+    ESP_LOGI(TAG, "LVGL direct mode: rendering into the two panel framebuffers (%zu bytes each)", fb_bytes);
 
-    uint32_t preferred_caps = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
-    uint32_t fallback_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    s_display = lv_display_create(BOARD_LCD_H_RES, BOARD_LCD_V_RES);
+    lv_display_set_color_format(s_display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_flush_cb(s_display, lvgl_flush_cb);
+    lv_display_set_buffers(s_display, fb0, fb1, fb_bytes, LV_DISPLAY_RENDER_MODE_DIRECT);
+    return ESP_OK;
+}
+#else
+static void *alloc_draw_buffer(size_t bytes, uint32_t caps)
+{
+#if LCD_ASYNC_FLUSH
+    // Source de la GDMA : début aligné sur une ligne de cache ; la PSRAM est
+    // accessible à la GDMA de l'ESP32-S3, la SRAM interne doit être marquée DMA
+    if (caps & MALLOC_CAP_INTERNAL) {
+        caps |= MALLOC_CAP_DMA;
+    }
+    return heap_caps_aligned_alloc(ASYNC_COPY_ALIGN_BYTES, bytes, caps);
+#else
+    return heap_caps_malloc(bytes, caps);
+#endif
+}
 
-    lv_color_t *buf1 = NULL;
-    lv_color_t *buf2 = NULL;
-    bool buffers_in_psram = false;
+static size_t draw_buf_bytes(uint16_t lines)
+{
+    return (size_t)lines * BOARD_LCD_H_RES * LCD_BYTES_PER_PX;
+}
 
-    if (query_psram_once()) {
-        buf1 = heap_caps_malloc(buffer_bytes, preferred_caps);
-        buf2 = heap_caps_malloc(buffer_bytes, preferred_caps);
-        if (!buf1 || !buf2) {
-            ESP_LOGW(TAG, "Insufficient PSRAM, falling back to internal SRAM buffers");
-            if (buf1) {
-                heap_caps_free(buf1);
-                buf1 = NULL;
-            }
-            if (buf2) {
-                heap_caps_free(buf2);
-                buf2 = NULL;
-            }
-        } else {
-            buffers_in_psram = true;
-        }
+static bool alloc_draw_buffers(lvgl_buffers_t *b)
+{
+    const uint32_t caps = b->in_psram ? (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    b->buf1 = alloc_draw_buffer(draw_buf_bytes(b->lines), caps);
+    b->buf2 = alloc_draw_buffer(draw_buf_bytes(b->lines), caps);
+    if (!b->buf1 || !b->buf2) {
+        heap_caps_free(b->buf1);
+        heap_caps_free(b->buf2);
+        b->buf1 = NULL;
+        b->buf2 = NULL;
+        return false;
     }
+    return true;
+}
 
-    if (!buf1) {
-        buf1 = heap_caps_malloc(buffer_bytes, fallback_caps);
+#if CONFIG_TERRARIUM_LVGL_DRAW_BUF_AUTOTUNE
+// Empreinte des options qui changent le coût d'une trame : un réglage mesuré
+// sous une autre configuration est ignoré et refait
+static uint32_t draw_tuning_config_key(void)
+{
+    const uint32_t fields[] = {
+        BOARD_LCD_H_RES,
+        BOARD_LCD_V_RES,
+        LV_DRAW_SW_DRAW_UNIT_CNT,
+        CONFIG_TERRARIUM_LCD_BOUNCE_LINES,
+        LCD_TEAR_FREE_PARTIAL,
+        LCD_ASYNC_FLUSH,
+        CONFIG_TERRARIUM_LVGL_DRAW_BUF_SRAM_BUDGET_KB,
+        CONFIG_TERRARIUM_LVGL_DRAW_BUF_PSRAM_BUDGET_KB,
+    };
+    uint32_t h = 2166136261u;  // FNV-1a
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i) {
+        h = (h ^ fields[i]) * 16777619u;
     }
-    if (!buf2) {
-        buf2 = heap_caps_malloc(buffer_bytes, fallback_caps);
+    return h;
+}
+#endif
+
+static esp_err_t init_lvgl_buffers(void)
+{
+#if LCD_FB_COPY
+    esp_err_t err = esp_lcd_rgb_panel_get_frame_buffer(s_panel_handle, LCD_FB_COUNT, (void **)&s_fbs[0], (void **)&s_fbs[1]);
+    if (err != ESP_OK) {
+        return err;
     }
-    if (!buf1 || !buf2) {
-        heap_caps_free(buf1);
-        heap_caps_free(buf2);
+#endif
+#if LCD_TEAR_FREE_PARTIAL
+    ESP_LOGI(TAG, "Tear-free partial mode: areas copied to the hidden framebuffer, swapped at vsync");
+#endif
+#if LCD_ASYNC_FLUSH
+    s_copy_done_sem = xSemaphoreCreateBinary();
+    if (!s_copy_done_sem) {
         return ESP_ERR_NO_MEM;
     }
+    async_memcpy_config_t copy_config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    copy_config.backlog = ASYNC_COPY_BACKLOG;
+    copy_config.dma_burst_size = ASYNC_COPY_ALIGN_BYTES;
+    err = esp_async_memcpy_install(&copy_config, &s_copy_dma);
+    if (err != ESP_OK) {
+        return err;
+    }
+    ESP_LOGI(TAG, "Async flush: areas copied by GDMA, aligned to %d px", ASYNC_COPY_ALIGN_PX);
+#endif
+    lvgl_buffers_t setup = {
+        .lines = DRAW_BUF_DEFAULT_LINES,
+        .in_psram = query_psram_once(),
+    };
+#if CONFIG_TERRARIUM_LVGL_DRAW_BUF_AUTOTUNE
+    storage_draw_tuning_t tuning;
+    if (storage_load_draw_tuning(&tuning) == ESP_OK && tuning.config_key == draw_tuning_config_key()) {
+        setup.lines = tuning.lines;
+        setup.in_psram = tuning.in_psram != 0;
+        s_draw_buf_tuned = true;
+    }
+#endif
+    if (!alloc_draw_buffers(&setup)) {
+        // Réglage enregistré devenu trop gros, ou PSRAM pleine : dimension par
+        // défaut, en PSRAM si possible puis en SRAM interne
+        ESP_LOGW(TAG, "Draw buffers of %u lines in %s unavailable, falling back to defaults",
+                 (unsigned)setup.lines, setup.in_psram ? "PSRAM" : "internal SRAM");
+        setup.lines = DRAW_BUF_DEFAULT_LINES;
+        setup.in_psram = query_psram_once();
+        if (!alloc_draw_buffers(&setup)) {
+            setup.in_psram = false;
+            if (!alloc_draw_buffers(&setup)) {
+                return ESP_ERR_NO_MEM;
+            }
+        }
+    }
 
-    ESP_LOGI(TAG, "LVGL draw buffers: %zu bytes each allocated in %s", buffer_bytes, buffers_in_psram ? "PSRAM" : "internal SRAM");
+    ESP_LOGI(TAG,
+             "LVGL draw buffers: %u lines (%zu bytes) each allocated in %s%s",
+             (unsigned)setup.lines,
+             draw_buf_bytes(setup.lines),
+             setup.in_psram ? "PSRAM" : "internal SRAM",
+             s_draw_buf_tuned ? " (auto-tuned)" : "");
 
     s_display = lv_display_create(BOARD_LCD_H_RES, BOARD_LCD_V_RES);
     lv_display_set_color_format(s_display, LV_COLOR_FORMAT_RGB565);
     lv_display_set_flush_cb(s_display, lvgl_flush_cb);
-    lv_display_set_buffers(s_display, buf1, buf2, buffer_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
-    s_lvgl_buffers.buf1 = buf1;
-    s_lvgl_buffers.buf2 = buf2;
+    lv_display_set_buffers(s_display, setup.buf1, setup.buf2, draw_buf_bytes(setup.lines), LV_DISPLAY_RENDER_MODE_PARTIAL);
+#if LCD_ASYNC_FLUSH
+    lv_display_add_event_cb(s_display, round_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+#endif
+    s_lvgl_buffers = setup;
+    return ESP_OK;
+}
 
-    const esp_lcd_rgb_panel_event_callbacks_t callbacks = {
-        .on_color_trans_done = rgb_panel_color_trans_cb,
+#if CONFIG_TERRARIUM_LVGL_DRAW_BUF_AUTOTUNE
+// Fond en dégradé, cartes arrondies semi-transparentes et texte : les
+// opérations dominantes des onglets (remplissages, mélanges, glyphes)
+static lv_obj_t *build_tuning_scene(void)
+{
+    lv_obj_t *scene = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(scene, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_radius(scene, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(scene, 0, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(scene, lv_color_hex(0x0B1220), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_color(scene, lv_color_hex(0x1E3A5F), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_dir(scene, LV_GRAD_DIR_VER, LV_PART_MAIN);
+    lv_obj_remove_flag(scene, LV_OBJ_FLAG_SCROLLABLE);
+    for (int i = 0; i < 12; ++i) {
+        lv_obj_t *card = lv_obj_create(scene);
+        lv_obj_set_size(card, 300, 120);
+        lv_obj_set_pos(card, 10 + (i % 3) * 330, 10 + (i / 3) * 140);
+        lv_obj_set_style_radius(card, 12, LV_PART_MAIN);
+        lv_obj_set_style_bg_color(card, lv_color_hex(0x22D3EE), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(card, LV_OPA_40, LV_PART_MAIN);
+        lv_obj_t *label = lv_label_create(card);
+        lv_label_set_text(label, "Puissance 45 W - Flux 3200 lm\nUVI 2,4 à 30 cm\nSubstrat 42 L - Brume 6 cycles/jour");
+        lv_obj_set_style_text_color(label, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
+    }
+    return scene;
+}
+
+static float bench_draw_buffers(lv_obj_t *scene)
+{
+    lv_refr_now(s_display);
+#if LCD_FB_COUNT == 2
+    const int64_t wait0 = s_present_wait_us;
+#endif
+    const int64_t t0 = esp_timer_get_time();
+    for (uint32_t i = 0; i < DRAW_BUF_TUNE_FRAMES; ++i) {
+        lv_obj_invalidate(scene);
+        lv_refr_now(s_display);
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+#if LCD_FB_COUNT == 2
+    // L'attente de synchro verticale masquerait les écarts entre configurations
+    dt -= s_present_wait_us - wait0;
+#endif
+#if LCD_ASYNC_FLUSH
+    // Les tampons vont être libérés : plus aucune copie DMA ne doit les lire
+    fb_copy_wait();
+#endif
+    return (float)dt / 1000.0f / DRAW_BUF_TUNE_FRAMES;
+}
+
+// Mesure chaque dimension et placement admis par les budgets mémoire sur une
+// scène synthétique, garde le plus rapide et l'enregistre en NVS. À temps
+// quasi égal (3 %), la configuration la moins gourmande en SRAM puis en mémoire
+// totale l'emporte.
+static void tune_draw_buffers(void)
+{
+    static const lvgl_buffers_t k_candidates[] = {
+        {.lines = 10, .in_psram = false},
+        {.lines = 20, .in_psram = false},
+        {.lines = 40, .in_psram = false},
+        {.lines = 30, .in_psram = true},
+        {.lines = 60, .in_psram = true},
+        {.lines = 120, .in_psram = true},
     };
-    esp_err_t err = esp_lcd_rgb_panel_register_event_callbacks(s_panel_handle, &callbacks, s_display);
-    if (err != ESP_OK) {
-        return err;
+    const size_t sram_budget = (size_t)CONFIG_TERRARIUM_LVGL_DRAW_BUF_SRAM_BUDGET_KB * 1024u;
+    const size_t psram_budget = (size_t)CONFIG_TERRARIUM_LVGL_DRAW_BUF_PSRAM_BUDGET_KB * 1024u;
+    const lvgl_buffers_t initial = s_lvgl_buffers;
+    lv_obj_t *scene = build_tuning_scene();
+
+    lvgl_buffers_t best = initial;
+    float best_ms = bench_draw_buffers(scene);
+    unsigned tried = 1;
+    ESP_LOGI(TAG, "Draw buffer tuning: %u lines in %s: %.1f ms/frame",
+             (unsigned)initial.lines, initial.in_psram ? "PSRAM" : "SRAM", best_ms);
+
+    for (size_t i = 0; i < sizeof(k_candidates) / sizeof(k_candidates[0]); ++i) {
+        lvgl_buffers_t c = k_candidates[i];
+        const size_t pair_bytes = 2 * draw_buf_bytes(c.lines);
+        if ((c.lines == initial.lines && c.in_psram == initial.in_psram) ||
+            (c.in_psram && (!query_psram_once() || pair_bytes > psram_budget)) ||
+            (!c.in_psram && (pair_bytes > sram_budget ||
+                             heap_caps_get_free_size(MALLOC_CAP_INTERNAL) < pair_bytes + DRAW_BUF_SRAM_RESERVE))) {
+            continue;
+        }
+        if (!alloc_draw_buffers(&c)) {
+            continue;
+        }
+        lv_display_set_buffers(s_display, c.buf1, c.buf2, draw_buf_bytes(c.lines), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        const float ms = bench_draw_buffers(scene);
+        ++tried;
+        ESP_LOGI(TAG, "Draw buffer tuning: %u lines in %s: %.1f ms/frame",
+                 (unsigned)c.lines, c.in_psram ? "PSRAM" : "SRAM", ms);
+
+        const size_t best_sram = best.in_psram ? 0 : 2 * draw_buf_bytes(best.lines);
+        const size_t c_sram = c.in_psram ? 0 : pair_bytes;
+        const bool clearly_faster = ms < best_ms * 0.97f;
+        const bool as_fast = ms <= best_ms * 1.03f;
+        const bool leaner = c_sram < best_sram || (c_sram == best_sram && c.lines < best.lines);
+        lvgl_buffers_t loser = c;
+        if (clearly_faster || (as_fast && leaner)) {
+            loser = best;
+            best = c;
+            best_ms = ms < best_ms ? ms : best_ms;
+        }
+        // Le tampon gagnant reste en place, le perdant est rendu au tas
+        lv_display_set_buffers(s_display, best.buf1, best.buf2, draw_buf_bytes(best.lines), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        heap_caps_free(loser.buf1);
+        heap_caps_free(loser.buf2);
     }
 
-    esp_timer_create_args_t timer_args = {
-        .callback = &lvgl_tick_cb,
-        .name = "lvgl_tick",
+    lv_obj_delete(scene);
+    s_lvgl_buffers = best;
+    ESP_LOGI(TAG,
+             "Draw buffers tuned: %u lines (%zu bytes x 2) in %s, %.1f ms/frame, best of %u setups",
+             (unsigned)best.lines,
+             draw_buf_bytes(best.lines),
+             best.in_psram ? "PSRAM" : "internal SRAM",
+             best_ms,
+             tried);
+
+    const storage_draw_tuning_t tuning = {
+        .config_key = draw_tuning_config_key(),
+        .lines = best.lines,
+        .in_psram = best.in_psram ? 1 : 0,
     };
-    err = esp_timer_create(&timer_args, &s_lvgl_tick_timer);
+    esp_err_t err = storage_save_draw_tuning(&tuning);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Draw buffer tuning not saved: %s", esp_err_to_name(err));
+    }
+}
+#endif
+#endif
+
+// LVGL crée un fil par unité de rendu dans lv_init(), avec xTaskCreate() donc
+// sans affinité, et le noyau de l'IDF ne sait pas épingler une tâche après
+// coup. xTaskCreatePinnedToCore() est enveloppé à l'édition de liens
+// (main/CMakeLists.txt) : pendant lv_init(), les tâches sans affinité créées
+// par la tâche appelante sont épinglées à tour de rôle sur les cœurs 0 et 1.
+static TaskHandle_t s_draw_thread_creator;
+static BaseType_t s_draw_thread_next_core;
+
+BaseType_t __real_xTaskCreatePinnedToCore(TaskFunction_t task_fn,
+                                          const char *const name,
+                                          const configSTACK_DEPTH_TYPE stack_depth,
+                                          void *const arg,
+                                          UBaseType_t priority,
+                                          TaskHandle_t *const created_task,
+                                          const BaseType_t core_id);
+
+BaseType_t __wrap_xTaskCreatePinnedToCore(TaskFunction_t task_fn,
+                                          const char *const name,
+                                          const configSTACK_DEPTH_TYPE stack_depth,
+                                          void *const arg,
+                                          UBaseType_t priority,
+                                          TaskHandle_t *const created_task,
+                                          const BaseType_t core_id)
+{
+    BaseType_t core = core_id;
+    if (s_draw_thread_creator && core == tskNO_AFFINITY && xTaskGetCurrentTaskHandle() == s_draw_thread_creator) {
+        core = s_draw_thread_next_core;
+        s_draw_thread_next_core = (s_draw_thread_next_core + 1) % portNUM_PROCESSORS;
+        ESP_LOGI(TAG, "LVGL draw thread %s pinned to core %d", name, (int)core);
+    }
+    return __real_xTaskCreatePinnedToCore(task_fn, name, stack_depth, arg, priority, created_task, core);
+}
+
+static esp_err_t init_lvgl(void)
+{
+    s_draw_thread_next_core = 0;
+    s_draw_thread_creator = xTaskGetCurrentTaskHandle();
+    lv_init();
+    s_draw_thread_creator = NULL;
+    // Horloge lue à la demande plutôt qu'incrémentée par un minuteur périodique
+    lv_tick_set_cb(lvgl_tick_get_cb);
+
+    esp_err_t err = init_lvgl_buffers();
     if (err != ESP_OK) {
         return err;
     }
-    err = esp_timer_start_periodic(s_lvgl_tick_timer, 5000);
+
+    // Rafraîchissement et animations à la cadence de la dalle plutôt qu'à la
+    // période par défaut de LVGL : un pas d'animation par trame affichée
+    lv_timer_set_period(lv_display_get_refr_timer(s_display), LCD_FRAME_PERIOD_MS);
+    lv_timer_set_period(lv_anim_get_timer(), LCD_FRAME_PERIOD_MS);
+    ESP_LOGI(TAG,
+             "Panel refresh %u.%02u Hz (%u x %u clocks per frame), LVGL refresh period %u ms",
+             (unsigned)(BOARD_LCD_REFRESH_MILLIHZ / 1000u),
+             (unsigned)(BOARD_LCD_REFRESH_MILLIHZ % 1000u / 10u),
+             (unsigned)BOARD_LCD_H_TOTAL,
+             (unsigned)BOARD_LCD_V_TOTAL,
+             (unsigned)LCD_FRAME_PERIOD_MS);
+
+    const esp_lcd_rgb_panel_event_callbacks_t callbacks = {
+#if !CONFIG_TERRARIUM_LVGL_RENDER_DIRECT && !LCD_FB_COPY
+        .on_color_trans_done = rgb_panel_color_trans_cb,
+#endif
+        .on_vsync = rgb_panel_vsync_cb,
+#if LCD_BOUNCE_ENABLED
+        .on_bounce_frame_finish = rgb_panel_bounce_frame_cb,
+#endif
+    };
+    err = esp_lcd_rgb_panel_register_event_callbacks(s_panel_handle, &callbacks, s_display);
     if (err != ESP_OK) {
         return err;
     }
 
+#if CONFIG_TERRARIUM_LVGL_RENDER_PARTIAL && CONFIG_TERRARIUM_LVGL_DRAW_BUF_AUTOTUNE
+    // Premier démarrage (ou configuration changée) : flush opérationnel, mesurer
+    if (!s_draw_buf_tuned) {
+        tune_draw_buffers();
+    }
+#endif
+
     return ESP_OK;
 }
 
@@ -428,11 +1377,6 @@ static void deinit_lvgl(void)
     if (task) {
         vTaskDelete(task);
     }
-    if (s_lvgl_tick_timer) {
-        esp_timer_stop(s_lvgl_tick_timer);
-        esp_timer_delete(s_lvgl_tick_timer);
-        s_lvgl_tick_timer = NULL;
-    }
     if (s_touch_indev) {
         lv_indev_delete(s_touch_indev);
         s_touch_indev = NULL;
@@ -441,6 +1385,16 @@ static void deinit_lvgl(void)
         lv_display_delete(s_display);
         s_display = NULL;
     }
+#if LCD_ASYNC_FLUSH
+    if (s_copy_dma) {
+        esp_async_memcpy_uninstall(s_copy_dma);
+        s_copy_dma = NULL;
+    }
+    if (s_copy_done_sem) {
+        vSemaphoreDelete(s_copy_done_sem);
+        s_copy_done_sem = NULL;
+    }
+#endif
     if (s_lvgl_buffers.buf1) {
         heap_caps_free(s_lvgl_buffers.buf1);
         s_lvgl_buffers.buf1 = NULL;
@@ -487,11 +1441,17 @@ static esp_err_t init_touch(void)
     if (s_display) {
         lv_indev_set_display(s_touch_indev, s_display);
     }
+    err = gt911_enable_irq(&s_touch_handle, touch_irq_cb, NULL);
+    if (err != ESP_OK) {
+        // Sans INT, le minuteur de lecture LVGL reste en scrutation permanente
+        ESP_LOGW(TAG, "GT911 IRQ unavailable (%s), polling touch", esp_err_to_name(err));
+    }
     return ESP_OK;
 }
 
 static void deinit_touch(void)
 {
+    s_touch_irq_seen = false;
     if (s_touch_handle.initialized) {
         gt911_deinit(&s_touch_handle);
     }
@@ -501,14 +1461,78 @@ static void run_self_tests(void)
 {
     heating_pad_run_self_test();
     heating_cable_run_self_test();
+    floor_stack_run_self_test();
+    spectrum_run_self_test();
     lighting_run_self_test();
     substrate_run_self_test();
     misting_run_self_test();
+    mist_net_run_self_test();
+    calibration_run_self_test();
+    species_run_self_test();
+    airflow_run_self_test();
+}
+
+static void init_arena(void)
+{
+    const arena_config_t cfg = {
+        .internal_bytes = ARENA_INTERNAL_BYTES,
+        .psram_bytes = query_psram_once() ? ARENA_PSRAM_BYTES : 0,
+    };
+    if (!arena_init(&cfg)) {
+        ESP_LOGW(TAG, "Arène de calcul indisponible : simulations désactivées");
+    }
+}
+
+// Redessine l'écran entier quelques fois avant le lancement de la tâche LVGL :
+// temps de rendu + présentation par trame, à comparer entre modes de rendu
+static void bench_render_mode(void)
+{
+#if CONFIG_TERRARIUM_LVGL_RENDER_BENCH_FRAMES > 0
+    // Texte seul, résultats denses en texte, grille de remplissages et mélanges
+    static const uint32_t k_bench_tabs[] = {0, 3, 5};
+    const uint32_t frames = CONFIG_TERRARIUM_LVGL_RENDER_BENCH_FRAMES;
+#if CONFIG_TERRARIUM_LVGL_RENDER_DIRECT
+    const char *mode = "direct";
+#else
+    const char *mode = "partiel";
+#endif
+    // Noyaux de mélange seuls, sur 10 rangées de 1024 pixels
+    blend_run_bench(10);
+    for (size_t t = 0; t < sizeof(k_bench_tabs) / sizeof(k_bench_tabs[0]); ++t) {
+        ui_main_show_tab(k_bench_tabs[t]);
+        lv_refr_now(s_display);
+        const int64_t t0 = esp_timer_get_time();
+        for (uint32_t i = 0; i < frames; ++i) {
+            lv_obj_invalidate(lv_screen_active());
+            lv_refr_now(s_display);
+        }
+        const int64_t dt = esp_timer_get_time() - t0;
+        ESP_LOGI(TAG,
+                 "Banc de rendu (%s, %d unité(s)) %s : %.1f ms par trame plein écran sur %u trames",
+                 mode,
+                 LV_DRAW_SW_DRAW_UNIT_CNT,
+                 ui_main_tab_name(k_bench_tabs[t]),
+                 (double)dt / 1000.0 / frames,
+                 (unsigned)frames);
+    }
+    ui_main_show_tab(0);
+#endif
+}
+
+// Recale les modules sur les mesures terrain persistées avant le premier calcul
+static void load_calibration(void)
+{
+    static cal_store_t store;
+    if (storage_load_calibration(&store) == ESP_OK) {
+        ESP_LOGI(TAG, "Calibration terrain appliquée");
+    }
+    calibration_apply(&store.current);
 }
 
 void app_main(void)
 {
     ESP_ERROR_CHECK(storage_init());
+    load_calibration();
     esp_err_t err = init_display();
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Display init failed: %s", esp_err_to_name(err));
@@ -516,6 +1540,9 @@ void app_main(void)
         enter_safe_fault_state("initialisation de l'écran", err);
     }
 
+    // Avant le premier rendu : les mélanges vectoriels ne sont activés
+    // qu'après comparaison à la référence
+    blend_init();
     err = init_lvgl();
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "LVGL init failed: %s", esp_err_to_name(err));
@@ -525,7 +1552,17 @@ void app_main(void)
     }
 
     configure_task_wdt();
+    init_arena();
+    // Un ouvrier par cœur pour les calculs parallèles (sous la priorité LVGL)
+    if (!jobs_init(NULL)) {
+        ESP_LOGW(TAG, "Système de tâches indisponible : calculs sur un seul cœur");
+    }
+    // Tables de spectre remplies avant que la tâche LVGL et les auto-tests ne
+    // les partagent
+    spectrum_init();
     ui_main_init();
+    bench_render_mode();
+    init_perf_hud();
 
     err = init_touch();
     if (err != ESP_OK) {
@@ -541,5 +1578,6 @@ void app_main(void)
     }
 
     run_self_tests();
+    arena_log_stats();
 }
 
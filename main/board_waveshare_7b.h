@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 #include "driver/gpio.h"
 #include "esp_lcd_types.h"
 
@@ -54,6 +56,20 @@
 #define BOARD_LCD_TIMING_VBP               20
 #define BOARD_LCD_TIMING_VFP               12
 
+/*
+ * Cadence réelle de la dalle déduite des timings : chaque trame balaie
+ * (actif + blanking) pixels sur les deux axes. À 18 MHz : 1344 × 635 horloges,
+ * soit ≈ 21,09 Hz et 47,4 ms par trame. LVGL et les animations s'y calent.
+ */
+#define BOARD_LCD_H_TOTAL \
+    (BOARD_LCD_H_RES + BOARD_LCD_TIMING_HPW + BOARD_LCD_TIMING_HBP + BOARD_LCD_TIMING_HFP)
+#define BOARD_LCD_V_TOTAL \
+    (BOARD_LCD_V_RES + BOARD_LCD_TIMING_VPW + BOARD_LCD_TIMING_VBP + BOARD_LCD_TIMING_VFP)
+#define BOARD_LCD_REFRESH_MILLIHZ \
+    ((uint32_t)((uint64_t)BOARD_LCD_PIXEL_CLOCK_HZ * 1000u / ((uint64_t)BOARD_LCD_H_TOTAL * BOARD_LCD_V_TOTAL)))
+#define BOARD_LCD_FRAME_PERIOD_US \
+    ((uint32_t)(((uint64_t)BOARD_LCD_H_TOTAL * BOARD_LCD_V_TOTAL * 1000000u) / BOARD_LCD_PIXEL_CLOCK_HZ))
+
 #define BOARD_GT911_SDA_IO         GPIO_NUM_8
 #define BOARD_GT911_SCL_IO         GPIO_NUM_9
 #define BOARD_GT911_RST_IO         GPIO_NUM_NC
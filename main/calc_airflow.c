@@ -0,0 +1,534 @@
+#include "calc_airflow.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena/arena.h"
+#include "jobs/jobs.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#else
+#include <time.h>
+#endif
+
+// Types de cellules (octet de drapeaux par cellule)
+#define CELL_FLUID  0x00
+#define CELL_WALL   0x01  // rebond à mi-chemin
+#define CELL_OPEN   0x02  // aération : réservoir à l'équilibre, jamais mis à jour
+#define CELL_HEATER 0x04  // paroi à température imposée (avec CELL_WALL)
+#define CELL_NOZZLE 0x08  // source d'humidité (cellule fluide)
+
+#define TAU_FLOW    0.56f  // ν = 0,02 : assez visqueux pour rester stable en basse résolution
+#define TAU_SCALAR  0.60f
+#define U_REF       0.05f  // vitesse de convection visée en unités réseau (Mach ≈ 0,09)
+#define U_MAX       0.25f  // garde-fou de stabilité sur la vitesse d'équilibre
+#define DT_REF_C    15.0f  // θ = (T - T_amb) / DT_REF_C
+#define THETA_PLUME 0.1f   // θ typique du panache, mesuré : fixe la flottabilité pour atteindre U_REF
+#define MIST_RATE   0.5f   // relaxation de l'humidité des buses vers la saturation
+#define MIST_PUSH   0.3f   // poussée descendante du brouillard, en fraction de la flottabilité
+#define TILE_X      64     // colonnes par tuile : 3 rangées × 38 flottants × 64 ≈ 29 Ko en cache
+
+// D2Q9 : repos, 4 axes, 4 diagonales ; D2Q5 = les 5 premières directions
+static const int8_t k_cx[9] = {0, 1, 0, -1, 0, 1, -1, -1, 1};
+static const int8_t k_cy[9] = {0, 0, 1, 0, -1, 1, 1, -1, -1};
+static const uint8_t k_opp[9] = {0, 3, 4, 1, 2, 7, 8, 5, 6};
+static const float k_w9[9] = {4.0f / 9.0f,
+                              1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f,
+                              1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f, 1.0f / 36.0f};
+static const float k_w5[5] = {1.0f / 3.0f, 1.0f / 6.0f, 1.0f / 6.0f, 1.0f / 6.0f, 1.0f / 6.0f};
+
+static int64_t now_us(void)
+{
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    return (int64_t)clock() * 1000000 / CLOCKS_PER_SEC;
+#endif
+}
+
+static float clampf(float v, float lo, float hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static uint16_t frac_to_col(float frac, uint16_t n)
+{
+    const float c = clampf(frac, 0.0f, 1.0f) * (float)(n - 1);
+    return (uint16_t)(c + 0.5f);
+}
+
+void airflow_grid_size(const airflow_input_t *in, uint16_t *nx, uint16_t *ny)
+{
+    const uint16_t x = (uint16_t)clampf((float)in->nx, 8.0f, 1024.0f);
+    const float aspect = (in->length_cm > 1.0f) ? in->height_cm / in->length_cm : 0.5f;
+    *nx = x;
+    *ny = (uint16_t)clampf(roundf((float)x * aspect), 8.0f, 1024.0f);
+}
+
+size_t airflow_buffer_size(uint16_t nx, uint16_t ny)
+{
+    const size_t cells = (size_t)nx * ny;
+    const size_t flags = (cells + 15u) & ~(size_t)15u;
+    return flags + cells * (2u * 9u + 2u * 5u + 2u * 5u) * sizeof(float);
+}
+
+void airflow_default_input(airflow_input_t *in)
+{
+    memset(in, 0, sizeof(*in));
+    in->length_cm = 90.0f;
+    in->height_cm = 60.0f;
+    in->nx = 48;
+    in->low_vent_height_frac = 0.15f;
+    in->top_vent_start = 0.55f;
+    in->top_vent_end = 0.95f;
+    in->heater_start = 0.0f;
+    in->heater_end = 0.35f;
+    in->heater_surface_c = 38.0f;
+    in->ambient_c = 24.0f;
+    in->ambient_rh_pct = 50.0f;
+    in->nozzle_count = 2;
+    in->nozzle_x[0] = 0.3f;
+    in->nozzle_x[1] = 0.7f;
+    in->misting_on = false;
+}
+
+static void set_rest(const airflow_sim_t *sim, int buf, uint32_t idx, float theta, float rh)
+{
+    const uint32_t n = sim->cells;
+    for (int i = 0; i < 9; ++i) {
+        sim->f[buf][i * n + idx] = k_w9[i];
+    }
+    for (int i = 0; i < 5; ++i) {
+        sim->temp[buf][i * n + idx] = k_w5[i] * theta;
+        sim->hum[buf][i * n + idx] = k_w5[i] * rh;
+    }
+}
+
+bool airflow_init(airflow_sim_t *sim, const airflow_input_t *in, void *buffer, size_t buffer_size)
+{
+    if (!sim || !in || !buffer) {
+        return false;
+    }
+    uint16_t nx;
+    uint16_t ny;
+    airflow_grid_size(in, &nx, &ny);
+    if (buffer_size < airflow_buffer_size(nx, ny)) {
+        return false;
+    }
+
+    memset(sim, 0, sizeof(*sim));
+    sim->nx = nx;
+    sim->ny = ny;
+    sim->cells = (uint32_t)nx * ny;
+    sim->cm_per_cell = in->length_cm / (float)nx;
+    sim->ambient_c = in->ambient_c;
+    sim->heater_c = in->heater_surface_c;
+    sim->ambient_rh = clampf(in->ambient_rh_pct, 0.0f, 100.0f) / 100.0f;
+    sim->theta_heater = clampf((in->heater_surface_c - in->ambient_c) / DT_REF_C, -1.0f, 3.0f);
+    sim->buoyancy = U_REF * U_REF / (THETA_PLUME * (float)ny);
+    sim->misting_on = in->misting_on;
+
+    // Échelle de vitesse : la convection naturelle atteint environ 20 % de la
+    // vitesse de chute libre √(g·β·ΔT·H) ; le réseau est réglé pour U_REF.
+    const float beta = 1.0f / (in->ambient_c + 273.15f);
+    const float h_m = in->height_cm / 100.0f;
+    sim->cm_s_per_lu = 0.2f * sqrtf(9.81f * beta * DT_REF_C * fmaxf(h_m, 0.01f)) * 100.0f / U_REF;
+
+    uint8_t *p = (uint8_t *)buffer;
+    sim->flags = p;
+    p += (sim->cells + 15u) & ~(size_t)15u;
+    float *fp = (float *)p;
+    sim->f[0] = fp;
+    fp += 9u * sim->cells;
+    sim->f[1] = fp;
+    fp += 9u * sim->cells;
+    sim->temp[0] = fp;
+    fp += 5u * sim->cells;
+    sim->temp[1] = fp;
+    fp += 5u * sim->cells;
+    sim->hum[0] = fp;
+    fp += 5u * sim->cells;
+    sim->hum[1] = fp;
+
+    // Cadre de parois, aérations et zone chaude
+    memset(sim->flags, CELL_FLUID, sim->cells);
+    for (uint16_t x = 0; x < nx; ++x) {
+        sim->flags[x] = CELL_WALL;
+        sim->flags[(uint32_t)(ny - 1) * nx + x] = CELL_WALL;
+    }
+    for (uint16_t y = 0; y < ny; ++y) {
+        sim->flags[(uint32_t)y * nx] = CELL_WALL;
+        sim->flags[(uint32_t)y * nx + nx - 1] = CELL_WALL;
+    }
+    const uint16_t low_top = (uint16_t)(clampf(in->low_vent_height_frac, 0.0f, 1.0f) * (float)(ny - 2) + 0.5f);
+    for (uint16_t y = 1; y <= low_top && y < ny - 1; ++y) {
+        sim->flags[(uint32_t)y * nx] = CELL_OPEN;
+    }
+    if (in->top_vent_end > in->top_vent_start) {
+        const uint16_t x0 = frac_to_col(in->top_vent_start, nx);
+        const uint16_t x1 = frac_to_col(in->top_vent_end, nx);
+        for (uint16_t x = (x0 < 1 ? 1 : x0); x <= x1 && x < nx - 1; ++x) {
+            sim->flags[(uint32_t)(ny - 1) * nx + x] = CELL_OPEN;
+        }
+    }
+    if (in->heater_end > in->heater_start) {
+        const uint16_t x0 = frac_to_col(in->heater_start, nx);
+        const uint16_t x1 = frac_to_col(in->heater_end, nx);
+        for (uint16_t x = (x0 < 1 ? 1 : x0); x <= x1 && x < nx - 1; ++x) {
+            sim->flags[x] = CELL_WALL | CELL_HEATER;
+        }
+    }
+    const uint8_t nozzles = in->nozzle_count > AIRFLOW_MAX_NOZZLES ? AIRFLOW_MAX_NOZZLES : in->nozzle_count;
+    const uint16_t nozzle_y = ny > 4 ? ny - 3 : 1;
+    for (uint8_t i = 0; i < nozzles; ++i) {
+        uint16_t x = frac_to_col(in->nozzle_x[i], nx);
+        x = x < 1 ? 1 : (x > nx - 2 ? nx - 2 : x);
+        sim->flags[(uint32_t)nozzle_y * nx + x] = CELL_NOZZLE;
+    }
+
+    // Air au repos à l'ambiante ; les aérations gardent cet état dans les deux tampons
+    for (uint32_t idx = 0; idx < sim->cells; ++idx) {
+        set_rest(sim, 0, idx, 0.0f, sim->ambient_rh);
+        set_rest(sim, 1, idx, 0.0f, sim->ambient_rh);
+    }
+    return true;
+}
+
+void airflow_set_misting(airflow_sim_t *sim, bool on)
+{
+    sim->misting_on = on;
+}
+
+/*
+ * Propagation (schéma « pull ») et collision BGK fusionnées : chaque cellule
+ * lit ses 9+5+5 populations entrantes dans le tampon courant et écrit l'état
+ * post-collision dans l'autre, en un seul passage mémoire. Les parois sont
+ * traitées par rebond à mi-chemin : la population qui viendrait d'une paroi
+ * est la population opposée de la cellule elle-même.
+ */
+static void step_tile(airflow_sim_t *sim, uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1)
+{
+    const uint32_t n = sim->cells;
+    const int32_t nx = sim->nx;
+    const uint8_t *restrict flags = sim->flags;
+    const float *restrict sf = sim->f[sim->cur];
+    const float *restrict st = sim->temp[sim->cur];
+    const float *restrict sh = sim->hum[sim->cur];
+    float *restrict df = sim->f[sim->cur ^ 1];
+    float *restrict dt = sim->temp[sim->cur ^ 1];
+    float *restrict dh = sim->hum[sim->cur ^ 1];
+
+    const float omega_f = 1.0f / TAU_FLOW;
+    const float omega_s = 1.0f / TAU_SCALAR;
+    const float theta_w = sim->theta_heater;
+    const float g = sim->buoyancy;
+    const bool misting = sim->misting_on;
+
+    int32_t off[9];
+    for (int i = 0; i < 9; ++i) {
+        off[i] = k_cx[i] + k_cy[i] * nx;
+    }
+
+    for (uint16_t y = y0; y < y1; ++y) {
+        const uint32_t row = (uint32_t)y * nx;
+        for (uint16_t x = x0; x < x1; ++x) {
+            const uint32_t idx = row + x;
+            const uint8_t fl = flags[idx];
+            if (fl & (CELL_WALL | CELL_OPEN)) {
+                continue;
+            }
+
+            float f[9];
+            float t[5];
+            float h[5];
+            f[0] = sf[idx];
+            t[0] = st[idx];
+            h[0] = sh[idx];
+            for (int i = 1; i < 9; ++i) {
+                const uint32_t s = idx - off[i];
+                const uint8_t sfl = flags[s];
+                const uint32_t back = k_opp[i] * n + idx;
+                if (sfl & CELL_WALL) {
+                    f[i] = sf[back];
+                    if (i < 5) {
+                        // paroi adiabatique ; chauffage : anti-rebond à θ imposé
+                        t[i] = (sfl & CELL_HEATER) ? 2.0f * k_w5[i] * theta_w - st[back] : st[back];
+                        h[i] = sh[back];
+                    }
+                } else {
+                    f[i] = sf[i * n + s];
+                    if (i < 5) {
+                        t[i] = st[i * n + s];
+                        h[i] = sh[i * n + s];
+                    }
+                }
+            }
+
+            const float rho = f[0] + f[1] + f[2] + f[3] + f[4] + f[5] + f[6] + f[7] + f[8];
+            const float inv_rho = 1.0f / rho;
+            float ux = (f[1] - f[3] + f[5] - f[6] - f[7] + f[8]) * inv_rho;
+            float uy = (f[2] - f[4] + f[5] + f[6] - f[7] - f[8]) * inv_rho;
+            const float theta = t[0] + t[1] + t[2] + t[3] + t[4];
+            const float c = h[0] + h[1] + h[2] + h[3] + h[4];
+
+            // Boussinesq : F_y = g·β·θ, appliquée par décalage de la vitesse d'équilibre
+            float fy = g * theta;
+            const bool nozzle = misting && (fl & CELL_NOZZLE);
+            if (nozzle) {
+                fy -= MIST_PUSH * g * (1.0f + fabsf(theta_w));
+            }
+            const float uy_phys = uy + 0.5f * fy * inv_rho;
+            uy += TAU_FLOW * fy * inv_rho;
+            const float u2 = ux * ux + uy * uy;
+            if (u2 > U_MAX * U_MAX) {
+                const float k = U_MAX / sqrtf(u2);
+                ux *= k;
+                uy *= k;
+            }
+
+            const float usq = 1.5f * (ux * ux + uy * uy);
+            for (int i = 0; i < 9; ++i) {
+                const float cu = 3.0f * ((float)k_cx[i] * ux + (float)k_cy[i] * uy);
+                const float feq = k_w9[i] * rho * (1.0f + cu + 0.5f * cu * cu - usq);
+                df[i * n + idx] = f[i] + omega_f * (feq - f[i]);
+            }
+
+            const float mist = nozzle ? MIST_RATE * (1.0f - c) : 0.0f;
+            for (int i = 0; i < 5; ++i) {
+                const float cu = 3.0f * ((float)k_cx[i] * ux + (float)k_cy[i] * uy_phys);
+                const float eq = k_w5[i] * (1.0f + cu);
+                dt[i * n + idx] = t[i] + omega_s * (eq * theta - t[i]);
+                dh[i * n + idx] = h[i] + omega_s * (eq * c - h[i]) + k_w5[i] * mist;
+            }
+        }
+    }
+}
+
+void airflow_step_rows(airflow_sim_t *sim, uint16_t y0, uint16_t y1)
+{
+    if (y0 < 1) {
+        y0 = 1;
+    }
+    if (y1 > sim->ny - 1) {
+        y1 = sim->ny - 1;
+    }
+    // Tuiles de colonnes : la bande de rangées est parcourue tuile par tuile
+    // pour que les trois rangées sources touchées restent en cache.
+    for (uint16_t x0 = 1; x0 < sim->nx - 1; x0 += TILE_X) {
+        const uint16_t x1 = (uint16_t)((x0 + TILE_X < sim->nx - 1) ? x0 + TILE_X : sim->nx - 1);
+        step_tile(sim, x0, x1, y0, y1);
+    }
+}
+
+// En dessous, le coût de distribution dépasse le gain du second cœur
+#define AIRFLOW_SPLIT_MIN_CELLS 512
+// Bandes d'au moins 4 rangées : chaque tranche garde ses rangées sources en cache
+#define AIRFLOW_BAND_ROWS 4
+
+static void step_band(void *ctx, uint32_t y0, uint32_t y1)
+{
+    airflow_step_rows((airflow_sim_t *)ctx, (uint16_t)y0, (uint16_t)y1);
+}
+
+void airflow_step(airflow_sim_t *sim, uint32_t steps)
+{
+    const bool split = sim->cells >= AIRFLOW_SPLIT_MIN_CELLS && jobs_ready();
+    for (uint32_t s = 0; s < steps; ++s) {
+        if (split) {
+            jobs_parallel_for(1, sim->ny - 1u, AIRFLOW_BAND_ROWS, step_band, sim, NULL);
+        } else {
+            airflow_step_rows(sim, 1, sim->ny - 1);
+        }
+        sim->cur ^= 1;
+        sim->step_count++;
+    }
+}
+
+void airflow_sample(const airflow_sim_t *sim, uint16_t x, uint16_t y, airflow_cell_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    if (x >= sim->nx || y >= sim->ny) {
+        out->solid = true;
+        return;
+    }
+    const uint32_t n = sim->cells;
+    const uint32_t idx = (uint32_t)y * sim->nx + x;
+    const uint8_t fl = sim->flags[idx];
+    if (fl & CELL_WALL) {
+        out->solid = true;
+        out->temp_c = (fl & CELL_HEATER) ? sim->heater_c : sim->ambient_c;
+        out->rh_pct = sim->ambient_rh * 100.0f;
+        return;
+    }
+    const float *f = sim->f[sim->cur];
+    const float *t = sim->temp[sim->cur];
+    const float *h = sim->hum[sim->cur];
+    float rho = 0.0f;
+    float mx = 0.0f;
+    float my = 0.0f;
+    for (int i = 0; i < 9; ++i) {
+        const float v = f[i * n + idx];
+        rho += v;
+        mx += (float)k_cx[i] * v;
+        my += (float)k_cy[i] * v;
+    }
+    float theta = 0.0f;
+    float c = 0.0f;
+    for (int i = 0; i < 5; ++i) {
+        theta += t[i * n + idx];
+        c += h[i * n + idx];
+    }
+    const float uy_phys = (my + 0.5f * sim->buoyancy * theta) / rho;
+    out->vx_cm_s = mx / rho * sim->cm_s_per_lu;
+    out->vy_cm_s = uy_phys * sim->cm_s_per_lu;
+    out->speed_cm_s = sqrtf(out->vx_cm_s * out->vx_cm_s + out->vy_cm_s * out->vy_cm_s);
+    out->temp_c = sim->ambient_c + theta * DT_REF_C;
+    out->rh_pct = clampf(c, 0.0f, 1.0f) * 100.0f;
+}
+
+void airflow_summarize(const airflow_sim_t *sim, airflow_summary_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    uint32_t fluid = 0;
+    uint32_t floor_cells = 0;
+    airflow_cell_t c;
+    for (uint16_t y = 1; y < sim->ny - 1; ++y) {
+        for (uint16_t x = 1; x < sim->nx - 1; ++x) {
+            airflow_sample(sim, x, y, &c);
+            if (c.solid) {
+                continue;
+            }
+            fluid++;
+            out->mean_rh_pct += c.rh_pct;
+            out->mean_temp_c += c.temp_c;
+            out->max_speed_cm_s = fmaxf(out->max_speed_cm_s, c.speed_cm_s);
+            if (y == 1) {
+                out->floor_rh_pct += c.rh_pct;
+                floor_cells++;
+            }
+            if (y == sim->ny - 2 && (sim->flags[(uint32_t)(y + 1) * sim->nx + x] & CELL_OPEN)) {
+                out->vent_outflow += fmaxf(c.vy_cm_s, 0.0f) / sim->cm_s_per_lu;
+            }
+        }
+    }
+    if (fluid) {
+        out->mean_rh_pct /= (float)fluid;
+        out->mean_temp_c /= (float)fluid;
+    }
+    if (floor_cells) {
+        out->floor_rh_pct /= (float)floor_cells;
+    }
+}
+
+static double total_mass(const airflow_sim_t *sim)
+{
+    double m = 0.0;
+    const float *f = sim->f[sim->cur];
+    for (uint32_t idx = 0; idx < sim->cells; ++idx) {
+        if (sim->flags[idx] & (CELL_WALL | CELL_OPEN)) {
+            continue;
+        }
+        for (int i = 0; i < 9; ++i) {
+            m += f[i * sim->cells + idx];
+        }
+    }
+    return m;
+}
+
+void airflow_run_self_test(void)
+{
+    static airflow_sim_t sim;
+    airflow_input_t in;
+    airflow_summary_t sum;
+
+    // Boîte fermée chauffée : masse conservée, panache montant au-dessus du chauffage
+    airflow_default_input(&in);
+    in.low_vent_height_frac = 0.0f;
+    in.top_vent_start = in.top_vent_end = 0.0f;
+    uint16_t nx;
+    uint16_t ny;
+    airflow_grid_size(&in, &nx, &ny);
+    size_t size = airflow_buffer_size(nx, ny);
+    // Grilles en PSRAM, rendues en bloc à la fin du test
+    const arena_user_t user = arena_register_user("airflow");
+    const arena_mark_t mark = arena_begin();
+    void *buf = arena_alloc(user, size, 64, ARENA_BULK);
+    if (!buf || !airflow_init(&sim, &in, buf, size)) {
+        printf("[TEST aéraulique] allocation %u octets : ÉCHEC\n", (unsigned)size);
+        arena_end(&mark);
+        return;
+    }
+    const double m0 = total_mass(&sim);
+    airflow_step(&sim, 1500);
+    const double drift = fabs(total_mass(&sim) - m0) / m0;
+    airflow_cell_t above;
+    airflow_sample(&sim, frac_to_col(0.5f * (in.heater_start + in.heater_end), nx), ny / 3, &above);
+    airflow_summarize(&sim, &sum);
+    printf("[TEST aéraulique] boîte fermée %ux%u : dérive masse %.1e, v_y au-dessus du chauffage %.1f cm/s, T moy %.1f °C %s\n",
+           nx,
+           ny,
+           drift,
+           (double)above.vy_cm_s,
+           (double)sum.mean_temp_c,
+           (drift < 1e-4 && above.vy_cm_s > 0.5f && sum.mean_temp_c > in.ambient_c) ? "OK" : "ÉCHEC");
+
+    // Terrarium ventilé avec brumisation : tirage vers la grille haute, humidité qui monte
+    airflow_default_input(&in);
+    in.misting_on = true;
+    airflow_init(&sim, &in, buf, size);
+    airflow_step(&sim, 3000);
+    airflow_summarize(&sim, &sum);
+    printf("[TEST aéraulique] ventilé + brume : sortie haute %.2f, HR moy %.0f %% (sol %.0f %%), v max %.1f cm/s %s\n",
+           (double)sum.vent_outflow,
+           (double)sum.mean_rh_pct,
+           (double)sum.floor_rh_pct,
+           (double)sum.max_speed_cm_s,
+           (sum.vent_outflow > 0.0f && sum.mean_rh_pct > in.ambient_rh_pct + 5.0f && sum.max_speed_cm_s < 100.0f &&
+            isfinite(sum.mean_temp_c))
+               ? "OK"
+               : "ÉCHEC");
+
+    // Débit du noyau sur un cœur (MLUPS = millions de mises à jour de cellule par seconde)
+    airflow_default_input(&in);
+    in.nx = 160;
+    airflow_grid_size(&in, &nx, &ny);
+    size = airflow_buffer_size(nx, ny);
+    buf = arena_alloc(user, size, 64, ARENA_BULK);
+    if (!buf) {
+        printf("[TEST aéraulique] grille de mesure %ux%u non allouée\n", nx, ny);
+        arena_end(&mark);
+        return;
+    }
+    airflow_init(&sim, &in, buf, size);
+    const uint32_t steps = 40;
+    const int64_t t0 = now_us();
+    for (uint32_t s = 0; s < steps; ++s) {
+        airflow_step_rows(&sim, 1, sim.ny - 1);
+        sim.cur ^= 1;
+    }
+    const int64_t dt = now_us() - t0;
+    const double mlups = dt > 0 ? (double)(nx - 2) * (ny - 2) * steps / (double)dt : 0.0;
+#ifdef ESP_PLATFORM
+    printf("[TEST aéraulique] %ux%u : %.2f MLUPS par cœur\n", nx, ny, mlups);
+#else
+    printf("[TEST aéraulique] %ux%u : %.1f MLUPS par cœur %s\n", nx, ny, mlups, mlups >= 5.0 ? "OK" : "ÉCHEC");
+#endif
+
+    // Même grille répartie sur les ouvriers (les bandes ne changent pas le résultat)
+    if (jobs_ready()) {
+        const int64_t t1 = now_us();
+        airflow_step(&sim, steps);
+        const int64_t dt_par = now_us() - t1;
+        const double mlups_par = dt_par > 0 ? (double)(nx - 2) * (ny - 2) * steps / (double)dt_par : 0.0;
+        printf("[TEST aéraulique] %ux%u : %.2f MLUPS en parallèle, %u ouvrier(s) + appelant (x%.2f)\n",
+               nx,
+               ny,
+               mlups_par,
+               jobs_worker_count(),
+               mlups > 0.0 ? mlups_par / mlups : 0.0);
+    }
+    arena_end(&mark);
+}
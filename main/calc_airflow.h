@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AIRFLOW_MAX_NOZZLES 4
+
+/**
+ * Coupe verticale du terrarium (longueur × hauteur) : aération basse sur la
+ * face gauche, grille haute au plafond, zone chaude au sol (tapis/câble) et
+ * buses de brumisation sous le plafond. Les positions sont des fractions de
+ * la longueur (0 = gauche, 1 = droite).
+ */
+typedef struct {
+    float length_cm;
+    float height_cm;
+    uint16_t nx;                 // résolution horizontale ; ny suit le rapport H/L
+    float low_vent_height_frac;  // hauteur de l'aération basse (fraction de H)
+    float top_vent_start;        // grille haute [début, fin]
+    float top_vent_end;
+    float heater_start;          // zone chauffée au sol [début, fin]
+    float heater_end;
+    float heater_surface_c;
+    float ambient_c;
+    float ambient_rh_pct;
+    uint8_t nozzle_count;
+    float nozzle_x[AIRFLOW_MAX_NOZZLES];
+    bool misting_on;
+} airflow_input_t;
+
+/**
+ * Simulation Boltzmann sur réseau : D2Q9 pour l'air (BGK, forçage de
+ * Boussinesq), deux D2Q5 pour la température et l'humidité transportées.
+ * Distributions en structure de tableaux, double tampon, tout dans un bloc
+ * fourni par l'appelant (PSRAM sur cible) : voir airflow_buffer_size().
+ */
+typedef struct {
+    uint16_t nx;
+    uint16_t ny;
+    uint32_t cells;
+    uint32_t step_count;
+    uint8_t cur;          // tampon courant (0/1)
+    float cm_per_cell;
+    float ambient_c;
+    float heater_c;
+    float ambient_rh;
+    float buoyancy;       // g·β·ΔT_ref en unités réseau
+    float theta_heater;   // écart chauffage-ambiant / ΔT_ref
+    float cm_s_per_lu;    // conversion vitesse réseau -> cm/s
+    bool misting_on;
+    uint8_t *flags;
+    float *f[2];          // 9 × cells
+    float *temp[2];       // 5 × cells
+    float *hum[2];        // 5 × cells
+} airflow_sim_t;
+
+typedef struct {
+    float speed_cm_s;
+    float vx_cm_s;
+    float vy_cm_s;  // positif vers le haut
+    float temp_c;
+    float rh_pct;
+    bool solid;
+} airflow_cell_t;
+
+typedef struct {
+    float max_speed_cm_s;
+    float mean_rh_pct;
+    float floor_rh_pct;   // rangée au-dessus du sol
+    float mean_temp_c;
+    float vent_outflow;   // débit sortant par la grille haute (cellules·u)
+} airflow_summary_t;
+
+/** Grille adaptée à l'entrée : ny déduit de nx et du rapport H/L. */
+void airflow_grid_size(const airflow_input_t *in, uint16_t *nx, uint16_t *ny);
+size_t airflow_buffer_size(uint16_t nx, uint16_t ny);
+void airflow_default_input(airflow_input_t *in);
+bool airflow_init(airflow_sim_t *sim, const airflow_input_t *in, void *buffer, size_t buffer_size);
+void airflow_set_misting(airflow_sim_t *sim, bool on);
+/**
+ * Avance de `steps` pas. Si le système de tâches (`jobs`) est démarré, les
+ * rangées sont réparties en bandes entre les ouvriers ; sinon, un seul fil.
+ */
+void airflow_step(airflow_sim_t *sim, uint32_t steps);
+/** Noyau fusionné propagation-collision sur les rangées [y0, y1) ; sans basculer de tampon. */
+void airflow_step_rows(airflow_sim_t *sim, uint16_t y0, uint16_t y1);
+void airflow_sample(const airflow_sim_t *sim, uint16_t x, uint16_t y, airflow_cell_t *out);
+void airflow_summarize(const airflow_sim_t *sim, airflow_summary_t *out);
+void airflow_run_self_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALC_BOUNDS_MAX_OUTPUTS 8
+
+// Tolérances par défaut utilisées par `*_default_tolerance()`
+#define CALC_TOL_TAPE_CM 0.5f       // mètre ruban / réglet
+#define CALC_TOL_PRODUCT_REL 0.10f  // dispersion d'un lot à l'autre (flux, débit, puissance)
+#define CALC_TOL_UV_REL 0.20f       // dispersion lampe à lampe des tubes/spots UV
+#define CALC_TOL_SUPPLY_REL 0.05f   // alimentation / secteur
+
+/**
+ * Bornes garanties [min, max] de chaque sortie continue, obtenues en une
+ * passe d'arithmétique d'intervalles à partir des tolérances d'entrée.
+ * L'arrondi est dirigé vers l'extérieur : la vraie valeur du modèle est
+ * toujours comprise dans l'intervalle (éventuellement un peu large).
+ */
+typedef struct {
+    bool valid;
+    uint8_t output_count;
+    const char *output_names[CALC_BOUNDS_MAX_OUTPUTS];
+    float min[CALC_BOUNDS_MAX_OUTPUTS];
+    float max[CALC_BOUNDS_MAX_OUTPUTS];
+} calc_bounds_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,243 @@
+#include "calc_calibration.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "calc_heating_cable.h"
+#include "calc_heating_pad.h"
+
+#define FORGET 0.99f            // oubli léger : suit le vieillissement des lampes
+#define HEAT_PRIOR_REL 0.25f    // ±25 % autour du catalogue avant toute mesure
+#define LAMP_PRIOR_LOG_GAIN 0.25f
+#define LAMP_PRIOR_EXPONENT 0.25f
+#define DEFAULT_EXPONENT 1.9f
+#define HEAT_NOISE_REL 0.08f    // thermomètre IR ±0,5 °C sur ~6 °C d'écart
+#define UV_NOISE_LOG 0.1f       // UVI-mètre grand public : ±10 %
+
+static void push_undo(cal_store_t *store)
+{
+    if (store->undo_count == CAL_UNDO_DEPTH) {
+        memmove(&store->undo[0], &store->undo[1], sizeof(store->undo[0]) * (CAL_UNDO_DEPTH - 1));
+        store->undo_count--;
+    }
+    store->undo[store->undo_count++] = store->current;
+}
+
+void calibration_defaults(cal_store_t *store)
+{
+    if (!store) {
+        return;
+    }
+    memset(store, 0, sizeof(*store));
+
+    cal_heat_state_t *h = &store->current.heat;
+    heating_pad_calibration_points(NULL, h->power_w, CAL_HEAT_POINTS);
+    for (size_t i = 0; i < CAL_HEAT_POINTS; ++i) {
+        const float sigma = HEAT_PRIOR_REL * h->power_w[i];
+        h->cov[i][i] = sigma * sigma;
+    }
+
+    for (size_t l = 0; l < CAL_LAMP_COUNT; ++l) {
+        cal_lamp_state_t *lamp = &store->current.lamp[l];
+        lamp->exponent = DEFAULT_EXPONENT;
+        lamp->cov[0][0] = LAMP_PRIOR_LOG_GAIN;
+        lamp->cov[1][1] = LAMP_PRIOR_EXPONENT;
+    }
+}
+
+// Mise à jour RLS générique à n paramètres pour y = φᵀθ + bruit (variance r) :
+// k = Pφ / (λr + φᵀPφ), θ += k (y - φᵀθ), P = (P - k φᵀP) / λ.
+// La variance est plafonnée à l'a priori pour éviter l'emballement quand
+// une zone n'est plus excitée.
+static void rls_update(size_t n, float *theta, float *cov, const float *phi, float y, float noise_var, const float *prior_var)
+{
+    float p_phi[CAL_HEAT_POINTS];
+    float denom = FORGET * noise_var;
+    for (size_t i = 0; i < n; ++i) {
+        p_phi[i] = 0.0f;
+        for (size_t j = 0; j < n; ++j) {
+            p_phi[i] += cov[i * n + j] * phi[j];
+        }
+        denom += phi[i] * p_phi[i];
+    }
+
+    float predicted = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        predicted += phi[i] * theta[i];
+    }
+    const float err = y - predicted;
+    for (size_t i = 0; i < n; ++i) {
+        theta[i] += p_phi[i] / denom * err;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i; j < n; ++j) {
+            // forme symétrique : P reste définie positive malgré l'arrondi float
+            const float v = (cov[i * n + j] - p_phi[i] * p_phi[j] / denom) / FORGET;
+            cov[i * n + j] = v;
+            cov[j * n + i] = v;
+        }
+        if (cov[i * n + i] > prior_var[i]) {
+            const float s = sqrtf(prior_var[i] / cov[i * n + i]);
+            for (size_t j = 0; j < n; ++j) {
+                cov[i * n + j] *= s;
+                cov[j * n + i] *= s;
+            }
+        }
+    }
+}
+
+bool calibration_add_heat(cal_store_t *store, const cal_heat_measurement_t *m)
+{
+    if (!store || !m || m->heated_area_cm2 <= 0.0f || m->power_w <= 0.0f) {
+        return false;
+    }
+    const float rise_measured = m->measured_surface_c - m->ambient_c;
+    const float rise_target = m->target_surface_c - m->ambient_c;
+    if (rise_measured < 1.0f || rise_target <= 0.0f) {
+        return false; // écart trop faible pour être exploitable au thermomètre IR
+    }
+    const float needed_w = m->power_w * rise_target / rise_measured;
+
+    // Régresseur : fonctions chapeau sur les nœuds (interpolation linéaire,
+    // deux coefficients non nuls), les nœuds gardent leur sens de puissance.
+    float area[CAL_HEAT_POINTS];
+    float catalog[CAL_HEAT_POINTS];
+    heating_pad_calibration_points(area, catalog, CAL_HEAT_POINTS);
+    float phi[CAL_HEAT_POINTS] = {0};
+    if (m->heated_area_cm2 <= area[0]) {
+        phi[0] = 1.0f;
+    } else if (m->heated_area_cm2 >= area[CAL_HEAT_POINTS - 1]) {
+        phi[CAL_HEAT_POINTS - 1] = 1.0f;
+    } else {
+        size_t i = 0;
+        while (m->heated_area_cm2 > area[i + 1]) {
+            ++i;
+        }
+        const float t = (m->heated_area_cm2 - area[i]) / (area[i + 1] - area[i]);
+        phi[i] = 1.0f - t;
+        phi[i + 1] = t;
+    }
+
+    float prior_var[CAL_HEAT_POINTS];
+    for (size_t i = 0; i < CAL_HEAT_POINTS; ++i) {
+        const float sigma = HEAT_PRIOR_REL * catalog[i];
+        prior_var[i] = sigma * sigma;
+    }
+
+    push_undo(store);
+    cal_heat_state_t *h = &store->current.heat;
+    const float noise = HEAT_NOISE_REL * needed_w;
+    rls_update(CAL_HEAT_POINTS, h->power_w, &h->cov[0][0], phi, needed_w, noise * noise, prior_var);
+    h->count++;
+    return true;
+}
+
+bool calibration_add_uv(cal_store_t *store, cal_lamp_t lamp, const cal_uv_measurement_t *m)
+{
+    if (!store || !m || lamp >= CAL_LAMP_COUNT || m->distance_cm <= 0.0f || m->measured <= 0.0f ||
+        m->datasheet_value <= 0.0f || m->reference_distance_cm <= 0.0f) {
+        return false;
+    }
+
+    // ln(E/E_réf) = ln(gain) - exposant · ln(d/d_réf) : linéaire en (ln gain, exposant)
+    const float phi[2] = {1.0f, -logf(m->distance_cm / m->reference_distance_cm)};
+    const float y = logf(m->measured / m->datasheet_value);
+    const float prior_var[2] = {LAMP_PRIOR_LOG_GAIN, LAMP_PRIOR_EXPONENT};
+
+    push_undo(store);
+    cal_lamp_state_t *s = &store->current.lamp[lamp];
+    float theta[2] = {s->log_gain, s->exponent};
+    rls_update(2, theta, &s->cov[0][0], phi, y, UV_NOISE_LOG * UV_NOISE_LOG, prior_var);
+    s->log_gain = theta[0];
+    s->exponent = fminf(fmaxf(theta[1], 0.5f), 3.0f);
+    s->count++;
+    return true;
+}
+
+bool calibration_rollback(cal_store_t *store)
+{
+    if (!store || store->undo_count == 0) {
+        return false;
+    }
+    store->current = store->undo[--store->undo_count];
+    return true;
+}
+
+lighting_falloff_t calibration_falloff(const cal_state_t *state, cal_lamp_t lamp)
+{
+    const cal_lamp_state_t *s = &state->lamp[lamp];
+    return (lighting_falloff_t){.gain = expf(s->log_gain), .exponent = s->exponent};
+}
+
+void calibration_apply(const cal_state_t *state)
+{
+    if (!state) {
+        heating_pad_set_calibration(NULL, 0);
+        heating_cable_set_calibration(NULL, 0);
+        lighting_set_falloff(NULL, NULL);
+        return;
+    }
+
+    // sans mesure, on laisse les modules sur leurs valeurs catalogue exactes
+    if (state->heat.count > 0) {
+        heating_pad_set_calibration(state->heat.power_w, CAL_HEAT_POINTS);
+        heating_cable_set_calibration(state->heat.power_w, CAL_HEAT_POINTS);
+    } else {
+        heating_pad_set_calibration(NULL, 0);
+        heating_cable_set_calibration(NULL, 0);
+    }
+
+    const lighting_falloff_t uvb = calibration_falloff(state, CAL_LAMP_UVB);
+    const lighting_falloff_t uva = calibration_falloff(state, CAL_LAMP_UVA);
+    lighting_set_falloff(state->lamp[CAL_LAMP_UVB].count ? &uvb : NULL, state->lamp[CAL_LAMP_UVA].count ? &uva : NULL);
+}
+
+void calibration_run_self_test(void)
+{
+    static cal_store_t store;
+    calibration_defaults(&store);
+
+    // Lampe UVB réelle : 80 % de la fiche, décroissance en 1/d^1,6
+    const float true_gain = 0.8f;
+    const float true_exp = 1.6f;
+    const float distances[] = {20.0f, 25.0f, 30.0f, 40.0f, 50.0f, 35.0f};
+    for (size_t i = 0; i < sizeof(distances) / sizeof(distances[0]); ++i) {
+        const cal_uv_measurement_t m = {
+            .distance_cm = distances[i],
+            .measured = 2.0f * true_gain * powf(30.0f / distances[i], true_exp),
+            .datasheet_value = 2.0f,
+            .reference_distance_cm = 30.0f,
+        };
+        calibration_add_uv(&store, CAL_LAMP_UVB, &m);
+    }
+    const lighting_falloff_t f = calibration_falloff(&store.current, CAL_LAMP_UVB);
+    printf("[TEST calibration] UVB après %u mesures : gain %.2f (réel %.2f), exposant %.2f (réel %.2f) %s\n",
+           store.current.lamp[CAL_LAMP_UVB].count,
+           f.gain,
+           true_gain,
+           f.exponent,
+           true_exp,
+           (fabsf(f.gain - true_gain) < 0.05f && fabsf(f.exponent - true_exp) < 0.1f) ? "OK" : "ÉCHEC");
+
+    // Tapis 377 cm² / 15 W : surface à 34 °C pour 30 °C visés (ambiance 24 °C)
+    const float before = store.current.heat.power_w[2];
+    const cal_heat_measurement_t hm = {
+        .heated_area_cm2 = 377.0f,
+        .power_w = 15.0f,
+        .measured_surface_c = 34.0f,
+        .ambient_c = 24.0f,
+        .target_surface_c = 30.0f,
+    };
+    calibration_add_heat(&store, &hm);
+    printf("[TEST calibration] nœud 377 cm² : %.1f W -> %.1f W (besoin mesuré 9,0 W)\n",
+           before,
+           store.current.heat.power_w[2]);
+
+    const bool rolled = calibration_rollback(&store);
+    printf("[TEST calibration] annulation : %s, nœud 377 cm² = %.1f W, %u état(s) en réserve\n",
+           rolled && store.current.heat.power_w[2] == before ? "OK" : "ÉCHEC",
+           store.current.heat.power_w[2],
+           store.undo_count);
+}
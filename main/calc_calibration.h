@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "calc_lighting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CAL_HEAT_POINTS 5
+#define CAL_UNDO_DEPTH  4
+
+typedef enum {
+    CAL_LAMP_UVB = 0,
+    CAL_LAMP_UVA,
+    CAL_LAMP_COUNT
+} cal_lamp_t;
+
+/**
+ * État des moindres carrés récursifs : paramètres estimés + covariance.
+ * Chaque mesure coûte O(n²) avec n fixe (5 nœuds chauffage, 2 paramètres
+ * lampe), sans jamais relire l'historique.
+ */
+typedef struct {
+    uint16_t count;
+    float power_w[CAL_HEAT_POINTS];              // puissances aux nœuds de la spline catalogue
+    float cov[CAL_HEAT_POINTS][CAL_HEAT_POINTS];
+} cal_heat_state_t;
+
+typedef struct {
+    uint16_t count;
+    float log_gain;  // ln(gain) : écart de la lampe à sa fiche (vieillissement)
+    float exponent;  // décroissance en 1/d^exposant
+    float cov[2][2];
+} cal_lamp_state_t;
+
+typedef struct {
+    cal_heat_state_t heat;
+    cal_lamp_state_t lamp[CAL_LAMP_COUNT];
+} cal_state_t;
+
+/** État courant + pile d'annulation, persisté tel quel en NVS. */
+typedef struct {
+    cal_state_t current;
+    uint8_t undo_count;
+    cal_state_t undo[CAL_UNDO_DEPTH];
+} cal_store_t;
+
+/**
+ * Relevé thermomètre IR : tapis/câble de surface et puissance connues, surface
+ * mesurée vs ambiance. La puissance qui aurait donné la consigne est
+ * P · (consigne - ambiance) / (mesure - ambiance) (échange linéaire).
+ */
+typedef struct {
+    float heated_area_cm2;
+    float power_w;
+    float measured_surface_c;
+    float ambient_c;
+    float target_surface_c;
+} cal_heat_measurement_t;
+
+/** Relevé UVI-mètre (ou radiomètre UVA) à une distance donnée. */
+typedef struct {
+    float distance_cm;
+    float measured;          // UVI (UVB) ou mW/cm² (UVA)
+    float datasheet_value;   // valeur annoncée à la distance de référence
+    float reference_distance_cm;
+} cal_uv_measurement_t;
+
+void calibration_defaults(cal_store_t *store);
+bool calibration_add_heat(cal_store_t *store, const cal_heat_measurement_t *m);
+bool calibration_add_uv(cal_store_t *store, cal_lamp_t lamp, const cal_uv_measurement_t *m);
+/** Revient à l'état précédant la dernière mesure. */
+bool calibration_rollback(cal_store_t *store);
+/** Pousse l'état courant dans les modules tapis, câble et éclairage. */
+void calibration_apply(const cal_state_t *state);
+lighting_falloff_t calibration_falloff(const cal_state_t *state, cal_lamp_t lamp);
+void calibration_run_self_test(void);
+
+#ifdef __cplusplus
+}
+#endif
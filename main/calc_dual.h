@@ -0,0 +1,167 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+
+#include "calc_sensitivity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALC_DUAL_VARS CALC_SENS_MAX_INPUTS
+
+/**
+ * Nombre dual « vectoriel » : valeur + gradient par rapport à toutes les
+ * entrées du module. Une évaluation du noyau sur ce type donne toutes les
+ * dérivées partielles d'un coup (mode direct), au lieu de N+1 calculs par
+ * différences finies.
+ */
+typedef struct {
+    float v;
+    float d[CALC_DUAL_VARS];
+} calc_dual_t;
+
+typedef float (*calc_mono_fn_t)(float x, float *slope);
+typedef float (*calc_mono_ctx_fn_t)(const void *ctx, float x, float *slope);
+
+static inline calc_dual_t calc_dual_const(float v)
+{
+    calc_dual_t r = {.v = v};
+    return r;
+}
+
+static inline calc_dual_t calc_dual_var(float v, size_t index)
+{
+    calc_dual_t r = {.v = v};
+    if (index < CALC_DUAL_VARS) {
+        r.d[index] = 1.0f;
+    }
+    return r;
+}
+
+static inline calc_dual_t calc_dual_add(calc_dual_t a, calc_dual_t b)
+{
+    calc_dual_t r = {.v = a.v + b.v};
+    for (size_t i = 0; i < CALC_DUAL_VARS; ++i) {
+        r.d[i] = a.d[i] + b.d[i];
+    }
+    return r;
+}
+
+static inline calc_dual_t calc_dual_sub(calc_dual_t a, calc_dual_t b)
+{
+    calc_dual_t r = {.v = a.v - b.v};
+    for (size_t i = 0; i < CALC_DUAL_VARS; ++i) {
+        r.d[i] = a.d[i] - b.d[i];
+    }
+    return r;
+}
+
+static inline calc_dual_t calc_dual_mul(calc_dual_t a, calc_dual_t b)
+{
+    calc_dual_t r = {.v = a.v * b.v};
+    for (size_t i = 0; i < CALC_DUAL_VARS; ++i) {
+        r.d[i] = a.d[i] * b.v + a.v * b.d[i];
+    }
+    return r;
+}
+
+static inline calc_dual_t calc_dual_div(calc_dual_t a, calc_dual_t b)
+{
+    calc_dual_t r = {.v = a.v / b.v};
+    const float inv_b2 = 1.0f / (b.v * b.v);
+    for (size_t i = 0; i < CALC_DUAL_VARS; ++i) {
+        r.d[i] = (a.d[i] * b.v - a.v * b.d[i]) * inv_b2;
+    }
+    return r;
+}
+
+static inline calc_dual_t calc_dual_scale(calc_dual_t a, float k)
+{
+    calc_dual_t r = {.v = a.v * k};
+    for (size_t i = 0; i < CALC_DUAL_VARS; ++i) {
+        r.d[i] = a.d[i] * k;
+    }
+    return r;
+}
+
+/* Règle de la chaîne commune : f(a) de dérivée f'(a.v). */
+static inline calc_dual_t calc_dual_chain(calc_dual_t a, float value, float slope)
+{
+    calc_dual_t r = {.v = value};
+    for (size_t i = 0; i < CALC_DUAL_VARS; ++i) {
+        r.d[i] = a.d[i] * slope;
+    }
+    return r;
+}
+
+static inline calc_dual_t calc_dual_sqrt(calc_dual_t a)
+{
+    const float s = sqrtf(a.v);
+    return calc_dual_chain(a, s, (s > 0.0f) ? 0.5f / s : 0.0f);
+}
+
+static inline calc_dual_t calc_dual_powf(calc_dual_t a, float exponent)
+{
+    const float p = powf(a.v, exponent);
+    return calc_dual_chain(a, p, (a.v > 0.0f) ? exponent * p / a.v : 0.0f);
+}
+
+static inline calc_dual_t calc_dual_clamp(calc_dual_t a, float min, float max)
+{
+    if (a.v < min) {
+        return calc_dual_const(min);
+    }
+    if (a.v > max) {
+        return calc_dual_const(max);
+    }
+    return a;
+}
+
+static inline calc_dual_t calc_dual_fmax(calc_dual_t a, float k)
+{
+    return (a.v >= k) ? a : calc_dual_const(k);
+}
+
+static inline calc_dual_t calc_dual_max(calc_dual_t a, calc_dual_t b)
+{
+    return (a.v >= b.v) ? a : b;
+}
+
+static inline calc_dual_t calc_dual_mono(calc_dual_t a, calc_mono_fn_t fn)
+{
+    float slope = 0.0f;
+    const float v = fn(a.v, &slope);
+    return calc_dual_chain(a, v, slope);
+}
+
+static inline calc_dual_t calc_dual_mono_ctx(calc_dual_t a, calc_mono_ctx_fn_t fn, const void *ctx)
+{
+    float slope = 0.0f;
+    const float v = fn(ctx, a.v, &slope);
+    return calc_dual_chain(a, v, slope);
+}
+
+static inline calc_dual_t calc_dual_step_le(calc_dual_t x, float threshold, calc_dual_t a, calc_dual_t b)
+{
+    return (x.v <= threshold) ? a : b;
+}
+
+/* Recopie valeur et gradient dans une ligne de la table de sensibilités. */
+static inline void calc_dual_to_sensitivity(calc_sensitivity_t *s, const char *name, calc_dual_t a)
+{
+    if (s->output_count >= CALC_SENS_MAX_OUTPUTS) {
+        return;
+    }
+    const uint8_t row = s->output_count++;
+    s->output_names[row] = name;
+    s->output_values[row] = a.v;
+    for (size_t i = 0; i < CALC_DUAL_VARS; ++i) {
+        s->partial[row][i] = a.d[i];
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
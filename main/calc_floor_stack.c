@@ -0,0 +1,185 @@
+#include "calc_floor_stack.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#endif
+
+#define K_AIR 0.026f          // W/m/K, air immobile
+#define K_INSULATION 0.035f   // PSE
+#define H_RADIATION_GAP 5.0f  // rayonnement entre faces d'une lame d'air (ε≈0,9, ~40 °C)
+#define H_SURFACE_UP 11.0f    // convection naturelle face chaude vers le haut (~5) + rayonnement (~6)
+#define H_BELOW 6.0f          // dessous du meuble, échange plus confiné
+#define PAD_TEMP_MAX_C 60.0f
+#define BURROW_TEMP_MAX_C 40.0f
+
+typedef struct {
+    float conductivity_w_mk;
+    float default_thickness_mm;
+} floor_layer_t;
+
+static floor_layer_t floor_layer_for_material(terrarium_material_t m)
+{
+    switch (m) {
+    case TERRARIUM_MATERIAL_WOOD:
+        return (floor_layer_t){.conductivity_w_mk = 0.13f, .default_thickness_mm = 12.0f}; // contreplaqué / OSB
+    case TERRARIUM_MATERIAL_GLASS:
+        return (floor_layer_t){.conductivity_w_mk = 1.0f, .default_thickness_mm = 5.0f};
+    case TERRARIUM_MATERIAL_PVC:
+        return (floor_layer_t){.conductivity_w_mk = 0.08f, .default_thickness_mm = 10.0f}; // PVC expansé
+    case TERRARIUM_MATERIAL_ACRYLIC:
+        return (floor_layer_t){.conductivity_w_mk = 0.19f, .default_thickness_mm = 5.0f};
+    default:
+        return (floor_layer_t){.conductivity_w_mk = 0.2f, .default_thickness_mm = 8.0f};
+    }
+}
+
+// Conductivités à humidité d'usage (terreau humide conduit bien, fibre de coco sèche isole)
+static float substrate_conductivity(substrate_type_t t)
+{
+    switch (t) {
+    case SUBSTRATE_SOIL:
+        return 0.50f;
+    case SUBSTRATE_COCO:
+        return 0.10f;
+    case SUBSTRATE_FOREST_BLEND:
+        return 0.30f;
+    case SUBSTRATE_SAND:
+        return 0.30f; // sable sec
+    case SUBSTRATE_SAND_SOIL:
+        return 0.45f;
+    default:
+        return 0.30f;
+    }
+}
+
+void floor_stack_apply_substrate(floor_stack_input_t *stack, const substrate_input_t *substrate)
+{
+    if (!stack || !substrate) {
+        return;
+    }
+    stack->substrate = substrate->type;
+    stack->substrate_thickness_cm = substrate->substrate_height_cm;
+}
+
+// Couche conductrice entre z1 et z2 (m) au-dessus d'un tapis de côté a (m),
+// rapportée à la surface du tapis ; a = 0 : couche plane classique e/k.
+static float spread_resistance(float a, float z1, float z2, float k)
+{
+    if (a <= 0.0f) {
+        return (z2 - z1) / k;
+    }
+    return a * a / (2.0f * k) * (1.0f / (a + 2.0f * z1) - 1.0f / (a + 2.0f * z2));
+}
+
+bool floor_stack_calculate(const floor_stack_input_t *in, floor_stack_result_t *out)
+{
+    if (!in || !out) {
+        return false;
+    }
+    if (in->power_density_w_per_cm2 < 0.0f || in->air_gap_mm < 0.0f || in->substrate_thickness_cm < 0.0f ||
+        in->below_insulation_cm < 0.0f || in->floor_thickness_mm < 0.0f) {
+        return false;
+    }
+
+    floor_stack_result_t r = {0};
+    const floor_layer_t floor = floor_layer_for_material(in->floor_material);
+    const float floor_mm = (in->floor_thickness_mm > 0.0f) ? in->floor_thickness_mm : floor.default_thickness_mm;
+
+    // Résistances surfaciques (m²·K/W) : e/k pour les couches, 1/h pour les échanges
+    r.r_air_gap_m2k_w = (in->air_gap_mm > 0.0f) ? 1.0f / (K_AIR / (in->air_gap_mm * 1e-3f) + H_RADIATION_GAP) : 0.0f;
+    const float a = fmaxf(in->pad_side_cm, 0.0f) * 1e-2f;
+    const float z_floor = floor_mm * 1e-3f;
+    const float z_top = z_floor + in->substrate_thickness_cm * 1e-2f;
+    r.r_floor_m2k_w = spread_resistance(a, 0.0f, z_floor, floor.conductivity_w_mk);
+    r.r_substrate_m2k_w = spread_resistance(a, z_floor, z_top, substrate_conductivity(in->substrate));
+    const float spot = (a > 0.0f) ? a + 2.0f * z_top : 0.0f;
+    r.surface_spot_cm = spot * 100.0f;
+    r.r_surface_m2k_w = (a > 0.0f) ? (a * a) / (spot * spot) / H_SURFACE_UP : 1.0f / H_SURFACE_UP;
+    r.r_below_m2k_w = in->below_insulation_cm * 1e-2f / K_INSULATION + 1.0f / H_BELOW;
+
+    const float r_up = r.r_air_gap_m2k_w + r.r_floor_m2k_w + r.r_substrate_m2k_w + r.r_surface_m2k_w;
+    const float r_down = r.r_below_m2k_w;
+    const float q = in->power_density_w_per_cm2 * 1e4f; // W/m²
+
+    // Nœud tapis : q = (Tp - Tair)/Rup + (Tp - Troom)/Rdown
+    const float g_up = 1.0f / r_up;
+    const float g_down = 1.0f / r_down;
+    r.pad_temp_c = (q + in->enclosure_air_c * g_up + in->room_air_c * g_down) / (g_up + g_down);
+    const float q_up = (r.pad_temp_c - in->enclosure_air_c) * g_up;
+    r.upward_fraction = (q > 0.0f) ? q_up / q : 0.0f;
+    r.floor_top_temp_c = r.pad_temp_c - q_up * (r.r_air_gap_m2k_w + r.r_floor_m2k_w);
+    r.surface_temp_c = in->enclosure_air_c + q_up * r.r_surface_m2k_w;
+
+    r.valid = true;
+    r.warning_pad_hot = r.pad_temp_c > PAD_TEMP_MAX_C;
+    r.warning_burrow_hot = r.floor_top_temp_c > BURROW_TEMP_MAX_C;
+    r.warning_surface_weak = (r.surface_temp_c - in->enclosure_air_c) < 2.0f;
+    *out = r;
+    return true;
+}
+
+static uint32_t now_us(void)
+{
+#ifdef ESP_PLATFORM
+    return (uint32_t)esp_timer_get_time();
+#else
+    return (uint32_t)((uint64_t)clock() * 1000000u / CLOCKS_PER_SEC);
+#endif
+}
+
+static void log_case(const char *label, const floor_stack_input_t *in)
+{
+    floor_stack_result_t out = {0};
+    if (floor_stack_calculate(in, &out)) {
+        printf("[TEST plancher %s] tapis %.1f °C, plancher %.1f °C, surface %.1f °C (%.0f %% vers le haut)%s%s%s\n",
+               label,
+               out.pad_temp_c,
+               out.floor_top_temp_c,
+               out.surface_temp_c,
+               out.upward_fraction * 100.0f,
+               out.warning_pad_hot ? " TAPIS>60°C" : "",
+               out.warning_burrow_hot ? " terrier>40°C" : "",
+               out.warning_surface_weak ? " surface peu chauffée" : "");
+    }
+}
+
+void floor_stack_run_self_test(void)
+{
+    const floor_stack_input_t bare_glass = {
+        .power_density_w_per_cm2 = 0.04f,
+        .pad_side_cm = 28.0f,
+        .floor_material = TERRARIUM_MATERIAL_GLASS,
+        .substrate = SUBSTRATE_SAND,
+        .substrate_thickness_cm = 0.0f,
+        .below_insulation_cm = 1.0f,
+        .enclosure_air_c = 26.0f,
+        .room_air_c = 21.0f,
+    };
+    floor_stack_input_t sand = bare_glass;
+    sand.substrate_thickness_cm = 8.0f;
+    floor_stack_input_t wood_coco = bare_glass;
+    wood_coco.floor_material = TERRARIUM_MATERIAL_WOOD;
+    wood_coco.air_gap_mm = 3.0f;
+    wood_coco.substrate = SUBSTRATE_COCO;
+    wood_coco.substrate_thickness_cm = 10.0f;
+
+    log_case("verre nu", &bare_glass);
+    log_case("verre + 8 cm sable", &sand);
+    log_case("bois décollé + 10 cm coco", &wood_coco);
+
+    const uint32_t runs = 1000;
+    floor_stack_result_t out;
+    volatile float sink = 0.0f;
+    const uint32_t t0 = now_us();
+    for (uint32_t i = 0; i < runs; ++i) {
+        floor_stack_calculate(&sand, &out);
+        sink += out.surface_temp_c;
+    }
+    const uint32_t dt = now_us() - t0;
+    (void)sink;
+    printf("[TEST plancher] %.2f µs par résolution\n", (float)dt / (float)runs);
+}
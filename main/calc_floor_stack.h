@@ -0,0 +1,56 @@
+#pragma once
+
+#include "calc_common.h"
+#include "calc_substrate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Empilement 1D en régime permanent au-dessus d'un tapis chauffant collé sous
+ * le bac : lame d'air éventuelle, plancher, substrat, puis convection +
+ * rayonnement vers l'air du terrarium. Une partie de la puissance repart vers
+ * le bas (isolant sous le tapis, puis air de la pièce).
+ * La chaleur s'étale à 45° dans le plancher et le substrat : avec un tapis de
+ * côté a, une couche entre z1 et z2 vaut a²/(2k)·(1/(a+2z1) - 1/(a+2z2))
+ * rapportée à la surface du tapis, toujours en forme close.
+ */
+typedef struct {
+    float power_density_w_per_cm2;
+    float pad_side_cm;             // côté du tapis (étalement à 45°) ; 0 = plan infini
+    terrarium_material_t floor_material;
+    float floor_thickness_mm;      // 0 = épaisseur courante du matériau
+    float air_gap_mm;              // tapis décollé, pieds, cales
+    substrate_type_t substrate;
+    float substrate_thickness_cm;  // 0 = sol nu
+    float below_insulation_cm;     // isolant (PSE) sous le tapis
+    float enclosure_air_c;
+    float room_air_c;
+} floor_stack_input_t;
+
+typedef struct {
+    bool valid;
+    float r_air_gap_m2k_w;
+    float r_floor_m2k_w;
+    float r_substrate_m2k_w;
+    float r_surface_m2k_w;     // convection + rayonnement en surface
+    float r_below_m2k_w;       // isolant + échange sous le meuble
+    float upward_fraction;     // part de la puissance qui chauffe le terrarium
+    float pad_temp_c;
+    float floor_top_temp_c;    // interface plancher / substrat (zone de terrier)
+    float surface_temp_c;      // surface du substrat, moyenne sur la tache chauffée
+    float surface_spot_cm;     // côté de la tache chauffée en surface
+    bool warning_pad_hot;      // > 60 °C : risque pour le tapis et le plancher
+    bool warning_burrow_hot;   // > 40 °C au contact du plancher : brûlure en terrier
+    bool warning_surface_weak; // moins de 2 °C gagnés en surface
+} floor_stack_result_t;
+
+/** Reprend type et épaisseur de substrat saisis dans l'onglet Substrat. */
+void floor_stack_apply_substrate(floor_stack_input_t *stack, const substrate_input_t *substrate);
+bool floor_stack_calculate(const floor_stack_input_t *in, floor_stack_result_t *out);
+void floor_stack_run_self_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,6 +2,16 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#else
+#include <pthread.h>
+#endif
+
+#include "calc_dual.h"
+#include "calc_interval.h"
 
 typedef struct {
     float heated_area_cm2;
@@ -16,6 +26,12 @@ static const calibration_point_t k_calibration[] = {
     {.heated_area_cm2 = 1947.0f, .power_w = 78.0f},
 };
 
+#define CALIBRATION_POINTS (sizeof(k_calibration) / sizeof(k_calibration[0]))
+
+// Puissances recalées sur mesures terrain (calc_calibration), sinon catalogue
+static float s_power_override[CALIBRATION_POINTS];
+static bool s_power_override_valid;
+
 typedef struct {
     float min_density_w_cm2;
     float max_density_w_cm2;
@@ -38,25 +54,15 @@ static material_limits_t limits_for_material(terrarium_material_t m)
     }
 }
 
-static float clampf(float v, float min, float max)
-{
-    if (v < min) {
-        return min;
-    }
-    if (v > max) {
-        return max;
-    }
-    return v;
-}
-
-static float spline_power_for_area(float area_cm2)
+// `slope` (optionnel) reçoit dP/dA pour l'évaluation duale.
+static float spline_power_for_area(float area_cm2, float *slope)
 {
     const size_t n = sizeof(k_calibration) / sizeof(k_calibration[0]);
     float x[n];
     float y[n];
     for (size_t i = 0; i < n; ++i) {
         x[i] = k_calibration[i].heated_area_cm2;
-        y[i] = k_calibration[i].power_w;
+        y[i] = s_power_override_valid ? s_power_override[i] : k_calibration[i].power_w;
     }
 
     float m[n - 1];
@@ -88,9 +94,15 @@ static float spline_power_for_area(float area_cm2)
     }
 
     if (area_cm2 <= x[0]) {
+        if (slope) {
+            *slope = t[0];
+        }
         return y[0] + t[0] * (area_cm2 - x[0]);
     }
     if (area_cm2 >= x[n - 1]) {
+        if (slope) {
+            *slope = t[n - 1];
+        }
         return y[n - 1] + t[n - 1] * (area_cm2 - x[n - 1]);
     }
 
@@ -109,72 +121,424 @@ static float spline_power_for_area(float area_cm2)
     const float h01 = (-2.0f * s * s * s) + (3.0f * s * s);
     const float h11 = (s * s * s) - (s * s);
 
+    if (slope) {
+        const float d00 = (6.0f * s * s) - (6.0f * s);
+        const float d10 = (3.0f * s * s) - (4.0f * s) + 1.0f;
+        const float d01 = (-6.0f * s * s) + (6.0f * s);
+        const float d11 = (3.0f * s * s) - (2.0f * s);
+        *slope = ((d00 * y[idx]) + (d10 * h * t[idx]) + (d01 * y[idx + 1]) + (d11 * h * t[idx + 1])) / h;
+    }
+
     return (h00 * y[idx]) + (h10 * h * t[idx]) + (h01 * y[idx + 1]) + (h11 * h * t[idx + 1]);
 }
 
+#define CALC_SCALAR_MODE CALC_SCALAR_FLOAT
+#include "calc_heating_cable_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_DUAL
+#include "calc_heating_cable_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_INTERVAL
+#include "calc_heating_cable_kernel.inc"
+#undef CALC_SCALAR_MODE
+
+static bool inputs_valid(const heating_cable_input_t *in)
+{
+    return in && in->length_cm >= 10.0f && in->depth_cm >= 10.0f && in->power_linear_w_per_m > 0.0f;
+}
+
+size_t heating_cable_calibration_points(float *area_cm2, float *power_w, size_t max)
+{
+    const size_t n = (max < CALIBRATION_POINTS) ? max : CALIBRATION_POINTS;
+    for (size_t i = 0; i < n; ++i) {
+        if (area_cm2) {
+            area_cm2[i] = k_calibration[i].heated_area_cm2;
+        }
+        if (power_w) {
+            power_w[i] = k_calibration[i].power_w;
+        }
+    }
+    return CALIBRATION_POINTS;
+}
+
+void heating_cable_set_calibration(const float *power_w, size_t count)
+{
+    if (!power_w || count != CALIBRATION_POINTS) {
+        s_power_override_valid = false;
+        return;
+    }
+    // la spline doit rester croissante (CS_MONO en mode intervalle)
+    float floor_w = 0.1f;
+    for (size_t i = 0; i < CALIBRATION_POINTS; ++i) {
+        floor_w = fmaxf(power_w[i], floor_w);
+        s_power_override[i] = floor_w;
+    }
+    s_power_override_valid = true;
+}
+
 bool heating_cable_calculate(const heating_cable_input_t *in, heating_cable_result_t *out)
 {
     if (!in || !out) {
         return false;
     }
-    if (in->length_cm < 10.0f || in->depth_cm < 10.0f || in->power_linear_w_per_m <= 0.0f) {
+    if (!inputs_valid(in)) {
         return false;
     }
 
     heating_cable_result_t r = {0};
-    const float ratio = clampf(in->heated_ratio, 0.25f, 0.6f);
-    const float heated_area = in->length_cm * in->depth_cm * ratio;
     const material_limits_t limits = limits_for_material(in->material);
+    const cable_vars_f v = {
+        .length_cm = in->length_cm,
+        .depth_cm = in->depth_cm,
+        .heated_ratio = in->heated_ratio,
+        .power_linear_w_per_m = in->power_linear_w_per_m,
+        .supply_voltage_v = in->supply_voltage_v,
+        .target_power_density_w_per_cm2 = in->target_power_density_w_per_cm2,
+        .spacing_cm = in->spacing_cm,
+    };
+    cable_out_f k;
+    cable_kernel_f(&limits, &v, &k);
 
-    const float power_catalog = spline_power_for_area(heated_area);
-    const float density_catalog = clampf(power_catalog / heated_area, limits.min_density_w_cm2, limits.max_density_w_cm2);
-
-    const float spacing = clampf(in->spacing_cm > 0.0f ? in->spacing_cm : 4.0f, 2.0f, 12.0f);
-
-    const float target_density_requested = (in->target_power_density_w_per_cm2 > 0.0f)
-                                               ? in->target_power_density_w_per_cm2
-                                               : density_catalog * limits.material_coeff;
-    const float target_density = clampf(target_density_requested, limits.min_density_w_cm2, limits.max_density_w_cm2);
-
-    const float target_power = heated_area * target_density;
-    const float length_from_power_m = target_power / in->power_linear_w_per_m;
-    const float length_from_geometry_m = heated_area / (spacing * 100.0f);
-    const float length_m = fmaxf(length_from_power_m, length_from_geometry_m);
-
-    const float resulting_density = (in->power_linear_w_per_m * length_m) / heated_area;
-
-    const float r_per_m = (in->supply_voltage_v > 0.0f)
-                              ? ((in->supply_voltage_v * in->supply_voltage_v) / in->power_linear_w_per_m)
-                              : 0.0f;
-    const float resistance = (r_per_m > 0.0f) ? r_per_m * length_m : 0.0f;
-    const float current = (resistance > 0.0f && in->supply_voltage_v > 0.0f) ? in->supply_voltage_v / resistance : 0.0f;
+    const float resulting_density = k.resulting_density_w_per_cm2;
 
     r.valid = true;
-    r.heated_area_cm2 = heated_area;
-    r.target_power_w = target_power;
-    r.recommended_length_m = length_m;
+    r.heated_area_cm2 = k.heated_area_cm2;
+    r.target_power_w = k.target_power_w;
+    r.recommended_length_m = k.length_m;
     r.resulting_density_w_per_cm2 = resulting_density;
-    r.spacing_cm = spacing;
-    r.estimated_resistance_ohm = resistance;
-    r.estimated_current_a = current;
+    r.spacing_cm = k.spacing_cm;
+    r.estimated_resistance_ohm = k.resistance_ohm;
+    r.estimated_current_a = k.current_a;
     r.warning_density_high = resulting_density > limits.max_density_w_cm2 * 0.9f;
     r.warning_density_over = resulting_density > limits.max_density_w_cm2;
-    r.warning_spacing_too_tight = spacing < 3.0f;
+    r.warning_spacing_too_tight = k.spacing_cm < 3.0f;
     r.warning_high_voltage = in->supply_voltage_v >= 220.0f;
 
     *out = r;
     return true;
 }
 
+bool heating_cable_sensitivity(const heating_cable_input_t *in, calc_sensitivity_t *out)
+{
+    if (!out || !inputs_valid(in)) {
+        return false;
+    }
+
+    const material_limits_t limits = limits_for_material(in->material);
+    const cable_vars_d v = {
+        .length_cm = calc_dual_var(in->length_cm, 0),
+        .depth_cm = calc_dual_var(in->depth_cm, 1),
+        .heated_ratio = calc_dual_var(in->heated_ratio, 2),
+        .power_linear_w_per_m = calc_dual_var(in->power_linear_w_per_m, 3),
+        .supply_voltage_v = calc_dual_var(in->supply_voltage_v, 4),
+        .target_power_density_w_per_cm2 = calc_dual_var(in->target_power_density_w_per_cm2, 5),
+        .spacing_cm = calc_dual_var(in->spacing_cm, 6),
+    };
+    cable_out_d k;
+    cable_kernel_d(&limits, &v, &k);
+
+    calc_sensitivity_t s = {
+        .valid = true,
+        .input_count = 7,
+        .input_names = {"Longueur (cm)",
+                        "Profondeur (cm)",
+                        "Ratio chauffé",
+                        "Puissance linéique (W/m)",
+                        "Tension (V)",
+                        "Densité cible (W/cm²)",
+                        "Espacement (cm)"},
+        .input_values = {in->length_cm,
+                         in->depth_cm,
+                         in->heated_ratio,
+                         in->power_linear_w_per_m,
+                         in->supply_voltage_v,
+                         in->target_power_density_w_per_cm2,
+                         in->spacing_cm},
+    };
+    calc_dual_to_sensitivity(&s, "Longueur câble (m)", k.length_m);
+    calc_dual_to_sensitivity(&s, "Puissance cible (W)", k.target_power_w);
+    calc_dual_to_sensitivity(&s, "Densité obtenue (W/cm²)", k.resulting_density_w_per_cm2);
+    if (k.current_a.v > 0.0f) {
+        calc_dual_to_sensitivity(&s, "Courant (A)", k.current_a);
+    }
+    *out = s;
+    return true;
+}
+
+void heating_cable_default_tolerance(const heating_cable_input_t *in, heating_cable_input_t *tol)
+{
+    const heating_cable_input_t t = {
+        .length_cm = CALC_TOL_TAPE_CM,
+        .depth_cm = CALC_TOL_TAPE_CM,
+        .material = in ? in->material : TERRARIUM_MATERIAL_GLASS,
+        .heated_ratio = 0.02f,
+        .power_linear_w_per_m = in ? in->power_linear_w_per_m * CALC_TOL_PRODUCT_REL : 0.0f,
+        .supply_voltage_v = in ? in->supply_voltage_v * CALC_TOL_SUPPLY_REL : 0.0f,
+        .target_power_density_w_per_cm2 = 0.0f,
+        .spacing_cm = CALC_TOL_TAPE_CM,
+    };
+    *tol = t;
+}
+
+bool heating_cable_bounds(const heating_cable_input_t *in, const heating_cable_input_t *tol, calc_bounds_t *out)
+{
+    if (!out || !tol || !inputs_valid(in)) {
+        return false;
+    }
+
+    const material_limits_t limits = limits_for_material(in->material);
+    const cable_vars_i v = {
+        .length_cm = calc_interval_around(in->length_cm, tol->length_cm),
+        .depth_cm = calc_interval_around(in->depth_cm, tol->depth_cm),
+        .heated_ratio = calc_interval_around(in->heated_ratio, tol->heated_ratio),
+        .power_linear_w_per_m = calc_interval_around(in->power_linear_w_per_m, tol->power_linear_w_per_m),
+        .supply_voltage_v = calc_interval_around(in->supply_voltage_v, tol->supply_voltage_v),
+        .target_power_density_w_per_cm2 =
+            calc_interval_around(in->target_power_density_w_per_cm2, tol->target_power_density_w_per_cm2),
+        .spacing_cm = calc_interval_around(in->spacing_cm, tol->spacing_cm),
+    };
+    cable_out_i k;
+    cable_kernel_i(&limits, &v, &k);
+
+    calc_bounds_t b = {.valid = true};
+    calc_interval_to_bounds(&b, "Longueur câble (m)", k.length_m);
+    calc_interval_to_bounds(&b, "Puissance cible (W)", k.target_power_w);
+    calc_interval_to_bounds(&b, "Densité obtenue (W/cm²)", k.resulting_density_w_per_cm2);
+    if (in->supply_voltage_v > 0.0f) {
+        calc_interval_to_bounds(&b, "Courant (A)", k.current_a);
+    }
+    *out = b;
+    return true;
+}
+
+void heating_cable_plan_defaults(const heating_cable_input_t *in,
+                                 const heating_cable_result_t *res,
+                                 cable_plan_input_t *plan)
+{
+    static const float k_lengths_m[] = {0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 5.0f};
+
+    memset(plan, 0, sizeof(*plan));
+    plan->target_power_w = res ? res->target_power_w : 0.0f;
+    plan->min_length_m = res ? res->recommended_length_m : 0.0f;
+    // Ω/m déduit de la puissance linéique annoncée à la tension saisie
+    const float v = (in && in->supply_voltage_v > 0.0f) ? in->supply_voltage_v : 12.0f;
+    plan->ohm_per_m_20c = (in && in->power_linear_w_per_m > 0.0f) ? v * v / in->power_linear_w_per_m : 0.0f;
+    plan->alpha_per_c = 0.0004f;
+    plan->operating_temp_c = 45.0f;
+    plan->cable_max_current_a = 3.0f;
+    plan->supply_max_current_a = 5.0f;
+    plan->tolerance_rel = 0.10f;
+    plan->length_count = (uint8_t)(sizeof(k_lengths_m) / sizeof(k_lengths_m[0]));
+    memcpy(plan->lengths_m, k_lengths_m, sizeof(k_lengths_m));
+}
+
+typedef struct {
+    const cable_plan_input_t *in;
+    float voltage_v;
+    float ohm_hot_per_m;
+    float ohm_cold_per_m;
+    uint8_t pieces[CABLE_PLAN_MAX_SERIES];
+    cable_plan_result_t *out;
+} plan_search_t;
+
+static float plan_score(const cable_plan_t *p)
+{
+    // écart de puissance, manque de longueur posée, puis simplicité de câblage
+    return p->error_rel + (p->within_tolerance ? 0.0f : 1.0f) + 0.01f * (float)(p->series_count * p->parallel_count);
+}
+
+static void plan_insert(cable_plan_result_t *out, const cable_plan_t *p)
+{
+    const float score = plan_score(p);
+    uint8_t pos = out->plan_count;
+    while (pos > 0 && plan_score(&out->plans[pos - 1]) > score) {
+        --pos;
+    }
+    if (pos >= CABLE_PLAN_TOP) {
+        return;
+    }
+    const uint8_t last = (out->plan_count < CABLE_PLAN_TOP) ? out->plan_count : CABLE_PLAN_TOP - 1;
+    for (uint8_t i = last; i > pos; --i) {
+        out->plans[i] = out->plans[i - 1];
+    }
+    out->plans[pos] = *p;
+    if (out->plan_count < CABLE_PLAN_TOP) {
+        out->plan_count++;
+    }
+}
+
+static void plan_try(plan_search_t *s, uint8_t series, float string_length_m, uint8_t parallel)
+{
+    const cable_plan_input_t *in = s->in;
+    const float v = s->voltage_v;
+    const float r_string_hot = s->ohm_hot_per_m * string_length_m;
+    const float r_string_cold = s->ohm_cold_per_m * string_length_m;
+    const float i_string = v / fminf(r_string_hot, r_string_cold);
+    const float inrush = (float)parallel * v / r_string_cold;
+
+    s->out->evaluated++;
+    if (i_string > in->cable_max_current_a || fmaxf(inrush, (float)parallel * v / r_string_hot) > in->supply_max_current_a) {
+        return;
+    }
+
+    cable_plan_t p = {0};
+    p.series_count = series;
+    memcpy(p.piece_index, s->pieces, series);
+    p.parallel_count = parallel;
+    p.string_length_m = string_length_m;
+    p.total_length_m = string_length_m * (float)parallel;
+    p.resistance_hot_ohm = r_string_hot / (float)parallel;
+    p.power_w = v * v / p.resistance_hot_ohm;
+    p.current_a = v / p.resistance_hot_ohm;
+    p.inrush_current_a = inrush;
+    p.error_rel = fabsf(p.power_w - in->target_power_w) / in->target_power_w;
+    p.within_tolerance = p.error_rel <= in->tolerance_rel && p.total_length_m >= in->min_length_m * 0.95f;
+    plan_insert(s->out, &p);
+}
+
+// Parcours des multi-ensembles de coupes (indices croissants) : ajouter une
+// coupe ne fait qu'augmenter R, donc si même CABLE_PLAN_MAX_PARALLEL chaînes
+// ne suffisent plus à atteindre la puissance basse, tout le sous-arbre est élagué.
+static void plan_search(plan_search_t *s, uint8_t depth, uint8_t first, float string_length_m)
+{
+    const cable_plan_input_t *in = s->in;
+    for (uint8_t i = first; i < in->length_count; ++i) {
+        const float length = string_length_m + in->lengths_m[i];
+        const float r_hot = s->ohm_hot_per_m * length;
+        const float p_one = s->voltage_v * s->voltage_v / r_hot;
+        if (p_one * CABLE_PLAN_MAX_PARALLEL < in->target_power_w * (1.0f - in->tolerance_rel)) {
+            s->out->pruned++;
+            continue;
+        }
+        s->pieces[depth] = i;
+
+        // nombre de chaînes qui encadre la cible
+        const float ideal = in->target_power_w / p_one;
+        const int lo = (int)floorf(ideal);
+        for (int par = lo; par <= lo + 1; ++par) {
+            if (par >= 1 && par <= CABLE_PLAN_MAX_PARALLEL) {
+                plan_try(s, (uint8_t)(depth + 1), length, (uint8_t)par);
+            }
+        }
+
+        if (depth + 1 < CABLE_PLAN_MAX_SERIES) {
+            plan_search(s, (uint8_t)(depth + 1), i, length);
+        }
+    }
+}
+
+typedef struct {
+    bool used;
+    float voltage_v;
+    cable_plan_input_t in;
+    cable_plan_result_t result;
+} plan_cache_entry_t;
+
+#define PLAN_CACHE_SIZE 4
+static plan_cache_entry_t s_plan_cache[PLAN_CACHE_SIZE];
+static uint8_t s_plan_cache_next;
+
+// Cache partagé entre la tâche LVGL et l'auto-test de démarrage (fils du
+// planificateur sur hôte) ; la recherche elle-même se fait hors verrou
+#ifdef ESP_PLATFORM
+static portMUX_TYPE s_plan_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+#define PLAN_CACHE_LOCK()   portENTER_CRITICAL(&s_plan_cache_lock)
+#define PLAN_CACHE_UNLOCK() portEXIT_CRITICAL(&s_plan_cache_lock)
+#else
+static pthread_mutex_t s_plan_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#define PLAN_CACHE_LOCK()   pthread_mutex_lock(&s_plan_cache_lock)
+#define PLAN_CACHE_UNLOCK() pthread_mutex_unlock(&s_plan_cache_lock)
+#endif
+
+// Clé de cache comparée au memcmp : copie champ par champ dans une structure
+// remise à zéro, pour ne dépendre ni du remplissage de la structure de
+// l'appelant ni des longueurs au-delà de length_count
+static void plan_cache_key(const cable_plan_input_t *in, cable_plan_input_t *key)
+{
+    memset(key, 0, sizeof(*key));
+    key->target_power_w = in->target_power_w;
+    key->min_length_m = in->min_length_m;
+    key->ohm_per_m_20c = in->ohm_per_m_20c;
+    key->alpha_per_c = in->alpha_per_c;
+    key->operating_temp_c = in->operating_temp_c;
+    key->cable_max_current_a = in->cable_max_current_a;
+    key->supply_max_current_a = in->supply_max_current_a;
+    key->tolerance_rel = in->tolerance_rel;
+    key->length_count = in->length_count;
+    for (uint8_t i = 0; i < in->length_count; ++i) {
+        key->lengths_m[i] = in->lengths_m[i];
+    }
+}
+
+bool heating_cable_plan(const cable_plan_input_t *in, float supply_voltage_v, cable_plan_result_t *out)
+{
+    if (!in || !out || supply_voltage_v <= 0.0f || in->target_power_w <= 0.0f || in->ohm_per_m_20c <= 0.0f ||
+        in->length_count == 0 || in->length_count > CABLE_PLAN_MAX_LENGTHS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < in->length_count; ++i) {
+        if (in->lengths_m[i] <= 0.0f) {
+            return false;
+        }
+    }
+
+    cable_plan_input_t key;
+    plan_cache_key(in, &key);
+
+    bool hit = false;
+    PLAN_CACHE_LOCK();
+    for (size_t i = 0; i < PLAN_CACHE_SIZE; ++i) {
+        const plan_cache_entry_t *e = &s_plan_cache[i];
+        if (e->used && e->voltage_v == supply_voltage_v && memcmp(&e->in, &key, sizeof(key)) == 0) {
+            *out = e->result;
+            hit = true;
+            break;
+        }
+    }
+    PLAN_CACHE_UNLOCK();
+    if (hit) {
+        out->from_cache = true;
+        return true;
+    }
+
+    cable_plan_result_t r = {0};
+    r.supply_voltage_v = supply_voltage_v;
+    const float ohm_hot = in->ohm_per_m_20c * (1.0f + in->alpha_per_c * (in->operating_temp_c - 20.0f));
+    plan_search_t s = {
+        .in = in,
+        .voltage_v = supply_voltage_v,
+        .ohm_hot_per_m = fmaxf(ohm_hot, 1e-6f),
+        .ohm_cold_per_m = in->ohm_per_m_20c,
+        .out = &r,
+    };
+    plan_search(&s, 0, 0, 0.0f);
+    r.valid = r.plan_count > 0;
+
+    PLAN_CACHE_LOCK();
+    plan_cache_entry_t *e = &s_plan_cache[s_plan_cache_next];
+    s_plan_cache_next = (uint8_t)((s_plan_cache_next + 1u) % PLAN_CACHE_SIZE);
+    memset(e, 0, sizeof(*e));
+    e->used = true;
+    e->voltage_v = supply_voltage_v;
+    memcpy(&e->in, &key, sizeof(key)); // octets de remplissage compris
+    e->result = r;
+    PLAN_CACHE_UNLOCK();
+
+    *out = r;
+    return true;
+}
+
 static void log_case(const heating_cable_input_t *in)
 {
     heating_cable_result_t out = {0};
-    if (heating_cable_calculate(in, &out)) {
-        printf("[TEST câble] %.0fx%.0f (ratio %.2f) -> %.2f m, %.1f cm esp., %.3f W/cm²%s%s\n",
+    calc_sensitivity_t sens = {0};
+    if (heating_cable_calculate(in, &out) && heating_cable_sensitivity(in, &sens)) {
+        printf("[TEST câble] %.0fx%.0f (ratio %.2f) -> %.2f m (dL/desp=%+.3f m/cm), %.1f cm esp., %.3f W/cm²%s%s\n",
                in->length_cm,
                in->depth_cm,
                in->heated_ratio,
                out.recommended_length_m,
+               sens.partial[0][6],
                out.spacing_cm,
                out.resulting_density_w_per_cm2,
                out.warning_density_over ? " DENSITÉ>max" : (out.warning_density_high ? " densité haute" : ""),
@@ -218,4 +582,47 @@ void heating_cable_run_self_test(void)
     log_case(&nominal);
     log_case(&minimal);
     log_case(&dense);
+
+    heating_cable_input_t tol;
+    heating_cable_default_tolerance(&nominal, &tol);
+    heating_cable_result_t ref = {0};
+    calc_bounds_t b = {0};
+    if (heating_cable_calculate(&nominal, &ref) && heating_cable_bounds(&nominal, &tol, &b)) {
+        const bool inside = ref.recommended_length_m >= b.min[0] && ref.recommended_length_m <= b.max[0];
+        printf("[TEST câble] bornes (±%.1f cm, ±%.0f%% W/m) : %.2f-%.2f m, %.2f-%.2f A %s\n",
+               CALC_TOL_TAPE_CM,
+               CALC_TOL_PRODUCT_REL * 100.0f,
+               b.min[0],
+               b.max[0],
+               b.min[3],
+               b.max[3],
+               inside ? "OK" : "ÉCHEC");
+    }
+
+    cable_plan_input_t plan_in;
+    heating_cable_plan_defaults(&nominal, &ref, &plan_in);
+    plan_in.ohm_per_m_20c = 8.0f; // fil CuNi 8 Ω/m, indépendant de la tension
+    const float voltages[] = {12.0f, 24.0f, 24.0f};
+    for (size_t i = 0; i < sizeof(voltages) / sizeof(voltages[0]); ++i) {
+        cable_plan_result_t plan = {0};
+        if (!heating_cable_plan(&plan_in, voltages[i], &plan) || !plan.valid) {
+            printf("[TEST câble] plan %.0f V : aucune combinaison dans les limites de courant\n", voltages[i]);
+            continue;
+        }
+        const cable_plan_t *best = &plan.plans[0];
+        printf("[TEST câble] plan %.0f V%s : %u chaîne(s) de %u coupe(s) = %.1f m, %.1f W (cible %.1f), %.2f A "
+               "(appel %.2f A), %lu évaluées / %lu élaguées %s\n",
+               voltages[i],
+               plan.from_cache ? " (cache)" : "",
+               best->parallel_count,
+               best->series_count,
+               best->total_length_m,
+               best->power_w,
+               plan_in.target_power_w,
+               best->current_a,
+               best->inrush_current_a,
+               (unsigned long)plan.evaluated,
+               (unsigned long)plan.pruned,
+               best->within_tolerance ? "OK" : "hors tolérance");
+    }
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <stddef.h>
+
 #include "calc_common.h"
+#include "calc_bounds.h"
+#include "calc_sensitivity.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,7 +36,67 @@ typedef struct {
     bool warning_density_over;
 } heating_cable_result_t;
 
+#define CABLE_PLAN_MAX_LENGTHS  8
+#define CABLE_PLAN_MAX_SERIES   4
+#define CABLE_PLAN_MAX_PARALLEL 8
+#define CABLE_PLAN_TOP          3
+
+/**
+ * Planification série/parallèle : à partir des coupes de câble disponibles,
+ * cherche des chaînes identiques (jusqu'à 4 coupes en série) montées en
+ * parallèle pour approcher la puissance cible sous une tension donnée.
+ */
+typedef struct {
+    float target_power_w;
+    float min_length_m;          // longueur à poser pour couvrir la zone chauffée
+    float ohm_per_m_20c;         // résistance linéique à 20 °C
+    float alpha_per_c;           // coefficient de température (CuNi ≈ 0,0004, cuivre 0,0039, carbone < 0)
+    float operating_temp_c;      // température du fil en régime
+    float cable_max_current_a;   // courant admissible par chaîne
+    float supply_max_current_a;  // limite de l'alimentation (appel à froid inclus)
+    float tolerance_rel;         // écart de puissance accepté
+    uint8_t length_count;
+    float lengths_m[CABLE_PLAN_MAX_LENGTHS];
+} cable_plan_input_t;
+
+typedef struct {
+    uint8_t series_count;
+    uint8_t piece_index[CABLE_PLAN_MAX_SERIES]; // indices dans lengths_m
+    uint8_t parallel_count;
+    float string_length_m;
+    float total_length_m;
+    float resistance_hot_ohm;   // résistance équivalente en régime
+    float power_w;              // puissance en régime
+    float current_a;            // courant total en régime
+    float inrush_current_a;     // courant total à froid (20 °C)
+    float error_rel;
+    bool within_tolerance;
+} cable_plan_t;
+
+typedef struct {
+    bool valid;
+    bool from_cache;
+    float supply_voltage_v;
+    uint8_t plan_count;
+    cable_plan_t plans[CABLE_PLAN_TOP]; // triés, meilleur en premier
+    uint32_t evaluated;
+    uint32_t pruned;
+} cable_plan_result_t;
+
 bool heating_cable_calculate(const heating_cable_input_t *in, heating_cable_result_t *out);
+bool heating_cable_sensitivity(const heating_cable_input_t *in, calc_sensitivity_t *out);
+void heating_cable_default_tolerance(const heating_cable_input_t *in, heating_cable_input_t *tol);
+bool heating_cable_bounds(const heating_cable_input_t *in, const heating_cable_input_t *tol, calc_bounds_t *out);
+/** Entrée de planification déduite d'un calcul (puissance cible, longueur, Ω/m). */
+void heating_cable_plan_defaults(const heating_cable_input_t *in,
+                                 const heating_cable_result_t *res,
+                                 cable_plan_input_t *plan);
+/** Résultats mis en cache par tension (12/24 V...) tant que l'entrée ne change pas. */
+bool heating_cable_plan(const cable_plan_input_t *in, float supply_voltage_v, cable_plan_result_t *out);
+/** Points catalogue (surface chauffée -> puissance) servant de nœuds à la spline. */
+size_t heating_cable_calibration_points(float *area_cm2, float *power_w, size_t max);
+/** Remplace les puissances des nœuds (rendues croissantes) ; NULL revient au catalogue. */
+void heating_cable_set_calibration(const float *power_w, size_t count);
 void heating_cable_run_self_test(void);
 
 #ifdef __cplusplus
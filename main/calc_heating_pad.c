@@ -3,6 +3,10 @@
 #include <math.h>
 #include <stdio.h>
 
+#include "calc_dual.h"
+#include "calc_interval.h"
+#include "calc_solve.h"
+
 typedef struct {
     float heated_area_cm2;
     float power_w;
@@ -18,6 +22,12 @@ static const calibration_point_t k_calibration[] = {
     {.heated_area_cm2 = 1947.0f, .power_w = 78.0f},
 };
 
+#define CALIBRATION_POINTS (sizeof(k_calibration) / sizeof(k_calibration[0]))
+
+// Puissances recalées sur mesures terrain (calc_calibration), sinon catalogue
+static float s_power_override[CALIBRATION_POINTS];
+static bool s_power_override_valid;
+
 typedef struct {
     float min_density_w_cm2;
     float max_density_w_cm2;
@@ -40,26 +50,16 @@ static material_limits_t limits_for_material(terrarium_material_t m)
     }
 }
 
-static float clampf(float v, float min, float max)
-{
-    if (v < min) {
-        return min;
-    }
-    if (v > max) {
-        return max;
-    }
-    return v;
-}
-
-// Spline Hermite monotone (Fritsch-Carlson) sur les 5 points catalogue
-static float spline_power_for_area(float area_cm2)
+// Spline Hermite monotone (Fritsch-Carlson) sur les 5 points catalogue.
+// `slope` (optionnel) reçoit dP/dA pour l'évaluation duale.
+static float spline_power_for_area(float area_cm2, float *slope)
 {
     const size_t n = sizeof(k_calibration) / sizeof(k_calibration[0]);
     float x[n];
     float y[n];
     for (size_t i = 0; i < n; ++i) {
         x[i] = k_calibration[i].heated_area_cm2;
-        y[i] = k_calibration[i].power_w;
+        y[i] = s_power_override_valid ? s_power_override[i] : k_calibration[i].power_w;
     }
 
     float m[n - 1];
@@ -91,9 +91,15 @@ static float spline_power_for_area(float area_cm2)
     }
 
     if (area_cm2 <= x[0]) {
+        if (slope) {
+            *slope = t[0];
+        }
         return y[0] + t[0] * (area_cm2 - x[0]);
     }
     if (area_cm2 >= x[n - 1]) {
+        if (slope) {
+            *slope = t[n - 1];
+        }
         return y[n - 1] + t[n - 1] * (area_cm2 - x[n - 1]);
     }
 
@@ -112,11 +118,22 @@ static float spline_power_for_area(float area_cm2)
     const float h01 = (-2.0f * s * s * s) + (3.0f * s * s);
     const float h11 = (s * s * s) - (s * s);
 
+    if (slope) {
+        const float d00 = (6.0f * s * s) - (6.0f * s);
+        const float d10 = (3.0f * s * s) - (4.0f * s) + 1.0f;
+        const float d01 = (-6.0f * s * s) + (6.0f * s);
+        const float d11 = (3.0f * s * s) - (2.0f * s);
+        *slope = ((d00 * y[idx]) + (d10 * h * t[idx]) + (d01 * y[idx + 1]) + (d11 * h * t[idx + 1])) / h;
+    }
+
     return (h00 * y[idx]) + (h10 * h * t[idx]) + (h01 * y[idx + 1]) + (h11 * h * t[idx + 1]);
 }
 
-static float round_catalog_power(float p)
+static float round_catalog_power(float p, float *slope)
 {
+    if (slope) {
+        *slope = 0.0f; // marches d'escalier du catalogue
+    }
     const float steps[] = {5, 7.5f, 10, 12.5f, 15, 20, 25, 30, 35, 40, 50, 60, 78, 100};
     const size_t n = sizeof(steps) / sizeof(steps[0]);
     for (size_t i = 0; i < n; ++i) {
@@ -127,47 +144,91 @@ static float round_catalog_power(float p)
     return ceilf(p / 25.0f) * 25.0f;
 }
 
+static float round_half_cm(float v, float *slope)
+{
+    if (slope) {
+        *slope = 0.0f;
+    }
+    return roundf(v * 2.0f) / 2.0f;
+}
+
+#define CALC_SCALAR_MODE CALC_SCALAR_FLOAT
+#include "calc_heating_pad_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_DUAL
+#include "calc_heating_pad_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_INTERVAL
+#include "calc_heating_pad_kernel.inc"
+#undef CALC_SCALAR_MODE
+
+static bool inputs_valid(const heating_pad_input_t *in)
+{
+    return in && in->length_cm >= 5.0f && in->depth_cm >= 5.0f && in->height_cm > 0.0f;
+}
+
+size_t heating_pad_calibration_points(float *area_cm2, float *power_w, size_t max)
+{
+    const size_t n = (max < CALIBRATION_POINTS) ? max : CALIBRATION_POINTS;
+    for (size_t i = 0; i < n; ++i) {
+        if (area_cm2) {
+            area_cm2[i] = k_calibration[i].heated_area_cm2;
+        }
+        if (power_w) {
+            power_w[i] = k_calibration[i].power_w;
+        }
+    }
+    return CALIBRATION_POINTS;
+}
+
+void heating_pad_set_calibration(const float *power_w, size_t count)
+{
+    if (!power_w || count != CALIBRATION_POINTS) {
+        s_power_override_valid = false;
+        return;
+    }
+    // la spline doit rester croissante (CS_MONO en mode intervalle)
+    float floor_w = 0.1f;
+    for (size_t i = 0; i < CALIBRATION_POINTS; ++i) {
+        floor_w = fmaxf(power_w[i], floor_w);
+        s_power_override[i] = floor_w;
+    }
+    s_power_override_valid = true;
+}
+
 bool heating_pad_calculate(const heating_pad_input_t *in, heating_pad_result_t *out)
 {
     if (!in || !out) {
         return false;
     }
-    if (in->length_cm < 5.0f || in->depth_cm < 5.0f || in->height_cm <= 0.0f) {
+    if (!inputs_valid(in)) {
         return false;
     }
 
     heating_pad_result_t r = {0};
 
-    const float ratio = clampf(in->heated_ratio, 0.2f, 0.6f);
-    const float floor_area = in->length_cm * in->depth_cm;
-    const float heated_area = floor_area * ratio;
-    const float heater_side = sqrtf(heated_area);
-
     const material_limits_t limits = limits_for_material(in->material);
-    const float power_catalog = spline_power_for_area(heated_area);
-    const float density_catalog = clampf(power_catalog / heated_area, limits.min_density_w_cm2, limits.max_density_w_cm2);
-
-    const float height_factor = clampf(in->height_cm / 50.0f, 0.85f, 1.35f);
-    const float density_raw = density_catalog * limits.material_coeff * height_factor;
-    const float density_capped = clampf(density_raw, limits.min_density_w_cm2, limits.max_density_w_cm2);
+    const pad_vars_f v = {
+        .length_cm = in->length_cm,
+        .depth_cm = in->depth_cm,
+        .height_cm = in->height_cm,
+        .heated_ratio = in->heated_ratio,
+    };
+    pad_out_f k;
+    pad_kernel_f(&limits, &v, &k);
 
-    const float power_raw = heated_area * density_capped;
-    const float power_final = round_catalog_power(power_raw);
-    const float voltage = (power_final <= 18.0f) ? 12.0f : 24.0f;
-    const float current = power_final / voltage;
-    const float resistance = (voltage * voltage) / power_final;
-    const float density_final = power_final / heated_area;
+    const float density_final = k.power_density_w_per_cm2;
 
     r.valid = true;
-    r.floor_area_cm2 = floor_area;
-    r.heated_area_cm2 = heated_area;
-    r.heater_side_cm = roundf(heater_side * 2.0f) / 2.0f;
-    r.power_w = power_final;
+    r.floor_area_cm2 = k.floor_area_cm2;
+    r.heated_area_cm2 = k.heated_area_cm2;
+    r.heater_side_cm = k.heater_side_cm;
+    r.power_w = k.power_w;
     r.power_density_w_per_cm2 = density_final;
     r.density_limit_w_per_cm2 = limits.max_density_w_cm2;
-    r.voltage_v = voltage;
-    r.current_a = current;
-    r.resistance_ohm = resistance;
+    r.voltage_v = k.voltage_v;
+    r.current_a = k.current_a;
+    r.resistance_ohm = k.resistance_ohm;
     r.warning_density_high = density_final > limits.max_density_w_cm2 * 0.9f;
     r.warning_density_over = density_final > limits.max_density_w_cm2;
     r.warning_density_near_limit = (density_final > limits.max_density_w_cm2 * 0.95f) ||
@@ -177,18 +238,130 @@ bool heating_pad_calculate(const heating_pad_input_t *in, heating_pad_result_t *
     return true;
 }
 
+typedef struct {
+    heating_pad_input_t base;
+    float aspect; // longueur / profondeur
+    float pad_power_w;
+} pad_area_ctx_t;
+
+static bool pad_fits_area(const void *ctx, float floor_area_cm2)
+{
+    const pad_area_ctx_t *c = ctx;
+    heating_pad_input_t in = c->base;
+    in.length_cm = sqrtf(floor_area_cm2 * c->aspect);
+    in.depth_cm = floor_area_cm2 / in.length_cm;
+    heating_pad_result_t r;
+    return heating_pad_calculate(&in, &r) && r.power_w <= c->pad_power_w;
+}
+
+bool heating_pad_max_floor_area(const heating_pad_input_t *in, float pad_power_w, float *floor_area_cm2)
+{
+    if (!floor_area_cm2 || !inputs_valid(in) || pad_power_w <= 0.0f) {
+        return false;
+    }
+    // la puissance croît avec la surface (spline monotone, densité bornée)
+    const pad_area_ctx_t ctx = {.base = *in, .aspect = in->length_cm / in->depth_cm, .pad_power_w = pad_power_w};
+    const float min_area = 25.0f * fmaxf(ctx.aspect, 1.0f / ctx.aspect); // petit côté ≥ 5 cm
+    return calc_solve_last_true(pad_fits_area, &ctx, min_area, 200000.0f, floor_area_cm2);
+}
+
+static bool pad_density_ok(const void *ctx, float height_cm)
+{
+    heating_pad_input_t in = *(const heating_pad_input_t *)ctx;
+    in.height_cm = height_cm;
+    heating_pad_result_t r;
+    return heating_pad_calculate(&in, &r) && !r.warning_density_over;
+}
+
+bool heating_pad_max_height(const heating_pad_input_t *in, float *height_cm)
+{
+    if (!height_cm || !inputs_valid(in)) {
+        return false;
+    }
+    // au-delà de 67,5 cm le facteur hauteur est saturé : 200 cm = pas de limite
+    return calc_solve_last_true(pad_density_ok, in, 1.0f, 200.0f, height_cm);
+}
+
+bool heating_pad_sensitivity(const heating_pad_input_t *in, calc_sensitivity_t *out)
+{
+    if (!out || !inputs_valid(in)) {
+        return false;
+    }
+
+    const material_limits_t limits = limits_for_material(in->material);
+    const pad_vars_d v = {
+        .length_cm = calc_dual_var(in->length_cm, 0),
+        .depth_cm = calc_dual_var(in->depth_cm, 1),
+        .height_cm = calc_dual_var(in->height_cm, 2),
+        .heated_ratio = calc_dual_var(in->heated_ratio, 3),
+    };
+    pad_out_d k;
+    pad_kernel_d(&limits, &v, &k);
+
+    calc_sensitivity_t s = {
+        .valid = true,
+        .input_count = 4,
+        .input_names = {"Longueur (cm)", "Profondeur (cm)", "Hauteur (cm)", "Ratio chauffé"},
+        .input_values = {in->length_cm, in->depth_cm, in->height_cm, in->heated_ratio},
+    };
+    calc_dual_to_sensitivity(&s, "Surface chauffée (cm²)", k.heated_area_cm2);
+    calc_dual_to_sensitivity(&s, "Puissance brute (W)", k.power_raw_w);
+    calc_dual_to_sensitivity(&s, "Densité finale (W/cm²)", k.power_density_w_per_cm2);
+    *out = s;
+    return true;
+}
+
+void heating_pad_default_tolerance(const heating_pad_input_t *in, heating_pad_input_t *tol)
+{
+    const heating_pad_input_t t = {
+        .length_cm = CALC_TOL_TAPE_CM,
+        .depth_cm = CALC_TOL_TAPE_CM,
+        .height_cm = CALC_TOL_TAPE_CM,
+        .material = in ? in->material : TERRARIUM_MATERIAL_GLASS,
+        .heated_ratio = 0.02f,
+    };
+    *tol = t;
+}
+
+bool heating_pad_bounds(const heating_pad_input_t *in, const heating_pad_input_t *tol, calc_bounds_t *out)
+{
+    if (!out || !tol || !inputs_valid(in)) {
+        return false;
+    }
+
+    const material_limits_t limits = limits_for_material(in->material);
+    const pad_vars_i v = {
+        .length_cm = calc_interval_around(in->length_cm, tol->length_cm),
+        .depth_cm = calc_interval_around(in->depth_cm, tol->depth_cm),
+        .height_cm = calc_interval_around(in->height_cm, tol->height_cm),
+        .heated_ratio = calc_interval_around(in->heated_ratio, tol->heated_ratio),
+    };
+    pad_out_i k;
+    pad_kernel_i(&limits, &v, &k);
+
+    calc_bounds_t b = {.valid = true};
+    calc_interval_to_bounds(&b, "Surface chauffée (cm²)", k.heated_area_cm2);
+    calc_interval_to_bounds(&b, "Puissance catalogue (W)", k.power_w);
+    calc_interval_to_bounds(&b, "Densité finale (W/cm²)", k.power_density_w_per_cm2);
+    calc_interval_to_bounds(&b, "Courant (A)", k.current_a);
+    *out = b;
+    return true;
+}
+
 static void log_case(float l, float p, float h, float ratio, terrarium_material_t m)
 {
     heating_pad_input_t in = {.length_cm = l, .depth_cm = p, .height_cm = h, .material = m, .heated_ratio = ratio};
     heating_pad_result_t out = {0};
-    if (heating_pad_calculate(&in, &out)) {
-        printf("[TEST tapis] %.0fx%.0f -> %.1f cm², %.1f W (%.3f W/cm²) %s\n",
+    calc_sensitivity_t sens = {0};
+    if (heating_pad_calculate(&in, &out) && heating_pad_sensitivity(&in, &sens)) {
+        printf("[TEST tapis] %.0fx%.0f -> %.1f cm², %.1f W (%.3f W/cm²) %s, dPbrute/dL=%.3f W/cm\n",
                l,
                p,
                out.heated_area_cm2,
                out.power_w,
                out.power_density_w_per_cm2,
-               out.warning_density_high ? "ALERTE" : "OK");
+               out.warning_density_high ? "ALERTE" : "OK",
+               sens.partial[1][0]);
     }
 }
 
@@ -201,4 +374,54 @@ void heating_pad_run_self_test(void)
     log_case(60, 45, 45, 0.33f, TERRARIUM_MATERIAL_GLASS);
     log_case(80, 50, 70, 0.6f, TERRARIUM_MATERIAL_WOOD);        // volume haut, ratio chauffé max
     log_case(100, 60, 60, 0.33f, TERRARIUM_MATERIAL_GLASS);
+
+    const heating_pad_input_t nominal = {.length_cm = 60, .depth_cm = 45, .height_cm = 45, .material = TERRARIUM_MATERIAL_GLASS, .heated_ratio = 0.33f};
+    heating_pad_input_t tol;
+    heating_pad_default_tolerance(&nominal, &tol);
+    heating_pad_result_t ref = {0};
+    calc_bounds_t b = {0};
+    if (heating_pad_calculate(&nominal, &ref) && heating_pad_bounds(&nominal, &tol, &b)) {
+        const bool inside = ref.power_density_w_per_cm2 >= b.min[2] && ref.power_density_w_per_cm2 <= b.max[2];
+        printf("[TEST tapis] bornes ±%.1f cm : P %.1f-%.1f W, densité %.4f-%.4f W/cm² %s\n",
+               CALC_TOL_TAPE_CM,
+               b.min[1],
+               b.max[1],
+               b.min[2],
+               b.max[2],
+               inside ? "OK" : "ÉCHEC");
+    }
+
+    // Inverse : surface max pour un tapis 15 W, puis hauteur max sous la limite
+    float area = 0.0f;
+    if (heating_pad_max_floor_area(&nominal, 15.0f, &area)) {
+        const float scale = sqrtf(area / (nominal.length_cm * nominal.depth_cm));
+        heating_pad_input_t at = nominal;
+        at.length_cm *= scale;
+        at.depth_cm *= scale;
+        heating_pad_input_t beyond = at;
+        beyond.length_cm *= 1.01f;
+        beyond.depth_cm *= 1.01f;
+        heating_pad_result_t r_at = {0};
+        heating_pad_result_t r_beyond = {0};
+        heating_pad_calculate(&at, &r_at);
+        heating_pad_calculate(&beyond, &r_beyond);
+        printf("[TEST tapis] inverse : tapis 15 W -> sol max %.0f cm² (%.0f×%.0f cm), +1 %% -> %.1f W %s\n",
+               area,
+               at.length_cm,
+               at.depth_cm,
+               r_beyond.power_w,
+               (r_at.power_w <= 15.0f && r_beyond.power_w > 15.0f) ? "OK" : "ÉCHEC");
+    }
+
+    const heating_pad_input_t acrylic = {.length_cm = 30, .depth_cm = 30, .height_cm = 30, .material = TERRARIUM_MATERIAL_ACRYLIC, .heated_ratio = 0.6f};
+    float max_h = 0.0f;
+    if (heating_pad_max_height(&acrylic, &max_h)) {
+        heating_pad_input_t above = acrylic;
+        above.height_cm = max_h + 1.0f;
+        heating_pad_result_t r_above = {0};
+        heating_pad_calculate(&above, &r_above);
+        printf("[TEST tapis] inverse : acrylique 30×30, ratio 0,6 -> hauteur max %.1f cm %s\n",
+               max_h,
+               (max_h >= 200.0f || r_above.warning_density_over) ? "OK" : "ÉCHEC");
+    }
 }
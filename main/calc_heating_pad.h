@@ -1,6 +1,10 @@
 #pragma once
 
+#include <stddef.h>
+
 #include "calc_common.h"
+#include "calc_bounds.h"
+#include "calc_sensitivity.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +35,22 @@ typedef struct {
 } heating_pad_result_t;
 
 bool heating_pad_calculate(const heating_pad_input_t *in, heating_pad_result_t *out);
+bool heating_pad_sensitivity(const heating_pad_input_t *in, calc_sensitivity_t *out);
+void heating_pad_default_tolerance(const heating_pad_input_t *in, heating_pad_input_t *tol);
+bool heating_pad_bounds(const heating_pad_input_t *in, const heating_pad_input_t *tol, calc_bounds_t *out);
+/** Points catalogue (surface chauffée -> puissance) servant de nœuds à la spline. */
+size_t heating_pad_calibration_points(float *area_cm2, float *power_w, size_t max);
+/** Remplace les puissances des nœuds (rendues croissantes) ; NULL revient au catalogue. */
+void heating_pad_set_calibration(const float *power_w, size_t count);
+/**
+ * Résolutions inverses (dichotomie bornée, calc_solve.h) :
+ * - plus grande surface au sol, à proportions L/P constantes, qu'un tapis de
+ *   `pad_power_w` couvre sans passer à la puissance catalogue supérieure ;
+ * - hauteur maximale gardant la densité sous la limite matière (toute hauteur
+ *   inférieure convient, la densité croît avec la hauteur).
+ */
+bool heating_pad_max_floor_area(const heating_pad_input_t *in, float pad_power_w, float *floor_area_cm2);
+bool heating_pad_max_height(const heating_pad_input_t *in, float *height_cm);
 void heating_pad_run_self_test(void);
 
 #ifdef __cplusplus
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <math.h>
+#include <stdbool.h>
+
+#include "calc_bounds.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Intervalle fermé [lo, hi] en float. Chaque opération arrondit ses bornes
+ * vers l'extérieur (nextafterf) pour que l'encadrement reste garanti malgré
+ * les arrondis au plus proche du FPU.
+ */
+typedef struct {
+    float lo;
+    float hi;
+} calc_interval_t;
+
+typedef float (*calc_interval_mono_fn_t)(float x, float *slope);
+typedef float (*calc_interval_mono_ctx_fn_t)(const void *ctx, float x, float *slope);
+
+static inline calc_interval_t calc_interval_widen(float lo, float hi)
+{
+    calc_interval_t r = {.lo = nextafterf(lo, -INFINITY), .hi = nextafterf(hi, INFINITY)};
+    return r;
+}
+
+static inline calc_interval_t calc_interval_const(float v)
+{
+    calc_interval_t r = {.lo = v, .hi = v};
+    return r;
+}
+
+static inline calc_interval_t calc_interval_around(float v, float tol)
+{
+    const float t = fabsf(tol);
+    if (t == 0.0f) {
+        return calc_interval_const(v);
+    }
+    return calc_interval_widen(v - t, v + t);
+}
+
+static inline calc_interval_t calc_interval_entire(void)
+{
+    calc_interval_t r = {.lo = -INFINITY, .hi = INFINITY};
+    return r;
+}
+
+static inline float calc_interval_mid(calc_interval_t a)
+{
+    return 0.5f * (a.lo + a.hi);
+}
+
+static inline calc_interval_t calc_interval_add(calc_interval_t a, calc_interval_t b)
+{
+    return calc_interval_widen(a.lo + b.lo, a.hi + b.hi);
+}
+
+static inline calc_interval_t calc_interval_sub(calc_interval_t a, calc_interval_t b)
+{
+    return calc_interval_widen(a.lo - b.hi, a.hi - b.lo);
+}
+
+static inline calc_interval_t calc_interval_mul(calc_interval_t a, calc_interval_t b)
+{
+    const float p1 = a.lo * b.lo;
+    const float p2 = a.lo * b.hi;
+    const float p3 = a.hi * b.lo;
+    const float p4 = a.hi * b.hi;
+    return calc_interval_widen(fminf(fminf(p1, p2), fminf(p3, p4)), fmaxf(fmaxf(p1, p2), fmaxf(p3, p4)));
+}
+
+static inline calc_interval_t calc_interval_div(calc_interval_t a, calc_interval_t b)
+{
+    if (b.lo <= 0.0f && b.hi >= 0.0f) {
+        return calc_interval_entire(); // diviseur pouvant s'annuler : pas de borne
+    }
+    const float q1 = a.lo / b.lo;
+    const float q2 = a.lo / b.hi;
+    const float q3 = a.hi / b.lo;
+    const float q4 = a.hi / b.hi;
+    return calc_interval_widen(fminf(fminf(q1, q2), fminf(q3, q4)), fmaxf(fmaxf(q1, q2), fmaxf(q3, q4)));
+}
+
+static inline calc_interval_t calc_interval_scale(calc_interval_t a, float k)
+{
+    return (k >= 0.0f) ? calc_interval_widen(a.lo * k, a.hi * k) : calc_interval_widen(a.hi * k, a.lo * k);
+}
+
+static inline calc_interval_t calc_interval_divf(calc_interval_t a, float k)
+{
+    return (k > 0.0f) ? calc_interval_widen(a.lo / k, a.hi / k) : calc_interval_widen(a.hi / k, a.lo / k);
+}
+
+static inline calc_interval_t calc_interval_sqrt(calc_interval_t a)
+{
+    return calc_interval_widen(sqrtf(fmaxf(a.lo, 0.0f)), sqrtf(fmaxf(a.hi, 0.0f)));
+}
+
+// Base positive uniquement (distances) ; powf n'est pas correctement arrondi,
+// d'où l'élargissement de deux ulp.
+static inline calc_interval_t calc_interval_powf(calc_interval_t a, float exponent)
+{
+    const float lo = powf(fmaxf(a.lo, 0.0f), exponent);
+    const float hi = powf(fmaxf(a.hi, 0.0f), exponent);
+    const calc_interval_t r = (exponent >= 0.0f) ? calc_interval_widen(lo, hi) : calc_interval_widen(hi, lo);
+    return calc_interval_widen(r.lo, r.hi);
+}
+
+static inline calc_interval_t calc_interval_clamp(calc_interval_t a, float min, float max)
+{
+    calc_interval_t r = {
+        .lo = (a.lo < min) ? min : ((a.lo > max) ? max : a.lo),
+        .hi = (a.hi < min) ? min : ((a.hi > max) ? max : a.hi),
+    };
+    return r;
+}
+
+static inline calc_interval_t calc_interval_fmax(calc_interval_t a, float k)
+{
+    calc_interval_t r = {.lo = fmaxf(a.lo, k), .hi = fmaxf(a.hi, k)};
+    return r;
+}
+
+static inline calc_interval_t calc_interval_max(calc_interval_t a, calc_interval_t b)
+{
+    calc_interval_t r = {.lo = fmaxf(a.lo, b.lo), .hi = fmaxf(a.hi, b.hi)};
+    return r;
+}
+
+static inline calc_interval_t calc_interval_hull(calc_interval_t a, calc_interval_t b)
+{
+    calc_interval_t r = {.lo = fminf(a.lo, b.lo), .hi = fmaxf(a.hi, b.hi)};
+    return r;
+}
+
+// Fonction croissante : images des bornes. Les paliers (pente nulle) sont
+// exacts ; les courbes (spline) sont élargies d'un ulp.
+static inline calc_interval_t calc_interval_mono(calc_interval_t a, calc_interval_mono_fn_t fn)
+{
+    float slope_lo = 0.0f;
+    float slope_hi = 0.0f;
+    calc_interval_t r = {.lo = fn(a.lo, &slope_lo), .hi = fn(a.hi, &slope_hi)};
+    if (slope_lo != 0.0f || slope_hi != 0.0f) {
+        r = calc_interval_widen(r.lo, r.hi);
+    }
+    return r;
+}
+
+static inline calc_interval_t calc_interval_mono_ctx(calc_interval_t a, calc_interval_mono_ctx_fn_t fn, const void *ctx)
+{
+    float slope_lo = 0.0f;
+    float slope_hi = 0.0f;
+    calc_interval_t r = {.lo = fn(ctx, a.lo, &slope_lo), .hi = fn(ctx, a.hi, &slope_hi)};
+    if (slope_lo != 0.0f || slope_hi != 0.0f) {
+        r = calc_interval_widen(r.lo, r.hi);
+    }
+    return r;
+}
+
+static inline calc_interval_t calc_interval_step_le(calc_interval_t x, float threshold, calc_interval_t a, calc_interval_t b)
+{
+    if (x.hi <= threshold) {
+        return a;
+    }
+    if (x.lo > threshold) {
+        return b;
+    }
+    return calc_interval_hull(a, b);
+}
+
+static inline void calc_interval_to_bounds(calc_bounds_t *b, const char *name, calc_interval_t a)
+{
+    if (b->output_count >= CALC_BOUNDS_MAX_OUTPUTS) {
+        return;
+    }
+    const uint8_t row = b->output_count++;
+    b->output_names[row] = name;
+    b->min[row] = a.lo;
+    b->max[row] = a.hi;
+}
+
+#ifdef __cplusplus
+}
+#endif
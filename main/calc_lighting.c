@@ -2,6 +2,11 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "calc_dual.h"
+#include "calc_interval.h"
+#include "calc_spectrum.h"
 
 static float clampf(float v, float min, float max)
 {
@@ -71,13 +76,177 @@ static float recommended_distance_for_env(terrarium_environment_t env)
     }
 }
 
-static float project_irradiance(float value_at_ref, float ref_cm, float target_cm)
+// Coefficients d'utilisation précalculés (radiosité 3 surfaces : couvercle
+// ρ=0,2, parois, sol ; LED dirigées ~90°, intensité en cos²θ).
+// Lignes : indice de local K, colonnes : réflectance du sol 0,1 / 0,2 / 0,3.
+#define CU_ROWS 10
+#define CU_COLS 3
+static const float k_cu_room_index[CU_ROWS] = {0.25f, 0.4f, 0.6f, 0.8f, 1.0f, 1.25f, 1.5f, 2.0f, 3.0f, 5.0f};
+static const float k_cu_floor_reflectance[CU_COLS] = {0.1f, 0.2f, 0.3f};
+
+// Verre (et acrylique) : ρ≈0,10, l'essentiel traverse la paroi
+static const float k_cu_glass[CU_ROWS][CU_COLS] = {
+    {0.11f, 0.11f, 0.11f},
+    {0.22f, 0.22f, 0.22f},
+    {0.35f, 0.35f, 0.35f},
+    {0.46f, 0.46f, 0.46f},
+    {0.53f, 0.54f, 0.54f},
+    {0.61f, 0.61f, 0.62f},
+    {0.66f, 0.67f, 0.68f},
+    {0.74f, 0.75f, 0.76f},
+    {0.83f, 0.84f, 0.85f},
+    {0.90f, 0.92f, 0.93f},
+};
+
+// Bois brut/vernis : ρ≈0,35
+static const float k_cu_wood[CU_ROWS][CU_COLS] = {
+    {0.15f, 0.15f, 0.15f},
+    {0.27f, 0.27f, 0.27f},
+    {0.41f, 0.41f, 0.41f},
+    {0.51f, 0.52f, 0.52f},
+    {0.59f, 0.59f, 0.60f},
+    {0.66f, 0.67f, 0.67f},
+    {0.71f, 0.72f, 0.73f},
+    {0.78f, 0.79f, 0.80f},
+    {0.85f, 0.87f, 0.88f},
+    {0.92f, 0.94f, 0.95f},
+};
+
+// PVC expansé blanc : ρ≈0,70
+static const float k_cu_pvc[CU_ROWS][CU_COLS] = {
+    {0.27f, 0.28f, 0.28f},
+    {0.40f, 0.41f, 0.42f},
+    {0.53f, 0.55f, 0.56f},
+    {0.62f, 0.64f, 0.66f},
+    {0.69f, 0.71f, 0.72f},
+    {0.75f, 0.77f, 0.78f},
+    {0.79f, 0.81f, 0.83f},
+    {0.84f, 0.86f, 0.88f},
+    {0.90f, 0.92f, 0.94f},
+    {0.95f, 0.97f, 0.99f},
+};
+
+static const float (*cu_table_for_material(terrarium_material_t m))[CU_COLS]
+{
+    switch (m) {
+    case TERRARIUM_MATERIAL_WOOD:
+        return k_cu_wood;
+    case TERRARIUM_MATERIAL_PVC:
+        return k_cu_pvc;
+    case TERRARIUM_MATERIAL_GLASS:
+    case TERRARIUM_MATERIAL_ACRYLIC:
+    default:
+        return k_cu_glass;
+    }
+}
+
+// Sable clair en désert, terreau et végétation sombres en tropical
+static float floor_reflectance_for_env(terrarium_environment_t env)
+{
+    switch (env) {
+    case TERRARIUM_ENV_DESERTIC:
+        return 0.3f;
+    case TERRARIUM_ENV_TROPICAL:
+        return 0.1f;
+    case TERRARIUM_ENV_TEMPERATE_FOREST:
+    case TERRARIUM_ENV_NOCTURNAL:
+    default:
+        return 0.2f;
+    }
+}
+
+typedef struct {
+    float target_lux;
+    float target_uvi_mid;
+    float target_uva;
+    float base_distance_cm;
+    bool use_height;
+    bool uvb_enabled;
+    bool uva_enabled;
+    const float (*cu_table)[CU_COLS];
+    float floor_reflectance;
+    float maintenance_factor;
+    lighting_falloff_t uvb_falloff;
+    lighting_falloff_t uva_falloff;
+} lighting_ctx_t;
+
+static const lighting_falloff_t k_default_falloff = {.gain = 1.0f, .exponent = 1.9f};
+static lighting_falloff_t s_uvb_falloff = {.gain = 1.0f, .exponent = 1.9f};
+static lighting_falloff_t s_uva_falloff = {.gain = 1.0f, .exponent = 1.9f};
+
+// Lecture bilinéaire (K, réflectance du sol) à coût constant ; croissante en
+// K, donc utilisable en CS_MONO_CTX. K est borné aux extrémités de la table.
+static float lumen_utilization(const void *vctx, float room_index, float *slope)
+{
+    const lighting_ctx_t *ctx = vctx;
+    size_t i = 0;
+    while (i + 2 < CU_ROWS && room_index > k_cu_room_index[i + 1]) {
+        ++i;
+    }
+    const float r0 = k_cu_room_index[i];
+    const float r1 = k_cu_room_index[i + 1];
+    const float k = clampf(room_index, k_cu_room_index[0], k_cu_room_index[CU_ROWS - 1]);
+    const float tx = clampf((k - r0) / (r1 - r0), 0.0f, 1.0f);
+
+    const float rho = clampf(ctx->floor_reflectance, k_cu_floor_reflectance[0], k_cu_floor_reflectance[CU_COLS - 1]);
+    const size_t j = (rho > k_cu_floor_reflectance[1]) ? 1 : 0;
+    const float ty = (rho - k_cu_floor_reflectance[j]) / (k_cu_floor_reflectance[j + 1] - k_cu_floor_reflectance[j]);
+
+    const float (*t)[CU_COLS] = ctx->cu_table;
+    const float lo = t[i][j] + (t[i][j + 1] - t[i][j]) * ty;
+    const float hi = t[i + 1][j] + (t[i + 1][j + 1] - t[i + 1][j]) * ty;
+    if (slope) {
+        const bool inside = room_index > k_cu_room_index[0] && room_index < k_cu_room_index[CU_ROWS - 1];
+        *slope = inside ? (hi - lo) / (r1 - r0) : 0.0f;
+    }
+    return lo + (hi - lo) * tx;
+}
+
+#define CALC_SCALAR_MODE CALC_SCALAR_FLOAT
+#include "calc_lighting_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_DUAL
+#include "calc_lighting_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_INTERVAL
+#include "calc_lighting_kernel.inc"
+#undef CALC_SCALAR_MODE
+
+static bool inputs_valid(const lighting_input_t *in)
 {
-    // loi en 1/r^p légèrement adoucie (p=1.9) pour refléter les réflecteurs UV
-    const float exponent = 1.9f;
-    const float ref = fmaxf(ref_cm, 1.0f);
-    const float tgt = fmaxf(target_cm, 1.0f);
-    return value_at_ref * powf(ref / tgt, exponent);
+    return in && in->length_cm > 0.0f && in->depth_cm > 0.0f && in->led_luminous_flux_lm > 0.0f && in->led_power_w > 0.0f;
+}
+
+static lighting_ctx_t make_ctx(const lighting_input_t *in)
+{
+    float uvi_min = 0.0f, uvi_max = 0.0f;
+    ferguson_range(in->environment, &uvi_min, &uvi_max);
+    const float target_mid = (uvi_min + uvi_max) * 0.5f;
+    return (lighting_ctx_t){
+        .target_lux = target_lux_for_env(in->environment),
+        .target_uvi_mid = target_mid,
+        .target_uva = clampf(target_mid * 15.0f, 1.5f, 25.0f),
+        .base_distance_cm = recommended_distance_for_env(in->environment),
+        .use_height = in->height_cm > 0.0f,
+        .uvb_enabled = in->uvb_uvi_at_distance > 0.0f,
+        .uva_enabled = in->uva_irradiance_mw_cm2_at_distance > 0.0f,
+        .cu_table = cu_table_for_material(in->wall_material),
+        .floor_reflectance = floor_reflectance_for_env(in->environment),
+        .maintenance_factor = 0.8f, // LED + buée/poussière sur le couvercle
+        .uvb_falloff = s_uvb_falloff,
+        .uva_falloff = s_uva_falloff,
+    };
+}
+
+static float reference_distance(const lighting_input_t *in)
+{
+    return (in->reference_distance_cm > 0.0f) ? in->reference_distance_cm : 30.0f;
+}
+
+void lighting_set_falloff(const lighting_falloff_t *uvb, const lighting_falloff_t *uva)
+{
+    s_uvb_falloff = uvb ? *uvb : k_default_falloff;
+    s_uva_falloff = uva ? *uva : k_default_falloff;
 }
 
 bool lighting_calculate(const lighting_input_t *in, lighting_result_t *out)
@@ -85,75 +254,214 @@ bool lighting_calculate(const lighting_input_t *in, lighting_result_t *out)
     if (!in || !out) {
         return false;
     }
-    if (in->length_cm <= 0.0f || in->depth_cm <= 0.0f || in->led_luminous_flux_lm <= 0.0f || in->led_power_w <= 0.0f) {
+    if (!inputs_valid(in)) {
         return false;
     }
 
-    lighting_result_t r = {0};
-    const float floor_area_m2 = (in->length_cm * in->depth_cm) / 10000.0f;
-    const float target_lux = target_lux_for_env(in->environment);
-    const float total_flux = target_lux * floor_area_m2;
-    const float led_units = total_flux / in->led_luminous_flux_lm;
-    const uint32_t led_count = (uint32_t)ceilf(led_units - 1e-3f);
-    const float total_power = led_count * in->led_power_w;
+    const lighting_ctx_t ctx = make_ctx(in);
+    const lighting_vars_f v = {
+        .length_cm = in->length_cm,
+        .depth_cm = in->depth_cm,
+        .height_cm = in->height_cm,
+        .led_luminous_flux_lm = in->led_luminous_flux_lm,
+        .led_power_w = in->led_power_w,
+        .uva_irradiance_mw_cm2_at_distance = in->uva_irradiance_mw_cm2_at_distance,
+        .uvb_uvi_at_distance = in->uvb_uvi_at_distance,
+        .reference_distance_cm = reference_distance(in),
+    };
+    lighting_out_f k;
+    lighting_kernel_f(&ctx, &v, &k);
 
+    lighting_result_t r = {0};
+    const uint32_t led_count = (uint32_t)k.led_count;
     r.led.valid = led_count > 0;
-    r.led.target_lux = target_lux;
-    r.led.total_flux_lm = total_flux;
+    r.led.target_lux = ctx.target_lux;
+    r.led.total_flux_lm = k.total_flux_lm;
     r.led.led_count = led_count;
-    r.led.total_power_w = total_power;
-    r.led.recommended_distance_cm = recommended_distance_for_env(in->environment);
-    r.led.area_m2 = floor_area_m2;
+    r.led.total_power_w = k.total_power_w;
+    r.led.recommended_distance_cm = ctx.base_distance_cm;
+    r.led.area_m2 = k.area_m2;
+    r.led.room_index = k.room_index;
+    r.led.utilization = k.utilization;
+    const float delivered_lux =
+        (k.area_m2 > 0.0f) ? k.led_count * in->led_luminous_flux_lm * k.utilization * ctx.maintenance_factor / k.area_m2 : 0.0f;
+    r.led.ppfd_umol_m2_s =
+        spectrum_convert(SPECTRUM_LAMP_LED_6500K, SPECTRUM_WEIGHT_PHOTOPIC, SPECTRUM_WEIGHT_PAR, delivered_lux);
 
-    const float ref_dist = (in->reference_distance_cm > 0.0f) ? in->reference_distance_cm : 30.0f;
     float uvi_min = 0.0f, uvi_max = 0.0f;
     ferguson_range(in->environment, &uvi_min, &uvi_max);
-    const float target_mid = (uvi_min + uvi_max) * 0.5f;
-
-    const float base_distance = recommended_distance_for_env(in->environment);
-    const float target_distance = clampf(in->height_cm > 0.0f ? in->height_cm * 0.7f : base_distance, 10.0f, 80.0f);
 
-    const float uvb_per_module = in->uvb_uvi_at_distance;
-    if (uvb_per_module > 0.0f) {
-        const float projected = project_irradiance(uvb_per_module, ref_dist, target_distance);
-        const float uvb_units = target_mid / fmaxf(projected, 0.05f);
-        r.uvb.module_count = (uint32_t)ceilf(uvb_units - 1e-3f);
+    if (ctx.uvb_enabled) {
+        r.uvb.module_count = (uint32_t)k.uvb_count;
         r.uvb.target_uvi_min = uvi_min;
         r.uvb.target_uvi_max = uvi_max;
         r.uvb.valid = r.uvb.module_count > 0;
-        r.uvb.recommended_distance_cm = target_distance;
-        r.uvb.estimated_uvi_at_distance = projected;
-        r.uvb.estimated_total_uvi = projected * r.uvb.module_count;
+        r.uvb.recommended_distance_cm = k.target_distance_cm;
+        r.uvb.estimated_uvi_at_distance = k.uvb_at_distance;
+        r.uvb.estimated_total_uvi = k.uvb_total;
         r.uvb.warning_high = r.uvb.estimated_total_uvi > (uvi_max * 1.2f);
         r.uvb.warning_low = r.uvb.estimated_total_uvi < (uvi_min * 0.8f);
     }
 
-    if (in->uva_irradiance_mw_cm2_at_distance > 0.0f) {
-        const float target_uva = clampf(target_mid * 15.0f, 1.5f, 25.0f);
-        const float projected = project_irradiance(in->uva_irradiance_mw_cm2_at_distance, ref_dist, target_distance);
-        const float uva_units = target_uva / fmaxf(projected, 0.05f);
-        r.uva.module_count = (uint32_t)ceilf(uva_units - 1e-3f);
-        r.uva.target_uvi_min = target_uva;
-        r.uva.target_uvi_max = target_uva;
+    if (ctx.uva_enabled) {
+        r.uva.module_count = (uint32_t)k.uva_count;
+        r.uva.target_uvi_min = ctx.target_uva;
+        r.uva.target_uvi_max = ctx.target_uva;
         r.uva.valid = r.uva.module_count > 0;
-        r.uva.recommended_distance_cm = target_distance;
-        r.uva.estimated_uvi_at_distance = projected;
-        r.uva.estimated_total_uvi = projected * r.uva.module_count;
-        r.uva.warning_high = r.uva.estimated_total_uvi > target_uva * 1.2f;
-        r.uva.warning_low = r.uva.estimated_total_uvi < target_uva * 0.8f;
+        r.uva.recommended_distance_cm = k.target_distance_cm;
+        r.uva.estimated_uvi_at_distance = k.uva_at_distance;
+        r.uva.estimated_total_uvi = k.uva_total;
+        r.uva.warning_high = r.uva.estimated_total_uvi > ctx.target_uva * 1.2f;
+        r.uva.warning_low = r.uva.estimated_total_uvi < ctx.target_uva * 0.8f;
     }
 
+    // UVI et dose D3 tirés des mêmes spectres : le tube T5 est décrit par son UVI,
+    // les modules UVA par leur éclairement 315-400 nm.
+    r.combined_uvi = r.uvb.estimated_total_uvi +
+                     spectrum_convert(SPECTRUM_LAMP_UVA, SPECTRUM_WEIGHT_UVA, SPECTRUM_WEIGHT_ERYTHEMA, r.uva.estimated_total_uvi);
+    r.previtd3_w_m2 =
+        spectrum_convert(SPECTRUM_LAMP_T5_UVB, SPECTRUM_WEIGHT_ERYTHEMA, SPECTRUM_WEIGHT_PREVITD3, r.uvb.estimated_total_uvi) +
+        spectrum_convert(SPECTRUM_LAMP_UVA, SPECTRUM_WEIGHT_UVA, SPECTRUM_WEIGHT_PREVITD3, r.uva.estimated_total_uvi);
+
     r.valid = r.led.valid || r.uvb.valid || r.uva.valid;
     *out = r;
     return true;
 }
 
+bool lighting_led_flux_for_count(const lighting_input_t *in, uint32_t led_count, float *flux_lm)
+{
+    if (!in || !flux_lm || led_count == 0) {
+        return false;
+    }
+    // le flux à installer ne dépend pas du flux par module
+    lighting_input_t probe = *in;
+    probe.led_luminous_flux_lm = 1000.0f;
+    probe.led_power_w = (in->led_power_w > 0.0f) ? in->led_power_w : 1.0f;
+    lighting_result_t r;
+    if (!lighting_calculate(&probe, &r) || r.led.total_flux_lm <= 0.0f) {
+        return false;
+    }
+
+    // ceil(total / flux - 1e-3) <= n  <=>  flux >= total / (n + 1e-3)
+    float flux = r.led.total_flux_lm / ((float)led_count + 1e-3f);
+    for (int i = 0; i < 4; ++i) {
+        probe.led_luminous_flux_lm = flux;
+        if (lighting_calculate(&probe, &r) && r.led.led_count <= led_count) {
+            break;
+        }
+        flux = nextafterf(flux, INFINITY); // arrondi float à la frontière
+    }
+    *flux_lm = flux;
+    return true;
+}
+
+bool lighting_sensitivity(const lighting_input_t *in, calc_sensitivity_t *out)
+{
+    if (!out || !inputs_valid(in)) {
+        return false;
+    }
+
+    const lighting_ctx_t ctx = make_ctx(in);
+    const lighting_vars_d v = {
+        .length_cm = calc_dual_var(in->length_cm, 0),
+        .depth_cm = calc_dual_var(in->depth_cm, 1),
+        .height_cm = calc_dual_var(in->height_cm, 2),
+        .led_luminous_flux_lm = calc_dual_var(in->led_luminous_flux_lm, 3),
+        .led_power_w = calc_dual_var(in->led_power_w, 4),
+        .uva_irradiance_mw_cm2_at_distance = calc_dual_var(in->uva_irradiance_mw_cm2_at_distance, 5),
+        .uvb_uvi_at_distance = calc_dual_var(in->uvb_uvi_at_distance, 6),
+        .reference_distance_cm = (in->reference_distance_cm > 0.0f) ? calc_dual_var(in->reference_distance_cm, 7)
+                                                                      : calc_dual_const(reference_distance(in)),
+    };
+    lighting_out_d k;
+    lighting_kernel_d(&ctx, &v, &k);
+
+    calc_sensitivity_t s = {
+        .valid = true,
+        .input_count = 8,
+        .input_names = {"Longueur (cm)", "Profondeur (cm)", "Hauteur (cm)", "Flux LED (lm)", "Puissance LED (W)",
+                        "UVA module", "UVB module (UVI)", "Distance réf. (cm)"},
+        .input_values = {in->length_cm, in->depth_cm, in->height_cm, in->led_luminous_flux_lm, in->led_power_w,
+                         in->uva_irradiance_mw_cm2_at_distance, in->uvb_uvi_at_distance, in->reference_distance_cm},
+    };
+    calc_dual_to_sensitivity(&s, "Flux total (lm)", k.total_flux_lm);
+    calc_dual_to_sensitivity(&s, "Puissance LED (W)", k.total_power_w);
+    if (ctx.uvb_enabled) {
+        calc_dual_to_sensitivity(&s, "UVI par module", k.uvb_at_distance);
+        calc_dual_to_sensitivity(&s, "UVI total", k.uvb_total);
+    }
+    if (ctx.uva_enabled) {
+        calc_dual_to_sensitivity(&s, "UVA par module", k.uva_at_distance);
+        calc_dual_to_sensitivity(&s, "UVA total", k.uva_total);
+    }
+    *out = s;
+    return true;
+}
+
+void lighting_default_tolerance(const lighting_input_t *in, lighting_input_t *tol)
+{
+    const lighting_input_t t = {
+        .length_cm = CALC_TOL_TAPE_CM,
+        .depth_cm = CALC_TOL_TAPE_CM,
+        .height_cm = CALC_TOL_TAPE_CM,
+        .environment = in ? in->environment : TERRARIUM_ENV_TROPICAL,
+        .wall_material = in ? in->wall_material : TERRARIUM_MATERIAL_GLASS,
+        .led_luminous_flux_lm = in ? in->led_luminous_flux_lm * CALC_TOL_PRODUCT_REL : 0.0f,
+        .led_power_w = in ? in->led_power_w * CALC_TOL_PRODUCT_REL : 0.0f,
+        .uva_irradiance_mw_cm2_at_distance = in ? in->uva_irradiance_mw_cm2_at_distance * CALC_TOL_UV_REL : 0.0f,
+        .uvb_uvi_at_distance = in ? in->uvb_uvi_at_distance * CALC_TOL_UV_REL : 0.0f,
+        .reference_distance_cm = 1.0f,
+    };
+    *tol = t;
+}
+
+bool lighting_bounds(const lighting_input_t *in, const lighting_input_t *tol, calc_bounds_t *out)
+{
+    if (!out || !tol || !inputs_valid(in)) {
+        return false;
+    }
+
+    const lighting_ctx_t ctx = make_ctx(in);
+    const lighting_vars_i v = {
+        .length_cm = calc_interval_around(in->length_cm, tol->length_cm),
+        .depth_cm = calc_interval_around(in->depth_cm, tol->depth_cm),
+        .height_cm = calc_interval_around(in->height_cm, tol->height_cm),
+        .led_luminous_flux_lm = calc_interval_around(in->led_luminous_flux_lm, tol->led_luminous_flux_lm),
+        .led_power_w = calc_interval_around(in->led_power_w, tol->led_power_w),
+        .uva_irradiance_mw_cm2_at_distance =
+            calc_interval_around(in->uva_irradiance_mw_cm2_at_distance, tol->uva_irradiance_mw_cm2_at_distance),
+        .uvb_uvi_at_distance = calc_interval_around(in->uvb_uvi_at_distance, tol->uvb_uvi_at_distance),
+        .reference_distance_cm = (in->reference_distance_cm > 0.0f)
+                                     ? calc_interval_around(in->reference_distance_cm, tol->reference_distance_cm)
+                                     : calc_interval_const(reference_distance(in)),
+    };
+    lighting_out_i k;
+    lighting_kernel_i(&ctx, &v, &k);
+
+    calc_bounds_t b = {.valid = true};
+    calc_interval_to_bounds(&b, "Nombre de LED", k.led_count);
+    calc_interval_to_bounds(&b, "Puissance LED (W)", k.total_power_w);
+    if (ctx.uvb_enabled) {
+        calc_interval_to_bounds(&b, "UVI par module", k.uvb_at_distance);
+        calc_interval_to_bounds(&b, "UVI total", k.uvb_total);
+    }
+    if (ctx.uva_enabled) {
+        calc_interval_to_bounds(&b, "UVA par module", k.uva_at_distance);
+        calc_interval_to_bounds(&b, "UVA total", k.uva_total);
+    }
+    *out = b;
+    return true;
+}
+
 static void log_case(const lighting_input_t *in, const char *label)
 {
     lighting_result_t out = {0};
-    if (lighting_calculate(in, &out)) {
-        printf("[TEST éclairage:%s] LED=%u (%.0f lm, %.0f lux cible), UVB=%u @%.0f cm (%.2f-%.2f UVI, est=%.2f), UVA=%u @%.0f cm (est=%.2f)\n",
+    calc_sensitivity_t sens = {0};
+    if (lighting_calculate(in, &out) && lighting_sensitivity(in, &sens)) {
+        printf("[TEST éclairage:%s] K=%.2f CU=%.2f, LED=%u (%.0f lm, %.0f lux cible), UVB=%u @%.0f cm (%.2f-%.2f UVI, est=%.2f), UVA=%u @%.0f cm (est=%.2f)\n",
                label,
+               out.led.room_index,
+               out.led.utilization,
                out.led.led_count,
                out.led.total_flux_lm,
                out.led.target_lux,
@@ -165,6 +473,19 @@ static void log_case(const lighting_input_t *in, const char *label)
                out.uva.module_count,
                out.uva.recommended_distance_cm,
                out.uva.estimated_total_uvi);
+        printf("[TEST éclairage:%s] spectre : PPFD %.0f µmol/m²/s, UVI combiné %.2f, D3 %.1f mW/m²\n",
+               label,
+               out.led.ppfd_umol_m2_s,
+               out.combined_uvi,
+               out.previtd3_w_m2 * 1000.0f);
+        for (uint8_t i = 0; i < sens.output_count; ++i) {
+            if (strcmp(sens.output_names[i], "UVI total") == 0) {
+                printf("[TEST éclairage:%s] sensibilité UVI total : %+.3f UVI/cm de hauteur, %+.3f UVI/cm de distance réf.\n",
+                       label,
+                       sens.partial[i][2],
+                       sens.partial[i][7]);
+            }
+        }
     }
 }
 
@@ -175,6 +496,7 @@ void lighting_run_self_test(void)
         .depth_cm = 60,
         .height_cm = 60,
         .environment = TERRARIUM_ENV_DESERTIC,
+        .wall_material = TERRARIUM_MATERIAL_GLASS,
         .led_luminous_flux_lm = 150.0f,
         .led_power_w = 1.0f,
         .uva_irradiance_mw_cm2_at_distance = 3.0f,
@@ -186,6 +508,7 @@ void lighting_run_self_test(void)
         .depth_cm = 40,
         .height_cm = 40,
         .environment = TERRARIUM_ENV_TROPICAL,
+        .wall_material = TERRARIUM_MATERIAL_PVC,
         .led_luminous_flux_lm = 110.0f,
         .led_power_w = 0.8f,
         .uva_irradiance_mw_cm2_at_distance = 5.0f,
@@ -196,7 +519,8 @@ void lighting_run_self_test(void)
         .length_cm = 150,
         .depth_cm = 80,
         .height_cm = 120,
-        .environment = TERRARIUM_ENV_TEMPERATE,
+        .environment = TERRARIUM_ENV_TEMPERATE_FOREST,
+        .wall_material = TERRARIUM_MATERIAL_WOOD,
         .led_luminous_flux_lm = 160.0f,
         .led_power_w = 1.2f,
         .uva_irradiance_mw_cm2_at_distance = 1.2f,
@@ -207,4 +531,36 @@ void lighting_run_self_test(void)
     log_case(&nominal, "nominal");
     log_case(&uv_close, "UV proche");
     log_case(&uv_far, "UV distant");
+
+    lighting_input_t tol;
+    lighting_default_tolerance(&nominal, &tol);
+    lighting_result_t ref = {0};
+    calc_bounds_t b = {0};
+    if (lighting_calculate(&nominal, &ref) && lighting_bounds(&nominal, &tol, &b)) {
+        const bool inside = ref.uvb.estimated_uvi_at_distance >= b.min[2] && ref.uvb.estimated_uvi_at_distance <= b.max[2];
+        printf("[TEST éclairage:nominal] bornes (±%.0f%% UV) : LED %.0f-%.0f, UVI/module %.2f-%.2f %s\n",
+               CALC_TOL_UV_REL * 100.0f,
+               b.min[0],
+               b.max[0],
+               b.min[2],
+               b.max[2],
+               inside ? "OK" : "ÉCHEC");
+    }
+
+    // Inverse : flux par module pour n'en poser que 12
+    float flux = 0.0f;
+    if (lighting_led_flux_for_count(&nominal, 12, &flux)) {
+        lighting_input_t at = nominal;
+        at.led_luminous_flux_lm = flux;
+        lighting_input_t below = nominal;
+        below.led_luminous_flux_lm = flux * 0.99f;
+        lighting_result_t r_at = {0};
+        lighting_result_t r_below = {0};
+        lighting_calculate(&at, &r_at);
+        lighting_calculate(&below, &r_below);
+        printf("[TEST éclairage] inverse : 12 modules -> %.0f lm/module (-1 %% -> %u modules) %s\n",
+               flux,
+               r_below.led.led_count,
+               (r_at.led.led_count <= 12 && r_below.led.led_count > 12) ? "OK" : "ÉCHEC");
+    }
 }
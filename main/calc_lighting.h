@@ -1,6 +1,8 @@
 #pragma once
 
 #include "calc_common.h"
+#include "calc_bounds.h"
+#include "calc_sensitivity.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,6 +13,7 @@ typedef struct {
     float depth_cm;
     float height_cm;
     terrarium_environment_t environment;
+    terrarium_material_t wall_material; // parois : coefficient d'utilisation (méthode des lumens)
     float led_luminous_flux_lm;
     float led_power_w;
     float uva_irradiance_mw_cm2_at_distance;
@@ -21,11 +24,14 @@ typedef struct {
 typedef struct {
     bool valid;
     float target_lux;
-    float total_flux_lm;
+    float total_flux_lm;  // flux à installer, pertes parois et maintenance comprises
+    float room_index;     // K = L·P / (H·(L + P))
+    float utilization;    // coefficient d'utilisation (CU) lu dans la table des parois
     float total_power_w;
     uint32_t led_count;
     float recommended_distance_cm;
     float area_m2;
+    float ppfd_umol_m2_s; // PPFD plantes issue du spectre LED 6500K (calc_spectrum)
 } lighting_led_result_t;
 
 typedef struct {
@@ -44,9 +50,28 @@ typedef struct {
     lighting_led_result_t led;
     lighting_uv_result_t uva;
     lighting_uv_result_t uvb;
+    float combined_uvi;  // UVB + part érythémale des modules UVA, d'après leurs spectres
+    float previtd3_w_m2; // éclairement pondéré pré-vitamine D3 (UVB + UVA)
+    bool valid;
 } lighting_result_t;
 
+/** Décroissance d'une lampe UV : E(d) = gain · E_réf · (d_réf / d)^exposant. */
+typedef struct {
+    float gain;
+    float exponent;
+} lighting_falloff_t;
+
 bool lighting_calculate(const lighting_input_t *in, lighting_result_t *out);
+bool lighting_sensitivity(const lighting_input_t *in, calc_sensitivity_t *out);
+void lighting_default_tolerance(const lighting_input_t *in, lighting_input_t *tol);
+bool lighting_bounds(const lighting_input_t *in, const lighting_input_t *tol, calc_bounds_t *out);
+/** Paramètres recalés sur mesures UVI-mètre ; NULL revient au modèle par défaut (1, 1,9). */
+void lighting_set_falloff(const lighting_falloff_t *uvb, const lighting_falloff_t *uva);
+/**
+ * Résolution inverse en forme close : flux minimal par module LED pour que
+ * `led_count` modules suffisent. `led_luminous_flux_lm` de `in` est ignoré.
+ */
+bool lighting_led_flux_for_count(const lighting_input_t *in, uint32_t led_count, float *flux_lm);
 void lighting_run_self_test(void);
 
 #ifdef __cplusplus
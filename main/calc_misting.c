@@ -3,6 +3,9 @@
 #include <math.h>
 #include <stdio.h>
 
+#include "calc_dual.h"
+#include "calc_interval.h"
+
 typedef struct {
     float coverage_min_m2_per_nozzle;
     float coverage_max_m2_per_nozzle;
@@ -27,32 +30,56 @@ static float clampf(float v, float min, float max)
     return v;
 }
 
+#define CALC_SCALAR_MODE CALC_SCALAR_FLOAT
+#include "calc_misting_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_DUAL
+#include "calc_misting_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_INTERVAL
+#include "calc_misting_kernel.inc"
+#undef CALC_SCALAR_MODE
+
+static bool inputs_valid(const misting_input_t *in)
+{
+    return in && in->length_cm >= 20.0f && in->depth_cm >= 20.0f && in->nozzle_flow_ml_per_min > 0.0f &&
+           in->cycle_duration_min > 0.0f && in->cycles_per_day != 0 && in->autonomy_days != 0;
+}
+
+static float coverage_mid_for(const mist_coverage_t *cov)
+{
+    return (cov->coverage_min_m2_per_nozzle + cov->coverage_max_m2_per_nozzle) * 0.5f;
+}
+
 bool misting_calculate(const misting_input_t *in, misting_result_t *out)
 {
     if (!in || !out) {
         return false;
     }
-    if (in->length_cm < 20.0f || in->depth_cm < 20.0f || in->nozzle_flow_ml_per_min <= 0.0f ||
-        in->cycle_duration_min <= 0.0f || in->cycles_per_day == 0 || in->autonomy_days == 0) {
+    if (!inputs_valid(in)) {
         return false;
     }
 
     const mist_coverage_t cov = coverage_table[in->environment];
-    const float area_m2 = (in->length_cm * in->depth_cm) / 10000.0f;
-    const float coverage_mid = (cov.coverage_min_m2_per_nozzle + cov.coverage_max_m2_per_nozzle) * 0.5f;
+    const misting_vars_f v = {
+        .length_cm = in->length_cm,
+        .depth_cm = in->depth_cm,
+        .nozzle_flow_ml_per_min = in->nozzle_flow_ml_per_min,
+        .cycle_duration_min = in->cycle_duration_min,
+        .cycles_per_day = (float)in->cycles_per_day,
+        .autonomy_days = (float)in->autonomy_days,
+    };
+    misting_out_f k;
+    misting_kernel_f(coverage_mid_for(&cov), &v, &k);
 
     misting_result_t r = {0};
-    const float nozzle_count_exact = area_m2 / coverage_mid;
-    r.nozzle_count = (uint32_t)ceilf(nozzle_count_exact - 1e-3f);
-
-    const float daily_volume_ml = in->nozzle_flow_ml_per_min * in->cycle_duration_min * in->cycles_per_day * r.nozzle_count;
-    const float daily_volume_l = daily_volume_ml / 1000.0f;
-    r.daily_consumption_l = daily_volume_l;
-    r.tank_volume_l = daily_volume_l * (float)in->autonomy_days * 1.2f; // +20% marge anti-désamorçage
-    r.tank_volume_autonomy3_l = daily_volume_l * 3.0f * 1.2f;
-    r.tank_volume_autonomy7_l = daily_volume_l * 7.0f * 1.2f;
+    r.nozzle_count = (uint32_t)k.nozzle_count;
+    r.daily_consumption_l = k.daily_consumption_l;
+    r.tank_volume_l = k.tank_volume_l;
+    r.tank_volume_autonomy3_l = k.tank_volume_autonomy3_l;
+    r.tank_volume_autonomy7_l = k.tank_volume_autonomy7_l;
 
-    const float nozzle_density = r.nozzle_count / fmaxf(area_m2, 0.1f);
+    const float nozzle_density = r.nozzle_count / fmaxf(k.area_m2, 0.1f);
     r.warning_dense_spray = nozzle_density > (1.0f / cov.coverage_min_m2_per_nozzle);
     r.warning_sparse_spray = nozzle_density < (1.0f / cov.coverage_max_m2_per_nozzle) * 0.6f;
     r.warning_flow_out_of_range = (in->nozzle_flow_ml_per_min < 60.0f || in->nozzle_flow_ml_per_min > 120.0f);
@@ -62,6 +89,109 @@ bool misting_calculate(const misting_input_t *in, misting_result_t *out)
     return true;
 }
 
+bool misting_max_cycles_per_day(const misting_input_t *in, float tank_volume_l, uint32_t *cycles_per_day)
+{
+    if (!in || !cycles_per_day || tank_volume_l <= 0.0f) {
+        return false;
+    }
+    // le réservoir est linéaire en cycles/jour : un calcul à 1 cycle suffit
+    misting_input_t one = *in;
+    one.cycles_per_day = 1;
+    misting_result_t r;
+    if (!misting_calculate(&one, &r) || !r.valid || r.tank_volume_l <= 0.0f) {
+        return false;
+    }
+    uint32_t cycles = (uint32_t)floorf(tank_volume_l / r.tank_volume_l);
+
+    // l'arrondi float peut faire déborder d'un cycle : vérification directe
+    one.cycles_per_day = cycles;
+    if (cycles > 0 && misting_calculate(&one, &r) && r.tank_volume_l > tank_volume_l) {
+        --cycles;
+    }
+    *cycles_per_day = cycles;
+    return true;
+}
+
+bool misting_sensitivity(const misting_input_t *in, calc_sensitivity_t *out)
+{
+    if (!out || !inputs_valid(in)) {
+        return false;
+    }
+
+    const mist_coverage_t cov = coverage_table[in->environment];
+    const misting_vars_d v = {
+        .length_cm = calc_dual_var(in->length_cm, 0),
+        .depth_cm = calc_dual_var(in->depth_cm, 1),
+        .nozzle_flow_ml_per_min = calc_dual_var(in->nozzle_flow_ml_per_min, 2),
+        .cycle_duration_min = calc_dual_var(in->cycle_duration_min, 3),
+        .cycles_per_day = calc_dual_var((float)in->cycles_per_day, 4),
+        .autonomy_days = calc_dual_var((float)in->autonomy_days, 5),
+    };
+    misting_out_d k;
+    misting_kernel_d(coverage_mid_for(&cov), &v, &k);
+
+    calc_sensitivity_t s = {
+        .valid = true,
+        .input_count = 6,
+        .input_names = {"Longueur (cm)",
+                        "Profondeur (cm)",
+                        "Débit buse (mL/min)",
+                        "Durée cycle (min)",
+                        "Cycles / jour",
+                        "Autonomie (j)"},
+        .input_values = {in->length_cm,
+                         in->depth_cm,
+                         in->nozzle_flow_ml_per_min,
+                         in->cycle_duration_min,
+                         (float)in->cycles_per_day,
+                         (float)in->autonomy_days},
+    };
+    calc_dual_to_sensitivity(&s, "Consommation (L/j)", k.daily_consumption_l);
+    calc_dual_to_sensitivity(&s, "Cuve (L)", k.tank_volume_l);
+    *out = s;
+    return true;
+}
+
+void misting_default_tolerance(const misting_input_t *in, misting_input_t *tol)
+{
+    const misting_input_t t = {
+        .length_cm = CALC_TOL_TAPE_CM,
+        .depth_cm = CALC_TOL_TAPE_CM,
+        .environment = in ? in->environment : MIST_ENV_TROPICAL,
+        .nozzle_flow_ml_per_min = in ? in->nozzle_flow_ml_per_min * CALC_TOL_PRODUCT_REL : 0.0f,
+        .cycle_duration_min = 0.0f,
+        .cycles_per_day = 0,
+        .autonomy_days = 0,
+    };
+    *tol = t;
+}
+
+bool misting_bounds(const misting_input_t *in, const misting_input_t *tol, calc_bounds_t *out)
+{
+    if (!out || !tol || !inputs_valid(in)) {
+        return false;
+    }
+
+    const mist_coverage_t cov = coverage_table[in->environment];
+    const misting_vars_i v = {
+        .length_cm = calc_interval_around(in->length_cm, tol->length_cm),
+        .depth_cm = calc_interval_around(in->depth_cm, tol->depth_cm),
+        .nozzle_flow_ml_per_min = calc_interval_around(in->nozzle_flow_ml_per_min, tol->nozzle_flow_ml_per_min),
+        .cycle_duration_min = calc_interval_around(in->cycle_duration_min, tol->cycle_duration_min),
+        .cycles_per_day = calc_interval_around((float)in->cycles_per_day, (float)tol->cycles_per_day),
+        .autonomy_days = calc_interval_around((float)in->autonomy_days, (float)tol->autonomy_days),
+    };
+    misting_out_i k;
+    misting_kernel_i(coverage_mid_for(&cov), &v, &k);
+
+    calc_bounds_t b = {.valid = true};
+    calc_interval_to_bounds(&b, "Nombre de buses", k.nozzle_count);
+    calc_interval_to_bounds(&b, "Consommation (L/j)", k.daily_consumption_l);
+    calc_interval_to_bounds(&b, "Cuve (L)", k.tank_volume_l);
+    *out = b;
+    return true;
+}
+
 void misting_run_self_test(void)
 {
     const misting_input_t nominal = {
@@ -95,11 +225,13 @@ void misting_run_self_test(void)
 
     for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
         misting_result_t out = {0};
-        if (misting_calculate(&cases[i], &out)) {
-            printf("[TEST brumisation %zu] buses=%u, conso=%.2f L/j, cuve %.2f L (3j=%.2f L, 7j=%.2f L)%s%s\n",
+        calc_sensitivity_t sens = {0};
+        if (misting_calculate(&cases[i], &out) && misting_sensitivity(&cases[i], &sens)) {
+            printf("[TEST brumisation %zu] buses=%u, conso=%.2f L/j (élasticité débit %.2f), cuve %.2f L (3j=%.2f L, 7j=%.2f L)%s%s\n",
                    i,
                    out.nozzle_count,
                    out.daily_consumption_l,
+                   calc_sensitivity_elasticity(&sens, 0, 2),
                    out.tank_volume_l,
                    out.tank_volume_autonomy3_l,
                    out.tank_volume_autonomy7_l,
@@ -107,4 +239,37 @@ void misting_run_self_test(void)
                    out.warning_sparse_spray ? " couverture faible" : "");
         }
     }
+
+    misting_input_t tol;
+    misting_default_tolerance(&nominal, &tol);
+    misting_result_t ref = {0};
+    calc_bounds_t b = {0};
+    if (misting_calculate(&nominal, &ref) && misting_bounds(&nominal, &tol, &b)) {
+        const bool inside = ref.tank_volume_l >= b.min[2] && ref.tank_volume_l <= b.max[2];
+        printf("[TEST brumisation] bornes (±%.0f%% débit) : conso %.2f-%.2f L/j, cuve %.2f-%.2f L %s\n",
+               CALC_TOL_PRODUCT_REL * 100.0f,
+               b.min[1],
+               b.max[1],
+               b.min[2],
+               b.max[2],
+               inside ? "OK" : "ÉCHEC");
+    }
+
+    // Inverse : cycles/jour max pour une cuve de 10 L
+    uint32_t max_cycles = 0;
+    if (misting_max_cycles_per_day(&nominal, 10.0f, &max_cycles)) {
+        misting_input_t at = nominal;
+        at.cycles_per_day = max_cycles;
+        misting_input_t next = nominal;
+        next.cycles_per_day = max_cycles + 1;
+        misting_result_t r_at = {0};
+        misting_result_t r_next = {0};
+        misting_calculate(&at, &r_at);
+        misting_calculate(&next, &r_next);
+        printf("[TEST brumisation] inverse : cuve 10 L -> %u cycles/jour max (%.2f L, +1 cycle %.2f L) %s\n",
+               max_cycles,
+               r_at.tank_volume_l,
+               r_next.tank_volume_l,
+               (r_at.tank_volume_l <= 10.0f && r_next.tank_volume_l > 10.0f) ? "OK" : "ÉCHEC");
+    }
 }
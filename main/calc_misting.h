@@ -1,6 +1,8 @@
 #pragma once
 
 #include "calc_common.h"
+#include "calc_bounds.h"
+#include "calc_sensitivity.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,6 +39,16 @@ typedef struct {
 } misting_result_t;
 
 bool misting_calculate(const misting_input_t *in, misting_result_t *out);
+bool misting_sensitivity(const misting_input_t *in, calc_sensitivity_t *out);
+void misting_default_tolerance(const misting_input_t *in, misting_input_t *tol);
+bool misting_bounds(const misting_input_t *in, const misting_input_t *tol, calc_bounds_t *out);
+/**
+ * Résolution inverse en forme close : plus grand nombre de cycles par jour
+ * dont le réservoir calculé (autonomie et marge comprises) tient dans
+ * `tank_volume_l`. `cycles_per_day` de `in` est ignoré ; 0 si même un cycle
+ * ne tient pas.
+ */
+bool misting_max_cycles_per_day(const misting_input_t *in, float tank_volume_l, uint32_t *cycles_per_day);
 void misting_run_self_test(void);
 
 #ifdef __cplusplus
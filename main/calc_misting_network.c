@@ -0,0 +1,352 @@
+#include "calc_misting_network.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#endif
+
+#define BAR_PER_M 0.0980665f  // colonne d'eau
+#define HW_EXP 1.852f
+#define HW_INV_EXP 0.54f
+#define HEAD_LINEAR_M 1e-4f   // sous ce Δh, loi linéarisée (dérivée finie en 0)
+#define PRESSURE_LINEAR_BAR 0.01f
+#define MAX_ITERATIONS 60
+#define STEP_TOL_M 1e-3f
+
+// Espace de travail fourni par l'appelant (un par tâche), voir l'en-tête
+typedef mist_net_workspace_t solver_t;
+
+void mist_net_default_input(mist_net_input_t *net)
+{
+    memset(net, 0, sizeof(*net));
+    net->pump_shutoff_bar = 8.0f;
+    net->pump_max_flow_l_min = 1.6f;
+    net->nozzle_flow_ml_min = 80.0f;
+    net->nozzle_rated_bar = 5.5f;
+    net->nozzle_min_bar = 4.0f;
+    net->hazen_c = 150.0f;
+    net->fitting_equiv_m = 0.3f;
+}
+
+bool mist_net_build_rack(const mist_rack_t *rack, mist_net_input_t *net)
+{
+    if (!rack || !net || rack->nozzle_count == 0 || rack->nozzle_count > MIST_NET_MAX_RACK_NOZZLES) {
+        return false;
+    }
+
+    uint16_t n = 0;
+    net->nodes[n++] = (mist_net_node_t){
+        .parent = -1,
+        .length_m = rack->supply_length_m,
+        .inner_diameter_mm = rack->supply_diameter_mm,
+        .fittings = 2, // coudes en pied et en tête de colonne
+        .elevation_m = rack->riser_m,
+    };
+    int16_t upstream = 0;
+    for (uint16_t i = 0; i < rack->nozzle_count; ++i) {
+        const int16_t tee = (int16_t)n;
+        net->nodes[n++] = (mist_net_node_t){
+            .parent = upstream,
+            .length_m = (i == 0) ? 0.05f : rack->manifold_spacing_m,
+            .inner_diameter_mm = rack->manifold_diameter_mm,
+            .fittings = 1,
+            .elevation_m = rack->riser_m,
+        };
+        net->nodes[n++] = (mist_net_node_t){
+            .parent = tee,
+            .length_m = rack->drop_length_m,
+            .inner_diameter_mm = rack->supply_diameter_mm,
+            .fittings = 1,
+            .elevation_m = rack->riser_m,
+            .nozzle = true,
+        };
+        upstream = tee;
+    }
+    net->node_count = n;
+    return true;
+}
+
+// Débit (L/min) dans un tube pour une perte de charge dh (m), et sa dérivée
+static float pipe_flow(float r, float dh, float *dq_ddh)
+{
+    const float a = fabsf(dh);
+    if (a < HEAD_LINEAR_M) {
+        const float slope = powf(HEAD_LINEAR_M / r, HW_INV_EXP) / HEAD_LINEAR_M;
+        *dq_ddh = slope;
+        return dh * slope;
+    }
+    const float q = powf(a / r, HW_INV_EXP);
+    *dq_ddh = HW_INV_EXP * q / a;
+    return (dh > 0.0f) ? q : -q;
+}
+
+// Loi d'orifice q = k sqrt(P), linéarisée près de 0
+static float nozzle_flow(float k, float p_bar, float *dq_dp)
+{
+    if (p_bar < PRESSURE_LINEAR_BAR) {
+        const float slope = k * sqrtf(PRESSURE_LINEAR_BAR) / PRESSURE_LINEAR_BAR;
+        *dq_dp = slope;
+        return p_bar * slope;
+    }
+    const float q = k * sqrtf(p_bar);
+    *dq_dp = 0.5f * q / p_bar;
+    return q;
+}
+
+// Courbe pompe P = Ps (1 - (Q/Qmax)²) inversée : Q(P), prolongée linéairement
+// près de la pression d'arrêt
+static float pump_flow(const mist_net_input_t *net, float p_bar, float *dq_dp)
+{
+    const float ps = net->pump_shutoff_bar;
+    const float qmax = net->pump_max_flow_l_min;
+    const float p_knee = 0.99f * ps;
+    if (p_bar > p_knee) {
+        const float q_knee = qmax * sqrtf(1.0f - p_knee / ps);
+        const float slope = -qmax / (2.0f * ps * sqrtf(1.0f - p_knee / ps));
+        *dq_dp = slope;
+        return q_knee + slope * (p_bar - p_knee);
+    }
+    const float root = sqrtf(1.0f - p_bar / ps);
+    *dq_dp = -qmax / (2.0f * ps * root);
+    return qmax * root;
+}
+
+// Assemble résidus (bilan de débit par nœud, L/min) et jacobienne tridiagonale
+// par blocs de l'arbre : diagonale + un terme vers le parent.
+static float assemble(const mist_net_input_t *net, solver_t *s, const float *head)
+{
+    const uint16_t n = net->node_count;
+    memset(s->residual, 0, sizeof(float) * (n + 1u));
+    memset(s->diag, 0, sizeof(float) * (n + 1u));
+
+    float dq = 0.0f;
+    s->residual[0] = pump_flow(net, head[0] * BAR_PER_M, &dq);
+    s->diag[0] = dq * BAR_PER_M;
+
+    for (uint16_t k = 1; k <= n; ++k) {
+        const uint16_t p = s->parent[k];
+        const float q = pipe_flow(s->pipe_r[k], head[p] - head[k], &dq);
+        s->residual[k] += q;
+        s->residual[p] -= q;
+        s->diag[k] -= dq;
+        s->diag[p] -= dq;
+        s->offdiag[k] = dq;
+        if (s->nozzle_k[k] > 0.0f) {
+            const float p_bar = (head[k] - net->nodes[k - 1].elevation_m) * BAR_PER_M;
+            float dqn = 0.0f;
+            s->residual[k] -= nozzle_flow(s->nozzle_k[k], p_bar, &dqn);
+            s->diag[k] -= dqn * BAR_PER_M;
+        }
+    }
+
+    float worst = 0.0f;
+    for (uint16_t k = 0; k <= n; ++k) {
+        worst = fmaxf(worst, fabsf(s->residual[k]));
+    }
+    return worst;
+}
+
+// Élimination creuse ordonnée par l'arbre : des feuilles vers la pompe puis
+// remontée. Aucun remplissage, O(n), diagonale négative sans pivotage.
+static void solve_tree(uint16_t n, solver_t *s)
+{
+    for (uint16_t k = 0; k <= n; ++k) {
+        s->step[k] = -s->residual[k];
+    }
+    for (uint16_t k = n; k >= 1; --k) {
+        const uint16_t p = s->parent[k];
+        const float f = s->offdiag[k] / s->diag[k];
+        s->diag[p] -= f * s->offdiag[k];
+        s->step[p] -= f * s->step[k];
+    }
+    s->step[0] /= s->diag[0];
+    for (uint16_t k = 1; k <= n; ++k) {
+        s->step[k] = (s->step[k] - s->offdiag[k] * s->step[s->parent[k]]) / s->diag[k];
+    }
+}
+
+bool mist_net_solve(const mist_net_input_t *net, mist_net_workspace_t *ws, mist_net_result_t *out)
+{
+    if (!net || !ws || !out || net->node_count == 0 || net->node_count > MIST_NET_MAX_NODES || net->pump_shutoff_bar <= 0.0f ||
+        net->pump_max_flow_l_min <= 0.0f || net->nozzle_flow_ml_min <= 0.0f || net->nozzle_rated_bar <= 0.0f ||
+        net->hazen_c <= 0.0f) {
+        return false;
+    }
+
+    solver_t *s = ws;
+    const uint16_t n = net->node_count;
+    const float c_pow = powf(net->hazen_c, HW_EXP);
+    const float k_nozzle = (net->nozzle_flow_ml_min / 1000.0f) / sqrtf(net->nozzle_rated_bar);
+    // Hazen-Williams SI : h = 10.67 L Q^1.852 / (C^1.852 D^4.87), Q en m³/s ;
+    // ramené à Q en L/min.
+    const float q_scale = powf(1.0f / 60000.0f, HW_EXP);
+
+    for (uint16_t k = 1; k <= n; ++k) {
+        const mist_net_node_t *node = &net->nodes[k - 1];
+        if (node->parent >= (int16_t)(k - 1) || node->parent < -1 || node->inner_diameter_mm <= 0.0f) {
+            return false;
+        }
+        s->parent[k] = (uint16_t)(node->parent + 1);
+        const float length = fmaxf(node->length_m, 0.0f) + node->fittings * net->fitting_equiv_m;
+        const float d_m = node->inner_diameter_mm * 1e-3f;
+        s->pipe_r[k] = fmaxf(10.67f * length * q_scale / (c_pow * powf(d_m, 4.8704f)), 1e-12f);
+        s->nozzle_k[k] = node->nozzle ? k_nozzle : 0.0f;
+    }
+
+    // Départ : toute la ligne à 80 % de la pression d'arrêt
+    const float h_start = 0.8f * net->pump_shutoff_bar / BAR_PER_M;
+    for (uint16_t k = 0; k <= n; ++k) {
+        s->head[k] = h_start;
+    }
+
+    // Résultat écrit en place : il ne tiendrait pas sur une petite pile de tâche
+    mist_net_result_t *r = out;
+    memset(r, 0, sizeof(*r));
+    float worst = assemble(net, s, s->head);
+    float *trial = s->trial;
+    for (r->iterations = 0; r->iterations < MAX_ITERATIONS; ++r->iterations) {
+        solve_tree(n, s);
+
+        float max_step = 0.0f;
+        for (uint16_t k = 0; k <= n; ++k) {
+            max_step = fmaxf(max_step, fabsf(s->step[k]));
+        }
+
+        // Newton amorti : on divise le pas tant que le résidu ne baisse pas
+        float lambda = 1.0f;
+        float trial_worst = worst;
+        for (int halving = 0; halving < 12; ++halving) {
+            for (uint16_t k = 0; k <= n; ++k) {
+                trial[k] = s->head[k] + lambda * s->step[k];
+            }
+            trial_worst = assemble(net, s, trial);
+            if (trial_worst < worst || lambda * max_step < STEP_TOL_M) {
+                break;
+            }
+            lambda *= 0.5f;
+        }
+        memcpy(s->head, trial, sizeof(float) * (n + 1u));
+        worst = trial_worst;
+
+        if (lambda * max_step < STEP_TOL_M) {
+            r->converged = true;
+            ++r->iterations;
+            break;
+        }
+    }
+
+    // Post-traitement : pressions, débits, buse la plus éloignée
+    float *path = s->path;
+    memset(path, 0, sizeof(float) * (n + 1u));
+    float farthest_path = -1.0f;
+    r->min_nozzle_pressure_bar = INFINITY;
+    r->max_nozzle_pressure_bar = 0.0f;
+    float dq = 0.0f;
+    r->pump_pressure_bar = s->head[0] * BAR_PER_M;
+    r->total_flow_ml_min = pump_flow(net, r->pump_pressure_bar, &dq) * 1000.0f;
+    for (uint16_t k = 1; k <= n; ++k) {
+        const mist_net_node_t *node = &net->nodes[k - 1];
+        path[k] = path[s->parent[k]] + node->length_m + node->fittings * net->fitting_equiv_m;
+        const float p_bar = (s->head[k] - node->elevation_m) * BAR_PER_M;
+        r->node_pressure_bar[k - 1] = p_bar;
+        if (!node->nozzle) {
+            continue;
+        }
+        const float q = fmaxf(nozzle_flow(k_nozzle, p_bar, &dq), 0.0f) * 1000.0f;
+        r->nozzle_flow_ml_min[k - 1] = q;
+        r->nozzle_count++;
+        r->min_nozzle_pressure_bar = fminf(r->min_nozzle_pressure_bar, p_bar);
+        r->max_nozzle_pressure_bar = fmaxf(r->max_nozzle_pressure_bar, p_bar);
+        if (path[k] > farthest_path) {
+            farthest_path = path[k];
+            r->farthest_nozzle = (uint16_t)(k - 1);
+            r->farthest_pressure_bar = p_bar;
+            r->farthest_flow_ml_min = q;
+        }
+    }
+
+    r->valid = r->nozzle_count > 0;
+    r->warning_far_nozzle_low = r->valid && r->farthest_pressure_bar < net->nozzle_min_bar;
+    r->warning_pump_overloaded = r->pump_pressure_bar < 0.5f * net->pump_shutoff_bar;
+    return true;
+}
+
+static uint32_t now_us(void)
+{
+#ifdef ESP_PLATFORM
+    return (uint32_t)esp_timer_get_time();
+#else
+    return (uint32_t)((uint64_t)clock() * 1000000u / CLOCKS_PER_SEC);
+#endif
+}
+
+static void log_rack(const char *label, const mist_rack_t *rack, float shutoff_bar, float max_flow_l_min)
+{
+    static mist_net_input_t net;
+    static mist_net_workspace_t ws;
+    static mist_net_result_t out;
+    mist_net_default_input(&net);
+    net.pump_shutoff_bar = shutoff_bar;
+    net.pump_max_flow_l_min = max_flow_l_min;
+    if (!mist_net_build_rack(rack, &net)) {
+        return;
+    }
+    const uint32_t t0 = now_us();
+    const bool ok = mist_net_solve(&net, &ws, &out);
+    const uint32_t dt = now_us() - t0;
+    if (ok) {
+        printf("[TEST réseau %s] %u buses, pompe %.2f bar / %.0f mL/min, buse éloignée %.2f bar (%.0f mL/min), "
+               "%u it. %s en %lu µs%s%s\n",
+               label,
+               out.nozzle_count,
+               out.pump_pressure_bar,
+               out.total_flow_ml_min,
+               out.farthest_pressure_bar,
+               out.farthest_flow_ml_min,
+               out.iterations,
+               out.converged ? "convergé" : "NON CONVERGÉ",
+               (unsigned long)dt,
+               dt > 20000u ? " (>20 ms !)" : "",
+               out.warning_far_nozzle_low ? " ALERTE pression buse" : "");
+    }
+}
+
+void mist_net_run_self_test(void)
+{
+    const mist_rack_t small = {
+        .nozzle_count = 4,
+        .supply_length_m = 2.0f,
+        .supply_diameter_mm = 4.3f,
+        .riser_m = 0.6f,
+        .manifold_spacing_m = 0.3f,
+        .manifold_diameter_mm = 4.3f,
+        .drop_length_m = 0.1f,
+    };
+    // rack d'élevage : 50 buses, rampe 3/8" et pompe plus grosse
+    const mist_rack_t rack50 = {
+        .nozzle_count = 50,
+        .supply_length_m = 5.0f,
+        .supply_diameter_mm = 7.0f,
+        .riser_m = 1.8f,
+        .manifold_spacing_m = 0.25f,
+        .manifold_diameter_mm = 7.0f,
+        .drop_length_m = 0.15f,
+    };
+    const mist_rack_t starved = {
+        .nozzle_count = 24,
+        .supply_length_m = 6.0f,
+        .supply_diameter_mm = 4.3f,
+        .riser_m = 1.5f,
+        .manifold_spacing_m = 0.3f,
+        .manifold_diameter_mm = 4.3f,
+        .drop_length_m = 0.1f,
+    };
+
+    log_rack("4 buses", &small, 8.0f, 1.6f);
+    log_rack("rack 50", &rack50, 10.0f, 6.0f);
+    log_rack("pompe sous-dimensionnée", &starved, 8.0f, 1.6f);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "calc_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MIST_NET_MAX_NODES 128
+// Une rampe compte un nœud d'alimentation puis un té et une buse par buse
+#define MIST_NET_MAX_RACK_NOZZLES ((MIST_NET_MAX_NODES - 1) / 2)
+
+/**
+ * Nœud du réseau pompe → tubes → buses (arborescence). Chaque nœud est relié à
+ * son parent par un tronçon de tube ; les parents doivent précéder leurs
+ * enfants dans le tableau (parent < index), -1 désignant la sortie pompe.
+ */
+typedef struct {
+    int16_t parent;
+    float length_m;           // tronçon depuis le parent
+    float inner_diameter_mm;  // diamètre intérieur du tronçon
+    uint8_t fittings;         // coudes / tés sur le tronçon
+    float elevation_m;        // altitude du nœud au-dessus de la pompe
+    bool nozzle;              // une buse débouche sur ce nœud
+} mist_net_node_t;
+
+typedef struct {
+    uint16_t node_count;
+    mist_net_node_t nodes[MIST_NET_MAX_NODES];
+    float pump_shutoff_bar;     // pression pompe à débit nul
+    float pump_max_flow_l_min;  // débit pompe à pression nulle
+    float nozzle_flow_ml_min;   // débit nominal d'une buse...
+    float nozzle_rated_bar;     // ...à cette pression
+    float nozzle_min_bar;       // pression mini pour une brume fine (spec buse)
+    float hazen_c;              // coefficient Hazen-Williams (PE/PVC ≈ 140-150)
+    float fitting_equiv_m;      // longueur équivalente d'un raccord
+} mist_net_input_t;
+
+typedef struct {
+    bool valid;
+    bool converged;
+    uint16_t iterations;
+    float pump_pressure_bar;
+    float total_flow_ml_min;
+    float node_pressure_bar[MIST_NET_MAX_NODES];
+    float nozzle_flow_ml_min[MIST_NET_MAX_NODES]; // 0 pour les nœuds sans buse
+    uint16_t nozzle_count;
+    uint16_t farthest_nozzle;      // plus long trajet hydraulique depuis la pompe
+    float farthest_pressure_bar;
+    float farthest_flow_ml_min;
+    float min_nozzle_pressure_bar;
+    float max_nozzle_pressure_bar;
+    bool warning_far_nozzle_low;   // buse la plus éloignée sous la pression mini
+    bool warning_pump_overloaded;  // pompe à moins de 50 % de sa pression d'arrêt
+} mist_net_result_t;
+
+/**
+ * Rampe classique : tube d'alimentation pompe → rampe (avec dénivelé), puis
+ * buses réparties régulièrement le long de la rampe via un té et une courte
+ * descente.
+ */
+typedef struct {
+    uint16_t nozzle_count;
+    float supply_length_m;
+    float supply_diameter_mm;
+    float riser_m;             // dénivelé pompe → rampe
+    float manifold_spacing_m;  // entre deux tés
+    float manifold_diameter_mm;
+    float drop_length_m;       // té → buse
+} mist_rack_t;
+
+/**
+ * Espace de travail du solveur (environ 5 Kio), indexé 0 = sortie pompe,
+ * k + 1 = nœud k. Champs internes à mist_net_solve() ; chaque tâche qui
+ * résout un réseau a le sien, en statique ou sur le tas.
+ */
+typedef struct {
+    float head[MIST_NET_MAX_NODES + 1];
+    float step[MIST_NET_MAX_NODES + 1];
+    float residual[MIST_NET_MAX_NODES + 1];
+    float diag[MIST_NET_MAX_NODES + 1];
+    float offdiag[MIST_NET_MAX_NODES + 1];  // couplage avec le parent
+    float pipe_r[MIST_NET_MAX_NODES + 1];   // résistance Hazen-Williams (m / (L/min)^1.852)
+    float nozzle_k[MIST_NET_MAX_NODES + 1]; // L/min / sqrt(bar)
+    float trial[MIST_NET_MAX_NODES + 1];    // pas de Newton amorti à l'essai
+    float path[MIST_NET_MAX_NODES + 1];     // longueur hydraulique depuis la pompe
+    uint16_t parent[MIST_NET_MAX_NODES + 1];
+} mist_net_workspace_t;
+
+/** Paramètres pompe/buse/tube par défaut (pompe à membrane 8 bar, tube 1/4"). */
+void mist_net_default_input(mist_net_input_t *net);
+bool mist_net_build_rack(const mist_rack_t *rack, mist_net_input_t *net);
+/**
+ * Résout les pressions (Newton amorti, pertes Hazen-Williams, loi d'orifice
+ * aux buses, courbe pompe quadratique). `ws` et `out` sont volumineux : les
+ * allouer en statique ou sur le tas plutôt que sur une petite pile de tâche.
+ * Sans état partagé : deux tâches avec chacune leur `ws` peuvent résoudre en
+ * même temps.
+ */
+bool mist_net_solve(const mist_net_input_t *net, mist_net_workspace_t *ws, mist_net_result_t *out);
+void mist_net_run_self_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Vocabulaire scalaire des noyaux de calcul génériques.
+ *
+ * Chaque module écrit son noyau une seule fois (`calc_*_kernel.inc`) avec les
+ * macros CS_* ci-dessous, puis l'inclut une fois par mode :
+ * - CALC_SCALAR_FLOAT : float natif, utilisé par `*_calculate()` ;
+ * - CALC_SCALAR_DUAL  : nombres duaux (calc_dual.h), utilisé par `*_sensitivity()` ;
+ * - CALC_SCALAR_INTERVAL : intervalles (calc_interval.h), utilisé par `*_bounds()`.
+ *
+ * Pas de garde d'inclusion volontairement : le fichier est ré-inclus au début
+ * de chaque instanciation pour redéfinir les macros selon CALC_SCALAR_MODE.
+ * CS_MONO attend une fonction `float fn(float x, float *slope)` croissante
+ * (spline, arrondi catalogue, ceil) ; `slope` peut être NULL.
+ * CS_MONO_CTX fait de même pour `float fn(const void *ctx, float x, float *slope)`
+ * quand la fonction dépend d'un contexte figé (table choisie par matériau...).
+ * CS_VAL ne sert qu'aux branches de mode (valeur 0 = « auto ») : en mode
+ * intervalle il renvoie le milieu, la tolérance ne doit pas changer de mode.
+ */
+
+#ifndef CALC_SCALAR_FLOAT
+#define CALC_SCALAR_FLOAT 0
+#define CALC_SCALAR_DUAL  1
+#define CALC_SCALAR_INTERVAL 2
+
+#include <math.h>
+#include <stddef.h>
+
+static inline float calc_scalar_clampf(float v, float min, float max)
+{
+    if (v < min) {
+        return min;
+    }
+    if (v > max) {
+        return max;
+    }
+    return v;
+}
+
+/* Nombre d'unités (LED, buses...) : arrondi supérieur, jamais négatif. */
+static inline float calc_scalar_ceil(float v, float *slope)
+{
+    if (slope) {
+        *slope = 0.0f;
+    }
+    const float c = ceilf(v);
+    return (c > 0.0f) ? c : 0.0f;
+}
+#endif
+
+#ifndef CALC_SCALAR_MODE
+#error "Définir CALC_SCALAR_MODE avant d'inclure calc_scalar.h"
+#endif
+
+#undef CS_T
+#undef CS_FN
+#undef CS_C
+#undef CS_VAL
+#undef CS_ADD
+#undef CS_SUB
+#undef CS_MUL
+#undef CS_DIV
+#undef CS_MULF
+#undef CS_DIVF
+#undef CS_SUBF
+#undef CS_SQRT
+#undef CS_POWF
+#undef CS_CLAMP
+#undef CS_FMAX
+#undef CS_MAX
+#undef CS_MONO
+#undef CS_MONO_CTX
+#undef CS_STEP_LE
+
+#if CALC_SCALAR_MODE == CALC_SCALAR_FLOAT
+
+#define CS_T float
+#define CS_FN(name) name##_f
+#define CS_C(k) ((float)(k))
+#define CS_VAL(a) (a)
+#define CS_ADD(a, b) ((a) + (b))
+#define CS_SUB(a, b) ((a) - (b))
+#define CS_MUL(a, b) ((a) * (b))
+#define CS_DIV(a, b) ((a) / (b))
+#define CS_MULF(a, k) ((a) * (k))
+#define CS_DIVF(a, k) ((a) / (k))
+#define CS_SUBF(a, k) ((a) - (k))
+#define CS_SQRT(a) sqrtf(a)
+#define CS_POWF(a, e) powf((a), (e))
+#define CS_CLAMP(a, lo, hi) calc_scalar_clampf((a), (lo), (hi))
+#define CS_FMAX(a, k) fmaxf((a), (k))
+#define CS_MAX(a, b) fmaxf((a), (b))
+#define CS_MONO(a, fn) fn((a), NULL)
+#define CS_MONO_CTX(a, fn, ctx) fn((ctx), (a), NULL)
+#define CS_STEP_LE(x, t, a, b) (((x) <= (t)) ? (a) : (b))
+
+#elif CALC_SCALAR_MODE == CALC_SCALAR_DUAL
+
+#include "calc_dual.h"
+
+#define CS_T calc_dual_t
+#define CS_FN(name) name##_d
+#define CS_C(k) calc_dual_const(k)
+#define CS_VAL(a) ((a).v)
+#define CS_ADD(a, b) calc_dual_add((a), (b))
+#define CS_SUB(a, b) calc_dual_sub((a), (b))
+#define CS_MUL(a, b) calc_dual_mul((a), (b))
+#define CS_DIV(a, b) calc_dual_div((a), (b))
+#define CS_MULF(a, k) calc_dual_scale((a), (k))
+#define CS_DIVF(a, k) calc_dual_scale((a), 1.0f / (k))
+#define CS_SUBF(a, k) calc_dual_sub((a), calc_dual_const(k))
+#define CS_SQRT(a) calc_dual_sqrt(a)
+#define CS_POWF(a, e) calc_dual_powf((a), (e))
+#define CS_CLAMP(a, lo, hi) calc_dual_clamp((a), (lo), (hi))
+#define CS_FMAX(a, k) calc_dual_fmax((a), (k))
+#define CS_MAX(a, b) calc_dual_max((a), (b))
+#define CS_MONO(a, fn) calc_dual_mono((a), (fn))
+#define CS_MONO_CTX(a, fn, ctx) calc_dual_mono_ctx((a), (fn), (ctx))
+#define CS_STEP_LE(x, t, a, b) calc_dual_step_le((x), (t), (a), (b))
+
+#elif CALC_SCALAR_MODE == CALC_SCALAR_INTERVAL
+
+#include "calc_interval.h"
+
+#define CS_T calc_interval_t
+#define CS_FN(name) name##_i
+#define CS_C(k) calc_interval_const(k)
+#define CS_VAL(a) calc_interval_mid(a)
+#define CS_ADD(a, b) calc_interval_add((a), (b))
+#define CS_SUB(a, b) calc_interval_sub((a), (b))
+#define CS_MUL(a, b) calc_interval_mul((a), (b))
+#define CS_DIV(a, b) calc_interval_div((a), (b))
+#define CS_MULF(a, k) calc_interval_scale((a), (k))
+#define CS_DIVF(a, k) calc_interval_divf((a), (k))
+#define CS_SUBF(a, k) calc_interval_sub((a), calc_interval_const(k))
+#define CS_SQRT(a) calc_interval_sqrt(a)
+#define CS_POWF(a, e) calc_interval_powf((a), (e))
+#define CS_CLAMP(a, lo, hi) calc_interval_clamp((a), (lo), (hi))
+#define CS_FMAX(a, k) calc_interval_fmax((a), (k))
+#define CS_MAX(a, b) calc_interval_max((a), (b))
+#define CS_MONO(a, fn) calc_interval_mono((a), (fn))
+#define CS_MONO_CTX(a, fn, ctx) calc_interval_mono_ctx((a), (fn), (ctx))
+#define CS_STEP_LE(x, t, a, b) calc_interval_step_le((x), (t), (a), (b))
+
+#else
+#error "CALC_SCALAR_MODE inconnu"
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALC_SENS_MAX_INPUTS  8
+#define CALC_SENS_MAX_OUTPUTS 8
+
+/**
+ * Table de sensibilités d'un module : dérivées partielles de chaque sortie
+ * continue par rapport à chaque entrée, obtenues en une seule passe duale.
+ * Les sorties discrètes (nombre de LED, puissance catalogue) ont une dérivée
+ * nulle par construction et ne sont donc pas listées.
+ */
+typedef struct {
+    bool valid;
+    uint8_t input_count;
+    uint8_t output_count;
+    const char *input_names[CALC_SENS_MAX_INPUTS];
+    const char *output_names[CALC_SENS_MAX_OUTPUTS];
+    float input_values[CALC_SENS_MAX_INPUTS];
+    float output_values[CALC_SENS_MAX_OUTPUTS];
+    float partial[CALC_SENS_MAX_OUTPUTS][CALC_SENS_MAX_INPUTS]; /*!< ∂sortie/∂entrée */
+} calc_sensitivity_t;
+
+/**
+ * Élasticité (variation relative de la sortie pour 1 % de variation de
+ * l'entrée), pratique pour comparer des entrées d'unités différentes.
+ */
+static inline float calc_sensitivity_elasticity(const calc_sensitivity_t *s, uint8_t output, uint8_t input)
+{
+    const float y = s->output_values[output];
+    if (y == 0.0f) {
+        return 0.0f;
+    }
+    return s->partial[output][input] * s->input_values[input] / y;
+}
+
+#ifdef __cplusplus
+}
+#endif
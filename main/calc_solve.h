@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Résolution inverse commune aux modules : dichotomie à nombre d'itérations
+ * fixe sur un prédicat monotone (vrai puis faux quand x croît). Les sorties
+ * catalogue sont des marches d'escalier : on cherche donc la dernière valeur
+ * admissible plutôt qu'un zéro, et le coût reste constant quelle que soit
+ * l'entrée (CALC_SOLVE_ITERATIONS appels au calcul direct).
+ */
+#define CALC_SOLVE_ITERATIONS 32
+
+typedef bool (*calc_solve_pred_t)(const void *ctx, float x);
+
+/**
+ * Plus grand x de [lo, hi] pour lequel `pred` est vrai, à (hi-lo)/2^32 près.
+ * Renvoie false si `pred(lo)` est déjà faux ; renvoie `hi` si `pred(hi)` est vrai.
+ */
+static inline bool calc_solve_last_true(calc_solve_pred_t pred, const void *ctx, float lo, float hi, float *x)
+{
+    if (!pred(ctx, lo)) {
+        return false;
+    }
+    if (pred(ctx, hi)) {
+        *x = hi;
+        return true;
+    }
+    for (size_t i = 0; i < CALC_SOLVE_ITERATIONS; ++i) {
+        const float mid = lo + (hi - lo) * 0.5f;
+        if (mid <= lo || mid >= hi) {
+            break; // précision float atteinte
+        }
+        if (pred(ctx, mid)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    *x = lo;
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
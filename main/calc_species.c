@@ -0,0 +1,273 @@
+#include "calc_species.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#else
+#include <time.h>
+#endif
+
+#include "calc_species_table.inc"
+
+#define SPECIES_COUNT (sizeof(k_species) / sizeof(k_species[0]))
+#define INDEX_COUNT   (sizeof(k_species_index) / sizeof(k_species_index[0]))
+
+static int64_t now_us(void)
+{
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    return (int64_t)clock() * 1000000 / CLOCKS_PER_SEC;
+#endif
+}
+
+size_t species_count(void)
+{
+    return SPECIES_COUNT;
+}
+
+const species_t *species_get(size_t index)
+{
+    return (index < SPECIES_COUNT) ? &k_species[index] : NULL;
+}
+
+// Même normalisation que le générateur : minuscules ASCII, accents UTF-8
+// latins repliés, tout séparateur réduit à une espace.
+static size_t normalise_query(const char *in, char *out, size_t cap)
+{
+    size_t n = 0;
+    const unsigned char *p = (const unsigned char *)in;
+    while (*p && n + 2 < cap) {
+        char c = 0;
+        const char *pair = NULL;
+        if (*p < 0x80) {
+            c = (char)*p++;
+            if (c >= 'A' && c <= 'Z') {
+                c = (char)(c - 'A' + 'a');
+            }
+        } else if ((*p == 0xC3 || *p == 0xC5) && p[1]) {
+            const unsigned lead = p[0];
+            const unsigned cp = ((lead & 0x1Fu) << 6) | (p[1] & 0x3Fu);
+            p += 2;
+            if ((cp >= 0xC0 && cp <= 0xC5) || (cp >= 0xE0 && cp <= 0xE5)) {
+                c = 'a';
+            } else if (cp == 0xC7 || cp == 0xE7) {
+                c = 'c';
+            } else if ((cp >= 0xC8 && cp <= 0xCB) || (cp >= 0xE8 && cp <= 0xEB)) {
+                c = 'e';
+            } else if ((cp >= 0xCC && cp <= 0xCF) || (cp >= 0xEC && cp <= 0xEF)) {
+                c = 'i';
+            } else if (cp == 0xD1 || cp == 0xF1) {
+                c = 'n';
+            } else if ((cp >= 0xD2 && cp <= 0xD6) || (cp >= 0xF2 && cp <= 0xF6)) {
+                c = 'o';
+            } else if ((cp >= 0xD9 && cp <= 0xDC) || (cp >= 0xF9 && cp <= 0xFC)) {
+                c = 'u';
+            } else if (cp == 0x152 || cp == 0x153) {
+                pair = "oe";
+            }
+        } else {
+            ++p; // autre caractère multi-octets : traité comme séparateur
+            while ((*p & 0xC0u) == 0x80u) {
+                ++p;
+            }
+        }
+
+        if (pair) {
+            out[n++] = pair[0];
+            out[n++] = pair[1];
+        } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            out[n++] = c;
+        } else if (n > 0 && out[n - 1] != ' ') {
+            out[n++] = ' ';
+        }
+    }
+    // l'espace finale est gardée : « gecko » puis « gecko » + espace doit
+    // restreindre aux noms dont le mot suivant existe
+    out[n] = '\0';
+    return n;
+}
+
+static int key_compare(uint16_t index, const char *prefix, size_t len)
+{
+    return strncmp(&k_species_names[k_species_index[index].name_offset], prefix, len);
+}
+
+// Première clé >= préfixe dans [lo, hi)
+static uint16_t lower_bound(uint16_t lo, uint16_t hi, const char *prefix, size_t len)
+{
+    while (lo < hi) {
+        const uint16_t mid = (uint16_t)(lo + (hi - lo) / 2);
+        if (key_compare(mid, prefix, len) < 0) {
+            lo = (uint16_t)(mid + 1);
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Première clé qui ne commence plus par le préfixe dans [lo, hi)
+static uint16_t upper_bound(uint16_t lo, uint16_t hi, const char *prefix, size_t len)
+{
+    while (lo < hi) {
+        const uint16_t mid = (uint16_t)(lo + (hi - lo) / 2);
+        if (key_compare(mid, prefix, len) <= 0) {
+            lo = (uint16_t)(mid + 1);
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void species_search_reset(species_search_t *s)
+{
+    if (!s) {
+        return;
+    }
+    memset(s, 0, sizeof(*s));
+    s->hi = (uint16_t)INDEX_COUNT;
+}
+
+void species_search_update(species_search_t *s, const char *query)
+{
+    if (!s) {
+        return;
+    }
+    char norm[SPECIES_QUERY_MAX];
+    const size_t len = normalise_query(query ? query : "", norm, sizeof(norm));
+
+    // frappe supplémentaire : on ne cherche que dans la plage précédente
+    const size_t prev_len = strlen(s->query);
+    uint16_t lo = 0;
+    uint16_t hi = (uint16_t)INDEX_COUNT;
+    if (prev_len > 0 && prev_len <= len && strncmp(norm, s->query, prev_len) == 0) {
+        lo = s->lo;
+        hi = s->hi;
+    }
+    if (len > 0) {
+        lo = lower_bound(lo, hi, norm, len);
+        hi = upper_bound(lo, hi, norm, len);
+    }
+    memcpy(s->query, norm, len + 1);
+    s->lo = lo;
+    s->hi = hi;
+    s->match_count = (uint16_t)(hi - lo);
+
+    // résultats uniques dans l'ordre alphabétique des clés
+    s->result_count = 0;
+    for (uint16_t i = lo; i < hi && s->result_count < SPECIES_MAX_RESULTS; ++i) {
+        const uint16_t sp = k_species_index[i].species;
+        bool dup = false;
+        for (uint8_t r = 0; r < s->result_count; ++r) {
+            if (s->results[r] == sp) {
+                dup = true;
+                break;
+            }
+        }
+        if (!dup) {
+            s->results[s->result_count++] = sp;
+        }
+    }
+}
+
+void species_fill_inputs(const species_t *sp,
+                         heating_pad_input_t *pad,
+                         heating_cable_input_t *cable,
+                         lighting_input_t *lighting,
+                         substrate_input_t *substrate,
+                         misting_input_t *misting)
+{
+    if (!sp) {
+        return;
+    }
+    const float length = sp->length_cm;
+    const float depth = sp->depth_cm;
+    const float height = sp->height_cm;
+    const float ratio = sp->heated_ratio_pct / 100.0f;
+
+    if (pad) {
+        pad->length_cm = length;
+        pad->depth_cm = depth;
+        pad->height_cm = height;
+        pad->heated_ratio = ratio;
+    }
+    if (cable) {
+        cable->length_cm = length;
+        cable->depth_cm = depth;
+        cable->heated_ratio = ratio;
+    }
+    if (lighting) {
+        lighting->length_cm = length;
+        lighting->depth_cm = depth;
+        lighting->height_cm = height;
+        lighting->environment = (terrarium_environment_t)sp->environment;
+    }
+    if (substrate) {
+        substrate->length_cm = length;
+        substrate->depth_cm = depth;
+        substrate->height_cm = height;
+        substrate->substrate_height_cm = sp->substrate_height_cm;
+        substrate->type = (substrate_type_t)sp->substrate;
+    }
+    if (misting) {
+        misting->length_cm = length;
+        misting->depth_cm = depth;
+        misting->environment = (mist_environment_t)sp->mist_environment;
+    }
+}
+
+void species_run_self_test(void)
+{
+    bool sorted = true;
+    for (size_t i = 1; i < INDEX_COUNT; ++i) {
+        if (strcmp(&k_species_names[k_species_index[i - 1].name_offset],
+                   &k_species_names[k_species_index[i].name_offset]) > 0) {
+            sorted = false;
+            break;
+        }
+    }
+    printf("[TEST espèces] %u fiches, %u clés, index trié : %s\n",
+           (unsigned)SPECIES_COUNT,
+           (unsigned)INDEX_COUNT,
+           sorted ? "OK" : "ÉCHEC");
+
+    // Saisie lettre par lettre comme au clavier, accents compris
+    static species_search_t s;
+    species_search_reset(&s);
+    const char *typed = "Gecko léopard";
+    char partial[SPECIES_QUERY_MAX];
+    int64_t worst_us = 0;
+    for (size_t n = 1; typed[n - 1] != '\0'; ++n) {
+        memcpy(partial, typed, n);
+        partial[n] = '\0';
+        const int64_t t0 = now_us();
+        species_search_update(&s, partial);
+        const int64_t dt = now_us() - t0;
+        worst_us = (dt > worst_us) ? dt : worst_us;
+    }
+    const species_t *first = s.result_count ? species_get(s.results[0]) : NULL;
+    printf("[TEST espèces] « %s » -> %s (%u résultat(s)), pire frappe %lld µs %s\n",
+           typed,
+           first ? first->latin_name : "aucun",
+           s.result_count,
+           (long long)worst_us,
+           (first && strcmp(first->latin_name, "Eublepharis macularius") == 0 && worst_us < 5000) ? "OK" : "ÉCHEC");
+
+    species_search_update(&s, "vitti");
+    first = s.result_count ? species_get(s.results[0]) : NULL;
+    heating_pad_input_t pad = {0};
+    lighting_input_t light = {0};
+    species_fill_inputs(first, &pad, NULL, &light, NULL, NULL);
+    printf("[TEST espèces] « vitti » -> %s : bac %.0f×%.0f×%.0f cm, zone %u, ratio %.2f %s\n",
+           first ? first->common_name : "aucun",
+           pad.length_cm,
+           pad.depth_cm,
+           pad.height_cm,
+           first ? first->ferguson_zone : 0,
+           pad.heated_ratio,
+           (first && light.environment == TERRARIUM_ENV_DESERTIC) ? "OK" : "ÉCHEC");
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "calc_common.h"
+#include "calc_heating_cable.h"
+#include "calc_heating_pad.h"
+#include "calc_lighting.h"
+#include "calc_misting.h"
+#include "calc_substrate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPECIES_QUERY_MAX   32
+#define SPECIES_MAX_RESULTS 8
+
+/**
+ * Fiche espèce en flash : conditions de maintenance et gabarit de terrarium
+ * adulte. Les enums sont stockés sur un octet pour garder la table compacte.
+ */
+typedef struct {
+    const char *common_name;
+    const char *latin_name;
+    uint8_t ferguson_zone;      // 1-4
+    uint8_t environment;        // terrarium_environment_t
+    uint8_t mist_environment;   // mist_environment_t
+    uint8_t lux_min_klux;
+    uint8_t lux_max_klux;
+    uint8_t humidity_min_pct;
+    uint8_t humidity_max_pct;
+    int8_t temp_cool_c;
+    int8_t temp_hot_c;
+    int8_t temp_basking_c;
+    uint8_t substrate;          // substrate_type_t
+    uint8_t heated_ratio_pct;
+    uint8_t substrate_height_cm;
+    uint16_t length_cm;
+    uint16_t depth_cm;
+    uint16_t height_cm;
+} species_t;
+
+/** Entrée de l'index trié : début de mot dans le réservoir de noms normalisés. */
+typedef struct {
+    uint16_t name_offset;
+    uint16_t species;
+} species_key_t;
+
+/**
+ * État de recherche incrémentale : la plage d'index de la requête précédente
+ * sert de point de départ quand l'utilisateur ajoute un caractère.
+ */
+typedef struct {
+    char query[SPECIES_QUERY_MAX];
+    uint16_t lo;
+    uint16_t hi;
+    uint8_t result_count;
+    uint16_t results[SPECIES_MAX_RESULTS];
+    uint16_t match_count; // clés correspondantes (une espèce peut en avoir plusieurs)
+} species_search_t;
+
+size_t species_count(void);
+const species_t *species_get(size_t index);
+
+void species_search_reset(species_search_t *s);
+/**
+ * Met à jour les résultats pour `query` (accents et casse ignorés, préfixe de
+ * n'importe quel mot du nom commun ou latin). O(log n) par frappe.
+ */
+void species_search_update(species_search_t *s, const char *query);
+
+/**
+ * Recopie les conditions de l'espèce dans les entrées des modules. Seuls les
+ * champs dépendant de l'animal sont modifiés (dimensions, biotope, ratio
+ * chauffé, substrat) ; le matériel saisi (LED, câble, buses) est conservé.
+ * Chaque pointeur peut être NULL.
+ */
+void species_fill_inputs(const species_t *sp,
+                         heating_pad_input_t *pad,
+                         heating_cable_input_t *cable,
+                         lighting_input_t *lighting,
+                         substrate_input_t *substrate,
+                         misting_input_t *misting);
+
+void species_run_self_test(void);
+
+#ifdef __cplusplus
+}
+#endif
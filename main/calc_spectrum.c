@@ -0,0 +1,230 @@
+#include "calc_spectrum.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#if defined(ESP_PLATFORM) && CONFIG_IDF_TARGET_ESP32S3
+#include "dsps_dotprod.h"
+#define SPECTRUM_USE_ESP_DSP 1
+#else
+#define SPECTRUM_USE_ESP_DSP 0
+#endif
+
+// Constantes physiques pour la conversion W -> µmol de photons
+#define PLANCK_H 6.62607015e-34
+#define LIGHT_C 2.99792458e8
+#define AVOGADRO 6.02214076e23
+
+typedef struct {
+    float center_nm;
+    float sigma_nm;
+    float weight;
+} spectrum_peak_t;
+
+typedef struct {
+    const spectrum_peak_t *peaks;
+    size_t count;
+} spectrum_model_t;
+
+// Modèles gaussiens approximatifs, à remplacer par des mesures au spectromètre
+// quand elles existent. Seules les proportions comptent : chaque spectre est
+// normalisé à 1 W.
+static const spectrum_peak_t k_led_6500k[] = {
+    {.center_nm = 450.0f, .sigma_nm = 10.0f, .weight = 0.32f}, // pompe bleue InGaN
+    {.center_nm = 555.0f, .sigma_nm = 55.0f, .weight = 0.68f}, // phosphore YAG
+};
+static const spectrum_peak_t k_uva[] = {
+    {.center_nm = 365.0f, .sigma_nm = 9.0f, .weight = 0.92f},
+    {.center_nm = 405.0f, .sigma_nm = 4.0f, .weight = 0.08f},
+};
+// Tube T5 UVB type 12 % : phosphore UVB, phosphore UVA et raies du mercure
+static const spectrum_peak_t k_t5_uvb[] = {
+    {.center_nm = 311.0f, .sigma_nm = 8.0f, .weight = 0.12f},
+    {.center_nm = 350.0f, .sigma_nm = 18.0f, .weight = 0.48f},
+    {.center_nm = 405.0f, .sigma_nm = 2.0f, .weight = 0.06f},
+    {.center_nm = 436.0f, .sigma_nm = 2.0f, .weight = 0.10f},
+    {.center_nm = 546.0f, .sigma_nm = 2.0f, .weight = 0.14f},
+    {.center_nm = 578.0f, .sigma_nm = 2.0f, .weight = 0.05f},
+    {.center_nm = 610.0f, .sigma_nm = 15.0f, .weight = 0.05f},
+};
+
+static const spectrum_model_t k_models[SPECTRUM_LAMP_COUNT] = {
+    [SPECTRUM_LAMP_LED_6500K] = {.peaks = k_led_6500k, .count = sizeof(k_led_6500k) / sizeof(k_led_6500k[0])},
+    [SPECTRUM_LAMP_UVA] = {.peaks = k_uva, .count = sizeof(k_uva) / sizeof(k_uva[0])},
+    [SPECTRUM_LAMP_T5_UVB] = {.peaks = k_t5_uvb, .count = sizeof(k_t5_uvb) / sizeof(k_t5_uvb[0])},
+};
+
+// Spectre d'action pré-vitamine D3 (CIE 174:2006) tabulé tous les 5 nm à
+// partir de 280 nm, normalisé à 1 au maximum ; nul au-delà de 330 nm.
+static const float k_previtd3_5nm[] = {0.86f, 0.92f, 0.97f, 1.00f, 0.88f, 0.55f, 0.22f, 0.055f, 0.011f, 0.0025f, 0.0f};
+
+static float s_weights[SPECTRUM_WEIGHT_COUNT][SPECTRUM_BINS_PADDED] __attribute__((aligned(16)));
+static float s_lamp[SPECTRUM_BINS_PADDED] __attribute__((aligned(16)));
+static spectrum_totals_t s_totals[SPECTRUM_LAMP_COUNT];
+static bool s_weights_ready;
+static bool s_totals_ready[SPECTRUM_LAMP_COUNT];
+
+float spectrum_dot(const float *a, const float *b, size_t n)
+{
+#if SPECTRUM_USE_ESP_DSP
+    float r = 0.0f;
+    dsps_dotprod_f32(a, b, &r, (int)n);
+    return r;
+#else
+    // 4 accumulateurs indépendants : le compilateur peut vectoriser et la
+    // chaîne de dépendance des additions est divisée par 4.
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+    const size_t n4 = n & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4) {
+        acc0 += a[i] * b[i];
+        acc1 += a[i + 1] * b[i + 1];
+        acc2 += a[i + 2] * b[i + 2];
+        acc3 += a[i + 3] * b[i + 3];
+    }
+    for (size_t i = n4; i < n; ++i) {
+        acc0 += a[i] * b[i];
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+#endif
+}
+
+static float photopic(float nm)
+{
+    // Ajustement gaussien de V(λ) (CIE 1924), erreur < 2 % sur 420-680 nm
+    const float um = nm * 1e-3f - 0.559f;
+    return 1.019f * expf(-285.4f * um * um);
+}
+
+static float erythema(float nm)
+{
+    // CIE 1998 (ISO 17166)
+    if (nm <= 298.0f) {
+        return 1.0f;
+    }
+    if (nm <= 328.0f) {
+        return powf(10.0f, 0.094f * (298.0f - nm));
+    }
+    if (nm <= 400.0f) {
+        return powf(10.0f, 0.015f * (140.0f - nm));
+    }
+    return 0.0f;
+}
+
+static float previtd3(float nm)
+{
+    const size_t n = sizeof(k_previtd3_5nm) / sizeof(k_previtd3_5nm[0]);
+    const float pos = (nm - (float)SPECTRUM_LAMBDA_MIN_NM) / 5.0f;
+    if (pos < 0.0f || pos >= (float)(n - 1)) {
+        return 0.0f;
+    }
+    const size_t idx = (size_t)pos;
+    const float t = pos - (float)idx;
+    return k_previtd3_5nm[idx] + t * (k_previtd3_5nm[idx + 1] - k_previtd3_5nm[idx]);
+}
+
+static void build_weights(void)
+{
+    // µmol/J pour un photon de longueur d'onde λ : λ / (h c N_A) × 1e6
+    const float umol_per_j_per_nm = (float)(1e-9 / (PLANCK_H * LIGHT_C * AVOGADRO) * 1e6);
+
+    memset(s_weights, 0, sizeof(s_weights));
+    for (int i = 0; i < SPECTRUM_BINS; ++i) {
+        const float nm = (float)(SPECTRUM_LAMBDA_MIN_NM + i);
+        s_weights[SPECTRUM_WEIGHT_PHOTOPIC][i] = 683.0f * photopic(nm);
+        s_weights[SPECTRUM_WEIGHT_PAR][i] = (nm >= 400.0f && nm <= 700.0f) ? nm * umol_per_j_per_nm : 0.0f;
+        s_weights[SPECTRUM_WEIGHT_ERYTHEMA][i] = 40.0f * erythema(nm);
+        s_weights[SPECTRUM_WEIGHT_PREVITD3][i] = previtd3(nm);
+        s_weights[SPECTRUM_WEIGHT_UVA][i] = (nm >= 315.0f && nm < 400.0f) ? 0.1f : 0.0f; // W/m² -> mW/cm²
+    }
+    s_weights_ready = true;
+}
+
+static void build_lamp(spectrum_lamp_t lamp)
+{
+    const spectrum_model_t *m = &k_models[lamp];
+    memset(s_lamp, 0, sizeof(s_lamp));
+    for (int i = 0; i < SPECTRUM_BINS; ++i) {
+        const float nm = (float)(SPECTRUM_LAMBDA_MIN_NM + i);
+        float v = 0.0f;
+        for (size_t p = 0; p < m->count; ++p) {
+            const float z = (nm - m->peaks[p].center_nm) / m->peaks[p].sigma_nm;
+            v += m->peaks[p].weight * expf(-0.5f * z * z) / m->peaks[p].sigma_nm;
+        }
+        s_lamp[i] = v;
+    }
+
+    // normalisation à 1 W/m² sur la grille (pas de 1 nm)
+    float total = 0.0f;
+    for (int i = 0; i < SPECTRUM_BINS; ++i) {
+        total += s_lamp[i];
+    }
+    if (total > 0.0f) {
+        const float inv = 1.0f / total;
+        for (int i = 0; i < SPECTRUM_BINS; ++i) {
+            s_lamp[i] *= inv;
+        }
+    }
+}
+
+const spectrum_totals_t *spectrum_lamp_totals(spectrum_lamp_t lamp)
+{
+    if ((unsigned)lamp >= SPECTRUM_LAMP_COUNT) {
+        return NULL;
+    }
+    if (!s_totals_ready[lamp]) {
+        if (!s_weights_ready) {
+            build_weights();
+        }
+        build_lamp(lamp);
+        for (int w = 0; w < SPECTRUM_WEIGHT_COUNT; ++w) {
+            s_totals[lamp].weighted[w] = spectrum_dot(s_lamp, s_weights[w], SPECTRUM_BINS_PADDED);
+        }
+        s_totals_ready[lamp] = true;
+    }
+    return &s_totals[lamp];
+}
+
+void spectrum_init(void)
+{
+    for (int l = 0; l < SPECTRUM_LAMP_COUNT; ++l) {
+        spectrum_lamp_totals((spectrum_lamp_t)l);
+    }
+}
+
+float spectrum_convert(spectrum_lamp_t lamp, spectrum_weight_t from, spectrum_weight_t to, float value)
+{
+    const spectrum_totals_t *t = spectrum_lamp_totals(lamp);
+    if (!t || (unsigned)from >= SPECTRUM_WEIGHT_COUNT || (unsigned)to >= SPECTRUM_WEIGHT_COUNT) {
+        return 0.0f;
+    }
+    const float per_w_from = t->weighted[from];
+    if (per_w_from <= 0.0f) {
+        return 0.0f;
+    }
+    return value * t->weighted[to] / per_w_from;
+}
+
+void spectrum_run_self_test(void)
+{
+    static const char *const names[SPECTRUM_LAMP_COUNT] = {"LED 6500K", "UVA", "T5 UVB"};
+    for (int l = 0; l < SPECTRUM_LAMP_COUNT; ++l) {
+        const spectrum_totals_t *t = spectrum_lamp_totals((spectrum_lamp_t)l);
+        printf("[TEST spectre %s] %.0f lm/W, %.2f µmol/J PAR, UVI %.2f /(W/m²), D3 %.3f, UVA %.3f mW/cm² par W/m²\n",
+               names[l],
+               t->weighted[SPECTRUM_WEIGHT_PHOTOPIC],
+               t->weighted[SPECTRUM_WEIGHT_PAR],
+               t->weighted[SPECTRUM_WEIGHT_ERYTHEMA],
+               t->weighted[SPECTRUM_WEIGHT_PREVITD3],
+               t->weighted[SPECTRUM_WEIGHT_UVA]);
+    }
+    // repère : une LED blanche froide donne ~1 µmol/m²/s pour 60-70 lux
+    const spectrum_totals_t *t5 = spectrum_lamp_totals(SPECTRUM_LAMP_T5_UVB);
+    printf("[TEST spectre] 10 000 lux LED 6500K -> %.0f µmol/m²/s PPFD ; T5 UVB : D3/érythème = %.2f\n",
+           spectrum_convert(SPECTRUM_LAMP_LED_6500K, SPECTRUM_WEIGHT_PHOTOPIC, SPECTRUM_WEIGHT_PAR, 10000.0f),
+           t5->weighted[SPECTRUM_WEIGHT_PREVITD3] / (t5->weighted[SPECTRUM_WEIGHT_ERYTHEMA] / 40.0f));
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Grille spectrale : 1 nm de 280 à 780 nm, complétée par des zéros jusqu'à un
+// multiple de 16 pour les produits scalaires vectoriels.
+#define SPECTRUM_LAMBDA_MIN_NM 280
+#define SPECTRUM_LAMBDA_MAX_NM 780
+#define SPECTRUM_BINS (SPECTRUM_LAMBDA_MAX_NM - SPECTRUM_LAMBDA_MIN_NM + 1)
+#define SPECTRUM_BINS_PADDED 512
+
+typedef enum {
+    SPECTRUM_LAMP_LED_6500K = 0,
+    SPECTRUM_LAMP_UVA,
+    SPECTRUM_LAMP_T5_UVB,
+    SPECTRUM_LAMP_COUNT
+} spectrum_lamp_t;
+
+/**
+ * Courbes de pondération. Les totaux sont exprimés pour 1 W/m² d'éclairement
+ * énergétique de la lampe :
+ * - PHOTOPIC : lux (683 lm/W × V(λ)) ;
+ * - PAR      : µmol/m²/s de photons 400-700 nm (PPFD) ;
+ * - ERYTHEMA : UVI (CIE 1998 × 40 m²/W) ;
+ * - PREVITD3 : W/m² pondéré pré-vitamine D3 (CIE 174:2006) ;
+ * - UVA      : mW/cm² dans la bande 315-400 nm.
+ */
+typedef enum {
+    SPECTRUM_WEIGHT_PHOTOPIC = 0,
+    SPECTRUM_WEIGHT_PAR,
+    SPECTRUM_WEIGHT_ERYTHEMA,
+    SPECTRUM_WEIGHT_PREVITD3,
+    SPECTRUM_WEIGHT_UVA,
+    SPECTRUM_WEIGHT_COUNT
+} spectrum_weight_t;
+
+typedef struct {
+    float weighted[SPECTRUM_WEIGHT_COUNT];
+} spectrum_totals_t;
+
+/**
+ * Calcule les totaux de toutes les lampes. À appeler une fois au démarrage,
+ * avant que plusieurs tâches ou fils n'utilisent le module : ensuite les
+ * tables ne sont plus que lues.
+ */
+void spectrum_init(void);
+
+/**
+ * Totaux pondérés d'une lampe. Sans spectrum_init() préalable, calculés au
+ * premier appel puis mis en cache, sans synchronisation.
+ */
+const spectrum_totals_t *spectrum_lamp_totals(spectrum_lamp_t lamp);
+
+/**
+ * Convertit une grandeur pondérée en une autre pour le même spectre, p. ex.
+ * lux -> PPFD ou UVA (mW/cm²) -> UVI. Retourne 0 si la pondération source est
+ * nulle pour cette lampe.
+ */
+float spectrum_convert(spectrum_lamp_t lamp, spectrum_weight_t from, spectrum_weight_t to, float value);
+
+/** Produit scalaire float (esp-dsp sur ESP32-S3, 4 accumulateurs ailleurs). */
+float spectrum_dot(const float *a, const float *b, size_t n);
+
+void spectrum_run_self_test(void);
+
+#ifdef __cplusplus
+}
+#endif
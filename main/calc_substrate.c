@@ -1,6 +1,11 @@
 #include "calc_substrate.h"
 
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "calc_dual.h"
+#include "calc_interval.h"
 
 typedef struct {
     float density_min_kg_per_l;
@@ -21,28 +26,48 @@ static const substrate_density_t density_table[SUBSTRATE_COUNT] = {
     [SUBSTRATE_SAND_SOIL] = {.density_min_kg_per_l = 1.00f, .density_max_kg_per_l = 1.30f},
 };
 
+#define CALC_SCALAR_MODE CALC_SCALAR_FLOAT
+#include "calc_substrate_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_DUAL
+#include "calc_substrate_kernel.inc"
+#undef CALC_SCALAR_MODE
+#define CALC_SCALAR_MODE CALC_SCALAR_INTERVAL
+#include "calc_substrate_kernel.inc"
+#undef CALC_SCALAR_MODE
+
+static bool inputs_valid(const substrate_input_t *in)
+{
+    return in && in->length_cm >= 20.0f && in->depth_cm >= 20.0f && in->substrate_height_cm > 0.0f;
+}
+
 bool substrate_calculate(const substrate_input_t *in, substrate_result_t *out)
 {
     if (!in || !out) {
         return false;
     }
-    if (in->length_cm < 20.0f || in->depth_cm < 20.0f || in->substrate_height_cm <= 0.0f) {
+    if (!inputs_valid(in)) {
         return false;
     }
 
     const substrate_density_t d = density_table[in->type];
     substrate_result_t r = {0};
-    const float volume_l = (in->length_cm * in->depth_cm * in->substrate_height_cm) / 1000.0f;
-    const float density_mid = (d.density_min_kg_per_l + d.density_max_kg_per_l) * 0.5f;
+    const substrate_vars_f v = {
+        .length_cm = in->length_cm,
+        .depth_cm = in->depth_cm,
+        .substrate_height_cm = in->substrate_height_cm,
+    };
+    substrate_out_f k;
+    substrate_kernel_f(&d, &v, &k);
 
-    r.valid = volume_l > 0.0f;
-    r.volume_l = volume_l;
+    r.valid = k.volume_l > 0.0f;
+    r.volume_l = k.volume_l;
     r.density_min_kg_per_l = d.density_min_kg_per_l;
     r.density_max_kg_per_l = d.density_max_kg_per_l;
-    r.density_kg_per_l = density_mid;
-    r.mass_min_kg = volume_l * d.density_min_kg_per_l;
-    r.mass_max_kg = volume_l * d.density_max_kg_per_l;
-    r.mass_kg = volume_l * density_mid;
+    r.density_kg_per_l = (d.density_min_kg_per_l + d.density_max_kg_per_l) * 0.5f;
+    r.mass_min_kg = k.mass_min_kg;
+    r.mass_max_kg = k.mass_max_kg;
+    r.mass_kg = k.mass_kg;
     r.warning_dimensions_small = (in->length_cm < 40.0f || in->depth_cm < 40.0f);
     r.warning_height_low = in->substrate_height_cm < 3.0f;
 
@@ -50,6 +75,233 @@ bool substrate_calculate(const substrate_input_t *in, substrate_result_t *out)
     return true;
 }
 
+bool substrate_sensitivity(const substrate_input_t *in, calc_sensitivity_t *out)
+{
+    if (!out || !inputs_valid(in)) {
+        return false;
+    }
+
+    const substrate_density_t d = density_table[in->type];
+    const substrate_vars_d v = {
+        .length_cm = calc_dual_var(in->length_cm, 0),
+        .depth_cm = calc_dual_var(in->depth_cm, 1),
+        .substrate_height_cm = calc_dual_var(in->substrate_height_cm, 2),
+    };
+    substrate_out_d k;
+    substrate_kernel_d(&d, &v, &k);
+
+    calc_sensitivity_t s = {
+        .valid = true,
+        .input_count = 3,
+        .input_names = {"Longueur (cm)", "Profondeur (cm)", "Épaisseur substrat (cm)"},
+        .input_values = {in->length_cm, in->depth_cm, in->substrate_height_cm},
+    };
+    calc_dual_to_sensitivity(&s, "Volume (L)", k.volume_l);
+    calc_dual_to_sensitivity(&s, "Masse (kg)", k.mass_kg);
+    *out = s;
+    return true;
+}
+
+void substrate_default_tolerance(const substrate_input_t *in, substrate_input_t *tol)
+{
+    const substrate_input_t t = {
+        .length_cm = CALC_TOL_TAPE_CM,
+        .depth_cm = CALC_TOL_TAPE_CM,
+        .height_cm = CALC_TOL_TAPE_CM,
+        .substrate_height_cm = CALC_TOL_TAPE_CM,
+        .type = in ? in->type : SUBSTRATE_SOIL,
+    };
+    *tol = t;
+}
+
+bool substrate_bounds(const substrate_input_t *in, const substrate_input_t *tol, calc_bounds_t *out)
+{
+    if (!out || !tol || !inputs_valid(in)) {
+        return false;
+    }
+
+    const substrate_density_t d = density_table[in->type];
+    const substrate_vars_i v = {
+        .length_cm = calc_interval_around(in->length_cm, tol->length_cm),
+        .depth_cm = calc_interval_around(in->depth_cm, tol->depth_cm),
+        .substrate_height_cm = calc_interval_around(in->substrate_height_cm, tol->substrate_height_cm),
+    };
+    substrate_out_i k;
+    substrate_kernel_i(&d, &v, &k);
+
+    calc_bounds_t b = {.valid = true};
+    calc_interval_to_bounds(&b, "Volume (L)", k.volume_l);
+    // la dispersion de densité du matériau s'ajoute à celle des cotes
+    calc_interval_to_bounds(&b, "Masse (kg)", (calc_interval_t){.lo = k.mass_min_kg.lo, .hi = k.mass_max_kg.hi});
+    *out = b;
+    return true;
+}
+
+// Prix indicatifs animalerie/jardinerie ; le rendement est le volume utile
+// (brique coco 5 kg -> 70-80 L : on retient le bas de la fourchette).
+static const substrate_package_t k_builtin_packages[] = {
+    {.name = "Terreau 20 L", .type = SUBSTRATE_SOIL, .yield_l = 20.0f, .price_eur = 6.90f},
+    {.name = "Terreau 40 L", .type = SUBSTRATE_SOIL, .yield_l = 40.0f, .price_eur = 9.90f},
+    {.name = "Terreau 70 L", .type = SUBSTRATE_SOIL, .yield_l = 70.0f, .price_eur = 14.90f},
+    {.name = "Brique coco 650 g", .type = SUBSTRATE_COCO, .yield_l = 8.0f, .price_eur = 3.50f},
+    {.name = "Brique coco 5 kg", .type = SUBSTRATE_COCO, .yield_l = 70.0f, .price_eur = 19.90f},
+    {.name = "Mélange forestier 10 L", .type = SUBSTRATE_FOREST_BLEND, .yield_l = 10.0f, .price_eur = 12.90f},
+    {.name = "Mélange forestier 26 L", .type = SUBSTRATE_FOREST_BLEND, .yield_l = 26.0f, .price_eur = 24.90f},
+    {.name = "Sable seau 5 kg", .type = SUBSTRATE_SAND, .yield_l = 3.1f, .price_eur = 7.90f},
+    {.name = "Sable sac 25 kg", .type = SUBSTRATE_SAND, .yield_l = 15.6f, .price_eur = 6.50f},
+    {.name = "Sable/terre 10 L", .type = SUBSTRATE_SAND_SOIL, .yield_l = 10.0f, .price_eur = 11.90f},
+    {.name = "Sable/terre 20 L", .type = SUBSTRATE_SAND_SOIL, .yield_l = 20.0f, .price_eur = 18.90f},
+};
+
+static const substrate_package_t *s_packages = k_builtin_packages;
+static size_t s_package_count = sizeof(k_builtin_packages) / sizeof(k_builtin_packages[0]);
+
+const substrate_package_t *substrate_package_table(size_t *count)
+{
+    if (count) {
+        *count = s_package_count;
+    }
+    return s_packages;
+}
+
+bool substrate_package_table_override(const substrate_package_t *table, size_t count)
+{
+    if (!table || count == 0) {
+        s_packages = k_builtin_packages;
+        s_package_count = sizeof(k_builtin_packages) / sizeof(k_builtin_packages[0]);
+        return true;
+    }
+    // une ligne d'achat par conditionnement : au plus SUBSTRATE_MAX_PACKAGE_LINES par substrat
+    uint8_t per_type[SUBSTRATE_COUNT] = {0};
+    for (size_t i = 0; i < count; ++i) {
+        if (table[i].type >= SUBSTRATE_COUNT || ++per_type[table[i].type] > SUBSTRATE_MAX_PACKAGE_LINES) {
+            return false;
+        }
+    }
+    s_packages = table;
+    s_package_count = count;
+    return true;
+}
+
+#define PLAN_UNIT_L 0.5f
+#define PLAN_WASTE_CENTS_PER_UNIT 3     // reste inutilisé : 0,06 €/L de pénalité
+#define PLAN_NO_COST UINT32_MAX
+
+static bool plan_layer(const substrate_layer_t *layer, substrate_plan_workspace_t *ws, substrate_layer_plan_t *plan)
+{
+    memset(plan, 0, sizeof(*plan));
+
+    // conditionnements de ce substrat ; rendement arrondi au demi-litre inférieur
+    uint8_t idx[SUBSTRATE_MAX_PACKAGE_LINES];
+    uint16_t units[SUBSTRATE_MAX_PACKAGE_LINES];
+    uint32_t cents[SUBSTRATE_MAX_PACKAGE_LINES];
+    uint8_t n = 0;
+    uint16_t max_units = 0;
+    for (size_t i = 0; i < s_package_count; ++i) {
+        const substrate_package_t *p = &s_packages[i];
+        const uint16_t u = (uint16_t)(p->yield_l / PLAN_UNIT_L);
+        if (p->type != layer->type || u == 0 || p->price_eur < 0.0f) {
+            continue;
+        }
+        if (n == SUBSTRATE_MAX_PACKAGE_LINES) {
+            return false; // table refusée par substrate_package_table_override()
+        }
+        idx[n] = (uint8_t)i;
+        units[n] = u;
+        cents[n] = (uint32_t)lroundf(p->price_eur * 100.0f);
+        max_units = (u > max_units) ? u : max_units;
+        ++n;
+    }
+    if (n == 0) {
+        return false;
+    }
+
+    const uint32_t need = (uint32_t)ceilf(layer->volume_l / PLAN_UNIT_L);
+    // au-delà de need + plus gros conditionnement, une solution contient un
+    // paquet retirable : inutile de chercher plus loin
+    const uint32_t cap = need + max_units;
+    if (cap > SUBSTRATE_PLAN_MAX_UNITS) {
+        return false;
+    }
+
+    ws->cost[0] = 0;
+    ws->last[0] = -1;
+    for (uint32_t c = 1; c <= cap; ++c) {
+        ws->cost[c] = PLAN_NO_COST;
+        ws->last[c] = -1;
+        for (uint8_t j = 0; j < n; ++j) {
+            if (units[j] <= c && ws->cost[c - units[j]] != PLAN_NO_COST) {
+                const uint32_t cost = ws->cost[c - units[j]] + cents[j];
+                if (cost < ws->cost[c]) {
+                    ws->cost[c] = cost;
+                    ws->last[c] = (int8_t)j;
+                }
+            }
+        }
+    }
+
+    uint32_t best_c = 0;
+    uint32_t best_score = PLAN_NO_COST;
+    for (uint32_t c = need; c <= cap; ++c) {
+        if (ws->cost[c] == PLAN_NO_COST) {
+            continue;
+        }
+        const uint32_t score = ws->cost[c] + (c - need) * PLAN_WASTE_CENTS_PER_UNIT;
+        if (score < best_score) {
+            best_score = score;
+            best_c = c;
+        }
+    }
+    if (best_score == PLAN_NO_COST) {
+        return false;
+    }
+
+    uint16_t qty[SUBSTRATE_MAX_PACKAGE_LINES] = {0};
+    for (uint32_t c = best_c; c > 0; c -= units[ws->last[c]]) {
+        qty[ws->last[c]]++;
+    }
+    for (uint8_t j = 0; j < n; ++j) {
+        if (qty[j] == 0) {
+            continue;
+        }
+        const substrate_package_t *p = &s_packages[idx[j]];
+        plan->package_index[plan->line_count] = idx[j];
+        plan->quantity[plan->line_count] = qty[j];
+        plan->line_count++;
+        plan->purchased_l += qty[j] * p->yield_l;
+        plan->cost_eur += qty[j] * p->price_eur;
+    }
+    plan->waste_l = fmaxf(plan->purchased_l - layer->volume_l, 0.0f);
+    plan->feasible = true;
+    return true;
+}
+
+bool substrate_plan_purchase(const substrate_layer_t *layers,
+                             uint8_t layer_count,
+                             substrate_plan_workspace_t *ws,
+                             substrate_purchase_t *out)
+{
+    if (!layers || !ws || !out || layer_count == 0 || layer_count > SUBSTRATE_MAX_LAYERS) {
+        return false;
+    }
+
+    substrate_purchase_t r = {.layer_count = layer_count};
+    r.valid = true;
+    for (uint8_t i = 0; i < layer_count; ++i) {
+        if (layers[i].type >= SUBSTRATE_COUNT || layers[i].volume_l <= 0.0f) {
+            return false;
+        }
+        if (!plan_layer(&layers[i], ws, &r.layers[i])) {
+            r.valid = false;
+            continue;
+        }
+        r.total_cost_eur += r.layers[i].cost_eur;
+        r.total_waste_l += r.layers[i].waste_l;
+    }
+    *out = r;
+    return true;
+}
+
 void substrate_run_self_test(void)
 {
     const substrate_input_t nominal = {.length_cm = 100, .depth_cm = 60, .height_cm = 60, .substrate_height_cm = 8, .type = SUBSTRATE_FOREST_BLEND};
@@ -59,10 +311,12 @@ void substrate_run_self_test(void)
 
     for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
         substrate_result_t out = {0};
-        if (substrate_calculate(&cases[i], &out)) {
-            printf("[TEST substrat %zu] %.1f L, %.1f-%.1f kg (densité %.2f-%.2f kg/L)%s%s\n",
+        calc_sensitivity_t sens = {0};
+        if (substrate_calculate(&cases[i], &out) && substrate_sensitivity(&cases[i], &sens)) {
+            printf("[TEST substrat %zu] %.1f L (+%.2f L/cm d'épaisseur), %.1f-%.1f kg (densité %.2f-%.2f kg/L)%s%s\n",
                    i,
                    out.volume_l,
+                   sens.partial[0][2],
                    out.mass_min_kg,
                    out.mass_max_kg,
                    out.density_min_kg_per_l,
@@ -71,4 +325,41 @@ void substrate_run_self_test(void)
                    out.warning_height_low ? " hauteur faible" : "");
         }
     }
+
+    substrate_input_t tol;
+    substrate_default_tolerance(&nominal, &tol);
+    substrate_result_t ref = {0};
+    calc_bounds_t b = {0};
+    if (substrate_calculate(&nominal, &ref) && substrate_bounds(&nominal, &tol, &b)) {
+        const bool inside = ref.volume_l >= b.min[0] && ref.volume_l <= b.max[0];
+        printf("[TEST substrat] bornes ±%.1f cm : %.1f-%.1f L, %.1f-%.1f kg %s\n",
+               CALC_TOL_TAPE_CM,
+               b.min[0],
+               b.max[0],
+               b.min[1],
+               b.max[1],
+               inside ? "OK" : "ÉCHEC");
+    }
+
+    // bac bioactif 120x60 : 4 cm de sable/terre drainant + 8 cm de coco
+    const substrate_layer_t layers[] = {
+        {.type = SUBSTRATE_SAND_SOIL, .volume_l = 120.0f * 60.0f * 4.0f / 1000.0f},
+        {.type = SUBSTRATE_COCO, .volume_l = 120.0f * 60.0f * 8.0f / 1000.0f},
+        {.type = SUBSTRATE_SAND, .volume_l = 40.0f},
+    };
+    static substrate_plan_workspace_t ws;
+    substrate_purchase_t plan = {0};
+    if (substrate_plan_purchase(layers, sizeof(layers) / sizeof(layers[0]), &ws, &plan) && plan.valid) {
+        size_t count = 0;
+        const substrate_package_t *table = substrate_package_table(&count);
+        for (uint8_t i = 0; i < plan.layer_count; ++i) {
+            const substrate_layer_plan_t *lp = &plan.layers[i];
+            printf("[TEST substrat achat] couche %u (%.1f L) :", i, layers[i].volume_l);
+            for (uint8_t j = 0; j < lp->line_count; ++j) {
+                printf(" %u x %s", lp->quantity[j], table[lp->package_index[j]].name);
+            }
+            printf(" -> %.2f €, reste %.1f L\n", lp->cost_eur, lp->waste_l);
+        }
+        printf("[TEST substrat achat] total %.2f €, reste %.1f L\n", plan.total_cost_eur, plan.total_waste_l);
+    }
 }
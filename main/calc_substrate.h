@@ -1,6 +1,10 @@
 #pragma once
 
+#include <stddef.h>
+
 #include "calc_common.h"
+#include "calc_bounds.h"
+#include "calc_sensitivity.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,7 +40,73 @@ typedef struct {
     bool warning_height_low;
 } substrate_result_t;
 
+#define SUBSTRATE_MAX_LAYERS 4
+#define SUBSTRATE_MAX_PACKAGE_LINES 4
+#define SUBSTRATE_PLAN_MAX_UNITS 1200 // demi-litres : 600 L par couche
+
+/** Conditionnement vendu : volume réellement obtenu (brique réhydratée, sac). */
+typedef struct {
+    const char *name;
+    substrate_type_t type;
+    float yield_l;
+    float price_eur;
+} substrate_package_t;
+
+typedef struct {
+    substrate_type_t type;
+    float volume_l;
+} substrate_layer_t;
+
+typedef struct {
+    bool feasible;
+    uint8_t line_count;
+    uint8_t package_index[SUBSTRATE_MAX_PACKAGE_LINES]; // indices dans la table de conditionnements
+    uint16_t quantity[SUBSTRATE_MAX_PACKAGE_LINES];
+    float purchased_l;
+    float waste_l;
+    float cost_eur;
+} substrate_layer_plan_t;
+
+typedef struct {
+    bool valid;
+    uint8_t layer_count;
+    substrate_layer_plan_t layers[SUBSTRATE_MAX_LAYERS];
+    float total_cost_eur;
+    float total_waste_l;
+} substrate_purchase_t;
+
+/**
+ * Tables de la programmation dynamique (environ 6 Kio), internes à
+ * substrate_plan_purchase() ; chaque tâche qui planifie un achat a la sienne,
+ * en statique ou sur le tas.
+ */
+typedef struct {
+    uint32_t cost[SUBSTRATE_PLAN_MAX_UNITS + 1]; // coût minimal (centimes) pour exactement c demi-litres
+    int8_t last[SUBSTRATE_PLAN_MAX_UNITS + 1];   // dernier conditionnement ajouté, pour reconstruire
+} substrate_plan_workspace_t;
+
 bool substrate_calculate(const substrate_input_t *in, substrate_result_t *out);
+bool substrate_sensitivity(const substrate_input_t *in, calc_sensitivity_t *out);
+void substrate_default_tolerance(const substrate_input_t *in, substrate_input_t *tol);
+bool substrate_bounds(const substrate_input_t *in, const substrate_input_t *tol, calc_bounds_t *out);
+/** Table de conditionnements active (intégrée, sauf surcharge). */
+const substrate_package_t *substrate_package_table(size_t *count);
+/**
+ * Remplace la table intégrée (prix locaux...) ; NULL revient à la table
+ * intégrée. Refusée (false, table active inchangée) si un substrat y compte
+ * plus de SUBSTRATE_MAX_PACKAGE_LINES conditionnements ou si un type est hors
+ * plage. La table doit rester valide tant qu'elle est active.
+ */
+bool substrate_package_table_override(const substrate_package_t *table, size_t count);
+/**
+ * Choisit, couche par couche, les quantités de chaque conditionnement qui
+ * couvrent le volume au moindre coût, le reste inutilisé étant pénalisé.
+ * Programmation dynamique exacte au demi-litre.
+ */
+bool substrate_plan_purchase(const substrate_layer_t *layers,
+                             uint8_t layer_count,
+                             substrate_plan_workspace_t *ws,
+                             substrate_purchase_t *out);
 void substrate_run_self_test(void);
 
 #ifdef __cplusplus
@@ -0,0 +1,198 @@
+#include "perf_hud.h"
+
+#include "sdkconfig.h"
+
+#if CONFIG_TERRARIUM_ENABLE_LV_PERF
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "ui_main.h"
+
+// Histogrammes au pas de 250 µs jusqu'à 64 ms ; au-delà, dernière case
+#define HIST_BUCKET_US  250
+#define HIST_BUCKETS    256
+#define HUD_PERIOD_MS   500
+#define DUMP_PERIOD_S   60
+#define MAX_TABS        8
+#define CORES           portNUM_PROCESSORS
+
+static const char *TAG = "perf";
+
+typedef struct {
+    uint32_t count;
+    uint16_t buckets[HIST_BUCKETS];
+} hist_t;
+
+typedef struct {
+    hist_t render;
+    hist_t flush;
+} tab_hist_t;
+
+static tab_hist_t s_tabs[MAX_TABS];
+static lv_obj_t *s_label;
+
+// Somme sur la fenêtre courante de la surimpression
+static uint32_t s_win_frames;
+static uint64_t s_win_render_us;
+static uint64_t s_win_flush_us;
+static uint64_t s_win_vsync_us;
+static int64_t s_win_start_us;
+static uint32_t s_idle_prev[CORES];
+static uint32_t s_ticks_since_dump;
+
+static void hist_add(hist_t *h, uint32_t us)
+{
+    uint32_t b = us / HIST_BUCKET_US;
+    if (b >= HIST_BUCKETS) {
+        b = HIST_BUCKETS - 1;
+    }
+    // Compteurs saturés plutôt que repliés sur les longues sessions
+    if (h->buckets[b] != UINT16_MAX) {
+        h->buckets[b]++;
+    }
+    h->count++;
+}
+
+// Borne haute de la case contenant le percentile p (en ms)
+static float hist_percentile(const hist_t *h, uint32_t p)
+{
+    const uint32_t rank = (h->count * p + 99u) / 100u;
+    uint32_t seen = 0;
+    for (uint32_t b = 0; b < HIST_BUCKETS; ++b) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            return (float)((b + 1) * HIST_BUCKET_US) / 1000.0f;
+        }
+    }
+    return (float)(HIST_BUCKETS * HIST_BUCKET_US) / 1000.0f;
+}
+
+static uint32_t idle_runtime(int core)
+{
+    return (uint32_t)ulTaskGetRunTimeCounter(xTaskGetIdleTaskHandleForCore(core));
+}
+
+static void hud_update(void)
+{
+    const int64_t now = esp_timer_get_time();
+    const uint32_t elapsed = (uint32_t)(now - s_win_start_us);
+    const uint32_t n = s_win_frames ? s_win_frames : 1;
+
+    char cpu[48] = "";
+    size_t used = 0;
+    for (int core = 0; core < CORES; ++core) {
+        // Compteur de temps d'exécution FreeRTOS en µs (horloge esp_timer)
+        const uint32_t idle = idle_runtime(core);
+        const uint32_t idle_us = idle - s_idle_prev[core];
+        s_idle_prev[core] = idle;
+        uint32_t load = elapsed ? 100u - (uint32_t)((uint64_t)idle_us * 100u / elapsed) : 0;
+        if (load > 100u) {
+            load = 0;
+        }
+        used += (size_t)snprintf(cpu + used, sizeof(cpu) - used, "  CPU%d %u %%", core, (unsigned)load);
+    }
+
+    // snprintf de la libc : le sprintf intégré de LVGL ne formate pas les flottants
+    char text[128];
+    snprintf(text,
+             sizeof(text),
+             "Rendu %.1f ms  Flush %.1f ms  Synchro %.1f ms\n%.1f i/s%s",
+             (double)s_win_render_us / n / 1000.0,
+             (double)s_win_flush_us / n / 1000.0,
+             (double)s_win_vsync_us / n / 1000.0,
+             elapsed ? (double)s_win_frames * 1e6 / elapsed : 0.0,
+             cpu);
+    lv_label_set_text(s_label, text);
+    s_win_frames = 0;
+    s_win_render_us = 0;
+    s_win_flush_us = 0;
+    s_win_vsync_us = 0;
+    s_win_start_us = now;
+}
+
+static void hud_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    hud_update();
+    if (++s_ticks_since_dump >= DUMP_PERIOD_S * 1000 / HUD_PERIOD_MS) {
+        perf_hud_dump();
+    }
+}
+
+static void hud_clicked_cb(lv_event_t *e)
+{
+    (void)e;
+    perf_hud_dump();
+}
+
+void perf_hud_init(void)
+{
+    if (s_label) {
+        return;
+    }
+    s_label = lv_label_create(lv_layer_top());
+    lv_obj_set_style_text_font(s_label, &lv_font_montserrat_12, LV_PART_MAIN);
+    lv_obj_set_style_text_color(s_label, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(s_label, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(s_label, LV_OPA_60, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(s_label, 4, LV_PART_MAIN);
+    lv_obj_align(s_label, LV_ALIGN_TOP_RIGHT, -4, 4);
+    // La couche supérieure ne reçoit pas les appuis : seule l'étiquette est cliquable
+    lv_obj_add_flag(s_label, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(s_label, hud_clicked_cb, LV_EVENT_CLICKED, NULL);
+
+    s_win_start_us = esp_timer_get_time();
+    for (int core = 0; core < CORES; ++core) {
+        s_idle_prev[core] = idle_runtime(core);
+    }
+    lv_label_set_text(s_label, "Mesure en cours...");
+    lv_timer_create(hud_timer_cb, HUD_PERIOD_MS, NULL);
+}
+
+void perf_hud_frame(const perf_frame_t *frame)
+{
+    if (!frame) {
+        return;
+    }
+    s_win_frames++;
+    s_win_render_us += frame->render_us;
+    s_win_flush_us += frame->flush_us;
+    s_win_vsync_us += frame->vsync_wait_us;
+
+    uint32_t tab = ui_main_active_tab();
+    if (tab >= MAX_TABS) {
+        tab = MAX_TABS - 1;
+    }
+    hist_add(&s_tabs[tab].render, frame->render_us);
+    hist_add(&s_tabs[tab].flush, frame->flush_us);
+}
+
+void perf_hud_dump(void)
+{
+    const uint32_t tabs = ui_main_tab_count() < MAX_TABS ? ui_main_tab_count() : MAX_TABS;
+    for (uint32_t t = 0; t < tabs; ++t) {
+        const tab_hist_t *h = &s_tabs[t];
+        if (h->render.count == 0) {
+            continue;
+        }
+        ESP_LOGI(TAG,
+                 "Onglet %s : %u trames, rendu p50 %.2f / p95 %.2f / p99 %.2f ms, flush p50 %.2f / p95 %.2f / p99 %.2f ms",
+                 ui_main_tab_name(t),
+                 (unsigned)h->render.count,
+                 hist_percentile(&h->render, 50),
+                 hist_percentile(&h->render, 95),
+                 hist_percentile(&h->render, 99),
+                 hist_percentile(&h->flush, 50),
+                 hist_percentile(&h->flush, 95),
+                 hist_percentile(&h->flush, 99));
+    }
+    memset(s_tabs, 0, sizeof(s_tabs));
+    s_ticks_since_dump = 0;
+}
+
+#endif /* CONFIG_TERRARIUM_ENABLE_LV_PERF */
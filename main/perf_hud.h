@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Temps d'une trame rendue, mesurés par la boucle d'affichage. */
+typedef struct {
+    uint32_t render_us;      /*!< Rendu LVGL, hors flush et attente de synchro. */
+    uint32_t flush_us;       /*!< Temps passé dans le callback de flush. */
+    uint32_t vsync_wait_us;  /*!< Attente de la synchro verticale (bascule). */
+} perf_frame_t;
+
+/**
+ * Surimpression de performance (CONFIG_TERRARIUM_ENABLE_LV_PERF) : rendu,
+ * flush, attente de synchro, trames/s et charge de chaque cœur, rafraîchis
+ * deux fois par seconde. Les temps de rendu et de flush sont aussi cumulés en
+ * histogrammes par onglet, journalisés (p50/p95/p99) toutes les minutes ou
+ * sur un appui sur la surimpression, qui remet les histogrammes à zéro.
+ * À appeler depuis le contexte LVGL, après ui_main_init().
+ */
+void perf_hud_init(void);
+
+/** Enregistre une trame ; contexte LVGL uniquement. */
+void perf_hud_frame(const perf_frame_t *frame);
+
+/** Journalise les percentiles de chaque onglet ayant des trames. */
+void perf_hud_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,6 @@
 #include "storage.h"
 
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -182,20 +183,28 @@ typedef struct __attribute__((packed)) {
     float uva;
     float uvb;
     float ref_dist;
+    uint8_t wall; // ajouté après coup : les anciens blobs s'arrêtent avant
 } light_blob_t;
 
+#define LIGHT_BLOB_LEGACY_SIZE offsetof(light_blob_t, wall)
+
 esp_err_t storage_load_lighting(lighting_input_t *in)
 {
     if (!in) {
         return ESP_ERR_INVALID_ARG;
     }
-    light_blob_t blob = {0};
+    light_blob_t blob = {.wall = TERRARIUM_MATERIAL_GLASS};
     esp_err_t err = load_blob("light", &blob, sizeof(blob));
+    if (err == ESP_ERR_INVALID_SIZE) {
+        blob.wall = TERRARIUM_MATERIAL_GLASS;
+        err = load_blob("light", &blob, LIGHT_BLOB_LEGACY_SIZE);
+    }
     if (err != ESP_OK) {
         in->length_cm = 100.0f;
         in->depth_cm = 60.0f;
         in->height_cm = 60.0f;
         in->environment = TERRARIUM_ENV_DESERTIC;
+        in->wall_material = TERRARIUM_MATERIAL_GLASS;
         in->led_luminous_flux_lm = 150.0f;
         in->led_power_w = 1.0f;
         in->uva_irradiance_mw_cm2_at_distance = 3.0f;
@@ -207,6 +216,7 @@ esp_err_t storage_load_lighting(lighting_input_t *in)
     in->depth_cm = blob.depth_cm;
     in->height_cm = blob.height_cm;
     in->environment = (terrarium_environment_t)blob.env;
+    in->wall_material = (blob.wall < TERRARIUM_MATERIAL_COUNT) ? (terrarium_material_t)blob.wall : TERRARIUM_MATERIAL_GLASS;
     in->led_luminous_flux_lm = blob.led_flux;
     in->led_power_w = blob.led_power;
     in->uva_irradiance_mw_cm2_at_distance = blob.uva;
@@ -230,6 +240,7 @@ esp_err_t storage_save_lighting(const lighting_input_t *in)
         .uva = in->uva_irradiance_mw_cm2_at_distance,
         .uvb = in->uvb_uvi_at_distance,
         .ref_dist = in->reference_distance_cm,
+        .wall = (uint8_t)in->wall_material,
     };
     return save_blob("light", &blob, sizeof(blob));
 }
@@ -334,3 +345,77 @@ esp_err_t storage_save_misting(const misting_input_t *in)
     return save_blob("misting", &blob, sizeof(blob));
 }
 
+
+// L'état RLS est stocké tel quel (pile d'annulation comprise) ; un changement
+// de taille ou de version renvoie aux valeurs catalogue.
+#define CALIB_BLOB_VERSION 1
+
+typedef struct {
+    uint8_t version;
+    cal_store_t store;
+} calib_blob_t;
+
+esp_err_t storage_load_calibration(cal_store_t *store)
+{
+    if (!store) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    static calib_blob_t blob;
+    esp_err_t err = load_blob("calib", &blob, sizeof(blob));
+    if (err == ESP_OK && blob.version != CALIB_BLOB_VERSION) {
+        err = ESP_ERR_INVALID_VERSION;
+    }
+    if (err != ESP_OK) {
+        calibration_defaults(store);
+        return err;
+    }
+    *store = blob.store;
+    return ESP_OK;
+}
+
+esp_err_t storage_save_calibration(const cal_store_t *store)
+{
+    if (!store) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    static calib_blob_t blob;
+    blob.version = CALIB_BLOB_VERSION;
+    blob.store = *store;
+    return save_blob("calib", &blob, sizeof(blob));
+}
+
+#define DRAW_TUNING_BLOB_VERSION 1
+
+typedef struct {
+    uint8_t version;
+    storage_draw_tuning_t tuning;
+} draw_tuning_blob_t;
+
+esp_err_t storage_load_draw_tuning(storage_draw_tuning_t *tuning)
+{
+    if (!tuning) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    draw_tuning_blob_t blob;
+    esp_err_t err = load_blob("drawbuf", &blob, sizeof(blob));
+    if (err == ESP_OK && blob.version != DRAW_TUNING_BLOB_VERSION) {
+        err = ESP_ERR_INVALID_VERSION;
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    *tuning = blob.tuning;
+    return ESP_OK;
+}
+
+esp_err_t storage_save_draw_tuning(const storage_draw_tuning_t *tuning)
+{
+    if (!tuning) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    draw_tuning_blob_t blob = {
+        .version = DRAW_TUNING_BLOB_VERSION,
+        .tuning = *tuning,
+    };
+    return save_blob("drawbuf", &blob, sizeof(blob));
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "calc_calibration.h"
 #include "calc_heating_cable.h"
 #include "calc_heating_pad.h"
 #include "calc_lighting.h"
@@ -29,6 +30,20 @@ esp_err_t storage_save_substrate(const substrate_input_t *in);
 esp_err_t storage_load_misting(misting_input_t *in);
 esp_err_t storage_save_misting(const misting_input_t *in);
 
+esp_err_t storage_load_calibration(cal_store_t *store);
+esp_err_t storage_save_calibration(const cal_store_t *store);
+
+/** Tampons de rendu LVGL retenus par l'auto-réglage du premier démarrage. */
+typedef struct {
+    uint32_t config_key;  /*!< Empreinte de la configuration d'affichage mesurée. */
+    uint16_t lines;       /*!< Lignes pleine largeur par tampon. */
+    uint8_t in_psram;     /*!< 1 = PSRAM, 0 = SRAM interne. */
+} storage_draw_tuning_t;
+
+/** ESP_ERR_NVS_NOT_FOUND tant qu'aucun réglage n'a été enregistré. */
+esp_err_t storage_load_draw_tuning(storage_draw_tuning_t *tuning);
+esp_err_t storage_save_draw_tuning(const storage_draw_tuning_t *tuning);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,318 @@
+#include "ui_airflow.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena/arena.h"
+#include "calc_airflow.h"
+#include "esp_log.h"
+#include "ui_keyboard.h"
+
+#define COLOR_TEXT lv_color_hex(0xE2E8F0)
+#define COLOR_MUTED lv_color_hex(0x94A3B8)
+#define COLOR_SURFACE lv_color_hex(0x111827)
+#define COLOR_ACCENT lv_color_hex(0x22D3EE)
+
+// Mode interactif : 48 colonnes, 6 px par cellule, ~25 pas tous les 100 ms
+#define GRID_NX        48
+#define CELL_PX        6
+#define CANVAS_PX      (GRID_NX * CELL_PX)
+#define GRID_MIN_NX    8   // plancher de airflow_grid_size()
+#define STEPS_PER_TICK 25
+#define TICK_MS        100
+
+static const char *TAG = "ui_airflow";
+
+enum {
+    CTRL_LENGTH = 0,
+    CTRL_HEIGHT,
+    CTRL_HEATER,
+    CTRL_VIEW,
+    CTRL_RUN_LABEL,
+    CTRL_MIST_LABEL,
+    CTRL_CANVAS,
+    CTRL_STATUS,
+    CTRL_COUNT
+};
+
+enum { VIEW_HUMIDITY = 0, VIEW_TEMPERATURE, VIEW_SPEED };
+
+static lv_obj_t *s_controls[CTRL_COUNT];
+static airflow_sim_t s_sim;
+static airflow_input_t s_input;
+static void *s_grid;
+static uint16_t *s_pixels;
+static lv_timer_t *s_timer;
+static bool s_running;
+
+static float parse_decimal(const char *txt, float def)
+{
+    if (!txt || txt[0] == '\0') {
+        return def;
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%s", txt);
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        if (buf[i] == ',') {
+            buf[i] = '.';
+        }
+    }
+    char *end = NULL;
+    float v = strtof(buf, &end);
+    if (end == buf) {
+        return def;
+    }
+    return v;
+}
+
+static float read_ta(size_t index, float def)
+{
+    return parse_decimal(lv_textarea_get_text(s_controls[index]), def);
+}
+
+static lv_obj_t *create_row(lv_obj_t *parent)
+{
+    lv_obj_t *row = lv_obj_create(parent);
+    lv_obj_set_width(row, LV_PCT(100));
+    lv_obj_set_height(row, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(row, LV_OPA_0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(row, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(row, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(row, 8, LV_PART_MAIN);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_END);
+    return row;
+}
+
+static lv_obj_t *create_input_row(lv_obj_t *parent, const char *label, const char *placeholder)
+{
+    lv_obj_t *cont = lv_obj_create(parent);
+    lv_obj_set_size(cont, 180, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(cont, 6, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(cont, 6, LV_PART_MAIN);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_remove_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *lbl = lv_label_create(cont);
+    lv_label_set_text(lbl, label);
+    lv_obj_set_style_text_color(lbl, COLOR_TEXT, LV_PART_MAIN);
+
+    lv_obj_t *ta = lv_textarea_create(cont);
+    lv_textarea_set_one_line(ta, true);
+    lv_textarea_set_placeholder_text(ta, placeholder);
+    lv_textarea_set_max_length(ta, 8);
+    lv_obj_set_width(ta, LV_PCT(100));
+    lv_obj_set_style_min_height(ta, 48, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ta, &lv_font_montserrat_20, LV_PART_MAIN);
+    ui_keyboard_attach(ta, UI_KEYBOARD_MODE_DECIMAL);
+
+    return ta;
+}
+
+static lv_obj_t *create_button(lv_obj_t *parent, const char *text, lv_event_cb_t cb, lv_obj_t **label_out)
+{
+    lv_obj_t *btn = lv_button_create(parent);
+    lv_obj_set_width(btn, LV_SIZE_CONTENT);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, NULL);
+
+    lv_obj_t *lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_color(lbl, COLOR_TEXT, LV_PART_MAIN);
+    if (label_out) {
+        *label_out = lbl;
+    }
+    return btn;
+}
+
+static lv_color_t ramp(float t, uint32_t lo, uint32_t hi)
+{
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    return lv_color_mix(lv_color_hex(hi), lv_color_hex(lo), (uint8_t)(t * 255.0f));
+}
+
+static void redraw(void)
+{
+    const uint32_t view = lv_dropdown_get_selected(s_controls[CTRL_VIEW]);
+    const float t_span = s_sim.heater_c - s_sim.ambient_c;
+    airflow_cell_t c;
+    for (uint16_t y = 0; y < s_sim.ny; ++y) {
+        // y = 0 est le sol : la première rangée du canevas est le plafond
+        const uint32_t py0 = (uint32_t)(s_sim.ny - 1 - y) * CELL_PX;
+        if (py0 + CELL_PX > CANVAS_PX) {
+            continue; // garde-fou : reset_sim() borne déjà ny à GRID_NX
+        }
+        for (uint16_t x = 0; x < s_sim.nx; ++x) {
+            airflow_sample(&s_sim, x, y, &c);
+            lv_color_t col;
+            if (c.solid) {
+                col = (c.temp_c > s_sim.ambient_c + 0.5f) ? lv_color_hex(0xB45309) : lv_color_hex(0x334155);
+            } else if (view == VIEW_TEMPERATURE) {
+                col = ramp(t_span > 0.5f ? (c.temp_c - s_sim.ambient_c) / t_span : 0.0f, 0x1E3A8A, 0xF97316);
+            } else if (view == VIEW_SPEED) {
+                col = ramp(c.speed_cm_s / 15.0f, 0x0F172A, 0xFDE047);
+            } else {
+                col = ramp((c.rh_pct - 30.0f) / 70.0f, 0x78350F, 0x22D3EE);
+            }
+            const uint16_t px = lv_color_to_u16(col);
+            for (uint32_t dy = 0; dy < CELL_PX; ++dy) {
+                uint16_t *line = &s_pixels[(py0 + dy) * CANVAS_PX + (uint32_t)x * CELL_PX];
+                for (uint32_t dx = 0; dx < CELL_PX; ++dx) {
+                    line[dx] = px;
+                }
+            }
+        }
+    }
+    lv_obj_invalidate(s_controls[CTRL_CANVAS]);
+
+    airflow_summary_t sum;
+    airflow_summarize(&s_sim, &sum);
+    static char text[192];
+    snprintf(text,
+             sizeof(text),
+             "t = %lu pas  |  HR moyenne %.0f %% (sol %.0f %%)  |  T moyenne %.1f °C  |  vitesse max %.1f cm/s",
+             (unsigned long)s_sim.step_count,
+             sum.mean_rh_pct,
+             sum.floor_rh_pct,
+             sum.mean_temp_c,
+             sum.max_speed_cm_s);
+    lv_label_set_text(s_controls[CTRL_STATUS], text);
+}
+
+static void reset_sim(void)
+{
+    airflow_default_input(&s_input);
+    s_input.length_cm = read_ta(CTRL_LENGTH, s_input.length_cm);
+    s_input.height_cm = read_ta(CTRL_HEIGHT, s_input.height_cm);
+    s_input.heater_surface_c = read_ta(CTRL_HEATER, s_input.heater_surface_c);
+    s_input.length_cm = s_input.length_cm < 10.0f ? 10.0f : s_input.length_cm;
+    s_input.height_cm = s_input.height_cm < 10.0f ? 10.0f : s_input.height_cm;
+    // La grille tient dans GRID_NX × GRID_NX : un bac plus haut que long perd
+    // des colonnes, jusqu'à GRID_MIN_NX ; au-delà la hauteur simulée est bornée
+    const float max_height_cm = s_input.length_cm * (float)GRID_NX / (float)GRID_MIN_NX;
+    if (s_input.height_cm > max_height_cm) {
+        ESP_LOGW(TAG, "height %.0f cm clamped to %.0f cm (aspect ratio)", s_input.height_cm, max_height_cm);
+        s_input.height_cm = max_height_cm;
+    }
+    s_input.nx = GRID_NX;
+    if (s_input.height_cm > s_input.length_cm) {
+        s_input.nx = (uint16_t)((float)GRID_NX * s_input.length_cm / s_input.height_cm);
+    }
+    s_input.misting_on = s_sim.misting_on;
+    lv_memset(s_pixels, 0, (size_t)CANVAS_PX * CANVAS_PX * sizeof(uint16_t));
+    if (!airflow_init(&s_sim, &s_input, s_grid, airflow_buffer_size(GRID_NX, GRID_NX))) {
+        ESP_LOGW(TAG, "airflow_init failed");
+    }
+    redraw();
+}
+
+static void tick_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    airflow_step(&s_sim, STEPS_PER_TICK);
+    redraw();
+}
+
+static void run_cb(lv_event_t *e)
+{
+    (void)e;
+    s_running = !s_running;
+    if (s_running) {
+        lv_timer_resume(s_timer);
+    } else {
+        lv_timer_pause(s_timer);
+    }
+    lv_label_set_text(s_controls[CTRL_RUN_LABEL], s_running ? "Pause" : "Lancer");
+}
+
+static void mist_cb(lv_event_t *e)
+{
+    (void)e;
+    airflow_set_misting(&s_sim, !s_sim.misting_on);
+    lv_label_set_text(s_controls[CTRL_MIST_LABEL], s_sim.misting_on ? "Couper la brume" : "Brumiser");
+}
+
+static void reset_cb(lv_event_t *e)
+{
+    (void)e;
+    reset_sim();
+}
+
+static void view_cb(lv_event_t *e)
+{
+    (void)e;
+    redraw();
+}
+
+lv_obj_t *ui_airflow_panel_create(lv_obj_t *parent, float length_cm)
+{
+    lv_obj_t *block = lv_obj_create(parent);
+    lv_obj_set_width(block, LV_PCT(100));
+    lv_obj_set_height(block, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_color(block, COLOR_SURFACE, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(block, LV_OPA_80, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(block, 12, LV_PART_MAIN);
+    lv_obj_set_style_radius(block, 8, LV_PART_MAIN);
+    lv_obj_set_style_border_color(block, COLOR_ACCENT, LV_PART_MAIN);
+    lv_obj_set_style_border_width(block, 2, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(block, 6, LV_PART_MAIN);
+    lv_obj_set_flex_flow(block, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t *hdr = lv_label_create(block);
+    lv_label_set_text(hdr, "Circulation d'air (coupe)");
+    lv_obj_set_style_text_color(hdr, COLOR_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(hdr, &lv_font_montserrat_20, LV_PART_MAIN);
+
+    lv_obj_t *hint = lv_label_create(block);
+    lv_obj_set_width(hint, LV_PCT(100));
+    lv_label_set_long_mode(hint, LV_LABEL_LONG_WRAP);
+    lv_label_set_text(hint,
+                      "Aération basse à gauche, grille haute à droite du plafond, chauffage au sol à gauche, buses"
+                      " sous le plafond. Vue qualitative : tendances de circulation, pas de mesure.");
+    lv_obj_set_style_text_color(hint, COLOR_MUTED, LV_PART_MAIN);
+
+    // Tampons permanents, pris dans l'arène au démarrage (hors de toute portée)
+    const arena_user_t user = arena_register_user("ui_airflow");
+    s_grid = arena_alloc(user, airflow_buffer_size(GRID_NX, GRID_NX), 64, ARENA_BULK);
+    s_pixels = s_grid ? arena_alloc(user, (size_t)CANVAS_PX * CANVAS_PX * sizeof(uint16_t), 0, ARENA_BULK) : NULL;
+    if (!s_grid || !s_pixels) {
+        ESP_LOGW(TAG, "arène insuffisante pour la simulation aéraulique");
+        lv_label_set_text(hint, "Simulation indisponible : mémoire de calcul insuffisante.");
+        return block;
+    }
+
+    lv_obj_t *row = create_row(block);
+    char txt[16];
+    s_controls[CTRL_LENGTH] = create_input_row(row, "Longueur (cm)", "90");
+    snprintf(txt, sizeof(txt), "%.0f", length_cm > 0.0f ? length_cm : 90.0f);
+    lv_textarea_set_text(s_controls[CTRL_LENGTH], txt);
+    s_controls[CTRL_HEIGHT] = create_input_row(row, "Hauteur (cm)", "60");
+    s_controls[CTRL_HEATER] = create_input_row(row, "Sol chauffé (°C)", "38");
+
+    lv_obj_t *view_dd = lv_dropdown_create(row);
+    lv_dropdown_set_options(view_dd, "Humidité\nTempérature\nVitesse");
+    lv_obj_set_width(view_dd, 180);
+    lv_obj_set_style_min_height(view_dd, 44, LV_PART_MAIN);
+    lv_obj_add_event_cb(view_dd, view_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    s_controls[CTRL_VIEW] = view_dd;
+
+    lv_obj_t *btn_row = create_row(block);
+    create_button(btn_row, "Lancer", run_cb, &s_controls[CTRL_RUN_LABEL]);
+    create_button(btn_row, "Brumiser", mist_cb, &s_controls[CTRL_MIST_LABEL]);
+    create_button(btn_row, "Réinitialiser", reset_cb, NULL);
+
+    lv_obj_t *canvas = lv_canvas_create(block);
+    lv_canvas_set_buffer(canvas, s_pixels, CANVAS_PX, CANVAS_PX, LV_COLOR_FORMAT_RGB565);
+    s_controls[CTRL_CANVAS] = canvas;
+
+    lv_obj_t *status = lv_label_create(block);
+    lv_obj_set_width(status, LV_PCT(100));
+    lv_label_set_long_mode(status, LV_LABEL_LONG_WRAP);
+    lv_obj_set_style_text_color(status, COLOR_TEXT, LV_PART_MAIN);
+    s_controls[CTRL_STATUS] = status;
+
+    s_timer = lv_timer_create(tick_cb, TICK_MS, NULL);
+    lv_timer_pause(s_timer);
+    reset_sim();
+    return block;
+}
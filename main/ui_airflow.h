@@ -0,0 +1,18 @@
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bloc « Circulation d'air » : coupe verticale du terrarium simulée en basse
+ * résolution (calc_airflow), affichée en carte d'humidité, de température ou
+ * de vitesse. La simulation avance par un minuteur LVGL tant qu'elle tourne.
+ */
+lv_obj_t *ui_airflow_panel_create(lv_obj_t *parent, float length_cm);
+
+#ifdef __cplusplus
+}
+#endif
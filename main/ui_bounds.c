@@ -0,0 +1,43 @@
+#include "ui_bounds.h"
+
+#include <math.h>
+
+#include "ui_result_panel.h"
+
+#define COLOR_TEXT lv_color_hex(0xE2E8F0)
+
+lv_obj_t *ui_bounds_panel_create(lv_obj_t *parent, const char *tolerance_hint)
+{
+    lv_obj_t *block = ui_result_panel_create(parent,
+                                             "Fourchette garantie",
+                                             "Saisir les cotes : la fourchette se met à jour à chaque frappe.",
+                                             COLOR_TEXT);
+    ui_result_panel_add_note(block, tolerance_hint);
+    return block;
+}
+
+void ui_bounds_panel_update(lv_obj_t *panel, const calc_bounds_t *b)
+{
+    lv_obj_t *body = ui_result_panel_body(panel);
+    if (!body) {
+        return;
+    }
+    if (!b || !b->valid || b->output_count == 0) {
+        lv_label_set_text(body, "Entrées hors plage : pas de fourchette.");
+        return;
+    }
+
+    char buf[512];
+    size_t len = 0;
+    for (uint8_t i = 0; i < b->output_count; ++i) {
+        const char *sep = (i == 0) ? "" : "\n";
+        if (!isfinite(b->min[i]) || !isfinite(b->max[i])) {
+            len = ui_result_panel_appendf(buf, sizeof(buf), len, "%s%s : non borné", sep, b->output_names[i]);
+        } else if (b->max[i] - b->min[i] <= 1e-6f * fabsf(b->max[i])) {
+            len = ui_result_panel_appendf(buf, sizeof(buf), len, "%s%s : %.3g", sep, b->output_names[i], b->max[i]);
+        } else {
+            len = ui_result_panel_appendf(buf, sizeof(buf), len, "%s%s : %.3g - %.3g", sep, b->output_names[i], b->min[i], b->max[i]);
+        }
+    }
+    lv_label_set_text(body, buf);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "lvgl.h"
+
+#include "calc_bounds.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bloc « Fourchette garantie » commun aux écrans de calcul : min/max de chaque
+ * sortie compte tenu des tolérances d'entrée. Assez léger pour être mis à
+ * jour à chaque frappe.
+ */
+lv_obj_t *ui_bounds_panel_create(lv_obj_t *parent, const char *tolerance_hint);
+void ui_bounds_panel_update(lv_obj_t *panel, const calc_bounds_t *b);
+
+#ifdef __cplusplus
+}
+#endif
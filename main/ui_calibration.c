@@ -0,0 +1,269 @@
+#include "ui_calibration.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "calc_calibration.h"
+#include "storage.h"
+#include "ui_keyboard.h"
+
+#define COLOR_TEXT lv_color_hex(0xE2E8F0)
+#define COLOR_MUTED lv_color_hex(0x94A3B8)
+#define COLOR_SURFACE lv_color_hex(0x111827)
+#define COLOR_ACCENT lv_color_hex(0x22D3EE)
+
+enum {
+    CTRL_HEAT_AREA = 0,
+    CTRL_HEAT_POWER,
+    CTRL_HEAT_SURFACE,
+    CTRL_HEAT_AMBIENT,
+    CTRL_HEAT_TARGET,
+    CTRL_UV_LAMP,
+    CTRL_UV_DISTANCE,
+    CTRL_UV_MEASURED,
+    CTRL_UV_DATASHEET,
+    CTRL_UV_REFERENCE,
+    CTRL_STATUS,
+    CTRL_COUNT
+};
+
+static cal_store_t s_store;
+static lv_obj_t *s_controls[CTRL_COUNT];
+
+static float parse_decimal(const char *txt, float def)
+{
+    if (!txt || txt[0] == '\0') {
+        return def;
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%s", txt);
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        if (buf[i] == ',') {
+            buf[i] = '.';
+        }
+    }
+    char *end = NULL;
+    float v = strtof(buf, &end);
+    if (end == buf) {
+        return def;
+    }
+    return v;
+}
+
+static float read_ta(size_t index, float def)
+{
+    return parse_decimal(lv_textarea_get_text(s_controls[index]), def);
+}
+
+static lv_obj_t *create_row(lv_obj_t *parent)
+{
+    lv_obj_t *row = lv_obj_create(parent);
+    lv_obj_set_width(row, LV_PCT(100));
+    lv_obj_set_height(row, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(row, LV_OPA_0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(row, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(row, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(row, 8, LV_PART_MAIN);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_END);
+    return row;
+}
+
+static lv_obj_t *create_input_row(lv_obj_t *parent, const char *label, const char *placeholder)
+{
+    lv_obj_t *cont = lv_obj_create(parent);
+    lv_obj_set_size(cont, 180, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(cont, 6, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(cont, 6, LV_PART_MAIN);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_remove_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *lbl = lv_label_create(cont);
+    lv_label_set_text(lbl, label);
+    lv_obj_set_style_text_color(lbl, COLOR_TEXT, LV_PART_MAIN);
+
+    lv_obj_t *ta = lv_textarea_create(cont);
+    lv_textarea_set_one_line(ta, true);
+    lv_textarea_set_placeholder_text(ta, placeholder);
+    lv_textarea_set_max_length(ta, 8);
+    lv_obj_set_width(ta, LV_PCT(100));
+    lv_obj_set_style_min_height(ta, 48, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ta, &lv_font_montserrat_20, LV_PART_MAIN);
+    ui_keyboard_attach(ta, UI_KEYBOARD_MODE_DECIMAL);
+
+    return ta;
+}
+
+static lv_obj_t *create_button(lv_obj_t *parent, const char *text, lv_event_cb_t cb)
+{
+    lv_obj_t *btn = lv_button_create(parent);
+    lv_obj_set_width(btn, LV_SIZE_CONTENT);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, NULL);
+
+    lv_obj_t *lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_color(lbl, COLOR_TEXT, LV_PART_MAIN);
+    return btn;
+}
+
+static void refresh_status(const char *event)
+{
+    const cal_state_t *st = &s_store.current;
+    const lighting_falloff_t uvb = calibration_falloff(st, CAL_LAMP_UVB);
+    const lighting_falloff_t uva = calibration_falloff(st, CAL_LAMP_UVA);
+
+    static char text[384];
+    snprintf(text,
+             sizeof(text),
+             "%s\n"
+             "Chauffage (%u mesure(s)) : %.1f / %.1f / %.1f / %.1f / %.1f W aux nœuds catalogue\n"
+             "UVB (%u mesure(s)) : gain %.2f, décroissance 1/d^%.2f\n"
+             "UVA (%u mesure(s)) : gain %.2f, décroissance 1/d^%.2f\n"
+             "Annulations disponibles : %u",
+             event,
+             st->heat.count,
+             st->heat.power_w[0],
+             st->heat.power_w[1],
+             st->heat.power_w[2],
+             st->heat.power_w[3],
+             st->heat.power_w[4],
+             st->lamp[CAL_LAMP_UVB].count,
+             uvb.gain,
+             uvb.exponent,
+             st->lamp[CAL_LAMP_UVA].count,
+             uva.gain,
+             uva.exponent,
+             s_store.undo_count);
+    lv_label_set_text(s_controls[CTRL_STATUS], text);
+}
+
+// Applique puis sauvegarde : les écrans recalculent à la prochaine frappe.
+static void commit(const char *event)
+{
+    calibration_apply(&s_store.current);
+    esp_err_t err = storage_save_calibration(&s_store);
+    if (err != ESP_OK) {
+        static char msg[96];
+        snprintf(msg, sizeof(msg), "%s (sauvegarde NVS impossible : %s)", event, esp_err_to_name(err));
+        refresh_status(msg);
+        return;
+    }
+    refresh_status(event);
+}
+
+static void add_heat_cb(lv_event_t *e)
+{
+    (void)e;
+    const cal_heat_measurement_t m = {
+        .heated_area_cm2 = read_ta(CTRL_HEAT_AREA, 0.0f),
+        .power_w = read_ta(CTRL_HEAT_POWER, 0.0f),
+        .measured_surface_c = read_ta(CTRL_HEAT_SURFACE, 0.0f),
+        .ambient_c = read_ta(CTRL_HEAT_AMBIENT, 24.0f),
+        .target_surface_c = read_ta(CTRL_HEAT_TARGET, 30.0f),
+    };
+    if (!calibration_add_heat(&s_store, &m)) {
+        refresh_status("Mesure IR refusée : surface, puissance ou écart à l'ambiance (< 1 °C) invalide.");
+        return;
+    }
+    commit("Mesure IR intégrée.");
+}
+
+static void add_uv_cb(lv_event_t *e)
+{
+    (void)e;
+    const cal_lamp_t lamp = lv_dropdown_get_selected(s_controls[CTRL_UV_LAMP]) == 1 ? CAL_LAMP_UVA : CAL_LAMP_UVB;
+    const cal_uv_measurement_t m = {
+        .distance_cm = read_ta(CTRL_UV_DISTANCE, 0.0f),
+        .measured = read_ta(CTRL_UV_MEASURED, 0.0f),
+        .datasheet_value = read_ta(CTRL_UV_DATASHEET, 0.0f),
+        .reference_distance_cm = read_ta(CTRL_UV_REFERENCE, 30.0f),
+    };
+    if (!calibration_add_uv(&s_store, lamp, &m)) {
+        refresh_status("Mesure UV refusée : distances et valeurs doivent être positives.");
+        return;
+    }
+    commit("Mesure UV intégrée.");
+}
+
+static void rollback_cb(lv_event_t *e)
+{
+    (void)e;
+    if (!calibration_rollback(&s_store)) {
+        refresh_status("Rien à annuler.");
+        return;
+    }
+    commit("Dernière mesure annulée.");
+}
+
+static void reset_cb(lv_event_t *e)
+{
+    (void)e;
+    calibration_defaults(&s_store);
+    commit("Calibration remise aux valeurs catalogue.");
+}
+
+lv_obj_t *ui_calibration_panel_create(lv_obj_t *parent)
+{
+    storage_load_calibration(&s_store);
+
+    lv_obj_t *block = lv_obj_create(parent);
+    lv_obj_set_width(block, LV_PCT(100));
+    lv_obj_set_height(block, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_color(block, COLOR_SURFACE, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(block, LV_OPA_80, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(block, 12, LV_PART_MAIN);
+    lv_obj_set_style_radius(block, 8, LV_PART_MAIN);
+    lv_obj_set_style_border_color(block, COLOR_ACCENT, LV_PART_MAIN);
+    lv_obj_set_style_border_width(block, 2, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(block, 6, LV_PART_MAIN);
+    lv_obj_set_flex_flow(block, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t *hdr = lv_label_create(block);
+    lv_label_set_text(hdr, "Calibration terrain");
+    lv_obj_set_style_text_color(hdr, COLOR_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(hdr, &lv_font_montserrat_20, LV_PART_MAIN);
+
+    lv_obj_t *hint = lv_label_create(block);
+    lv_obj_set_width(hint, LV_PCT(100));
+    lv_label_set_long_mode(hint, LV_LABEL_LONG_WRAP);
+    lv_label_set_text(hint,
+                      "Chaque relevé affine les courbes catalogue (tapis, câble, décroissance UV) sans"
+                      " recalcul global. Les mesures aberrantes s'annulent une à une.");
+    lv_obj_set_style_text_color(hint, COLOR_MUTED, LV_PART_MAIN);
+
+    lv_obj_t *heat_row = create_row(block);
+    s_controls[CTRL_HEAT_AREA] = create_input_row(heat_row, "Surface chauffée (cm²)", "377");
+    s_controls[CTRL_HEAT_POWER] = create_input_row(heat_row, "Puissance (W)", "15");
+    s_controls[CTRL_HEAT_SURFACE] = create_input_row(heat_row, "Surface IR (°C)", "34");
+    s_controls[CTRL_HEAT_AMBIENT] = create_input_row(heat_row, "Ambiance (°C)", "24");
+    s_controls[CTRL_HEAT_TARGET] = create_input_row(heat_row, "Consigne (°C)", "30");
+    create_button(heat_row, "Ajouter mesure IR", add_heat_cb);
+
+    lv_obj_t *uv_row = create_row(block);
+    lv_obj_t *lamp_dd = lv_dropdown_create(uv_row);
+    lv_dropdown_set_options(lamp_dd, "UVB (UVI)\nUVA (mW/cm²)");
+    lv_obj_set_width(lamp_dd, 180);
+    lv_obj_set_style_text_color(lamp_dd, COLOR_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(lamp_dd, COLOR_SURFACE, LV_PART_MAIN);
+    lv_obj_set_style_border_color(lamp_dd, COLOR_ACCENT, LV_PART_MAIN);
+    s_controls[CTRL_UV_LAMP] = lamp_dd;
+    s_controls[CTRL_UV_DISTANCE] = create_input_row(uv_row, "Distance (cm)", "25");
+    s_controls[CTRL_UV_MEASURED] = create_input_row(uv_row, "Valeur mesurée", "2.5");
+    s_controls[CTRL_UV_DATASHEET] = create_input_row(uv_row, "Valeur fiche", "3.0");
+    s_controls[CTRL_UV_REFERENCE] = create_input_row(uv_row, "Distance fiche (cm)", "30");
+    create_button(uv_row, "Ajouter mesure UV", add_uv_cb);
+
+    lv_obj_t *action_row = create_row(block);
+    create_button(action_row, "Annuler dernière", rollback_cb);
+    create_button(action_row, "Réinitialiser", reset_cb);
+
+    lv_obj_t *status = lv_label_create(block);
+    lv_obj_set_width(status, LV_PCT(100));
+    lv_label_set_long_mode(status, LV_LABEL_LONG_WRAP);
+    lv_obj_set_style_text_color(status, COLOR_TEXT, LV_PART_MAIN);
+    s_controls[CTRL_STATUS] = status;
+    refresh_status("Calibration chargée.");
+
+    return block;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bloc « Calibration terrain » : saisie des relevés thermomètre IR et
+ * UVI-mètre, raffinement incrémental (RLS) des courbes catalogue, annulation
+ * de la dernière mesure et retour usine. L'état est sauvegardé en NVS après
+ * chaque action et appliqué immédiatement aux modules de calcul.
+ */
+lv_obj_t *ui_calibration_panel_create(lv_obj_t *parent);
+
+#ifdef __cplusplus
+}
+#endif
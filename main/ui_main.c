@@ -21,6 +21,13 @@
 #define COLOR_MUTED lv_color_hex(0x94A3B8)
 #define COLOR_ACCENT lv_color_hex(0x22D3EE)
 
+static const char *const k_tab_names[] = {
+    "Accueil", "Tapis", "Câble", "Éclairage", "Substrat", "Brumisation", "Sécurité",
+};
+#define TAB_COUNT (sizeof(k_tab_names) / sizeof(k_tab_names[0]))
+
+static lv_obj_t *s_tabview;
+
 static void apply_theme(void)
 {
     lv_display_t *disp = lv_display_get_default();
@@ -85,17 +92,18 @@ void ui_main_init(void)
     lv_label_set_long_mode(subtitle, LV_LABEL_LONG_WRAP);
 
     lv_obj_t *tabview = lv_tabview_create(root, LV_DIR_TOP, 52);
+    s_tabview = tabview;
     lv_obj_set_size(tabview, LV_PCT(100), LV_PCT(100));
     lv_obj_set_flex_grow(tabview, 1);
     style_tab_bar(tabview);
 
-    lv_obj_t *tab_home = lv_tabview_add_tab(tabview, "Accueil");
-    lv_obj_t *tab_pad = lv_tabview_add_tab(tabview, "Tapis");
-    lv_obj_t *tab_cable = lv_tabview_add_tab(tabview, "Câble");
-    lv_obj_t *tab_light = lv_tabview_add_tab(tabview, "Éclairage");
-    lv_obj_t *tab_substrate = lv_tabview_add_tab(tabview, "Substrat");
-    lv_obj_t *tab_mist = lv_tabview_add_tab(tabview, "Brumisation");
-    lv_obj_t *tab_about = lv_tabview_add_tab(tabview, "Sécurité");
+    lv_obj_t *tab_home = lv_tabview_add_tab(tabview, k_tab_names[0]);
+    lv_obj_t *tab_pad = lv_tabview_add_tab(tabview, k_tab_names[1]);
+    lv_obj_t *tab_cable = lv_tabview_add_tab(tabview, k_tab_names[2]);
+    lv_obj_t *tab_light = lv_tabview_add_tab(tabview, k_tab_names[3]);
+    lv_obj_t *tab_substrate = lv_tabview_add_tab(tabview, k_tab_names[4]);
+    lv_obj_t *tab_mist = lv_tabview_add_tab(tabview, k_tab_names[5]);
+    lv_obj_t *tab_about = lv_tabview_add_tab(tabview, k_tab_names[6]);
 
     lv_obj_add_event_cb(tabview, tabview_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
 
@@ -111,3 +119,24 @@ void ui_main_init(void)
     ui_screen_about_build(tab_about);
 }
 
+uint32_t ui_main_tab_count(void)
+{
+    return TAB_COUNT;
+}
+
+const char *ui_main_tab_name(uint32_t index)
+{
+    return index < TAB_COUNT ? k_tab_names[index] : "?";
+}
+
+uint32_t ui_main_active_tab(void)
+{
+    return s_tabview ? lv_tabview_get_tab_act(s_tabview) : 0;
+}
+
+void ui_main_show_tab(uint32_t index)
+{
+    if (s_tabview && index < TAB_COUNT) {
+        lv_tabview_set_active(s_tabview, index, LV_ANIM_OFF);
+    }
+}
@@ -8,6 +8,14 @@ extern "C" {
 
 void ui_main_init(void);
 
+/** Onglets de l'écran principal, dans l'ordre d'affichage. */
+uint32_t ui_main_tab_count(void);
+const char *ui_main_tab_name(uint32_t index);
+/** Onglet affiché (0 avant ui_main_init()). */
+uint32_t ui_main_active_tab(void);
+/** Active un onglet sans animation (banc de rendu, restauration d'état). */
+void ui_main_show_tab(uint32_t index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,68 @@
+#include "ui_result_panel.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#define COLOR_TEXT lv_color_hex(0xE2E8F0)
+#define COLOR_MUTED lv_color_hex(0x94A3B8)
+#define COLOR_SURFACE lv_color_hex(0x111827)
+#define COLOR_ACCENT lv_color_hex(0x22D3EE)
+
+static lv_obj_t *create_wrapped_label(lv_obj_t *parent, const char *text, lv_color_t color)
+{
+    lv_obj_t *label = lv_label_create(parent);
+    lv_obj_set_width(label, LV_PCT(100));
+    lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+    lv_label_set_text(label, text);
+    lv_obj_set_style_text_color(label, color, LV_PART_MAIN);
+    return label;
+}
+
+lv_obj_t *ui_result_panel_create(lv_obj_t *parent, const char *title, const char *placeholder, lv_color_t body_color)
+{
+    lv_obj_t *block = lv_obj_create(parent);
+    lv_obj_set_width(block, LV_PCT(100));
+    lv_obj_set_height(block, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_color(block, COLOR_SURFACE, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(block, LV_OPA_70, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(block, 12, LV_PART_MAIN);
+    lv_obj_set_style_radius(block, 8, LV_PART_MAIN);
+    lv_obj_set_style_border_color(block, COLOR_ACCENT, LV_PART_MAIN);
+    lv_obj_set_style_border_width(block, 1, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(block, 6, LV_PART_MAIN);
+    lv_obj_set_flex_flow(block, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t *hdr = lv_label_create(block);
+    lv_label_set_text(hdr, title);
+    lv_obj_set_style_text_color(hdr, COLOR_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(hdr, &lv_font_montserrat_20, LV_PART_MAIN);
+
+    create_wrapped_label(block, placeholder, body_color);
+    return block;
+}
+
+void ui_result_panel_add_note(lv_obj_t *panel, const char *text)
+{
+    create_wrapped_label(panel, text, COLOR_MUTED);
+}
+
+lv_obj_t *ui_result_panel_body(lv_obj_t *panel)
+{
+    return panel ? lv_obj_get_child(panel, 1) : NULL;
+}
+
+size_t ui_result_panel_appendf(char *buf, size_t size, size_t len, const char *fmt, ...)
+{
+    if (len + 1 >= size) {
+        return len;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vsnprintf(buf + len, size - len, fmt, ap);
+    va_end(ap);
+    if (n < 0) {
+        return len;
+    }
+    len += (size_t)n;
+    return len < size ? len : size - 1;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bloc de résultat commun aux panneaux Sensibilité et Fourchette garantie :
+ * cadre accentué, titre, puis un corps texte d'une ligne par sortie.
+ */
+lv_obj_t *ui_result_panel_create(lv_obj_t *parent, const char *title, const char *placeholder, lv_color_t body_color);
+/** Ajoute sous le corps une note en couleur atténuée. */
+void ui_result_panel_add_note(lv_obj_t *panel, const char *text);
+/** Corps texte du bloc, NULL si le bloc n'en a pas. */
+lv_obj_t *ui_result_panel_body(lv_obj_t *panel);
+
+/**
+ * Ajoute du texte formaté à buf à partir de len et rend la nouvelle longueur,
+ * bornée à size - 1 : les appels suivants sur un tampon plein n'écrivent rien.
+ */
+size_t ui_result_panel_appendf(char *buf, size_t size, size_t len, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+#ifdef __cplusplus
+}
+#endif
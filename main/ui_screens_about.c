@@ -5,6 +5,7 @@
 #include "esp_err.h"
 
 #include "storage.h"
+#include "ui_calibration.h"
 #include "ui_keyboard.h"
 
 #define COLOR_TEXT lv_color_hex(0xE2E8F0)
@@ -95,6 +96,8 @@ void ui_screen_about_build(lv_obj_t *parent)
                  " locales et les besoins biologiques de l'espèce. Installer des protections mécaniques contre les brûlures et"
                  " l'humidité sur les éléments électriques.");
 
+    ui_calibration_panel_create(parent);
+
     lv_obj_t *pref_panel = create_panel(parent,
                                         "Maintenance & préférences",
                                         "Réinitialise les données NVS en cas de corruption et sélectionne la disposition"
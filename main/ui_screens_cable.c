@@ -2,10 +2,13 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "calc_heating_cable.h"
 #include "storage.h"
+#include "ui_bounds.h"
 #include "ui_keyboard.h"
+#include "ui_sensitivity.h"
 
 #define COLOR_TEXT lv_color_hex(0xE2E8F0)
 #define COLOR_MUTED lv_color_hex(0x94A3B8)
@@ -114,9 +117,30 @@ static lv_obj_t *create_input_row(lv_obj_t *parent, const char *label, const cha
     return ta;
 }
 
-static void calculate_cb(lv_event_t *e)
+static lv_obj_t *s_controls[11];
+
+static void show_inputs(lv_obj_t **controls, const heating_cable_input_t *in)
+{
+    char tmp[16];
+    snprintf(tmp, sizeof(tmp), "%.0f", in->length_cm);
+    lv_textarea_set_text(controls[0], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->depth_cm);
+    lv_textarea_set_text(controls[1], tmp);
+    snprintf(tmp, sizeof(tmp), "%.2f", in->heated_ratio);
+    lv_textarea_set_text(controls[2], tmp);
+    snprintf(tmp, sizeof(tmp), "%.3f", in->target_power_density_w_per_cm2);
+    lv_textarea_set_text(controls[3], tmp);
+    snprintf(tmp, sizeof(tmp), "%.1f", in->power_linear_w_per_m);
+    lv_textarea_set_text(controls[4], tmp);
+    lv_dropdown_set_selected(controls[5], in->material);
+    snprintf(tmp, sizeof(tmp), "%.1f", in->spacing_cm);
+    lv_textarea_set_text(controls[6], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->supply_voltage_v);
+    lv_textarea_set_text(controls[7], tmp);
+}
+
+static heating_cable_input_t read_inputs(lv_obj_t **controls)
 {
-    lv_obj_t **controls = lv_event_get_user_data(e);
     lv_obj_t *length_ta = controls[0];
     lv_obj_t *depth_ta = controls[1];
     lv_obj_t *ratio_ta = controls[2];
@@ -125,7 +149,6 @@ static void calculate_cb(lv_event_t *e)
     lv_obj_t *material_dd = controls[5];
     lv_obj_t *spacing_ta = controls[6];
     lv_obj_t *supply_ta = controls[7];
-    lv_obj_t *out_label = controls[8];
 
     heating_cable_input_t in = {
         .length_cm = parse_decimal(lv_textarea_get_text(length_ta), 100.0f),
@@ -137,10 +160,58 @@ static void calculate_cb(lv_event_t *e)
         .spacing_cm = parse_decimal(lv_textarea_get_text(spacing_ta), 4.0f),
         .supply_voltage_v = parse_decimal(lv_textarea_get_text(supply_ta), 24.0f),
     };
+    return in;
+}
+
+static void update_bounds(lv_obj_t *panel, const heating_cable_input_t *in)
+{
+    heating_cable_input_t tol;
+    heating_cable_default_tolerance(in, &tol);
+    calc_bounds_t bounds = {0};
+    heating_cable_bounds(in, &tol, &bounds);
+    ui_bounds_panel_update(panel, &bounds);
+}
+
+// Meilleur montage série/parallèle en 12 V et 24 V pour les coupes standard
+static void append_plans(char *buf, size_t size, const heating_cable_input_t *in, const heating_cable_result_t *out)
+{
+    static const float k_voltages[] = {12.0f, 24.0f};
+    cable_plan_input_t plan_in;
+    heating_cable_plan_defaults(in, out, &plan_in);
+    for (size_t i = 0; i < sizeof(k_voltages) / sizeof(k_voltages[0]); ++i) {
+        cable_plan_result_t plan = {0};
+        const size_t len = strlen(buf);
+        if (!heating_cable_plan(&plan_in, k_voltages[i], &plan) || !plan.valid) {
+            snprintf(buf + len, size - len, "\n%.0f V : aucun montage dans les limites de courant", k_voltages[i]);
+            continue;
+        }
+        const cable_plan_t *best = &plan.plans[0];
+        snprintf(buf + len,
+                 size - len,
+                 "\n%.0f V : %u x (%u coupe%s en série, %.1f m), %.1f W, %.2f A%s",
+                 k_voltages[i],
+                 best->parallel_count,
+                 best->series_count,
+                 best->series_count > 1 ? "s" : "",
+                 best->string_length_m,
+                 best->power_w,
+                 best->current_a,
+                 best->within_tolerance ? "" : " (hors tolérance)");
+    }
+}
+
+static void calculate_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    lv_obj_t *out_label = controls[8];
+    lv_obj_t *sens_panel = controls[9];
+    lv_obj_t *bounds_panel = controls[10];
+
+    heating_cable_input_t in = read_inputs(controls);
 
     heating_cable_result_t out = {0};
     if (heating_cable_calculate(&in, &out) && out.valid) {
-        char buf[320];
+        char buf[512];
         snprintf(buf,
                  sizeof(buf),
                  "Surface chauffée: %.0f cm²\n"
@@ -158,11 +229,25 @@ static void calculate_cb(lv_event_t *e)
                  out.warning_density_high ? "Alerte densité : réduire la puissance ou augmenter la surface. " : "Densité ok. ",
                  out.warning_spacing_too_tight ? "Spirale trop serrée (<3 cm). " : "",
                  out.warning_high_voltage ? "230 V uniquement théorique : préférer 12/24 V SELV." : "");
+        append_plans(buf, sizeof(buf), &in, &out);
         lv_label_set_text(out_label, buf);
         storage_save_heating_cable(&in);
     } else {
         lv_label_set_text(out_label, "Entrées invalides pour le calcul de câble chauffant.");
     }
+
+    calc_sensitivity_t sens = {0};
+    heating_cable_sensitivity(&in, &sens);
+    ui_sensitivity_panel_update(sens_panel, &sens);
+    update_bounds(bounds_panel, &in);
+}
+
+// Recalcul léger des bornes à chaque frappe, sans sauvegarde NVS
+static void bounds_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    const heating_cable_input_t in = read_inputs(controls);
+    update_bounds(controls[10], &in);
 }
 
 void ui_screen_cable_build(lv_obj_t *parent)
@@ -178,34 +263,13 @@ void ui_screen_cable_build(lv_obj_t *parent)
     heating_cable_input_t defaults = {0};
     storage_load_heating_cable(&defaults);
 
-    char tmp[16];
     lv_obj_t *length_ta = create_input_row(inputs, "Longueur (cm)", "100");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.length_cm);
-    lv_textarea_set_text(length_ta, tmp);
-
     lv_obj_t *depth_ta = create_input_row(inputs, "Profondeur (cm)", "60");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.depth_cm);
-    lv_textarea_set_text(depth_ta, tmp);
-
     lv_obj_t *ratio_ta = create_input_row(inputs, "Ratio chauffé", "0.33");
-    snprintf(tmp, sizeof(tmp), "%.2f", defaults.heated_ratio);
-    lv_textarea_set_text(ratio_ta, tmp);
-
     lv_obj_t *density_ta = create_input_row(inputs, "Densité cible (W/cm²)", "0.035");
-    snprintf(tmp, sizeof(tmp), "%.3f", defaults.target_power_density_w_per_cm2);
-    lv_textarea_set_text(density_ta, tmp);
-
     lv_obj_t *power_lin_ta = create_input_row(inputs, "Puissance linéique (W/m)", "20");
-    snprintf(tmp, sizeof(tmp), "%.1f", defaults.power_linear_w_per_m);
-    lv_textarea_set_text(power_lin_ta, tmp);
-
     lv_obj_t *spacing_ta = create_input_row(inputs, "Pas des spires (cm)", "4");
-    snprintf(tmp, sizeof(tmp), "%.1f", defaults.spacing_cm);
-    lv_textarea_set_text(spacing_ta, tmp);
-
     lv_obj_t *supply_ta = create_input_row(inputs, "Tension câble (V)", "24");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.supply_voltage_v);
-    lv_textarea_set_text(supply_ta, tmp);
 
     lv_obj_t *mat_cont = lv_obj_create(inputs);
     lv_obj_set_size(mat_cont, 240, LV_SIZE_CONTENT);
@@ -221,7 +285,6 @@ void ui_screen_cable_build(lv_obj_t *parent)
 
     lv_obj_t *material_dd = lv_dropdown_create(mat_cont);
     lv_dropdown_set_options(material_dd, "Bois\nVerre\nPVC\nAcrylique");
-    lv_dropdown_set_selected(material_dd, defaults.material);
     lv_obj_set_style_min_height(material_dd, 44, LV_PART_MAIN);
     lv_obj_set_style_text_font(material_dd, &lv_font_montserrat_20, LV_PART_MAIN);
 
@@ -242,13 +305,16 @@ void ui_screen_cable_build(lv_obj_t *parent)
     lv_label_set_text(out, "Résultats câble chauffant en attente.");
     lv_obj_set_style_text_color(out, COLOR_TEXT, LV_PART_MAIN);
 
+    lv_obj_t *bounds_panel = ui_bounds_panel_create(parent, "Tolérances : ±0,5 cm sur les cotes et l'espacement, ±10 % sur la puissance linéique, ±5 % sur la tension.");
+    lv_obj_t *sens_panel = ui_sensitivity_panel_create(parent);
+
     create_help_block(parent,
                       "Aide & limites",
                       "Espacement conseillé 3-6 cm. Densité cible : verre 0,03-0,04 W/cm², bois 0,04-0,05 W/cm²."
                       " Les valeurs 230 V sont indicatives : privilégier 12/24 V SELV avec disjoncteur différentiel et protection"
                       " mécanique du câble.");
 
-    static lv_obj_t *controls[9];
+    lv_obj_t **controls = s_controls;
     controls[0] = length_ta;
     controls[1] = depth_ta;
     controls[2] = ratio_ta;
@@ -258,6 +324,22 @@ void ui_screen_cable_build(lv_obj_t *parent)
     controls[6] = spacing_ta;
     controls[7] = supply_ta;
     controls[8] = out;
+    controls[9] = sens_panel;
+    controls[10] = bounds_panel;
+    show_inputs(controls, &defaults);
     lv_obj_add_event_cb(btn, calculate_cb, LV_EVENT_CLICKED, controls);
+    for (size_t i = 0; i < 8; ++i) {
+        lv_obj_add_event_cb(controls[i], bounds_cb, LV_EVENT_VALUE_CHANGED, controls);
+    }
 }
 
+// Rechargées depuis la NVS après application d'une fiche espèce
+void ui_screen_cable_reload(void)
+{
+    if (!s_controls[0]) {
+        return;
+    }
+    heating_cable_input_t in = {0};
+    storage_load_heating_cable(&in);
+    show_inputs(s_controls, &in);
+}
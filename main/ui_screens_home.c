@@ -1,5 +1,7 @@
 #include "ui_screens_home.h"
 
+#include "ui_species.h"
+
 #define COLOR_TEXT lv_color_hex(0xE2E8F0)
 #define COLOR_MUTED lv_color_hex(0x94A3B8)
 #define COLOR_SURFACE lv_color_hex(0x111827)
@@ -55,6 +57,8 @@ void ui_screen_home_build(lv_obj_t *parent)
     lv_obj_set_width(desc, LV_PCT(100));
     lv_obj_set_style_text_color(desc, COLOR_MUTED, LV_PART_MAIN);
 
+    ui_species_panel_create(parent);
+
     create_help(parent,
                 "Hypothèses et limites",
                 "Calculs conservateurs, adaptés à des tensions SELV 12/24 V. Vérifie toujours avec des instruments (thermomètre IR,"
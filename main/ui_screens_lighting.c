@@ -5,7 +5,9 @@
 
 #include "calc_lighting.h"
 #include "storage.h"
+#include "ui_bounds.h"
 #include "ui_keyboard.h"
+#include "ui_sensitivity.h"
 
 #define COLOR_TEXT lv_color_hex(0xE2E8F0)
 #define COLOR_MUTED lv_color_hex(0x94A3B8)
@@ -47,6 +49,21 @@ static terrarium_environment_t env_from_dd(lv_obj_t *dd)
     }
 }
 
+static terrarium_material_t material_from_dd(lv_obj_t *dd)
+{
+    switch (lv_dropdown_get_selected(dd)) {
+    case 0:
+        return TERRARIUM_MATERIAL_WOOD;
+    case 1:
+        return TERRARIUM_MATERIAL_GLASS;
+    case 2:
+        return TERRARIUM_MATERIAL_PVC;
+    case 3:
+    default:
+        return TERRARIUM_MATERIAL_ACRYLIC;
+    }
+}
+
 static lv_obj_t *create_card(lv_obj_t *parent)
 {
     lv_obj_t *card = lv_obj_create(parent);
@@ -114,9 +131,33 @@ static lv_obj_t *create_input_row(lv_obj_t *parent, const char *label, const cha
     return ta;
 }
 
-static void calculate_cb(lv_event_t *e)
+static lv_obj_t *s_controls[13];
+
+static void show_inputs(lv_obj_t **controls, const lighting_input_t *in)
+{
+    char tmp[16];
+    snprintf(tmp, sizeof(tmp), "%.0f", in->length_cm);
+    lv_textarea_set_text(controls[0], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->depth_cm);
+    lv_textarea_set_text(controls[1], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->height_cm);
+    lv_textarea_set_text(controls[2], tmp);
+    lv_dropdown_set_selected(controls[3], in->environment);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->led_luminous_flux_lm);
+    lv_textarea_set_text(controls[4], tmp);
+    snprintf(tmp, sizeof(tmp), "%.1f", in->led_power_w);
+    lv_textarea_set_text(controls[5], tmp);
+    snprintf(tmp, sizeof(tmp), "%.1f", in->uva_irradiance_mw_cm2_at_distance);
+    lv_textarea_set_text(controls[6], tmp);
+    snprintf(tmp, sizeof(tmp), "%.2f", in->uvb_uvi_at_distance);
+    lv_textarea_set_text(controls[7], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->reference_distance_cm);
+    lv_textarea_set_text(controls[8], tmp);
+    lv_dropdown_set_selected(controls[9], in->wall_material);
+}
+
+static lighting_input_t read_inputs(lv_obj_t **controls)
 {
-    lv_obj_t **controls = lv_event_get_user_data(e);
     lv_obj_t *length_ta = controls[0];
     lv_obj_t *depth_ta = controls[1];
     lv_obj_t *height_ta = controls[2];
@@ -126,33 +167,57 @@ static void calculate_cb(lv_event_t *e)
     lv_obj_t *uva_ta = controls[6];
     lv_obj_t *uvb_ta = controls[7];
     lv_obj_t *dist_ta = controls[8];
-    lv_obj_t *out_label = controls[9];
+    lv_obj_t *wall_dd = controls[9];
 
     lighting_input_t in = {
         .length_cm = parse_decimal(lv_textarea_get_text(length_ta), 100.0f),
         .depth_cm = parse_decimal(lv_textarea_get_text(depth_ta), 60.0f),
         .height_cm = parse_decimal(lv_textarea_get_text(height_ta), 60.0f),
         .environment = env_from_dd(env_dd),
+        .wall_material = material_from_dd(wall_dd),
         .led_luminous_flux_lm = parse_decimal(lv_textarea_get_text(flux_ta), 150.0f),
         .led_power_w = parse_decimal(lv_textarea_get_text(led_power_ta), 1.0f),
         .uva_irradiance_mw_cm2_at_distance = parse_decimal(lv_textarea_get_text(uva_ta), 3.0f),
         .uvb_uvi_at_distance = parse_decimal(lv_textarea_get_text(uvb_ta), 1.2f),
         .reference_distance_cm = parse_decimal(lv_textarea_get_text(dist_ta), 30.0f),
     };
+    return in;
+}
+
+static void update_bounds(lv_obj_t *panel, const lighting_input_t *in)
+{
+    lighting_input_t tol;
+    lighting_default_tolerance(in, &tol);
+    calc_bounds_t bounds = {0};
+    lighting_bounds(in, &tol, &bounds);
+    ui_bounds_panel_update(panel, &bounds);
+}
+
+static void calculate_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    lv_obj_t *out_label = controls[10];
+    lv_obj_t *sens_panel = controls[11];
+    lv_obj_t *bounds_panel = controls[12];
+
+    lighting_input_t in = read_inputs(controls);
 
     lighting_result_t out = {0};
     if (lighting_calculate(&in, &out)) {
-        char buf[420];
+        char buf[520];
         snprintf(buf,
                  sizeof(buf),
-                 "Cible %.0f lux : %u LED (%.0f lm, %.1f W) sur %.2f m².\n"
+                 "Cible %.0f lux : %u LED (%.0f lm, %.1f W) sur %.2f m², K=%.2f, CU=%.2f.\n"
                  "UVB zone %.1f-%.1f : %u module(s) à %.0f cm, UVI estimé %.2f (total %.2f)%s%s.\n"
-                 "UVA cible %.1f mW/cm² : %u module(s) à %.0f cm, estimé %.2f%s%s.",
+                 "UVA cible %.1f mW/cm² : %u module(s) à %.0f cm, estimé %.2f%s%s.\n"
+                 "Spectre : PPFD plantes ≈%.0f µmol/m²/s, UVI combiné ≈%.2f, pré-D3 %.1f mW/m².",
                  out.led.target_lux,
                  out.led.led_count,
                  out.led.total_flux_lm,
                  out.led.total_power_w,
                  out.led.area_m2,
+                 out.led.room_index,
+                 out.led.utilization,
                  out.uvb.target_uvi_min,
                  out.uvb.target_uvi_max,
                  out.uvb.module_count,
@@ -166,12 +231,28 @@ static void calculate_cb(lv_event_t *e)
                  out.uva.recommended_distance_cm,
                  out.uva.estimated_uvi_at_distance,
                  out.uva.warning_high ? " (trop haut)" : "",
-                 out.uva.warning_low ? " (trop bas)" : "");
+                 out.uva.warning_low ? " (trop bas)" : "",
+                 out.led.ppfd_umol_m2_s,
+                 out.combined_uvi,
+                 out.previtd3_w_m2 * 1000.0f);
         lv_label_set_text(out_label, buf);
         storage_save_lighting(&in);
     } else {
         lv_label_set_text(out_label, "Entrées invalides pour l'éclairage.");
     }
+
+    calc_sensitivity_t sens = {0};
+    lighting_sensitivity(&in, &sens);
+    ui_sensitivity_panel_update(sens_panel, &sens);
+    update_bounds(bounds_panel, &in);
+}
+
+// Recalcul léger des bornes à chaque frappe, sans sauvegarde NVS
+static void bounds_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    const lighting_input_t in = read_inputs(controls);
+    update_bounds(controls[12], &in);
 }
 
 void ui_screen_lighting_build(lv_obj_t *parent)
@@ -187,38 +268,14 @@ void ui_screen_lighting_build(lv_obj_t *parent)
     lighting_input_t defaults = {0};
     storage_load_lighting(&defaults);
 
-    char tmp[16];
     lv_obj_t *length_ta = create_input_row(inputs, "Longueur (cm)", "100");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.length_cm);
-    lv_textarea_set_text(length_ta, tmp);
-
     lv_obj_t *depth_ta = create_input_row(inputs, "Profondeur (cm)", "60");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.depth_cm);
-    lv_textarea_set_text(depth_ta, tmp);
-
     lv_obj_t *height_ta = create_input_row(inputs, "Hauteur (cm)", "60");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.height_cm);
-    lv_textarea_set_text(height_ta, tmp);
-
     lv_obj_t *flux_ta = create_input_row(inputs, "Flux par LED (lm)", "150");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.led_luminous_flux_lm);
-    lv_textarea_set_text(flux_ta, tmp);
-
     lv_obj_t *led_pow_ta = create_input_row(inputs, "Puissance par LED (W)", "1");
-    snprintf(tmp, sizeof(tmp), "%.1f", defaults.led_power_w);
-    lv_textarea_set_text(led_pow_ta, tmp);
-
     lv_obj_t *uva_ta = create_input_row(inputs, "UVA module (mW/cm²)", "3");
-    snprintf(tmp, sizeof(tmp), "%.1f", defaults.uva_irradiance_mw_cm2_at_distance);
-    lv_textarea_set_text(uva_ta, tmp);
-
     lv_obj_t *uvb_ta = create_input_row(inputs, "UVB module (UVI)", "1.2");
-    snprintf(tmp, sizeof(tmp), "%.2f", defaults.uvb_uvi_at_distance);
-    lv_textarea_set_text(uvb_ta, tmp);
-
     lv_obj_t *dist_ta = create_input_row(inputs, "Distance modules (cm)", "30");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.reference_distance_cm);
-    lv_textarea_set_text(dist_ta, tmp);
 
     lv_obj_t *env_cont = lv_obj_create(inputs);
     lv_obj_set_size(env_cont, 240, LV_SIZE_CONTENT);
@@ -234,10 +291,26 @@ void ui_screen_lighting_build(lv_obj_t *parent)
 
     lv_obj_t *env_dd = lv_dropdown_create(env_cont);
     lv_dropdown_set_options(env_dd, "Tropical\nDésertique\nForêt tempérée\nNocturne");
-    lv_dropdown_set_selected(env_dd, defaults.environment);
     lv_obj_set_style_min_height(env_dd, 44, LV_PART_MAIN);
     lv_obj_set_style_text_font(env_dd, &lv_font_montserrat_20, LV_PART_MAIN);
 
+    lv_obj_t *wall_cont = lv_obj_create(inputs);
+    lv_obj_set_size(wall_cont, 240, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(wall_cont, LV_OPA_0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(wall_cont, 6, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(wall_cont, 6, LV_PART_MAIN);
+    lv_obj_set_flex_flow(wall_cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_remove_flag(wall_cont, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *wall_lbl = lv_label_create(wall_cont);
+    lv_label_set_text(wall_lbl, "Parois");
+    lv_obj_set_style_text_color(wall_lbl, COLOR_TEXT, LV_PART_MAIN);
+
+    lv_obj_t *wall_dd = lv_dropdown_create(wall_cont);
+    lv_dropdown_set_options(wall_dd, "Bois\nVerre\nPVC\nAcrylique");
+    lv_obj_set_style_min_height(wall_dd, 44, LV_PART_MAIN);
+    lv_obj_set_style_text_font(wall_dd, &lv_font_montserrat_20, LV_PART_MAIN);
+
     lv_obj_t *btn = lv_button_create(parent);
     lv_obj_set_width(btn, 200);
     lv_obj_set_style_min_height(btn, 52, LV_PART_MAIN);
@@ -255,13 +328,17 @@ void ui_screen_lighting_build(lv_obj_t *parent)
     lv_label_set_text(out, "Résultats éclairage en attente.");
     lv_obj_set_style_text_color(out, COLOR_TEXT, LV_PART_MAIN);
 
+    lv_obj_t *bounds_panel = ui_bounds_panel_create(parent, "Tolérances : ±0,5 cm sur les cotes, ±10 % flux/puissance LED, ±20 % d'une lampe UV à l'autre, ±1 cm sur la distance de référence.");
+    lv_obj_t *sens_panel = ui_sensitivity_panel_create(parent);
+
     create_help_block(parent,
                       "Aide & limites",
                       "Zones de Ferguson : zone 1 (0-1 UVI nocturne), zone 2 (0,7-2 UVI forêt), zone 3 (1-3 UVI tropical), zone 4"
                       " (3-6 UVI désert). UVI calculé en 1/r² depuis la distance de référence : toujours vérifier à l'UVI-mètre,"
-                      " ajuster avec du grillage ou la hauteur.");
+                      " ajuster avec du grillage ou la hauteur. Nombre de LED par la méthode des lumens : indice de local"
+                      " K = L·P / (H·(L+P)), coefficient d'utilisation selon les parois et le sol, maintenance 0,8.");
 
-    static lv_obj_t *controls[10];
+    lv_obj_t **controls = s_controls;
     controls[0] = length_ta;
     controls[1] = depth_ta;
     controls[2] = height_ta;
@@ -271,7 +348,24 @@ void ui_screen_lighting_build(lv_obj_t *parent)
     controls[6] = uva_ta;
     controls[7] = uvb_ta;
     controls[8] = dist_ta;
-    controls[9] = out;
+    controls[9] = wall_dd;
+    controls[10] = out;
+    controls[11] = sens_panel;
+    controls[12] = bounds_panel;
+    show_inputs(controls, &defaults);
     lv_obj_add_event_cb(btn, calculate_cb, LV_EVENT_CLICKED, controls);
+    for (size_t i = 0; i < 10; ++i) {
+        lv_obj_add_event_cb(controls[i], bounds_cb, LV_EVENT_VALUE_CHANGED, controls);
+    }
 }
 
+// Rechargées depuis la NVS après application d'une fiche espèce
+void ui_screen_lighting_reload(void)
+{
+    if (!s_controls[0]) {
+        return;
+    }
+    lighting_input_t in = {0};
+    storage_load_lighting(&in);
+    show_inputs(s_controls, &in);
+}
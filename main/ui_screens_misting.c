@@ -2,10 +2,15 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "calc_misting.h"
+#include "calc_misting_network.h"
 #include "storage.h"
+#include "ui_airflow.h"
+#include "ui_bounds.h"
 #include "ui_keyboard.h"
+#include "ui_sensitivity.h"
 
 #define COLOR_TEXT lv_color_hex(0xE2E8F0)
 #define COLOR_MUTED lv_color_hex(0x94A3B8)
@@ -114,9 +119,28 @@ static lv_obj_t *create_input_row(lv_obj_t *parent, const char *label, const cha
     return ta;
 }
 
-static void calculate_cb(lv_event_t *e)
+static lv_obj_t *s_controls[10];
+
+static void show_inputs(lv_obj_t **controls, const misting_input_t *in)
+{
+    char tmp[16];
+    snprintf(tmp, sizeof(tmp), "%.0f", in->length_cm);
+    lv_textarea_set_text(controls[0], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->depth_cm);
+    lv_textarea_set_text(controls[1], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->nozzle_flow_ml_per_min);
+    lv_textarea_set_text(controls[2], tmp);
+    snprintf(tmp, sizeof(tmp), "%.1f", in->cycle_duration_min);
+    lv_textarea_set_text(controls[3], tmp);
+    snprintf(tmp, sizeof(tmp), "%u", in->cycles_per_day);
+    lv_textarea_set_text(controls[4], tmp);
+    snprintf(tmp, sizeof(tmp), "%u", in->autonomy_days);
+    lv_textarea_set_text(controls[5], tmp);
+    lv_dropdown_set_selected(controls[6], in->environment);
+}
+
+static misting_input_t read_inputs(lv_obj_t **controls)
 {
-    lv_obj_t **controls = lv_event_get_user_data(e);
     lv_obj_t *length_ta = controls[0];
     lv_obj_t *depth_ta = controls[1];
     lv_obj_t *flow_ta = controls[2];
@@ -124,7 +148,6 @@ static void calculate_cb(lv_event_t *e)
     lv_obj_t *cycle_ta = controls[4];
     lv_obj_t *autonomy_ta = controls[5];
     lv_obj_t *env_dd = controls[6];
-    lv_obj_t *out_label = controls[7];
 
     misting_input_t in = {
         .length_cm = parse_decimal(lv_textarea_get_text(length_ta), 100.0f),
@@ -135,10 +158,50 @@ static void calculate_cb(lv_event_t *e)
         .autonomy_days = (uint32_t)parse_decimal(lv_textarea_get_text(autonomy_ta), 3),
         .environment = env_from_dd(env_dd),
     };
+    return in;
+}
+
+static void update_bounds(lv_obj_t *panel, const misting_input_t *in)
+{
+    misting_input_t tol;
+    misting_default_tolerance(in, &tol);
+    calc_bounds_t bounds = {0};
+    misting_bounds(in, &tol, &bounds);
+    ui_bounds_panel_update(panel, &bounds);
+}
+
+// Réseau type d'un terrarium : pompe à membrane au sol, 2 m de tube 1/4"
+// jusqu'au toit (~0,5 m de dénivelé), buses réparties sur la longueur.
+static bool solve_default_network(const misting_input_t *in, uint16_t nozzle_count, mist_net_result_t *net_out)
+{
+    static mist_net_input_t net;
+    static mist_net_workspace_t ws;
+    mist_net_default_input(&net);
+    net.nozzle_flow_ml_min = in->nozzle_flow_ml_per_min;
+    const mist_rack_t rack = {
+        .nozzle_count = nozzle_count,
+        .supply_length_m = 2.0f,
+        .supply_diameter_mm = 4.3f,
+        .riser_m = 0.5f,
+        .manifold_spacing_m = (in->length_cm / 100.0f) / (float)nozzle_count,
+        .manifold_diameter_mm = 4.3f,
+        .drop_length_m = 0.1f,
+    };
+    return mist_net_build_rack(&rack, &net) && mist_net_solve(&net, &ws, net_out) && net_out->valid;
+}
+
+static void calculate_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    lv_obj_t *out_label = controls[7];
+    lv_obj_t *sens_panel = controls[8];
+    lv_obj_t *bounds_panel = controls[9];
+
+    misting_input_t in = read_inputs(controls);
 
     misting_result_t out = {0};
     if (misting_calculate(&in, &out) && out.valid) {
-        char buf[256];
+        char buf[384];
         snprintf(buf,
                  sizeof(buf),
                  "Buses recommandées: %u\nConsommation: %.2f L/jour\nRéservoir: %.2f L (%.2f L pour 3j, %.2f L pour 7j)%s%s",
@@ -149,11 +212,43 @@ static void calculate_cb(lv_event_t *e)
                  out.tank_volume_autonomy7_l,
                  out.warning_dense_spray ? " (buses très proches, risque saturation)" : "",
                  out.warning_sparse_spray ? " (couverture faible, ajouter des buses)" : "");
+        static mist_net_result_t net_out;
+        const size_t len = strlen(buf);
+        if (out.nozzle_count > MIST_NET_MAX_RACK_NOZZLES) {
+            snprintf(buf + len,
+                     sizeof(buf) - len,
+                     "\nRéseau: trop grand pour le calcul (%u buses, %u max)",
+                     out.nozzle_count,
+                     (unsigned)MIST_NET_MAX_RACK_NOZZLES);
+        } else if (!solve_default_network(&in, (uint16_t)out.nozzle_count, &net_out)) {
+            snprintf(buf + len, sizeof(buf) - len, "\nRéseau: calcul impossible");
+        } else {
+            snprintf(buf + len,
+                     sizeof(buf) - len,
+                     "\nRéseau: pompe %.1f bar, buse la plus éloignée %.1f bar (%.0f mL/min)%s",
+                     net_out.pump_pressure_bar,
+                     net_out.farthest_pressure_bar,
+                     net_out.farthest_flow_ml_min,
+                     net_out.warning_far_nozzle_low ? " - pression insuffisante, brume grossière" : "");
+        }
         lv_label_set_text(out_label, buf);
         storage_save_misting(&in);
     } else {
         lv_label_set_text(out_label, "Entrées invalides pour la brumisation.");
     }
+
+    calc_sensitivity_t sens = {0};
+    misting_sensitivity(&in, &sens);
+    ui_sensitivity_panel_update(sens_panel, &sens);
+    update_bounds(bounds_panel, &in);
+}
+
+// Recalcul léger des bornes à chaque frappe, sans sauvegarde NVS
+static void bounds_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    const misting_input_t in = read_inputs(controls);
+    update_bounds(controls[9], &in);
 }
 
 void ui_screen_misting_build(lv_obj_t *parent)
@@ -169,30 +264,12 @@ void ui_screen_misting_build(lv_obj_t *parent)
     misting_input_t defaults = {0};
     storage_load_misting(&defaults);
 
-    char tmp[16];
     lv_obj_t *length_ta = create_input_row(inputs, "Longueur (cm)", "100");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.length_cm);
-    lv_textarea_set_text(length_ta, tmp);
-
     lv_obj_t *depth_ta = create_input_row(inputs, "Profondeur (cm)", "60");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.depth_cm);
-    lv_textarea_set_text(depth_ta, tmp);
-
     lv_obj_t *flow_ta = create_input_row(inputs, "Débit buse (mL/min)", "80");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.nozzle_flow_ml_per_min);
-    lv_textarea_set_text(flow_ta, tmp);
-
     lv_obj_t *duration_ta = create_input_row(inputs, "Durée cycle (min)", "2");
-    snprintf(tmp, sizeof(tmp), "%.1f", defaults.cycle_duration_min);
-    lv_textarea_set_text(duration_ta, tmp);
-
     lv_obj_t *cycle_ta = create_input_row(inputs, "Cycles / jour", "4");
-    snprintf(tmp, sizeof(tmp), "%u", defaults.cycles_per_day);
-    lv_textarea_set_text(cycle_ta, tmp);
-
     lv_obj_t *autonomy_ta = create_input_row(inputs, "Autonomie (jours)", "3");
-    snprintf(tmp, sizeof(tmp), "%u", defaults.autonomy_days);
-    lv_textarea_set_text(autonomy_ta, tmp);
 
     lv_obj_t *env_cont = lv_obj_create(inputs);
     lv_obj_set_size(env_cont, 240, LV_SIZE_CONTENT);
@@ -208,7 +285,6 @@ void ui_screen_misting_build(lv_obj_t *parent)
 
     lv_obj_t *env_dd = lv_dropdown_create(env_cont);
     lv_dropdown_set_options(env_dd, "Tropical\nTempéré humide\nSemi-aride\nDésertique");
-    lv_dropdown_set_selected(env_dd, defaults.environment);
     lv_obj_set_style_min_height(env_dd, 44, LV_PART_MAIN);
     lv_obj_set_style_text_font(env_dd, &lv_font_montserrat_20, LV_PART_MAIN);
 
@@ -229,13 +305,17 @@ void ui_screen_misting_build(lv_obj_t *parent)
     lv_label_set_text(out, "Résultats brumisation en attente.");
     lv_obj_set_style_text_color(out, COLOR_TEXT, LV_PART_MAIN);
 
+    lv_obj_t *bounds_panel = ui_bounds_panel_create(parent, "Tolérances : ±0,5 cm sur les cotes, ±10 % sur le débit des buses.");
+    lv_obj_t *sens_panel = ui_sensitivity_panel_create(parent);
+    ui_airflow_panel_create(parent, defaults.length_cm);
+
     create_help_block(parent,
                       "Aide & limites",
                       "Débits de buses fines typiques 60-120 mL/min. Couverture 0,08-0,16 m²/buse selon milieu : trop faible →"
                       " humidité inhomogène, trop forte → saturation. Ajouter 20% de marge sur le volume, vérifier la filtration"
                       " et le niveau d'eau quotidiennement.");
 
-    static lv_obj_t *controls[8];
+    lv_obj_t **controls = s_controls;
     controls[0] = length_ta;
     controls[1] = depth_ta;
     controls[2] = flow_ta;
@@ -244,6 +324,22 @@ void ui_screen_misting_build(lv_obj_t *parent)
     controls[5] = autonomy_ta;
     controls[6] = env_dd;
     controls[7] = out;
+    controls[8] = sens_panel;
+    controls[9] = bounds_panel;
+    show_inputs(controls, &defaults);
     lv_obj_add_event_cb(btn, calculate_cb, LV_EVENT_CLICKED, controls);
+    for (size_t i = 0; i < 7; ++i) {
+        lv_obj_add_event_cb(controls[i], bounds_cb, LV_EVENT_VALUE_CHANGED, controls);
+    }
 }
 
+// Rechargées depuis la NVS après application d'une fiche espèce
+void ui_screen_misting_reload(void)
+{
+    if (!s_controls[0]) {
+        return;
+    }
+    misting_input_t in = {0};
+    storage_load_misting(&in);
+    show_inputs(s_controls, &in);
+}
@@ -7,6 +7,7 @@ extern "C" {
 #endif
 
 void ui_screen_misting_build(lv_obj_t *parent);
+void ui_screen_misting_reload(void);
 
 #ifdef __cplusplus
 }
@@ -3,9 +3,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "calc_floor_stack.h"
 #include "calc_heating_pad.h"
 #include "storage.h"
+#include "ui_bounds.h"
 #include "ui_keyboard.h"
+#include "ui_sensitivity.h"
 
 #define COLOR_TEXT lv_color_hex(0xE2E8F0)
 #define COLOR_MUTED lv_color_hex(0x94A3B8)
@@ -115,15 +118,29 @@ static lv_obj_t *create_input_row(lv_obj_t *parent, const char *label, const cha
     return ta;
 }
 
-static void calculate_cb(lv_event_t *e)
+static lv_obj_t *s_controls[9];
+
+static void show_inputs(lv_obj_t **controls, const heating_pad_input_t *in)
+{
+    char tmp[16];
+    snprintf(tmp, sizeof(tmp), "%.0f", in->length_cm);
+    lv_textarea_set_text(controls[0], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->depth_cm);
+    lv_textarea_set_text(controls[1], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->height_cm);
+    lv_textarea_set_text(controls[2], tmp);
+    snprintf(tmp, sizeof(tmp), "%.2f", in->heated_ratio);
+    lv_textarea_set_text(controls[3], tmp);
+    lv_dropdown_set_selected(controls[4], in->material);
+}
+
+static heating_pad_input_t read_inputs(lv_obj_t **controls)
 {
-    lv_obj_t **controls = lv_event_get_user_data(e);
     lv_obj_t *length_ta = controls[0];
     lv_obj_t *depth_ta = controls[1];
     lv_obj_t *height_ta = controls[2];
     lv_obj_t *ratio_ta = controls[3];
     lv_obj_t *material_dd = controls[4];
-    lv_obj_t *out_label = controls[5];
 
     heating_pad_input_t in = {
         .length_cm = parse_decimal(lv_textarea_get_text(length_ta), 100.0f),
@@ -132,6 +149,70 @@ static void calculate_cb(lv_event_t *e)
         .heated_ratio = parse_decimal(lv_textarea_get_text(ratio_ta), 0.33f),
         .material = material_from_dd(material_dd),
     };
+    return in;
+}
+
+static void update_bounds(lv_obj_t *panel, const heating_pad_input_t *in)
+{
+    heating_pad_input_t tol;
+    heating_pad_default_tolerance(in, &tol);
+    calc_bounds_t bounds = {0};
+    heating_pad_bounds(in, &tol, &bounds);
+    ui_bounds_panel_update(panel, &bounds);
+}
+
+// Substrat saisi dans l'onglet Substrat, relu à chaque calcul (pas à chaque frappe)
+static substrate_input_t s_substrate;
+
+// Température de surface à travers plancher + substrat : forme close, assez
+// légère pour suivre chaque frappe.
+static void update_floor_stack(lv_obj_t *label, const heating_pad_input_t *in)
+{
+    heating_pad_result_t pad = {0};
+    floor_stack_result_t stack = {0};
+    floor_stack_input_t stack_in = {
+        .floor_material = in->material,
+        .below_insulation_cm = 1.0f,
+        .enclosure_air_c = 26.0f,
+        .room_air_c = 21.0f,
+    };
+    floor_stack_apply_substrate(&stack_in, &s_substrate);
+    if (!heating_pad_calculate(in, &pad) || !pad.valid) {
+        lv_label_set_text(label, "");
+        return;
+    }
+    stack_in.power_density_w_per_cm2 = pad.power_density_w_per_cm2;
+    stack_in.pad_side_cm = pad.heater_side_cm;
+    if (!floor_stack_calculate(&stack_in, &stack)) {
+        lv_label_set_text(label, "");
+        return;
+    }
+    char buf[256];
+    snprintf(buf,
+             sizeof(buf),
+             "Sous %.0f cm de substrat (air 26 °C, sans thermostat) : tapis %.0f °C, fond %.0f °C,"
+             " surface %.0f °C sur ≈%.0f cm%s%s",
+             s_substrate.substrate_height_cm,
+             stack.pad_temp_c,
+             stack.floor_top_temp_c,
+             stack.surface_temp_c,
+             stack.surface_spot_cm,
+             stack.warning_burrow_hot ? "\nFond >40 °C : thermostat obligatoire (terriers)." : "",
+             stack.warning_surface_weak ? "\nSurface à peine chauffée : substrat trop épais ou isolant." : "");
+    lv_label_set_text(label, buf);
+}
+
+static void calculate_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    lv_obj_t *out_label = controls[5];
+    lv_obj_t *sens_panel = controls[6];
+    lv_obj_t *bounds_panel = controls[7];
+    lv_obj_t *stack_label = controls[8];
+
+    heating_pad_input_t in = read_inputs(controls);
+    storage_load_substrate(&s_substrate);
+    update_floor_stack(stack_label, &in);
 
     heating_pad_result_t out = {0};
     if (heating_pad_calculate(&in, &out) && out.valid) {
@@ -158,6 +239,20 @@ static void calculate_cb(lv_event_t *e)
     } else {
         lv_label_set_text(out_label, "Entrées invalides pour le calcul de tapis chauffant.");
     }
+
+    calc_sensitivity_t sens = {0};
+    heating_pad_sensitivity(&in, &sens);
+    ui_sensitivity_panel_update(sens_panel, &sens);
+    update_bounds(bounds_panel, &in);
+}
+
+// Recalcul léger des bornes à chaque frappe, sans sauvegarde NVS
+static void bounds_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    const heating_pad_input_t in = read_inputs(controls);
+    update_bounds(controls[7], &in);
+    update_floor_stack(controls[8], &in);
 }
 
 void ui_screen_pad_build(lv_obj_t *parent)
@@ -172,23 +267,12 @@ void ui_screen_pad_build(lv_obj_t *parent)
 
     heating_pad_input_t defaults = {0};
     storage_load_heating_pad(&defaults);
+    storage_load_substrate(&s_substrate);
 
-    char tmp[16];
     lv_obj_t *length_ta = create_input_row(inputs, "Longueur (cm)", "100", true);
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.length_cm);
-    lv_textarea_set_text(length_ta, tmp);
-
     lv_obj_t *depth_ta = create_input_row(inputs, "Profondeur (cm)", "60", true);
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.depth_cm);
-    lv_textarea_set_text(depth_ta, tmp);
-
     lv_obj_t *height_ta = create_input_row(inputs, "Hauteur (cm)", "60", true);
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.height_cm);
-    lv_textarea_set_text(height_ta, tmp);
-
     lv_obj_t *ratio_ta = create_input_row(inputs, "Ratio surface chauffée (0.2-0.6)", "0.33", true);
-    snprintf(tmp, sizeof(tmp), "%.2f", defaults.heated_ratio);
-    lv_textarea_set_text(ratio_ta, tmp);
 
     lv_obj_t *mat_cont = lv_obj_create(inputs);
     lv_obj_set_size(mat_cont, 240, LV_SIZE_CONTENT);
@@ -204,7 +288,6 @@ void ui_screen_pad_build(lv_obj_t *parent)
 
     lv_obj_t *material_dd = lv_dropdown_create(mat_cont);
     lv_dropdown_set_options(material_dd, "Bois\nVerre\nPVC\nAcrylique");
-    lv_dropdown_set_selected(material_dd, defaults.material);
     lv_obj_set_style_min_height(material_dd, 44, LV_PART_MAIN);
     lv_obj_set_style_text_font(material_dd, &lv_font_montserrat_20, LV_PART_MAIN);
 
@@ -225,19 +308,46 @@ void ui_screen_pad_build(lv_obj_t *parent)
     lv_label_set_text(out, "Résultats tapis chauffant en attente.");
     lv_obj_set_style_text_color(out, COLOR_TEXT, LV_PART_MAIN);
 
+    lv_obj_t *stack_label = lv_label_create(parent);
+    lv_obj_set_width(stack_label, LV_PCT(100));
+    lv_label_set_long_mode(stack_label, LV_LABEL_LONG_WRAP);
+    lv_label_set_text(stack_label, "");
+    lv_obj_set_style_text_color(stack_label, COLOR_MUTED, LV_PART_MAIN);
+
+    lv_obj_t *bounds_panel = ui_bounds_panel_create(parent, "Tolérances : ±0,5 cm sur les cotes, ±0,02 sur le ratio chauffé.");
+    lv_obj_t *sens_panel = ui_sensitivity_panel_create(parent);
+
     create_help_block(parent,
                       "Aide & limites",
                       "Densité catalogue visée ≈0,04 W/cm², limite matière 0,045-0,065 W/cm² selon support."
                       " Le ratio chauffé par défaut 1/3 convient aux serpents/boïdés, réduire à 0,25 pour espèces sensibles."
                       " Utiliser exclusivement 12/24 V SELV avec protection thermique et fusible.");
 
-    static lv_obj_t *controls[6];
+    lv_obj_t **controls = s_controls;
     controls[0] = length_ta;
     controls[1] = depth_ta;
     controls[2] = height_ta;
     controls[3] = ratio_ta;
     controls[4] = material_dd;
     controls[5] = out;
+    controls[6] = sens_panel;
+    controls[7] = bounds_panel;
+    controls[8] = stack_label;
+    show_inputs(controls, &defaults);
     lv_obj_add_event_cb(btn, calculate_cb, LV_EVENT_CLICKED, controls);
+    for (size_t i = 0; i < 5; ++i) {
+        lv_obj_add_event_cb(controls[i], bounds_cb, LV_EVENT_VALUE_CHANGED, controls);
+    }
 }
 
+// Rechargées depuis la NVS après application d'une fiche espèce
+void ui_screen_pad_reload(void)
+{
+    if (!s_controls[0]) {
+        return;
+    }
+    heating_pad_input_t in = {0};
+    storage_load_heating_pad(&in);
+    storage_load_substrate(&s_substrate);
+    show_inputs(s_controls, &in);
+}
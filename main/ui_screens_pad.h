@@ -7,6 +7,7 @@ extern "C" {
 #endif
 
 void ui_screen_pad_build(lv_obj_t *parent);
+void ui_screen_pad_reload(void);
 
 #ifdef __cplusplus
 }
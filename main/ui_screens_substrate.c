@@ -2,10 +2,13 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "calc_substrate.h"
 #include "storage.h"
+#include "ui_bounds.h"
 #include "ui_keyboard.h"
+#include "ui_sensitivity.h"
 
 #define COLOR_TEXT lv_color_hex(0xE2E8F0)
 #define COLOR_MUTED lv_color_hex(0x94A3B8)
@@ -116,15 +119,29 @@ static lv_obj_t *create_input_row(lv_obj_t *parent, const char *label, const cha
     return ta;
 }
 
-static void calculate_cb(lv_event_t *e)
+static lv_obj_t *s_controls[8];
+
+static void show_inputs(lv_obj_t **controls, const substrate_input_t *in)
+{
+    char tmp[16];
+    snprintf(tmp, sizeof(tmp), "%.0f", in->length_cm);
+    lv_textarea_set_text(controls[0], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->depth_cm);
+    lv_textarea_set_text(controls[1], tmp);
+    snprintf(tmp, sizeof(tmp), "%.0f", in->height_cm);
+    lv_textarea_set_text(controls[2], tmp);
+    snprintf(tmp, sizeof(tmp), "%.1f", in->substrate_height_cm);
+    lv_textarea_set_text(controls[3], tmp);
+    lv_dropdown_set_selected(controls[4], in->type);
+}
+
+static substrate_input_t read_inputs(lv_obj_t **controls)
 {
-    lv_obj_t **controls = lv_event_get_user_data(e);
     lv_obj_t *length_ta = controls[0];
     lv_obj_t *depth_ta = controls[1];
     lv_obj_t *height_ta = controls[2];
     lv_obj_t *substrate_ta = controls[3];
     lv_obj_t *type_dd = controls[4];
-    lv_obj_t *out_label = controls[5];
 
     substrate_input_t in = {
         .length_cm = parse_decimal(lv_textarea_get_text(length_ta), 100.0f),
@@ -133,10 +150,52 @@ static void calculate_cb(lv_event_t *e)
         .substrate_height_cm = parse_decimal(lv_textarea_get_text(substrate_ta), 8.0f),
         .type = type_from_dd(type_dd),
     };
+    return in;
+}
+
+static void update_bounds(lv_obj_t *panel, const substrate_input_t *in)
+{
+    substrate_input_t tol;
+    substrate_default_tolerance(in, &tol);
+    calc_bounds_t bounds = {0};
+    substrate_bounds(in, &tol, &bounds);
+    ui_bounds_panel_update(panel, &bounds);
+}
+
+// Liste d'achat la moins chère (reste pénalisé) pour la couche saisie
+static void append_purchase(char *buf, size_t size, const substrate_input_t *in, const substrate_result_t *out)
+{
+    const substrate_layer_t layer = {.type = in->type, .volume_l = out->volume_l};
+    static substrate_plan_workspace_t ws; // tâche LVGL uniquement
+    substrate_purchase_t plan = {0};
+    if (!substrate_plan_purchase(&layer, 1, &ws, &plan) || !plan.valid) {
+        return;
+    }
+    size_t count = 0;
+    const substrate_package_t *table = substrate_package_table(&count);
+    const substrate_layer_plan_t *lp = &plan.layers[0];
+    size_t len = strlen(buf);
+    snprintf(buf + len, size - len, "\nAchat :");
+    for (uint8_t j = 0; j < lp->line_count; ++j) {
+        len = strlen(buf);
+        snprintf(buf + len, size - len, "%s %u x %s", j ? "," : "", lp->quantity[j], table[lp->package_index[j]].name);
+    }
+    len = strlen(buf);
+    snprintf(buf + len, size - len, " = %.2f € (reste %.1f L)", lp->cost_eur, lp->waste_l);
+}
+
+static void calculate_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    lv_obj_t *out_label = controls[5];
+    lv_obj_t *sens_panel = controls[6];
+    lv_obj_t *bounds_panel = controls[7];
+
+    substrate_input_t in = read_inputs(controls);
 
     substrate_result_t out = {0};
     if (substrate_calculate(&in, &out) && out.valid) {
-        char buf[256];
+        char buf[384];
         snprintf(buf,
                  sizeof(buf),
                  "Volume: %.1f L\nMasse: %.1f-%.1f kg (densité %.2f-%.2f kg/L)\nNominal: %.1f kg",
@@ -146,11 +205,25 @@ static void calculate_cb(lv_event_t *e)
                  out.density_min_kg_per_l,
                  out.density_max_kg_per_l,
                  out.mass_kg);
+        append_purchase(buf, sizeof(buf), &in, &out);
         lv_label_set_text(out_label, buf);
         storage_save_substrate(&in);
     } else {
         lv_label_set_text(out_label, "Entrées invalides pour le substrat.");
     }
+
+    calc_sensitivity_t sens = {0};
+    substrate_sensitivity(&in, &sens);
+    ui_sensitivity_panel_update(sens_panel, &sens);
+    update_bounds(bounds_panel, &in);
+}
+
+// Recalcul léger des bornes à chaque frappe, sans sauvegarde NVS
+static void bounds_cb(lv_event_t *e)
+{
+    lv_obj_t **controls = lv_event_get_user_data(e);
+    const substrate_input_t in = read_inputs(controls);
+    update_bounds(controls[7], &in);
 }
 
 void ui_screen_substrate_build(lv_obj_t *parent)
@@ -166,22 +239,10 @@ void ui_screen_substrate_build(lv_obj_t *parent)
     substrate_input_t defaults = {0};
     storage_load_substrate(&defaults);
 
-    char tmp[16];
     lv_obj_t *length_ta = create_input_row(inputs, "Longueur (cm)", "100");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.length_cm);
-    lv_textarea_set_text(length_ta, tmp);
-
     lv_obj_t *depth_ta = create_input_row(inputs, "Profondeur (cm)", "60");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.depth_cm);
-    lv_textarea_set_text(depth_ta, tmp);
-
     lv_obj_t *height_ta = create_input_row(inputs, "Hauteur (cm)", "60");
-    snprintf(tmp, sizeof(tmp), "%.0f", defaults.height_cm);
-    lv_textarea_set_text(height_ta, tmp);
-
     lv_obj_t *substrate_ta = create_input_row(inputs, "Hauteur substrat (cm)", "8");
-    snprintf(tmp, sizeof(tmp), "%.1f", defaults.substrate_height_cm);
-    lv_textarea_set_text(substrate_ta, tmp);
 
     lv_obj_t *type_cont = lv_obj_create(inputs);
     lv_obj_set_size(type_cont, 240, LV_SIZE_CONTENT);
@@ -197,7 +258,6 @@ void ui_screen_substrate_build(lv_obj_t *parent)
 
     lv_obj_t *type_dd = lv_dropdown_create(type_cont);
     lv_dropdown_set_options(type_dd, "Terreau\nFibre coco\nMélange forestier\nSable\nSable/terre");
-    lv_dropdown_set_selected(type_dd, defaults.type);
     lv_obj_set_style_min_height(type_dd, 44, LV_PART_MAIN);
     lv_obj_set_style_text_font(type_dd, &lv_font_montserrat_20, LV_PART_MAIN);
 
@@ -218,18 +278,37 @@ void ui_screen_substrate_build(lv_obj_t *parent)
     lv_label_set_text(out, "Résultats substrat en attente.");
     lv_obj_set_style_text_color(out, COLOR_TEXT, LV_PART_MAIN);
 
+    lv_obj_t *bounds_panel = ui_bounds_panel_create(parent, "Tolérances : ±0,5 cm sur les cotes et l'épaisseur, plus la plage de densité du matériau.");
+    lv_obj_t *sens_panel = ui_sensitivity_panel_create(parent);
+
     create_help_block(parent,
                       "Aide & limites",
                       "Densités typiques : terreau 0,65-0,85 kg/L, coco 0,45-0,65 kg/L, forêt 0,60-0,80 kg/L, sable 1,5-1,7 kg/L."
                       " Prévoir +10% pour tassement et pertes; augmenter la hauteur si l'espèce creuse profondément.");
 
-    static lv_obj_t *controls[6];
+    lv_obj_t **controls = s_controls;
     controls[0] = length_ta;
     controls[1] = depth_ta;
     controls[2] = height_ta;
     controls[3] = substrate_ta;
     controls[4] = type_dd;
     controls[5] = out;
+    controls[6] = sens_panel;
+    controls[7] = bounds_panel;
+    show_inputs(controls, &defaults);
     lv_obj_add_event_cb(btn, calculate_cb, LV_EVENT_CLICKED, controls);
+    for (size_t i = 0; i < 5; ++i) {
+        lv_obj_add_event_cb(controls[i], bounds_cb, LV_EVENT_VALUE_CHANGED, controls);
+    }
 }
 
+// Rechargées depuis la NVS après application d'une fiche espèce
+void ui_screen_substrate_reload(void)
+{
+    if (!s_controls[0]) {
+        return;
+    }
+    substrate_input_t in = {0};
+    storage_load_substrate(&in);
+    show_inputs(s_controls, &in);
+}
@@ -0,0 +1,67 @@
+#include "ui_sensitivity.h"
+
+#include <math.h>
+
+#include "ui_result_panel.h"
+
+#define COLOR_MUTED lv_color_hex(0x94A3B8)
+
+// Entrées affichées par sortie, classées par élasticité décroissante
+#define TOP_INPUTS 2
+
+lv_obj_t *ui_sensitivity_panel_create(lv_obj_t *parent)
+{
+    return ui_result_panel_create(parent,
+                                  "Sensibilité",
+                                  "Calculer pour voir quelles entrées pèsent le plus sur le résultat.",
+                                  COLOR_MUTED);
+}
+
+void ui_sensitivity_panel_update(lv_obj_t *panel, const calc_sensitivity_t *s)
+{
+    lv_obj_t *body = ui_result_panel_body(panel);
+    if (!body) {
+        return;
+    }
+    if (!s || !s->valid || s->output_count == 0) {
+        lv_label_set_text(body, "Sensibilité indisponible pour ces entrées.");
+        return;
+    }
+
+    char buf[768];
+    size_t len = 0;
+    for (uint8_t o = 0; o < s->output_count; ++o) {
+        len = ui_result_panel_appendf(buf, sizeof(buf), len, "%s%s = %.3g :", (o == 0) ? "" : "\n", s->output_names[o], s->output_values[o]);
+
+        bool used[CALC_SENS_MAX_INPUTS] = {0};
+        bool any = false;
+        for (int rank = 0; rank < TOP_INPUTS; ++rank) {
+            int best = -1;
+            float best_abs = 0.0f;
+            for (uint8_t i = 0; i < s->input_count; ++i) {
+                const float e = fabsf(calc_sensitivity_elasticity(s, o, i));
+                if (!used[i] && e > best_abs) {
+                    best = i;
+                    best_abs = e;
+                }
+            }
+            if (best < 0 || best_abs < 1e-3f) {
+                break;
+            }
+            used[best] = true;
+            any = true;
+            len = ui_result_panel_appendf(buf,
+                                          sizeof(buf),
+                                          len,
+                                          "%s %s %+.3g/u (%+.2f %%/%%)",
+                                          (rank == 0) ? "" : ",",
+                                          s->input_names[best],
+                                          s->partial[o][best],
+                                          calc_sensitivity_elasticity(s, o, best));
+        }
+        if (!any) {
+            len = ui_result_panel_appendf(buf, sizeof(buf), len, " insensible (palier ou butée)");
+        }
+    }
+    lv_label_set_text(body, buf);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "lvgl.h"
+
+#include "calc_sensitivity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bloc « Sensibilité » commun aux écrans de calcul : pour chaque sortie, les
+ * entrées qui la font le plus varier (dérivée et élasticité).
+ */
+lv_obj_t *ui_sensitivity_panel_create(lv_obj_t *parent);
+void ui_sensitivity_panel_update(lv_obj_t *panel, const calc_sensitivity_t *s);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,213 @@
+#include "ui_species.h"
+
+#include <stdio.h>
+
+#include "calc_species.h"
+#include "storage.h"
+#include "ui_keyboard.h"
+#include "ui_screens_cable.h"
+#include "ui_screens_lighting.h"
+#include "ui_screens_misting.h"
+#include "ui_screens_pad.h"
+#include "ui_screens_substrate.h"
+
+#define COLOR_TEXT lv_color_hex(0xE2E8F0)
+#define COLOR_MUTED lv_color_hex(0x94A3B8)
+#define COLOR_SURFACE lv_color_hex(0x111827)
+#define COLOR_ACCENT lv_color_hex(0x22D3EE)
+
+static species_search_t s_search;
+static lv_obj_t *s_result_btns[SPECIES_MAX_RESULTS];
+static lv_obj_t *s_count_label;
+static lv_obj_t *s_detail_label;
+static lv_obj_t *s_apply_btn;
+static const species_t *s_selected;
+
+static const char *const k_env_names[] = {"tropical", "désertique", "forêt tempérée", "nocturne"};
+static const char *const k_substrate_names[] = {"terreau", "coco", "forest blend", "sable", "sable/terre"};
+
+static void show_detail(const species_t *sp)
+{
+    s_selected = sp;
+    if (!sp) {
+        lv_label_set_text(s_detail_label, "Tape quelques lettres du nom commun ou latin (ex. « léopard », « pogona »).");
+        lv_obj_add_state(s_apply_btn, LV_STATE_DISABLED);
+        return;
+    }
+    static char buf[384];
+    snprintf(buf,
+             sizeof(buf),
+             "%s (%s)\n"
+             "Biotope %s, zone de Ferguson %u, %u-%u klux\n"
+             "Hygrométrie %u-%u %%, point froid %d °C, point chaud %d °C, basking %d °C\n"
+             "Terrarium conseillé %u×%u×%u cm, substrat %s %u cm, ratio chauffé %.2f",
+             sp->common_name,
+             sp->latin_name,
+             k_env_names[sp->environment % TERRARIUM_ENV_COUNT],
+             sp->ferguson_zone,
+             sp->lux_min_klux,
+             sp->lux_max_klux,
+             sp->humidity_min_pct,
+             sp->humidity_max_pct,
+             sp->temp_cool_c,
+             sp->temp_hot_c,
+             sp->temp_basking_c,
+             sp->length_cm,
+             sp->depth_cm,
+             sp->height_cm,
+             k_substrate_names[sp->substrate % SUBSTRATE_COUNT],
+             sp->substrate_height_cm,
+             sp->heated_ratio_pct / 100.0f);
+    lv_label_set_text(s_detail_label, buf);
+    lv_obj_remove_state(s_apply_btn, LV_STATE_DISABLED);
+}
+
+// Appelé à chaque frappe : la recherche reprend la plage de la requête
+// précédente, seul l'affichage des 8 boutons coûte quelque chose.
+static void query_changed_cb(lv_event_t *e)
+{
+    lv_obj_t *ta = lv_event_get_target(e);
+    species_search_update(&s_search, lv_textarea_get_text(ta));
+
+    for (uint8_t i = 0; i < SPECIES_MAX_RESULTS; ++i) {
+        lv_obj_t *btn = s_result_btns[i];
+        if (i < s_search.result_count) {
+            const species_t *sp = species_get(s_search.results[i]);
+            lv_label_set_text(lv_obj_get_child(btn, 0), sp->common_name);
+            lv_obj_set_user_data(btn, (void *)sp);
+            lv_obj_remove_flag(btn, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(btn, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    char count[64];
+    if (s_search.query[0] == '\0') {
+        snprintf(count, sizeof(count), "%u espèces disponibles", (unsigned)species_count());
+    } else {
+        snprintf(count, sizeof(count), "%u correspondance(s)", s_search.match_count);
+    }
+    lv_label_set_text(s_count_label, count);
+    show_detail(s_search.result_count == 1 ? species_get(s_search.results[0]) : NULL);
+}
+
+static void result_cb(lv_event_t *e)
+{
+    lv_obj_t *btn = lv_event_get_target(e);
+    show_detail(lv_obj_get_user_data(btn));
+}
+
+// Les saisies sont réécrites en NVS puis rechargées par chaque onglet, qui
+// recalcule ses bornes comme après une frappe.
+static void apply_cb(lv_event_t *e)
+{
+    (void)e;
+    if (!s_selected) {
+        return;
+    }
+    heating_pad_input_t pad = {0};
+    heating_cable_input_t cable = {0};
+    lighting_input_t lighting = {0};
+    substrate_input_t substrate = {0};
+    misting_input_t misting = {0};
+    storage_load_heating_pad(&pad);
+    storage_load_heating_cable(&cable);
+    storage_load_lighting(&lighting);
+    storage_load_substrate(&substrate);
+    storage_load_misting(&misting);
+
+    species_fill_inputs(s_selected, &pad, &cable, &lighting, &substrate, &misting);
+
+    storage_save_heating_pad(&pad);
+    storage_save_heating_cable(&cable);
+    storage_save_lighting(&lighting);
+    storage_save_substrate(&substrate);
+    storage_save_misting(&misting);
+
+    ui_screen_pad_reload();
+    ui_screen_cable_reload();
+    ui_screen_lighting_reload();
+    ui_screen_substrate_reload();
+    ui_screen_misting_reload();
+
+    static char msg[128];
+    snprintf(msg, sizeof(msg), "%s appliqué à tous les onglets.", s_selected->common_name);
+    lv_label_set_text(s_count_label, msg);
+}
+
+lv_obj_t *ui_species_panel_create(lv_obj_t *parent)
+{
+    species_search_reset(&s_search);
+
+    lv_obj_t *block = lv_obj_create(parent);
+    lv_obj_set_width(block, LV_PCT(100));
+    lv_obj_set_height(block, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_color(block, COLOR_SURFACE, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(block, LV_OPA_80, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(block, 12, LV_PART_MAIN);
+    lv_obj_set_style_radius(block, 8, LV_PART_MAIN);
+    lv_obj_set_style_border_color(block, COLOR_ACCENT, LV_PART_MAIN);
+    lv_obj_set_style_border_width(block, 2, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(block, 8, LV_PART_MAIN);
+    lv_obj_set_flex_flow(block, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t *hdr = lv_label_create(block);
+    lv_label_set_text(hdr, "Fiche espèce");
+    lv_obj_set_style_text_color(hdr, COLOR_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(hdr, &lv_font_montserrat_20, LV_PART_MAIN);
+
+    lv_obj_t *ta = lv_textarea_create(block);
+    lv_textarea_set_one_line(ta, true);
+    lv_textarea_set_placeholder_text(ta, "Rechercher une espèce...");
+    lv_textarea_set_max_length(ta, SPECIES_QUERY_MAX - 1);
+    lv_obj_set_width(ta, LV_PCT(100));
+    lv_obj_set_style_min_height(ta, 48, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ta, &lv_font_montserrat_20, LV_PART_MAIN);
+    ui_keyboard_attach_text(ta);
+    lv_obj_add_event_cb(ta, query_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
+
+    s_count_label = lv_label_create(block);
+    lv_obj_set_style_text_color(s_count_label, COLOR_MUTED, LV_PART_MAIN);
+
+    lv_obj_t *results = lv_obj_create(block);
+    lv_obj_set_width(results, LV_PCT(100));
+    lv_obj_set_height(results, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(results, LV_OPA_0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(results, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(results, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(results, 8, LV_PART_MAIN);
+    lv_obj_set_flex_flow(results, LV_FLEX_FLOW_ROW_WRAP);
+
+    // boutons créés une fois puis réétiquetés : pas d'allocation à la frappe
+    for (uint8_t i = 0; i < SPECIES_MAX_RESULTS; ++i) {
+        lv_obj_t *btn = lv_button_create(results);
+        lv_obj_set_width(btn, LV_SIZE_CONTENT);
+        lv_obj_set_style_min_height(btn, 44, LV_PART_MAIN);
+        lv_obj_add_event_cb(btn, result_cb, LV_EVENT_CLICKED, NULL);
+        lv_obj_t *lbl = lv_label_create(btn);
+        lv_obj_set_style_text_color(lbl, COLOR_TEXT, LV_PART_MAIN);
+        lv_obj_add_flag(btn, LV_OBJ_FLAG_HIDDEN);
+        s_result_btns[i] = btn;
+    }
+
+    s_detail_label = lv_label_create(block);
+    lv_obj_set_width(s_detail_label, LV_PCT(100));
+    lv_label_set_long_mode(s_detail_label, LV_LABEL_LONG_WRAP);
+    lv_obj_set_style_text_color(s_detail_label, COLOR_TEXT, LV_PART_MAIN);
+
+    s_apply_btn = lv_button_create(block);
+    lv_obj_set_width(s_apply_btn, LV_SIZE_CONTENT);
+    lv_obj_set_style_min_height(s_apply_btn, 52, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(s_apply_btn, COLOR_ACCENT, LV_PART_MAIN);
+    lv_obj_add_event_cb(s_apply_btn, apply_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *apply_lbl = lv_label_create(s_apply_btn);
+    lv_label_set_text(apply_lbl, "Appliquer à tous les onglets");
+    lv_obj_set_style_text_color(apply_lbl, COLOR_TEXT, LV_PART_MAIN);
+
+    char count[64];
+    snprintf(count, sizeof(count), "%u espèces disponibles", (unsigned)species_count());
+    lv_label_set_text(s_count_label, count);
+    show_detail(NULL);
+
+    return block;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bloc « Fiche espèce » : recherche par préfixe (nom commun ou latin) mise à
+ * jour à chaque frappe du clavier texte, puis application des conditions de
+ * l'espèce à tous les onglets de calcul d'un coup.
+ */
+lv_obj_t *ui_species_panel_create(lv_obj_t *parent);
+
+#ifdef __cplusplus
+}
+#endif
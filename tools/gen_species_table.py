@@ -0,0 +1,637 @@
+#!/usr/bin/env python3
+"""Génère main/calc_species_table.inc à partir de la liste d'espèces ci-dessous.
+
+Chaque espèce hérite des conditions de son biotope (zone de Ferguson, lux,
+hygrométrie, températures, substrat) et d'un gabarit de terrarium selon sa
+taille adulte. L'index de recherche est trié ici, une fois pour toutes : le
+firmware ne fait qu'une recherche dichotomique dans la flash.
+
+Usage : python3 tools/gen_species_table.py > main/calc_species_table.inc
+"""
+
+import sys
+import unicodedata
+
+# biotope : zone, environnement éclairage, environnement brumisation,
+#           lux min/max (klux), HR min/max (%), T° point froid/chaud/basking,
+#           substrat, ratio chauffé (%), hauteur substrat (cm)
+BIOTOPES = {
+    "desert":      (3, "DESERTIC", "DESERTIC", 15, 20, 20, 40, 26, 35, 45, "SAND_SOIL", 33, 10),
+    "desert_hot":  (4, "DESERTIC", "DESERTIC", 18, 25, 15, 30, 27, 38, 55, "SAND_SOIL", 33, 12),
+    "desert_night": (1, "NOCTURNAL", "SEMI_ARID", 2, 5, 30, 45, 24, 32, 34, "SAND_SOIL", 33, 8),
+    "semi_arid":   (3, "DESERTIC", "SEMI_ARID", 12, 18, 35, 55, 24, 32, 40, "SAND_SOIL", 33, 10),
+    "savanna":     (3, "DESERTIC", "SEMI_ARID", 15, 20, 40, 60, 26, 35, 55, "SAND_SOIL", 33, 20),
+    "tropical":    (2, "TROPICAL", "TROPICAL", 10, 15, 60, 80, 23, 29, 33, "FOREST_BLEND", 25, 8),
+    "tropical_night": (1, "NOCTURNAL", "TROPICAL", 2, 5, 60, 90, 20, 26, 27, "FOREST_BLEND", 20, 8),
+    "rainforest":  (1, "TROPICAL", "TROPICAL", 8, 12, 80, 100, 20, 25, 26, "FOREST_BLEND", 20, 10),
+    "riparian":    (2, "TROPICAL", "TROPICAL", 12, 18, 60, 80, 24, 30, 38, "SOIL", 25, 10),
+    "monitor_wet": (3, "TROPICAL", "TROPICAL", 12, 18, 70, 90, 26, 32, 45, "SOIL", 33, 15),
+    "temperate":   (2, "TEMPERATE_FOREST", "TEMPERATE_HUMID", 8, 12, 60, 80, 18, 26, 30, "SOIL", 25, 10),
+    "temperate_cool": (1, "TEMPERATE_FOREST", "TEMPERATE_HUMID", 3, 8, 70, 90, 14, 20, 20, "FOREST_BLEND", 20, 8),
+    "mediterranean": (3, "TEMPERATE_FOREST", "SEMI_ARID", 15, 20, 40, 60, 22, 30, 35, "SOIL", 33, 12),
+    "snake_humid": (1, "NOCTURNAL", "TEMPERATE_HUMID", 3, 8, 55, 75, 25, 32, 33, "COCO", 33, 8),
+    "snake_temperate": (1, "TEMPERATE_FOREST", "SEMI_ARID", 5, 10, 40, 60, 22, 30, 32, "FOREST_BLEND", 33, 8),
+    "snake_arid":  (1, "DESERTIC", "SEMI_ARID", 8, 12, 30, 50, 24, 32, 35, "SAND_SOIL", 33, 10),
+    "spider_wet":  (1, "NOCTURNAL", "TROPICAL", 1, 3, 70, 85, 22, 27, 27, "COCO", 25, 8),
+    "spider_dry":  (1, "NOCTURNAL", "SEMI_ARID", 1, 3, 50, 65, 22, 28, 28, "COCO", 25, 10),
+    "insect":      (1, "TROPICAL", "TROPICAL", 5, 10, 50, 70, 22, 28, 28, "COCO", 20, 4),
+}
+
+# gabarits L × P × H (cm) : terrestre puis arboricole (suffixe « a »)
+SIZES = {
+    "XS": (45, 45, 30), "S": (60, 45, 45), "M": (100, 50, 50), "L": (150, 60, 60), "XL": (200, 100, 80),
+    "XSa": (30, 30, 45), "Sa": (45, 45, 60), "Ma": (60, 60, 90), "La": (90, 60, 120), "XLa": (150, 80, 180),
+}
+
+SPECIES = [
+    # Agamidés
+    ("Pogona vitticeps", "Agame barbu", "desert", "L"),
+    ("Pogona henrylawsoni", "Agame de Lawson", "desert", "M"),
+    ("Pogona minor", "Agame barbu nain", "desert", "M"),
+    ("Pogona barbata", "Agame barbu de l'Est", "desert", "L"),
+    ("Ctenophorus pictus", "Agame peint", "desert", "S"),
+    ("Ctenophorus nuchalis", "Agame à nuque", "desert", "S"),
+    ("Chlamydosaurus kingii", "Lézard à collerette", "savanna", "La"),
+    ("Physignathus cocincinus", "Dragon d'eau chinois", "riparian", "La"),
+    ("Intellagama lesueurii", "Dragon d'eau australien", "riparian", "La"),
+    ("Agama agama", "Agame des colons", "semi_arid", "M"),
+    ("Agama mwanzae", "Agame de Mwanza", "semi_arid", "M"),
+    ("Laudakia stellio", "Agame stellion", "mediterranean", "M"),
+    ("Paralaudakia caucasia", "Agame du Caucase", "semi_arid", "M"),
+    ("Stellagama stellio", "Stellion", "mediterranean", "M"),
+    ("Trapelus mutabilis", "Agame variable", "desert_hot", "S"),
+    ("Phrynocephalus mystaceus", "Agame à oreilles", "desert_hot", "M"),
+    ("Phrynocephalus arabicus", "Agame crapaud d'Arabie", "desert_hot", "S"),
+    ("Uromastyx aegyptia", "Fouette-queue d'Égypte", "desert_hot", "XL"),
+    ("Uromastyx acanthinura", "Fouette-queue nord-africain", "desert_hot", "L"),
+    ("Uromastyx ornata", "Fouette-queue orné", "desert_hot", "L"),
+    ("Uromastyx geyri", "Fouette-queue de Geyr", "desert_hot", "L"),
+    ("Uromastyx dispar", "Fouette-queue du Sahara", "desert_hot", "L"),
+    ("Uromastyx ocellata", "Fouette-queue ocellé", "desert_hot", "L"),
+    ("Uromastyx princeps", "Fouette-queue princier", "desert_hot", "M"),
+    ("Uromastyx benti", "Fouette-queue de Bent", "desert_hot", "L"),
+    ("Saara hardwickii", "Fouette-queue indien", "desert_hot", "L"),
+    ("Saara loricata", "Fouette-queue d'Irak", "desert_hot", "L"),
+    ("Moloch horridus", "Diable cornu", "desert_hot", "M"),
+    ("Calotes versicolor", "Agame des jardins", "tropical", "Ma"),
+    ("Calotes calotes", "Caméléon vert de Ceylan", "tropical", "Ma"),
+    ("Gonocephalus grandis", "Dragon de forêt géant", "rainforest", "La"),
+    ("Gonocephalus chamaeleontinus", "Dragon de forêt de Java", "rainforest", "La"),
+    ("Acanthosaura capra", "Agame cornu vert", "rainforest", "Ma"),
+    ("Acanthosaura lepidogaster", "Agame cornu brun", "rainforest", "Ma"),
+    ("Draco volans", "Dragon volant", "tropical", "Ma"),
+    ("Hydrosaurus amboinensis", "Hydrosaure d'Amboine", "riparian", "XL"),
+    ("Leiolepis belliana", "Leiolépis papillon", "semi_arid", "L"),
+    ("Lophognathus gilberti", "Dragon de Gilbert", "savanna", "M"),
+    ("Amphibolurus muricatus", "Dragon de Jacky", "semi_arid", "M"),
+    ("Diporiphora bilineata", "Dragon à deux raies", "semi_arid", "S"),
+    ("Xenagama taylori", "Agame à queue de bouclier", "desert_hot", "S"),
+    # Caméléons
+    ("Chamaeleo calyptratus", "Caméléon casqué du Yémen", "tropical", "La"),
+    ("Furcifer pardalis", "Caméléon panthère", "tropical", "La"),
+    ("Furcifer lateralis", "Caméléon tapis", "tropical", "Ma"),
+    ("Furcifer oustaleti", "Caméléon d'Oustalet", "tropical", "XLa"),
+    ("Furcifer verrucosus", "Caméléon verruqueux", "tropical", "La"),
+    ("Furcifer minor", "Caméléon mineur", "tropical", "Ma"),
+    ("Trioceros jacksonii", "Caméléon de Jackson", "temperate", "La"),
+    ("Trioceros melleri", "Caméléon de Meller", "tropical", "XLa"),
+    ("Trioceros quadricornis", "Caméléon à quatre cornes", "temperate", "La"),
+    ("Trioceros hoehnelii", "Caméléon de Höhnel", "temperate", "Ma"),
+    ("Trioceros deremensis", "Caméléon à trois cornes d'Usambara", "temperate", "La"),
+    ("Trioceros montium", "Caméléon du Cameroun", "temperate", "Ma"),
+    ("Kinyongia multituberculata", "Caméléon des Usambara", "temperate", "Ma"),
+    ("Chamaeleo chamaeleon", "Caméléon commun", "mediterranean", "Ma"),
+    ("Chamaeleo senegalensis", "Caméléon du Sénégal", "tropical", "Ma"),
+    ("Chamaeleo gracilis", "Caméléon gracile", "tropical", "La"),
+    ("Calumma parsonii", "Caméléon de Parson", "tropical", "XLa"),
+    ("Calumma globifer", "Caméléon globifère", "rainforest", "La"),
+    ("Brookesia superciliaris", "Brookésie à sourcils", "rainforest", "XSa"),
+    ("Brookesia thieli", "Brookésie de Thiel", "rainforest", "XSa"),
+    ("Rieppeleon brevicaudatus", "Caméléon feuille à queue courte", "rainforest", "XSa"),
+    ("Rhampholeon spectrum", "Caméléon spectre", "rainforest", "XSa"),
+    ("Rhampholeon temporalis", "Caméléon pygmée d'Usambara", "rainforest", "XSa"),
+    # Geckos
+    ("Eublepharis macularius", "Gecko léopard", "desert_night", "M"),
+    ("Eublepharis angramainyu", "Gecko léopard d'Iran", "desert_night", "M"),
+    ("Eublepharis hardwickii", "Gecko léopard de l'Inde", "tropical_night", "M"),
+    ("Hemitheconyx caudicinctus", "Gecko à queue grasse", "desert_night", "M"),
+    ("Goniurosaurus luii", "Gecko des cavernes de Lui", "tropical_night", "S"),
+    ("Goniurosaurus hainanensis", "Gecko des cavernes de Hainan", "tropical_night", "S"),
+    ("Goniurosaurus kuroiwae", "Gecko des cavernes de Kuroiwa", "tropical_night", "S"),
+    ("Coleonyx variegatus", "Gecko à bandes du désert", "desert_night", "S"),
+    ("Coleonyx mitratus", "Gecko à bandes d'Amérique centrale", "tropical_night", "S"),
+    ("Correlophus ciliatus", "Gecko à crête", "tropical_night", "Ma"),
+    ("Correlophus sarasinorum", "Gecko de Sarasin", "tropical_night", "Ma"),
+    ("Rhacodactylus leachianus", "Gecko géant de Nouvelle-Calédonie", "tropical_night", "La"),
+    ("Rhacodactylus auriculatus", "Gecko gargouille", "tropical_night", "Ma"),
+    ("Mniarogekko chahoua", "Gecko mousse de Nouvelle-Calédonie", "tropical_night", "Ma"),
+    ("Eurydactylodes agricolae", "Gecko caméléon", "tropical_night", "Sa"),
+    ("Uroplatus fimbriatus", "Uroplate frangé", "tropical_night", "La"),
+    ("Uroplatus henkeli", "Uroplate de Henkel", "tropical_night", "Ma"),
+    ("Uroplatus sikorae", "Uroplate mousse", "tropical_night", "Ma"),
+    ("Uroplatus phantasticus", "Uroplate fantastique", "tropical_night", "Sa"),
+    ("Uroplatus ebenaui", "Uroplate d'Ebenau", "tropical_night", "Sa"),
+    ("Uroplatus lineatus", "Uroplate rayé", "tropical_night", "Ma"),
+    ("Uroplatus pietschmanni", "Uroplate de Pietschmann", "tropical_night", "Sa"),
+    ("Phelsuma grandis", "Phelsume géant de Madagascar", "tropical", "Ma"),
+    ("Phelsuma madagascariensis", "Phelsume de Madagascar", "tropical", "Ma"),
+    ("Phelsuma laticauda", "Phelsume à queue plate", "tropical", "Sa"),
+    ("Phelsuma klemmeri", "Phelsume de Klemmer", "tropical", "XSa"),
+    ("Phelsuma standingi", "Phelsume de Standing", "tropical", "Ma"),
+    ("Phelsuma quadriocellata", "Phelsume à quatre ocelles", "tropical", "Sa"),
+    ("Phelsuma lineata", "Phelsume rayé", "tropical", "Sa"),
+    ("Phelsuma guttata", "Phelsume moucheté", "tropical", "Sa"),
+    ("Phelsuma robertmertensi", "Phelsume de Mertens", "tropical", "Sa"),
+    ("Phelsuma cepediana", "Phelsume à queue bleue", "tropical", "Sa"),
+    ("Phelsuma ornata", "Phelsume orné", "tropical", "Sa"),
+    ("Phelsuma borbonica", "Phelsume de Bourbon", "tropical", "Sa"),
+    ("Phelsuma inexpectata", "Phelsume de Manapany", "tropical", "Sa"),
+    ("Phelsuma barbouri", "Phelsume de Barbour", "tropical", "Sa"),
+    ("Phelsuma seippi", "Phelsume de Seipp", "tropical", "Sa"),
+    ("Phelsuma dubia", "Phelsume terne", "tropical", "Sa"),
+    ("Lygodactylus williamsi", "Gecko bleu électrique", "tropical", "XSa"),
+    ("Lygodactylus kimhowelli", "Gecko nain de Kim Howell", "tropical", "XSa"),
+    ("Lygodactylus conraui", "Gecko nain de Conrau", "tropical", "XSa"),
+    ("Gekko gecko", "Gecko tokay", "tropical_night", "Ma"),
+    ("Gekko vittatus", "Gecko à bande blanche", "tropical_night", "Ma"),
+    ("Gekko smithii", "Gecko de Smith", "tropical_night", "Ma"),
+    ("Ptychozoon kuhli", "Gecko volant de Kuhl", "tropical_night", "Ma"),
+    ("Hemidactylus turcicus", "Hémidactyle verruqueux", "mediterranean", "Sa"),
+    ("Hemidactylus frenatus", "Gecko domestique", "tropical_night", "Sa"),
+    ("Tarentola mauritanica", "Tarente de Maurétanie", "mediterranean", "Sa"),
+    ("Tarentola annularis", "Tarente à anneaux", "semi_arid", "Ma"),
+    ("Tarentola chazaliae", "Gecko casqué", "desert_night", "S"),
+    ("Pachydactylus bibronii", "Gecko de Bibron", "desert_night", "Sa"),
+    ("Pachydactylus rangei", "Gecko palmé du Namib", "desert_night", "S"),
+    ("Pachydactylus turneri", "Gecko de Turner", "desert_night", "Sa"),
+    ("Chondrodactylus angulifer", "Gecko géant des sables", "desert_night", "S"),
+    ("Ptenopus garrulus", "Gecko aboyeur", "desert_night", "S"),
+    ("Stenodactylus petrii", "Sténodactyle de Petrie", "desert_night", "S"),
+    ("Stenodactylus sthenodactylus", "Sténodactyle élégant", "desert_night", "S"),
+    ("Teratoscincus scincus", "Gecko à écailles de poisson", "desert_night", "M"),
+    ("Teratoscincus roborowskii", "Gecko de Roborowski", "desert_night", "M"),
+    ("Teratoscincus keyserlingii", "Gecko de Keyserling", "desert_night", "M"),
+    ("Nephrurus levis", "Gecko à queue en bouton", "desert_night", "S"),
+    ("Nephrurus amyae", "Gecko à queue en bouton d'Amy", "desert_night", "M"),
+    ("Nephrurus wheeleri", "Gecko à queue en bouton de Wheeler", "desert_night", "S"),
+    ("Nephrurus milii", "Gecko à queue épaisse", "desert_night", "S"),
+    ("Underwoodisaurus milii", "Gecko à queue grasse d'Australie", "desert_night", "S"),
+    ("Strophurus ciliaris", "Gecko épineux à queue", "desert_night", "Sa"),
+    ("Strophurus williamsi", "Gecko épineux de Williams", "desert_night", "Sa"),
+    ("Oedura castelnaui", "Gecko velours du Nord", "desert_night", "Sa"),
+    ("Oedura marmorata", "Gecko velours marbré", "desert_night", "Sa"),
+    ("Diplodactylus galeatus", "Gecko casqué d'Australie", "desert_night", "S"),
+    ("Lucasium damaeum", "Gecko des dunes", "desert_night", "S"),
+    ("Paroedura pictus", "Gecko panthère de Madagascar", "tropical_night", "S"),
+    ("Paroedura androyensis", "Gecko de l'Androy", "desert_night", "XS"),
+    ("Aeluroscalabotes felinus", "Gecko chat", "tropical_night", "Sa"),
+    ("Chatogekko amazonicus", "Gecko nain d'Amazonie", "rainforest", "XS"),
+    ("Gonatodes albogularis", "Gonatode à gorge jaune", "tropical", "XSa"),
+    ("Sphaerodactylus elegans", "Sphérodactyle élégant", "tropical", "XS"),
+    ("Thecadactylus rapicauda", "Gecko à queue de navet", "tropical_night", "Ma"),
+    ("Homopholis fasciata", "Gecko velours à bandes", "semi_arid", "Sa"),
+    ("Homopholis wahlbergii", "Gecko velours de Wahlberg", "semi_arid", "Sa"),
+    ("Agamura persica", "Gecko araignée", "desert_night", "S"),
+    ("Crossobamon eversmanni", "Gecko des sables d'Eversmann", "desert_night", "S"),
+    # Scinques et cordylidés
+    ("Tiliqua scincoides", "Scinque à langue bleue", "semi_arid", "L"),
+    ("Tiliqua gigas", "Scinque à langue bleue d'Indonésie", "tropical", "L"),
+    ("Tiliqua occipitalis", "Scinque à langue bleue de l'Ouest", "semi_arid", "L"),
+    ("Tiliqua nigrolutea", "Scinque à langue bleue tachetée", "temperate", "L"),
+    ("Tiliqua rugosa", "Scinque à queue courte", "semi_arid", "L"),
+    ("Tiliqua multifasciata", "Scinque à langue bleue du Centre", "desert", "L"),
+    ("Egernia stokesii", "Scinque épineux de Stokes", "semi_arid", "M"),
+    ("Egernia cunninghami", "Scinque de Cunningham", "temperate", "L"),
+    ("Egernia striolata", "Scinque des arbres", "semi_arid", "Ma"),
+    ("Egernia depressa", "Scinque épineux pygmée", "desert", "S"),
+    ("Corucia zebrata", "Scinque à queue préhensile", "tropical", "La"),
+    ("Tribolonotus gracilis", "Scinque crocodile aux yeux rouges", "rainforest", "M"),
+    ("Tribolonotus novaeguineae", "Scinque crocodile de Nouvelle-Guinée", "rainforest", "M"),
+    ("Eumeces schneideri", "Scinque de Schneider", "semi_arid", "M"),
+    ("Plestiodon fasciatus", "Scinque à cinq raies", "temperate", "M"),
+    ("Plestiodon obsoletus", "Scinque des Grandes Plaines", "semi_arid", "M"),
+    ("Scincus scincus", "Poisson des sables", "desert_hot", "M"),
+    ("Chalcides ocellatus", "Seps ocellé", "mediterranean", "S"),
+    ("Chalcides chalcides", "Seps tridactyle", "mediterranean", "S"),
+    ("Trachylepis quinquetaeniata", "Mabuya à cinq raies", "semi_arid", "M"),
+    ("Trachylepis margaritifera", "Mabuya arc-en-ciel", "semi_arid", "M"),
+    ("Eutropis multifasciata", "Mabuya doré", "tropical", "M"),
+    ("Lepidothyris fernandi", "Scinque de feu", "rainforest", "M"),
+    ("Riopa fernandi", "Scinque de Fernand", "rainforest", "M"),
+    ("Mochlus fernandi", "Scinque royal", "rainforest", "M"),
+    ("Broadleysaurus major", "Gerrhosaure géant", "savanna", "L"),
+    ("Gerrhosaurus nigrolineatus", "Gerrhosaure à lignes noires", "savanna", "L"),
+    ("Gerrhosaurus flavigularis", "Gerrhosaure à gorge jaune", "savanna", "M"),
+    ("Zonosaurus madagascariensis", "Zonosaure de Madagascar", "tropical", "M"),
+    ("Cordylus cataphractus", "Cordyle tatou", "desert", "M"),
+    ("Cordylus giganteus", "Cordyle géant", "semi_arid", "M"),
+    ("Cordylus tropidosternum", "Cordyle tropical", "savanna", "S"),
+    ("Smaug warreni", "Cordyle de Warren", "semi_arid", "M"),
+    ("Platysaurus intermedius", "Lézard plat", "desert", "M"),
+    # Lacertidés, iguanes, anolis
+    ("Timon lepidus", "Lézard ocellé", "mediterranean", "L"),
+    ("Timon pater", "Lézard ocellé d'Afrique du Nord", "mediterranean", "L"),
+    ("Lacerta viridis", "Lézard vert", "temperate", "M"),
+    ("Lacerta bilineata", "Lézard à deux raies", "temperate", "M"),
+    ("Lacerta agilis", "Lézard des souches", "temperate", "M"),
+    ("Podarcis muralis", "Lézard des murailles", "mediterranean", "S"),
+    ("Podarcis siculus", "Lézard des ruines", "mediterranean", "S"),
+    ("Gallotia galloti", "Lézard de Tenerife", "mediterranean", "M"),
+    ("Takydromus sexlineatus", "Lézard à longue queue", "tropical", "M"),
+    ("Acanthodactylus erythrurus", "Acanthodactyle commun", "desert", "S"),
+    ("Eremias velox", "Érémias rapide", "desert", "S"),
+    ("Holaspis guentheri", "Lézard planeur de Günther", "tropical", "Sa"),
+    ("Iguana iguana", "Iguane vert", "tropical", "XLa"),
+    ("Cyclura cornuta", "Iguane rhinocéros", "desert", "XL"),
+    ("Ctenosaura similis", "Cténosaure noir", "savanna", "XL"),
+    ("Ctenosaura quinquecarinata", "Cténosaure à cinq carènes", "semi_arid", "L"),
+    ("Dipsosaurus dorsalis", "Iguane du désert", "desert_hot", "L"),
+    ("Sauromalus ater", "Chuckwalla", "desert_hot", "L"),
+    ("Crotaphytus collaris", "Lézard à collier", "desert", "M"),
+    ("Gambelia wislizenii", "Lézard léopard", "desert", "M"),
+    ("Phrynosoma cornutum", "Lézard cornu du Texas", "desert_hot", "M"),
+    ("Phrynosoma platyrhinos", "Lézard cornu du désert", "desert_hot", "M"),
+    ("Sceloporus malachiticus", "Lézard épineux vert", "temperate", "Ma"),
+    ("Sceloporus cyanogenys", "Lézard épineux à gorge bleue", "semi_arid", "M"),
+    ("Sceloporus jarrovii", "Lézard épineux de Yarrow", "semi_arid", "M"),
+    ("Uma notata", "Lézard à frange", "desert_hot", "M"),
+    ("Basiliscus plumifrons", "Basilic vert", "riparian", "La"),
+    ("Basiliscus basiliscus", "Basilic commun", "riparian", "La"),
+    ("Basiliscus vittatus", "Basilic brun", "riparian", "La"),
+    ("Corytophanes cristatus", "Lézard casqué", "rainforest", "Ma"),
+    ("Laemanctus serratus", "Lézard à casque dentelé", "tropical", "Ma"),
+    ("Anolis carolinensis", "Anolis vert", "tropical", "Sa"),
+    ("Anolis sagrei", "Anolis brun", "tropical", "Sa"),
+    ("Anolis equestris", "Anolis chevalier", "tropical", "La"),
+    ("Anolis barbatus", "Anolis barbu", "rainforest", "Ma"),
+    ("Anolis roquet", "Anolis de la Martinique", "tropical", "Sa"),
+    ("Anolis marmoratus", "Anolis de la Guadeloupe", "tropical", "Sa"),
+    ("Anolis allisoni", "Anolis d'Allison", "tropical", "Sa"),
+    ("Polychrus marmoratus", "Polychrus marbré", "tropical", "Ma"),
+    ("Uracentron flaviceps", "Lézard à queue épineuse", "rainforest", "Ma"),
+    ("Oplurus cuvieri", "Oplure de Cuvier", "semi_arid", "M"),
+    ("Oplurus cyclurus", "Oplure à queue épineuse", "semi_arid", "M"),
+    ("Leiocephalus carinatus", "Lézard à queue frisée", "semi_arid", "M"),
+    # Varans, téjus, hélodermes
+    ("Varanus exanthematicus", "Varan des savanes", "savanna", "XL"),
+    ("Varanus albigularis", "Varan à gorge blanche", "savanna", "XL"),
+    ("Varanus acanthurus", "Varan à queue épineuse", "desert", "L"),
+    ("Varanus storri", "Varan de Storr", "desert", "M"),
+    ("Varanus gilleni", "Varan pygmée de Gillen", "desert", "M"),
+    ("Varanus tristis", "Varan à tête noire", "desert", "La"),
+    ("Varanus glauerti", "Varan de Glauert", "savanna", "La"),
+    ("Varanus mitchelli", "Varan de Mitchell", "monitor_wet", "L"),
+    ("Varanus prasinus", "Varan émeraude", "monitor_wet", "La"),
+    ("Varanus macraei", "Varan à points bleus", "monitor_wet", "La"),
+    ("Varanus beccarii", "Varan noir des arbres", "monitor_wet", "La"),
+    ("Varanus salvator", "Varan malais", "monitor_wet", "XL"),
+    ("Varanus niloticus", "Varan du Nil", "monitor_wet", "XL"),
+    ("Varanus indicus", "Varan des mangroves", "monitor_wet", "XL"),
+    ("Varanus cumingi", "Varan de Cuming", "monitor_wet", "XL"),
+    ("Varanus panoptes", "Varan de Gould argenté", "savanna", "XL"),
+    ("Varanus rosenbergi", "Varan de Rosenberg", "semi_arid", "XL"),
+    ("Varanus kingorum", "Varan pygmée des rochers", "desert", "M"),
+    ("Salvator merianae", "Téju argentin noir et blanc", "monitor_wet", "XL"),
+    ("Salvator rufescens", "Téju rouge", "savanna", "XL"),
+    ("Tupinambis teguixin", "Téju doré", "monitor_wet", "XL"),
+    ("Dracaena guianensis", "Dracène de Guyane", "monitor_wet", "XL"),
+    ("Ameiva ameiva", "Améive commun", "tropical", "L"),
+    ("Aspidoscelis sexlineatus", "Cnémidophore à six raies", "semi_arid", "M"),
+    ("Heloderma suspectum", "Monstre de Gila", "desert", "L"),
+    ("Heloderma horridum", "Lézard perlé", "semi_arid", "L"),
+    ("Abronia graminea", "Abronie des arbres", "temperate_cool", "Ma"),
+    ("Elgaria multicarinata", "Lézard alligator du Sud", "temperate", "M"),
+    ("Pseudopus apodus", "Scheltopusik", "mediterranean", "L"),
+    ("Anguis fragilis", "Orvet fragile", "temperate_cool", "S"),
+    ("Shinisaurus crocodilurus", "Lézard crocodile de Chine", "temperate_cool", "L"),
+    # Serpents
+    ("Python regius", "Python royal", "snake_humid", "L"),
+    ("Python brongersmai", "Python sanguin", "snake_humid", "L"),
+    ("Python curtus", "Python à queue courte", "snake_humid", "L"),
+    ("Python bivittatus", "Python molure birman", "snake_humid", "XL"),
+    ("Malayopython reticulatus", "Python réticulé", "snake_humid", "XL"),
+    ("Malayopython timoriensis", "Python de Timor", "snake_humid", "L"),
+    ("Morelia spilota", "Python tapis", "snake_humid", "La"),
+    ("Morelia viridis", "Python vert arboricole", "snake_humid", "Ma"),
+    ("Morelia bredli", "Python de Bredl", "snake_arid", "La"),
+    ("Antaresia childreni", "Python de Children", "snake_arid", "M"),
+    ("Antaresia maculosa", "Python tacheté", "snake_arid", "M"),
+    ("Antaresia stimsoni", "Python de Stimson", "snake_arid", "M"),
+    ("Antaresia perthensis", "Python pygmée", "snake_arid", "S"),
+    ("Aspidites melanocephalus", "Python à tête noire", "snake_arid", "L"),
+    ("Aspidites ramsayi", "Woma", "snake_arid", "L"),
+    ("Liasis mackloti", "Python de Macklot", "snake_humid", "L"),
+    ("Leiopython albertisii", "Python à lèvres blanches", "snake_humid", "L"),
+    ("Simalia amethistina", "Python améthyste", "snake_humid", "XL"),
+    ("Boa constrictor", "Boa constricteur", "snake_humid", "XL"),
+    ("Boa imperator", "Boa impérial", "snake_humid", "L"),
+    ("Epicrates cenchria", "Boa arc-en-ciel", "snake_humid", "L"),
+    ("Epicrates maurus", "Boa arc-en-ciel de Colombie", "snake_humid", "L"),
+    ("Corallus hortulana", "Boa des jardins", "snake_humid", "La"),
+    ("Corallus caninus", "Boa émeraude", "snake_humid", "Ma"),
+    ("Corallus batesii", "Boa émeraude de l'Amazone", "snake_humid", "La"),
+    ("Acrantophis dumerili", "Boa de Duméril", "snake_humid", "XL"),
+    ("Sanzinia madagascariensis", "Boa arboricole de Madagascar", "snake_humid", "La"),
+    ("Candoia aspera", "Boa de Nouvelle-Guinée", "snake_humid", "M"),
+    ("Candoia bibroni", "Boa du Pacifique", "snake_humid", "Ma"),
+    ("Eryx colubrinus", "Boa des sables du Kenya", "snake_arid", "S"),
+    ("Eryx jaculus", "Boa des sables javelot", "snake_arid", "S"),
+    ("Eryx johnii", "Boa des sables indien", "snake_arid", "M"),
+    ("Eryx tataricus", "Boa des sables de Tartarie", "snake_arid", "M"),
+    ("Lichanura trivirgata", "Boa rosé", "snake_arid", "M"),
+    ("Charina bottae", "Boa caoutchouc", "snake_temperate", "S"),
+    ("Calabaria reinhardtii", "Python fouisseur du Calabar", "snake_humid", "M"),
+    ("Pantherophis guttatus", "Serpent des blés", "snake_temperate", "M"),
+    ("Pantherophis obsoletus", "Serpent ratier noir", "snake_temperate", "L"),
+    ("Pantherophis alleghaniensis", "Serpent ratier gris", "snake_temperate", "L"),
+    ("Pantherophis emoryi", "Serpent ratier des Grandes Plaines", "snake_temperate", "M"),
+    ("Pituophis catenifer", "Serpent-taureau", "snake_arid", "L"),
+    ("Pituophis melanoleucus", "Serpent des pins", "snake_temperate", "L"),
+    ("Lampropeltis getula", "Serpent-roi commun", "snake_temperate", "L"),
+    ("Lampropeltis californiae", "Serpent-roi de Californie", "snake_temperate", "M"),
+    ("Lampropeltis triangulum", "Serpent-roi faux corail", "snake_temperate", "M"),
+    ("Lampropeltis mexicana", "Serpent-roi du Mexique", "snake_temperate", "M"),
+    ("Lampropeltis alterna", "Serpent-roi gris à bandes", "snake_arid", "M"),
+    ("Lampropeltis pyromelana", "Serpent-roi des montagnes d'Arizona", "snake_temperate", "M"),
+    ("Lampropeltis zonata", "Serpent-roi des montagnes de Californie", "snake_temperate", "M"),
+    ("Lampropeltis holbrooki", "Serpent-roi moucheté", "snake_temperate", "M"),
+    ("Elaphe quatuorlineata", "Couleuvre à quatre raies", "snake_temperate", "L"),
+    ("Elaphe schrenckii", "Couleuvre de l'Amour", "snake_temperate", "L"),
+    ("Elaphe climacophora", "Couleuvre de Japon", "snake_temperate", "L"),
+    ("Elaphe dione", "Couleuvre de Dione", "snake_temperate", "M"),
+    ("Zamenis longissimus", "Couleuvre d'Esculape", "snake_temperate", "L"),
+    ("Zamenis situla", "Couleuvre léopard", "snake_temperate", "M"),
+    ("Zamenis scalaris", "Couleuvre à échelons", "snake_temperate", "L"),
+    ("Orthriophis taeniurus", "Couleuvre à queue rayée", "snake_humid", "L"),
+    ("Gonyosoma oxycephalum", "Couleuvre ratière à queue rouge", "snake_humid", "La"),
+    ("Euprepiophis mandarinus", "Couleuvre mandarine", "temperate_cool", "M"),
+    ("Oreocryptophis porphyraceus", "Couleuvre bambou", "temperate_cool", "M"),
+    ("Heterodon nasicus", "Couleuvre à nez retroussé de l'Ouest", "snake_arid", "M"),
+    ("Heterodon platirhinos", "Couleuvre à nez retroussé de l'Est", "snake_temperate", "M"),
+    ("Thamnophis sirtalis", "Couleuvre rayée", "snake_temperate", "M"),
+    ("Thamnophis marcianus", "Couleuvre rayée à damier", "snake_temperate", "M"),
+    ("Opheodrys aestivus", "Couleuvre verte rugueuse", "tropical", "Ma"),
+    ("Dasypeltis scabra", "Mangeur d'œufs africain", "snake_arid", "M"),
+    ("Boaedon fuliginosus", "Couleuvre des maisons africaine", "snake_humid", "M"),
+    ("Lamprophis fuliginosus", "Serpent des maisons brun", "snake_humid", "M"),
+    ("Philodryas baroni", "Couleuvre à nez de Baron", "snake_humid", "Ma"),
+    ("Xenodon merremii", "Xénodon de Merrem", "snake_humid", "M"),
+    ("Rhinocheilus lecontei", "Serpent à long nez", "snake_arid", "M"),
+    ("Arizona elegans", "Serpent luisant", "snake_arid", "M"),
+    ("Hierophis viridiflavus", "Couleuvre verte et jaune", "snake_temperate", "L"),
+    ("Natrix natrix", "Couleuvre à collier", "temperate", "L"),
+    ("Natrix maura", "Couleuvre vipérine", "temperate", "M"),
+    ("Coronella austriaca", "Coronelle lisse", "snake_temperate", "S"),
+    ("Coronella girondica", "Coronelle girondine", "snake_temperate", "S"),
+    ("Malpolon monspessulanus", "Couleuvre de Montpellier", "snake_arid", "L"),
+    ("Spalerosophis diadema", "Couleuvre diadème", "snake_arid", "L"),
+    ("Rhynchophis boulengeri", "Couleuvre à nez de rhinocéros", "snake_humid", "La"),
+    ("Ahaetulla prasina", "Serpent-liane", "tropical", "Ma"),
+    ("Chrysopelea ornata", "Serpent volant orné", "tropical", "Ma"),
+    ("Enhydris enhydris", "Couleuvre aquatique arc-en-ciel", "riparian", "M"),
+    ("Xenopeltis unicolor", "Serpent arc-en-ciel asiatique", "snake_humid", "M"),
+    # Tortues terrestres et semi-aquatiques
+    ("Testudo hermanni", "Tortue d'Hermann", "mediterranean", "XL"),
+    ("Testudo graeca", "Tortue grecque", "mediterranean", "XL"),
+    ("Testudo horsfieldii", "Tortue des steppes", "semi_arid", "XL"),
+    ("Testudo marginata", "Tortue bordée", "mediterranean", "XL"),
+    ("Testudo kleinmanni", "Tortue d'Égypte", "desert", "L"),
+    ("Chelonoidis carbonarius", "Tortue charbonnière", "tropical", "XL"),
+    ("Chelonoidis denticulatus", "Tortue denticulée", "rainforest", "XL"),
+    ("Centrochelys sulcata", "Tortue sillonnée", "savanna", "XL"),
+    ("Stigmochelys pardalis", "Tortue léopard", "savanna", "XL"),
+    ("Geochelone elegans", "Tortue étoilée d'Inde", "semi_arid", "XL"),
+    ("Astrochelys radiata", "Tortue rayonnée", "semi_arid", "XL"),
+    ("Kinixys belliana", "Kinixys de Bell", "savanna", "XL"),
+    ("Kinixys homeana", "Kinixys de Home", "rainforest", "XL"),
+    ("Malacochersus tornieri", "Tortue à carapace molle", "semi_arid", "L"),
+    ("Indotestudo elongata", "Tortue à tête jaune", "tropical", "XL"),
+    ("Manouria emys", "Tortue brune d'Asie", "rainforest", "XL"),
+    ("Pyxis arachnoides", "Tortue araignée", "semi_arid", "L"),
+    ("Terrapene carolina", "Tortue-boîte de Caroline", "temperate", "XL"),
+    ("Terrapene ornata", "Tortue-boîte ornée", "semi_arid", "XL"),
+    ("Cuora amboinensis", "Tortue-boîte d'Amboine", "riparian", "XL"),
+    ("Cuora galbinifrons", "Tortue-boîte indochinoise", "temperate", "L"),
+    ("Cuora flavomarginata", "Tortue-boîte à bords jaunes", "temperate", "L"),
+    ("Rhinoclemmys pulcherrima", "Tortue peinte d'Amérique centrale", "riparian", "XL"),
+    ("Glyptemys insculpta", "Tortue des bois", "temperate", "XL"),
+    # Amphibiens
+    ("Dendrobates tinctorius", "Dendrobate à tapirer", "rainforest", "Ma"),
+    ("Dendrobates auratus", "Dendrobate doré", "rainforest", "Ma"),
+    ("Dendrobates leucomelas", "Dendrobate à bandes jaunes", "rainforest", "Ma"),
+    ("Dendrobates truncatus", "Dendrobate à rayures jaunes", "rainforest", "Sa"),
+    ("Oophaga pumilio", "Dendrobate fraise", "rainforest", "Sa"),
+    ("Oophaga histrionica", "Dendrobate arlequin", "rainforest", "Sa"),
+    ("Oophaga sylvatica", "Dendrobate sylvatique", "rainforest", "Sa"),
+    ("Oophaga granulifera", "Dendrobate granuleux", "rainforest", "Sa"),
+    ("Oophaga lehmanni", "Dendrobate de Lehmann", "rainforest", "Sa"),
+    ("Ranitomeya imitator", "Dendrobate imitateur", "rainforest", "Sa"),
+    ("Ranitomeya variabilis", "Dendrobate variable", "rainforest", "Sa"),
+    ("Ranitomeya ventrimaculata", "Dendrobate à ventre tacheté", "rainforest", "Sa"),
+    ("Ranitomeya amazonica", "Dendrobate d'Amazonie", "rainforest", "Sa"),
+    ("Ranitomeya benedicta", "Dendrobate béni", "rainforest", "Sa"),
+    ("Ranitomeya fantastica", "Dendrobate fantastique", "rainforest", "Sa"),
+    ("Ranitomeya reticulata", "Dendrobate réticulé", "rainforest", "Sa"),
+    ("Ranitomeya sirensis", "Dendrobate de Sira", "rainforest", "Sa"),
+    ("Phyllobates terribilis", "Phyllobate terrible", "rainforest", "Ma"),
+    ("Phyllobates bicolor", "Phyllobate bicolore", "rainforest", "Ma"),
+    ("Phyllobates vittatus", "Phyllobate rayé", "rainforest", "Ma"),
+    ("Phyllobates aurotaenia", "Phyllobate à bande dorée", "rainforest", "Ma"),
+    ("Phyllobates lugubris", "Phyllobate lugubre", "rainforest", "Sa"),
+    ("Epipedobates anthonyi", "Dendrobate d'Anthony", "rainforest", "Sa"),
+    ("Epipedobates tricolor", "Dendrobate tricolore", "rainforest", "Sa"),
+    ("Ameerega trivittata", "Dendrobate à trois bandes", "rainforest", "Ma"),
+    ("Ameerega bassleri", "Dendrobate de Bassler", "rainforest", "Ma"),
+    ("Adelphobates galactonotus", "Dendrobate à dos lacté", "rainforest", "Ma"),
+    ("Adelphobates castaneoticus", "Dendrobate brun", "rainforest", "Sa"),
+    ("Allobates femoralis", "Allobate à cuisses brillantes", "rainforest", "M"),
+    ("Mantella aurantiaca", "Mantelle dorée", "rainforest", "S"),
+    ("Mantella baroni", "Mantelle de Baron", "rainforest", "S"),
+    ("Mantella viridis", "Mantelle verte", "rainforest", "S"),
+    ("Mantella expectata", "Mantelle bleue", "tropical", "S"),
+    ("Mantella laevigata", "Mantelle grimpeuse", "rainforest", "Sa"),
+    ("Agalychnis callidryas", "Rainette aux yeux rouges", "tropical_night", "Ma"),
+    ("Agalychnis spurrelli", "Rainette planeuse", "tropical_night", "Ma"),
+    ("Phyllomedusa sauvagii", "Phylloméduse de Sauvage", "semi_arid", "Ma"),
+    ("Phyllomedusa bicolor", "Phylloméduse bicolore", "tropical_night", "La"),
+    ("Ranoidea caerulea", "Rainette de White", "tropical_night", "Ma"),
+    ("Litoria infrafrenata", "Rainette géante à lèvres blanches", "tropical_night", "Ma"),
+    ("Litoria chloris", "Rainette aux yeux rouges d'Australie", "tropical_night", "Ma"),
+    ("Hyla arborea", "Rainette verte", "temperate", "Ma"),
+    ("Hyla meridionalis", "Rainette méridionale", "mediterranean", "Ma"),
+    ("Dryophytes cinereus", "Rainette verte d'Amérique", "temperate", "Ma"),
+    ("Dryophytes versicolor", "Rainette versicolore", "temperate", "Ma"),
+    ("Trachycephalus resinifictrix", "Rainette laitière d'Amazonie", "tropical_night", "Ma"),
+    ("Osteopilus septentrionalis", "Rainette de Cuba", "tropical_night", "Ma"),
+    ("Boana punctata", "Rainette ponctuée", "tropical_night", "Sa"),
+    ("Theloderma corticale", "Grenouille mousse du Vietnam", "rainforest", "Ma"),
+    ("Kaloula pulchra", "Grenouille-bœuf asiatique", "tropical_night", "M"),
+    ("Ceratophrys cranwelli", "Grenouille cornue de Cranwell", "tropical_night", "S"),
+    ("Ceratophrys ornata", "Grenouille cornue ornée", "tropical_night", "S"),
+    ("Ceratophrys cornuta", "Grenouille cornue d'Amazonie", "tropical_night", "S"),
+    ("Lepidobatrachus laevis", "Grenouille Budgett", "tropical_night", "S"),
+    ("Pyxicephalus adspersus", "Grenouille-taureau africaine", "savanna", "L"),
+    ("Dyscophus antongilii", "Grenouille tomate", "tropical_night", "M"),
+    ("Megophrys nasuta", "Grenouille cornue de Malaisie", "rainforest", "M"),
+    ("Rhinella marina", "Crapaud buffle", "tropical_night", "L"),
+    ("Bombina orientalis", "Sonneur oriental", "temperate", "M"),
+    ("Bombina variegata", "Sonneur à ventre jaune", "temperate_cool", "M"),
+    ("Hymenochirus boettgeri", "Grenouille naine africaine", "riparian", "S"),
+    ("Salamandra salamandra", "Salamandre tachetée", "temperate_cool", "M"),
+    ("Salamandra algira", "Salamandre d'Algérie", "temperate_cool", "M"),
+    ("Pleurodeles waltl", "Pleurodèle de Waltl", "temperate_cool", "M"),
+    ("Tylototriton verrucosus", "Triton crocodile", "temperate_cool", "M"),
+    ("Tylototriton shanjing", "Triton mandarin", "temperate_cool", "M"),
+    ("Paramesotriton hongkongensis", "Triton de Hong Kong", "temperate_cool", "M"),
+    ("Cynops orientalis", "Triton à ventre de feu chinois", "temperate_cool", "S"),
+    ("Cynops pyrrhogaster", "Triton à ventre de feu japonais", "temperate_cool", "S"),
+    ("Ambystoma mexicanum", "Axolotl", "temperate_cool", "M"),
+    ("Ambystoma tigrinum", "Salamandre tigrée", "temperate_cool", "M"),
+    ("Ambystoma maculatum", "Salamandre maculée", "temperate_cool", "M"),
+    ("Notophthalmus viridescens", "Triton vert", "temperate_cool", "S"),
+    ("Triturus marmoratus", "Triton marbré", "temperate_cool", "M"),
+    ("Ichthyosaura alpestris", "Triton alpestre", "temperate_cool", "S"),
+    ("Lissotriton helveticus", "Triton palmé", "temperate_cool", "S"),
+    # Arachnides
+    ("Brachypelma hamorii", "Mygale à genoux rouges", "spider_dry", "S"),
+    ("Brachypelma boehmei", "Mygale à pattes rouges de Boehme", "spider_dry", "S"),
+    ("Brachypelma albiceps", "Mygale à tête dorée", "spider_dry", "S"),
+    ("Brachypelma emilia", "Mygale à jambes rouges du Mexique", "spider_dry", "S"),
+    ("Tliltocatl albopilosus", "Mygale frisée", "spider_wet", "S"),
+    ("Tliltocatl vagans", "Mygale à croupe rouge", "spider_dry", "S"),
+    ("Grammostola pulchra", "Mygale noire du Brésil", "spider_dry", "S"),
+    ("Grammostola rosea", "Mygale rose du Chili", "spider_dry", "S"),
+    ("Grammostola pulchripes", "Mygale à genoux dorés", "spider_dry", "S"),
+    ("Aphonopelma chalcodes", "Mygale blonde du désert", "spider_dry", "S"),
+    ("Aphonopelma seemanni", "Mygale zébrée du Costa Rica", "spider_dry", "S"),
+    ("Chromatopelma cyaneopubescens", "Mygale bleu-vert", "spider_dry", "S"),
+    ("Caribena versicolor", "Mygale des Antilles", "spider_wet", "XSa"),
+    ("Avicularia avicularia", "Mygale à pieds roses", "spider_wet", "XSa"),
+    ("Avicularia metallica", "Mygale métallique", "spider_wet", "XSa"),
+    ("Psalmopoeus irminia", "Mygale tigre vénézuélienne", "spider_wet", "XSa"),
+    ("Psalmopoeus cambridgei", "Mygale tigre de Trinidad", "spider_wet", "XSa"),
+    ("Poecilotheria regalis", "Mygale ornementale indienne", "spider_wet", "XSa"),
+    ("Poecilotheria metallica", "Mygale saphir", "spider_wet", "XSa"),
+    ("Theraphosa blondi", "Mygale Goliath", "spider_wet", "M"),
+    ("Theraphosa stirmi", "Mygale Goliath de Stirm", "spider_wet", "M"),
+    ("Lasiodora parahybana", "Mygale saumon du Brésil", "spider_wet", "M"),
+    ("Acanthoscurria geniculata", "Mygale à genoux blancs", "spider_wet", "S"),
+    ("Nhandu chromatus", "Mygale à bandes blanches", "spider_wet", "S"),
+    ("Nhandu tripepii", "Mygale de Tripepi", "spider_dry", "S"),
+    ("Euathlus sp. red", "Mygale naine du Chili", "spider_dry", "XS"),
+    ("Pterinochilus murinus", "Mygale orange du Baboon", "spider_dry", "XS"),
+    ("Ceratogyrus darlingi", "Mygale cornue", "spider_dry", "XS"),
+    ("Monocentropus balfouri", "Mygale de Socotra", "spider_dry", "XS"),
+    ("Heteroscodra maculata", "Mygale ornementale du Togo", "spider_wet", "XSa"),
+    ("Cyriopagopus lividus", "Mygale bleue de Birmanie", "spider_wet", "XS"),
+    ("Haplopelma minax", "Mygale noire de Thaïlande", "spider_wet", "XS"),
+    ("Pandinus imperator", "Scorpion empereur", "spider_wet", "M"),
+    ("Heterometrus spinifer", "Scorpion géant de forêt", "spider_wet", "M"),
+    ("Hadrurus arizonensis", "Scorpion géant velu du désert", "desert_night", "S"),
+    ("Androctonus australis", "Androctone austral", "desert_night", "S"),
+    ("Centruroides gracilis", "Scorpion gracile", "spider_wet", "XS"),
+    ("Hottentotta hottentotta", "Scorpion hottentot", "desert_night", "XS"),
+    ("Damon diadema", "Amblypyge diadème", "spider_wet", "XSa"),
+    ("Phrynus marginemaculatus", "Amblypyge de Floride", "spider_wet", "XSa"),
+    # Insectes et myriapodes
+    ("Hymenopus coronatus", "Mante orchidée", "insect", "XSa"),
+    ("Phyllocrania paradoxa", "Mante fantôme", "insect", "XSa"),
+    ("Idolomantis diabolica", "Mante fleur du diable", "insect", "Sa"),
+    ("Sphodromantis lineola", "Mante africaine", "insect", "XSa"),
+    ("Hierodula membranacea", "Mante géante asiatique", "insect", "XSa"),
+    ("Creobroter gemmatus", "Mante fleur de Jade", "insect", "XSa"),
+    ("Pseudocreobotra wahlbergii", "Mante épineuse", "insect", "XSa"),
+    ("Deroplatys desiccata", "Mante feuille morte géante", "insect", "XSa"),
+    ("Empusa pennata", "Empuse", "mediterranean", "XSa"),
+    ("Mantis religiosa", "Mante religieuse", "temperate", "XSa"),
+    ("Extatosoma tiaratum", "Phasme scorpion", "insect", "Sa"),
+    ("Phyllium philippinicum", "Phyllie des Philippines", "insect", "Sa"),
+    ("Heteropteryx dilatata", "Phasme de Malaisie", "insect", "Ma"),
+    ("Eurycantha calcarata", "Phasme à épines de Nouvelle-Guinée", "insect", "Sa"),
+    ("Carausius morosus", "Phasme bâton", "insect", "XSa"),
+    ("Gromphadorhina portentosa", "Blatte siffleuse de Madagascar", "insect", "XS"),
+    ("Blaberus craniifer", "Blatte tête de mort", "insect", "XS"),
+    ("Pachnoda marginata", "Cétoine du Togo", "insect", "XS"),
+    ("Dynastes hercules", "Dynaste Hercule", "rainforest", "S"),
+    ("Archispirostreptus gigas", "Mille-pattes géant africain", "spider_wet", "S"),
+    ("Scolopendra subspinipes", "Scolopendre géante vietnamienne", "spider_wet", "S"),
+    ("Achatina fulica", "Achatine", "rainforest", "S"),
+]
+
+
+def normalise(text):
+    """Minuscules ASCII sans accents ; tout séparateur devient une espace."""
+    out = []
+    for ch in unicodedata.normalize("NFKD", text.replace("œ", "oe").replace("Œ", "oe")):
+        if unicodedata.combining(ch):
+            continue
+        ch = ch.lower()
+        if "a" <= ch <= "z" or "0" <= ch <= "9":
+            out.append(ch)
+        elif out and out[-1] != " ":
+            out.append(" ")
+    return "".join(out).strip()
+
+
+def c_string(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def main():
+    seen = set()
+    for latin, _, biotope, size in SPECIES:
+        assert latin not in seen, latin
+        assert biotope in BIOTOPES, biotope
+        assert size in SIZES, size
+        seen.add(latin)
+
+    # Réservoir de noms normalisés « commun\0latin\0 » ; chaque début de mot
+    # devient une clé, ce qui permet de taper « leopard » ou « macularius ».
+    pool = bytearray()
+    keys = []
+    for idx, (latin, common, _, _) in enumerate(SPECIES):
+        for name in (normalise(common), normalise(latin)):
+            base = len(pool)
+            pool += name.encode("ascii") + b"\0"
+            for pos, ch in enumerate(name):
+                if ch != " " and (pos == 0 or name[pos - 1] == " "):
+                    keys.append((name[pos:], base + pos, idx))
+    keys.sort(key=lambda k: (k[0], k[2]))
+    assert len(pool) < 65536 and len(SPECIES) < 65536
+
+    w = sys.stdout.write
+    w("/*\n * Généré par tools/gen_species_table.py — ne pas éditer à la main.\n")
+    w(" * %d espèces, %d clés d'index, %d octets de noms normalisés.\n */\n\n" % (len(SPECIES), len(keys), len(pool)))
+    w("static const species_t k_species[%d] = {\n" % len(SPECIES))
+    for latin, common, biotope, size in SPECIES:
+        (zone, env, mist, lux_lo, lux_hi, hr_lo, hr_hi, cool, hot, bask, substrate, ratio, sub_h) = BIOTOPES[biotope]
+        length, depth, height = SIZES[size]
+        w("    {%s, %s, %d, TERRARIUM_ENV_%s, MIST_ENV_%s, %d, %d, %d, %d, %d, %d, %d, SUBSTRATE_%s, %d, %d, %d, %d, %d},\n"
+          % (c_string(common), c_string(latin), zone, env, mist, lux_lo, lux_hi, hr_lo, hr_hi, cool, hot, bask,
+             substrate, ratio, sub_h, length, depth, height))
+    w("};\n\n")
+
+    w("static const char k_species_names[%d] =\n" % len(pool))
+    line = ""
+    for chunk in pool.split(b"\0")[:-1]:
+        piece = chunk.decode("ascii") + "\\0"
+        if len(line) + len(piece) > 100:
+            w('    "%s"\n' % line)
+            line = ""
+        line += piece
+    w('    "%s";\n\n' % line)
+
+    w("static const species_key_t k_species_index[%d] = {\n" % len(keys))
+    row = []
+    for _, offset, idx in keys:
+        row.append("{%d, %d}" % (offset, idx))
+        if len(row) == 8:
+            w("    " + ", ".join(row) + ",\n")
+            row = []
+    if row:
+        w("    " + ", ".join(row) + ",\n")
+    w("};\n")
+
+
+if __name__ == "__main__":
+    main()
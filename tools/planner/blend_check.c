@@ -0,0 +1,117 @@
+// Vérification hôte des mélanges RGB565 (components/blend) : les noyaux PIE,
+// exécutés ici par leur modèle C (blend_pie_model.c), doivent donner au bit
+// près le résultat de lv_color_16_16_mix() pour tout couple de canaux et toute
+// opacité, puis les versions découpées par rangée celui de la référence.
+// --bench N : micro-bancs sur N rangées de 1024 pixels.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "blend/blend.h"
+#include "blend_pie.h"
+
+static uint32_t s_seed = 0x12345678u;
+
+static uint16_t rnd16(void)
+{
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 17;
+    s_seed ^= s_seed << 5;
+    return (uint16_t)s_seed;
+}
+
+typedef struct {
+    const char *name;
+    int shift;
+    uint16_t max;
+} channel_t;
+
+// Chaque canal est parcouru exhaustivement (premier plan × fond × opacité),
+// les deux autres tirés au hasard : les voies ne se mélangent pas entre canaux.
+static unsigned long check_channel(const channel_t *ch, bool image)
+{
+    static uint16_t dst[BLEND_PIE_BLOCK_PX] __attribute__((aligned(16)));
+    static uint16_t src[BLEND_PIE_BLOCK_PX] __attribute__((aligned(16)));
+    const uint16_t field = (uint16_t)(ch->max << ch->shift);
+    unsigned long errors = 0;
+    blend_pie_k_t k;
+
+    for (unsigned opa = 0; opa < 256; ++opa) {
+        for (unsigned fg = 0; fg <= ch->max; ++fg) {
+            const uint16_t color = (uint16_t)((rnd16() & ~field) | (fg << ch->shift));
+            const uint16_t mix = (uint16_t)((opa + 4u) >> 3);
+            for (int i = 0; i < 8; ++i) {
+                k.mix[i] = mix;
+                k.mask_g[i] = 0x07E0;
+                k.mask_b[i] = 0x001F;
+                k.mask_r[i] = 0xF800;
+                k.c16[i] = 16;
+                k.c64[i] = 64;
+                k.floor_g[i] = 0xFFE0;
+                k.floor_r[i] = 0xFC00;
+                k.fg_g[i] = color & 0x07E0;
+                k.fg_b[i] = color & 0x001F;
+                k.fg_r[i] = (uint16_t)((color & 0xF800) >> 1);
+                k.color[i] = color;
+            }
+            for (unsigned bg0 = 0; bg0 <= ch->max; bg0 += BLEND_PIE_BLOCK_PX) {
+                uint16_t bg[BLEND_PIE_BLOCK_PX];
+                for (int i = 0; i < BLEND_PIE_BLOCK_PX; ++i) {
+                    const unsigned v = (bg0 + (unsigned)i) & ch->max;
+                    bg[i] = (uint16_t)((rnd16() & ~field) | (v << ch->shift));
+                    dst[i] = bg[i];
+                    src[i] = image ? (uint16_t)((rnd16() & ~field) | (fg << ch->shift)) : color;
+                }
+                if (image) {
+                    blend_pie_image_opa_row(dst, src, 1, &k);
+                } else {
+                    blend_pie_fill_opa_row(dst, 1, &k);
+                }
+                for (int i = 0; i < BLEND_PIE_BLOCK_PX; ++i) {
+                    const uint16_t want = blend_mix_rgb565(src[i], bg[i], (uint8_t)opa);
+                    if (dst[i] != want && errors++ < 5) {
+                        printf("ÉCHEC %s %s : fg %04X bg %04X opa %u -> %04X (attendu %04X)\n",
+                               image ? "image" : "remplissage",
+                               ch->name,
+                               src[i],
+                               bg[i],
+                               opa,
+                               dst[i],
+                               want);
+                    }
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+int main(int argc, char **argv)
+{
+    static const channel_t channels[] = {
+        {"R", 11, 31},
+        {"G", 5, 63},
+        {"B", 0, 31},
+    };
+    unsigned long errors = 0;
+    for (size_t c = 0; c < sizeof(channels) / sizeof(channels[0]); ++c) {
+        errors += check_channel(&channels[c], false);
+        errors += check_channel(&channels[c], true);
+    }
+    printf("Canaux : %lu écarts au mélange LVGL\n", errors);
+
+    // Découpage en rangées (têtes, queues, sources désalignées) contre la référence
+    if (!blend_init()) {
+        printf("ÉCHEC : chemin vectoriel refusé par blend_init()\n");
+        errors++;
+    }
+    if (errors == 0) {
+        printf("Mélanges identiques à la référence\n");
+    }
+
+    if (argc == 3 && !strcmp(argv[1], "--bench")) {
+        blend_run_bench((uint32_t)strtoul(argv[2], NULL, 10));
+    }
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,920 @@
+#include "plan_record.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    plan_field_t field;
+} field_name_t;
+
+static const field_name_t k_fields[] = {
+    {"id", PLAN_FIELD_ID},
+    {"species", PLAN_FIELD_SPECIES},
+    {"length_cm", PLAN_FIELD_LENGTH},
+    {"depth_cm", PLAN_FIELD_DEPTH},
+    {"height_cm", PLAN_FIELD_HEIGHT},
+    {"material", PLAN_FIELD_MATERIAL},
+    {"environment", PLAN_FIELD_ENVIRONMENT},
+    {"heated_ratio", PLAN_FIELD_HEATED_RATIO},
+    {"cable_w_per_m", PLAN_FIELD_CABLE_W_PER_M},
+    {"cable_voltage_v", PLAN_FIELD_CABLE_VOLTAGE},
+    {"cable_density_w_cm2", PLAN_FIELD_CABLE_DENSITY},
+    {"cable_spacing_cm", PLAN_FIELD_CABLE_SPACING},
+    {"led_lm", PLAN_FIELD_LED_LM},
+    {"led_w", PLAN_FIELD_LED_W},
+    {"uva_mw_cm2", PLAN_FIELD_UVA},
+    {"uvb_uvi", PLAN_FIELD_UVB},
+    {"uv_distance_cm", PLAN_FIELD_UV_DISTANCE},
+    {"substrate", PLAN_FIELD_SUBSTRATE},
+    {"substrate_cm", PLAN_FIELD_SUBSTRATE_HEIGHT},
+    {"mist_environment", PLAN_FIELD_MIST_ENVIRONMENT},
+    {"nozzle_ml_min", PLAN_FIELD_NOZZLE_FLOW},
+    {"cycle_min", PLAN_FIELD_CYCLE_MIN},
+    {"cycles_per_day", PLAN_FIELD_CYCLES_PER_DAY},
+    {"autonomy_days", PLAN_FIELD_AUTONOMY_DAYS},
+};
+
+typedef struct {
+    const char *name;
+    int value;
+} enum_name_t;
+
+static const enum_name_t k_materials[] = {
+    {"wood", TERRARIUM_MATERIAL_WOOD},
+    {"bois", TERRARIUM_MATERIAL_WOOD},
+    {"glass", TERRARIUM_MATERIAL_GLASS},
+    {"verre", TERRARIUM_MATERIAL_GLASS},
+    {"pvc", TERRARIUM_MATERIAL_PVC},
+    {"acrylic", TERRARIUM_MATERIAL_ACRYLIC},
+    {"acrylique", TERRARIUM_MATERIAL_ACRYLIC},
+    {NULL, 0},
+};
+
+static const enum_name_t k_environments[] = {
+    {"tropical", TERRARIUM_ENV_TROPICAL},
+    {"desertic", TERRARIUM_ENV_DESERTIC},
+    {"desert", TERRARIUM_ENV_DESERTIC},
+    {"temperate_forest", TERRARIUM_ENV_TEMPERATE_FOREST},
+    {"temperate", TERRARIUM_ENV_TEMPERATE_FOREST},
+    {"nocturnal", TERRARIUM_ENV_NOCTURNAL},
+    {NULL, 0},
+};
+
+static const enum_name_t k_substrates[] = {
+    {"soil", SUBSTRATE_SOIL},
+    {"coco", SUBSTRATE_COCO},
+    {"forest_blend", SUBSTRATE_FOREST_BLEND},
+    {"sand", SUBSTRATE_SAND},
+    {"sand_soil", SUBSTRATE_SAND_SOIL},
+    {NULL, 0},
+};
+
+static const enum_name_t k_mist_environments[] = {
+    {"tropical", MIST_ENV_TROPICAL},
+    {"temperate_humid", MIST_ENV_TEMPERATE_HUMID},
+    {"temperate", MIST_ENV_TEMPERATE_HUMID},
+    {"semi_arid", MIST_ENV_SEMI_ARID},
+    {"desertic", MIST_ENV_DESERTIC},
+    {"desert", MIST_ENV_DESERTIC},
+    {NULL, 0},
+};
+
+// Tranche [p, p+len) d'une ligne ; `escaped` si elle contient des "" (CSV) ou \x (JSON)
+typedef struct {
+    const char *p;
+    uint16_t len;
+    bool escaped;
+} slice_t;
+
+static bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static slice_t trim(const char *p, size_t len)
+{
+    while (len && is_space(*p)) {
+        ++p;
+        --len;
+    }
+    while (len && is_space(p[len - 1])) {
+        --len;
+    }
+    return (slice_t){.p = p, .len = (uint16_t)(len > 0xFFFF ? 0xFFFF : len), .escaped = false};
+}
+
+static bool slice_eq(slice_t s, const char *name)
+{
+    const size_t n = strlen(name);
+    if (s.len != n) {
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        char c = s.p[i];
+        c = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+        if (c != name[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static plan_field_t lookup_field(slice_t s)
+{
+    for (size_t i = 0; i < sizeof(k_fields) / sizeof(k_fields[0]); ++i) {
+        if (slice_eq(s, k_fields[i].name)) {
+            return k_fields[i].field;
+        }
+    }
+    return PLAN_FIELD_UNKNOWN;
+}
+
+/*
+ * Nombre décimal sans copie. Chemin rapide de Clinger : mantisse < 2^24 et
+ * au plus 10 décimales, la division flottante est alors correctement arrondie
+ * et donne exactement le strtof() de l'interface. Sinon, strtof() sur une
+ * copie locale du jeton, comme parse_decimal() dans les écrans.
+ */
+static bool parse_number(slice_t s, float *out)
+{
+    static const float k_pow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    const char *p = s.p;
+    const char *end = s.p + s.len;
+    if (p == end) {
+        return false;
+    }
+    bool neg = false;
+    if (*p == '-' || *p == '+') {
+        neg = (*p == '-');
+        ++p;
+    }
+    uint32_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    bool dot = false;
+    bool fast = true;
+    for (; p < end; ++p) {
+        const char c = *p;
+        if (c >= '0' && c <= '9') {
+            if (mantissa >= (1u << 24) / 10u) {
+                fast = false;
+            }
+            mantissa = mantissa * 10u + (uint32_t)(c - '0');
+            digits++;
+            decimals += dot ? 1 : 0;
+        } else if ((c == '.' || c == ',') && !dot) {
+            dot = true;
+        } else {
+            fast = false;
+            break;
+        }
+    }
+    if (digits == 0 && fast) {
+        return false;
+    }
+    if (fast && decimals <= 10) {
+        const float v = (float)mantissa / k_pow10[decimals];
+        *out = neg ? -v : v;
+        return true;
+    }
+
+    char buf[32];
+    if (s.len >= sizeof(buf)) {
+        return false;
+    }
+    for (size_t i = 0; i < s.len; ++i) {
+        buf[i] = (s.p[i] == ',') ? '.' : s.p[i];
+    }
+    buf[s.len] = '\0';
+    char *stop = NULL;
+    const float v = strtof(buf, &stop);
+    if (stop != buf + s.len) {
+        return false;
+    }
+    *out = v;
+    return true;
+}
+
+static bool parse_uint(slice_t s, uint32_t *out)
+{
+    float v;
+    if (!parse_number(s, &v) || v < 0.0f || v > 1e6f) {
+        return false;
+    }
+    *out = (uint32_t)(v + 0.5f);
+    return true;
+}
+
+static bool parse_enum(slice_t s, const enum_name_t *names, int count, int *out)
+{
+    for (const enum_name_t *n = names; n->name; ++n) {
+        if (slice_eq(s, n->name)) {
+            *out = n->value;
+            return true;
+        }
+    }
+    uint32_t v;
+    if (parse_uint(s, &v) && v < (uint32_t)count) {
+        *out = (int)v;
+        return true;
+    }
+    return false;
+}
+
+void plan_record_defaults(plan_record_t *rec)
+{
+    memset(rec, 0, sizeof(*rec));
+    rec->pad = (heating_pad_input_t){
+        .length_cm = 100.0f,
+        .depth_cm = 60.0f,
+        .height_cm = 60.0f,
+        .material = TERRARIUM_MATERIAL_GLASS,
+        .heated_ratio = 0.33f,
+    };
+    rec->cable = (heating_cable_input_t){
+        .length_cm = 100.0f,
+        .depth_cm = 60.0f,
+        .material = TERRARIUM_MATERIAL_GLASS,
+        .heated_ratio = 0.33f,
+        .power_linear_w_per_m = 20.0f,
+        .supply_voltage_v = 24.0f,
+        .target_power_density_w_per_cm2 = 0.035f,
+        .spacing_cm = 4.0f,
+    };
+    rec->lighting = (lighting_input_t){
+        .length_cm = 100.0f,
+        .depth_cm = 60.0f,
+        .height_cm = 60.0f,
+        .environment = TERRARIUM_ENV_TROPICAL,
+        .wall_material = TERRARIUM_MATERIAL_GLASS,
+        .led_luminous_flux_lm = 150.0f,
+        .led_power_w = 1.0f,
+        .uva_irradiance_mw_cm2_at_distance = 3.0f,
+        .uvb_uvi_at_distance = 1.2f,
+        .reference_distance_cm = 30.0f,
+    };
+    rec->substrate = (substrate_input_t){
+        .length_cm = 100.0f,
+        .depth_cm = 60.0f,
+        .height_cm = 60.0f,
+        .substrate_height_cm = 8.0f,
+        .type = SUBSTRATE_SOIL,
+    };
+    rec->misting = (misting_input_t){
+        .length_cm = 100.0f,
+        .depth_cm = 60.0f,
+        .environment = MIST_ENV_TROPICAL,
+        .nozzle_flow_ml_per_min = 80.0f,
+        .cycle_duration_min = 2.0f,
+        .cycles_per_day = 4,
+        .autonomy_days = 3,
+    };
+}
+
+bool plan_layout_detect(const char *line, size_t len, plan_layout_t *layout, char *err, size_t err_len)
+{
+    memset(layout, 0, sizeof(*layout));
+    const slice_t s = trim(line, len);
+    if (s.len && (s.p[0] == '{' || s.p[0] == '[')) {
+        layout->format = PLAN_FORMAT_JSON;
+        return true;
+    }
+
+    // En-tête CSV : ';' l'emporte s'il est présent (tableurs en français)
+    layout->format = PLAN_FORMAT_CSV;
+    layout->delimiter = memchr(s.p, ';', s.len) ? ';' : ',';
+    const char *p = s.p;
+    const char *end = s.p + s.len;
+    bool has_dimension = false;
+    while (p <= end) {
+        const char *q = memchr(p, layout->delimiter, (size_t)(end - p));
+        q = q ? q : end;
+        if (layout->column_count >= PLAN_MAX_COLUMNS) {
+            snprintf(err, err_len, "trop de colonnes (max %d)", PLAN_MAX_COLUMNS);
+            return false;
+        }
+        slice_t name = trim(p, (size_t)(q - p));
+        if (name.len >= 2 && name.p[0] == '"' && name.p[name.len - 1] == '"') {
+            name.p++;
+            name.len -= 2;
+        }
+        const plan_field_t f = lookup_field(name);
+        has_dimension |= (f == PLAN_FIELD_LENGTH || f == PLAN_FIELD_SPECIES);
+        layout->columns[layout->column_count++] = (uint8_t)f;
+        p = q + 1;
+    }
+    if (!has_dimension) {
+        snprintf(err, err_len, "en-tête CSV sans colonne length_cm ni species");
+        return false;
+    }
+    return true;
+}
+
+typedef struct {
+    plan_field_t field;
+    slice_t value;
+    bool is_string;
+} field_value_t;
+
+static int split_csv(const plan_layout_t *layout, slice_t line, field_value_t *vals, const char **err)
+{
+    int n = 0;
+    const char *p = line.p;
+    const char *end = line.p + line.len;
+    for (uint8_t col = 0; p <= end; ++col) {
+        slice_t v;
+        if (p < end && *p == '"') {
+            // Champ entre guillemets, "" pour un guillemet
+            const char *q = p + 1;
+            bool escaped = false;
+            for (;;) {
+                const char *close = memchr(q, '"', (size_t)(end - q));
+                if (!close) {
+                    *err = "guillemet non fermé";
+                    return -1;
+                }
+                if (close + 1 < end && close[1] == '"') {
+                    escaped = true;
+                    q = close + 2;
+                    continue;
+                }
+                v = (slice_t){.p = p + 1, .len = (uint16_t)(close - p - 1), .escaped = escaped};
+                p = close + 1;
+                break;
+            }
+            while (p < end && *p != layout->delimiter) {
+                ++p;
+            }
+        } else {
+            const char *q = memchr(p, layout->delimiter, (size_t)(end - p));
+            q = q ? q : end;
+            v = trim(p, (size_t)(q - p));
+            p = q;
+        }
+        ++p;
+        if (col >= layout->column_count) {
+            *err = "plus de champs que de colonnes";
+            return -1;
+        }
+        if (layout->columns[col] != PLAN_FIELD_UNKNOWN && v.len) {
+            vals[n++] = (field_value_t){.field = (plan_field_t)layout->columns[col], .value = v, .is_string = true};
+        }
+    }
+    return n;
+}
+
+static const char *skip_space(const char *p, const char *end)
+{
+    while (p < end && (is_space(*p) || *p == '\n')) {
+        ++p;
+    }
+    return p;
+}
+
+static const char *json_string(const char *p, const char *end, slice_t *out)
+{
+    // p pointe sur le guillemet ouvrant
+    const char *q = p + 1;
+    bool escaped = false;
+    while (q < end && *q != '"') {
+        if (*q == '\\') {
+            escaped = true;
+            ++q;
+        }
+        ++q;
+    }
+    if (q >= end) {
+        return NULL;
+    }
+    *out = (slice_t){.p = p + 1, .len = (uint16_t)(q - p - 1), .escaped = escaped};
+    return q + 1;
+}
+
+static int split_json(slice_t line, field_value_t *vals, const char **err)
+{
+    const char *p = line.p;
+    const char *end = line.p + line.len;
+    // Tableau JSON écrit un objet par ligne : « [ », « ] » et virgules finales tolérés
+    while (p < end && (*p == '[' || *p == ',' || is_space(*p))) {
+        ++p;
+    }
+    while (end > p && (end[-1] == ']' || end[-1] == ',' || is_space(end[-1]))) {
+        --end;
+    }
+    if (p == end) {
+        return 0;
+    }
+    if (*p != '{' || end[-1] != '}') {
+        *err = "objet JSON attendu (un par ligne)";
+        return -1;
+    }
+    ++p;
+    --end;
+    int n = 0;
+    for (;;) {
+        p = skip_space(p, end);
+        if (p == end) {
+            break;
+        }
+        slice_t key;
+        if (*p != '"' || !(p = json_string(p, end, &key))) {
+            *err = "clé JSON invalide";
+            return -1;
+        }
+        p = skip_space(p, end);
+        if (p == end || *p != ':') {
+            *err = "« : » attendu après une clé JSON";
+            return -1;
+        }
+        p = skip_space(p + 1, end);
+        slice_t v;
+        bool is_string = false;
+        if (p < end && *p == '"') {
+            if (!(p = json_string(p, end, &v))) {
+                *err = "chaîne JSON non fermée";
+                return -1;
+            }
+            is_string = true;
+        } else if (p < end && (*p == '{' || *p == '[')) {
+            *err = "valeurs imbriquées non prises en charge";
+            return -1;
+        } else {
+            const char *q = p;
+            while (q < end && *q != ',') {
+                ++q;
+            }
+            v = trim(p, (size_t)(q - p));
+            p = q;
+        }
+        const plan_field_t f = lookup_field(key);
+        if (f != PLAN_FIELD_UNKNOWN && !slice_eq(v, "null") && n < PLAN_MAX_COLUMNS) {
+            vals[n++] = (field_value_t){.field = f, .value = v, .is_string = is_string};
+        }
+        p = skip_space(p, end);
+        if (p < end) {
+            if (*p != ',') {
+                *err = "« , » attendu entre deux champs JSON";
+                return -1;
+            }
+            ++p;
+        }
+    }
+    return n;
+}
+
+// species_search_update() normalise au plus SPECIES_QUERY_MAX - 2 caractères
+// et la normalisation ne rallonge jamais : un nom de cette taille en octets
+// est cherché en entier, un nom plus long serait tronqué en préfixe
+#define SPECIES_NAME_MAX (SPECIES_QUERY_MAX - 2)
+
+static bool find_species(slice_t name, const species_t **out)
+{
+    *out = NULL;
+    if (name.len > SPECIES_NAME_MAX) {
+        return false;
+    }
+    char query[SPECIES_NAME_MAX + 1];
+    memcpy(query, name.p, name.len);
+    query[name.len] = '\0';
+    species_search_t search;
+    species_search_reset(&search);
+    species_search_update(&search, query);
+    *out = search.result_count ? species_get(search.results[0]) : NULL;
+    return *out != NULL;
+}
+
+static bool apply_field(plan_record_t *rec, const field_value_t *fv)
+{
+    float v = 0.0f;
+    uint32_t u = 0;
+    int e = 0;
+    const slice_t s = fv->value;
+    switch (fv->field) {
+    case PLAN_FIELD_ID:
+        rec->id = s.p;
+        rec->id_len = s.len;
+        rec->id_escaped = s.escaped;
+        return true;
+    case PLAN_FIELD_SPECIES:
+        return true; // appliquée avant les autres champs
+    case PLAN_FIELD_LENGTH:
+        if (!parse_number(s, &v)) {
+            return false;
+        }
+        rec->pad.length_cm = rec->cable.length_cm = rec->lighting.length_cm = v;
+        rec->substrate.length_cm = rec->misting.length_cm = v;
+        return true;
+    case PLAN_FIELD_DEPTH:
+        if (!parse_number(s, &v)) {
+            return false;
+        }
+        rec->pad.depth_cm = rec->cable.depth_cm = rec->lighting.depth_cm = v;
+        rec->substrate.depth_cm = rec->misting.depth_cm = v;
+        return true;
+    case PLAN_FIELD_HEIGHT:
+        if (!parse_number(s, &v)) {
+            return false;
+        }
+        rec->pad.height_cm = rec->lighting.height_cm = rec->substrate.height_cm = v;
+        return true;
+    case PLAN_FIELD_MATERIAL:
+        if (!parse_enum(s, k_materials, TERRARIUM_MATERIAL_COUNT, &e)) {
+            return false;
+        }
+        rec->pad.material = rec->cable.material = rec->lighting.wall_material = (terrarium_material_t)e;
+        return true;
+    case PLAN_FIELD_ENVIRONMENT:
+        if (!parse_enum(s, k_environments, TERRARIUM_ENV_COUNT, &e)) {
+            return false;
+        }
+        rec->lighting.environment = (terrarium_environment_t)e;
+        return true;
+    case PLAN_FIELD_HEATED_RATIO:
+        if (!parse_number(s, &v)) {
+            return false;
+        }
+        rec->pad.heated_ratio = rec->cable.heated_ratio = v;
+        return true;
+    case PLAN_FIELD_CABLE_W_PER_M:
+        return parse_number(s, &rec->cable.power_linear_w_per_m);
+    case PLAN_FIELD_CABLE_VOLTAGE:
+        return parse_number(s, &rec->cable.supply_voltage_v);
+    case PLAN_FIELD_CABLE_DENSITY:
+        return parse_number(s, &rec->cable.target_power_density_w_per_cm2);
+    case PLAN_FIELD_CABLE_SPACING:
+        return parse_number(s, &rec->cable.spacing_cm);
+    case PLAN_FIELD_LED_LM:
+        return parse_number(s, &rec->lighting.led_luminous_flux_lm);
+    case PLAN_FIELD_LED_W:
+        return parse_number(s, &rec->lighting.led_power_w);
+    case PLAN_FIELD_UVA:
+        return parse_number(s, &rec->lighting.uva_irradiance_mw_cm2_at_distance);
+    case PLAN_FIELD_UVB:
+        return parse_number(s, &rec->lighting.uvb_uvi_at_distance);
+    case PLAN_FIELD_UV_DISTANCE:
+        return parse_number(s, &rec->lighting.reference_distance_cm);
+    case PLAN_FIELD_SUBSTRATE:
+        if (!parse_enum(s, k_substrates, SUBSTRATE_COUNT, &e)) {
+            return false;
+        }
+        rec->substrate.type = (substrate_type_t)e;
+        return true;
+    case PLAN_FIELD_SUBSTRATE_HEIGHT:
+        return parse_number(s, &rec->substrate.substrate_height_cm);
+    case PLAN_FIELD_MIST_ENVIRONMENT:
+        if (!parse_enum(s, k_mist_environments, MIST_ENV_COUNT, &e)) {
+            return false;
+        }
+        rec->misting.environment = (mist_environment_t)e;
+        return true;
+    case PLAN_FIELD_NOZZLE_FLOW:
+        return parse_number(s, &rec->misting.nozzle_flow_ml_per_min);
+    case PLAN_FIELD_CYCLE_MIN:
+        return parse_number(s, &rec->misting.cycle_duration_min);
+    case PLAN_FIELD_CYCLES_PER_DAY:
+        if (!parse_uint(s, &u)) {
+            return false;
+        }
+        rec->misting.cycles_per_day = u;
+        return true;
+    case PLAN_FIELD_AUTONOMY_DAYS:
+        if (!parse_uint(s, &u)) {
+            return false;
+        }
+        rec->misting.autonomy_days = u;
+        return true;
+    default:
+        return true;
+    }
+}
+
+int plan_record_parse(const plan_layout_t *layout, const char *line, size_t len, plan_record_t *rec, const char **err)
+{
+    const slice_t s = trim(line, len);
+    if (s.len == 0) {
+        return 0;
+    }
+    field_value_t vals[PLAN_MAX_COLUMNS];
+    const int n = (layout->format == PLAN_FORMAT_JSON) ? split_json(s, vals, err) : split_csv(layout, s, vals, err);
+    if (n <= 0) {
+        return n;
+    }
+
+    plan_record_defaults(rec);
+    for (int i = 0; i < n; ++i) {
+        if (vals[i].field == PLAN_FIELD_SPECIES) {
+            if (!find_species(vals[i].value, &rec->species)) {
+                *err = vals[i].value.len > SPECIES_NAME_MAX ? "nom d'espèce trop long" : "espèce inconnue";
+                return -1;
+            }
+            species_fill_inputs(rec->species, &rec->pad, &rec->cable, &rec->lighting, &rec->substrate, &rec->misting);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        if (!apply_field(rec, &vals[i])) {
+            *err = "valeur illisible";
+            return -1;
+        }
+    }
+    return 1;
+}
+
+void plan_record_evaluate(const plan_record_t *rec, plan_result_t *res)
+{
+    res->pad_ok = heating_pad_calculate(&rec->pad, &res->pad);
+    res->cable_ok = heating_cable_calculate(&rec->cable, &res->cable);
+    res->lighting_ok = lighting_calculate(&rec->lighting, &res->lighting);
+    res->substrate_ok = substrate_calculate(&rec->substrate, &res->substrate);
+    res->misting_ok = misting_calculate(&rec->misting, &res->misting);
+}
+
+// --- Sortie -----------------------------------------------------------------
+
+static const char *const k_columns[] = {
+    "id",
+    "status",
+    "species",
+    "pad_power_w",
+    "pad_density_w_cm2",
+    "cable_length_m",
+    "cable_power_w",
+    "led_count",
+    "led_power_w",
+    "uvb_modules",
+    "uva_modules",
+    "substrate_l",
+    "substrate_kg",
+    "nozzle_count",
+    "tank_l",
+    "warnings",
+};
+
+static void put_raw(char **cursor, const char *s, size_t n)
+{
+    memcpy(*cursor, s, n);
+    *cursor += n;
+}
+
+static void put_str(char **cursor, const char *s)
+{
+    put_raw(cursor, s, strlen(s));
+}
+
+static void put_char(char **cursor, char c)
+{
+    *(*cursor)++ = c;
+}
+
+/*
+ * Virgule fixe sans printf : entier arrondi puis partie décimale, virgule
+ * décimale si le CSV est en « ; ». Hors plage, repli sur %g.
+ */
+static void put_fixed(char **cursor, float value, int decimals, bool decimal_comma)
+{
+    static const double k_scale[] = {1.0, 10.0, 100.0, 1000.0, 10000.0};
+    const double scaled = (double)value * k_scale[decimals];
+    if (!isfinite(scaled) || fabs(scaled) > 9e15) {
+        *cursor += snprintf(*cursor, 32, "%g", (double)value);
+        return;
+    }
+    long long v = llround(scaled);
+    if (v < 0) {
+        put_char(cursor, '-');
+        v = -v;
+    }
+    char tmp[24];
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v || n <= decimals);
+    for (int i = n - 1; i >= 0; --i) {
+        if (i == decimals - 1) {
+            put_char(cursor, decimal_comma ? ',' : '.');
+        }
+        put_char(cursor, tmp[i]);
+    }
+}
+
+static void put_uint(char **cursor, uint32_t v)
+{
+    put_fixed(cursor, (float)v, 0, false);
+}
+
+/*
+ * Recopie une tranche d'entrée (identifiant) en changeant d'échappement si
+ * besoin : "" en CSV, \" en JSON. Borne à 128 octets pour tenir dans
+ * PLAN_OUTPUT_MAX.
+ */
+static void put_text(char **cursor, const char *s, size_t n, bool escaped, plan_format_t in_format, plan_format_t out_format)
+{
+    n = n > 128 ? 128 : n;
+    put_char(cursor, '"');
+    for (size_t i = 0; i < n; ++i) {
+        char c = s[i];
+        if (escaped && in_format == PLAN_FORMAT_CSV && c == '"' && i + 1 < n && s[i + 1] == '"') {
+            ++i;
+        } else if (escaped && in_format == PLAN_FORMAT_JSON && c == '\\' && i + 1 < n) {
+            if (out_format == PLAN_FORMAT_JSON) {
+                put_char(cursor, c);
+            }
+            c = s[++i];
+            if (out_format == PLAN_FORMAT_JSON) {
+                put_char(cursor, c);
+                continue;
+            }
+        }
+        if (c == '"') {
+            put_char(cursor, out_format == PLAN_FORMAT_JSON ? '\\' : '"');
+        } else if (c == '\\' && out_format == PLAN_FORMAT_JSON) {
+            put_char(cursor, '\\');
+        }
+        put_char(cursor, c);
+    }
+    put_char(cursor, '"');
+}
+
+void plan_write_header(const plan_layout_t *layout, plan_format_t out_format, char **cursor)
+{
+    if (out_format != PLAN_FORMAT_CSV) {
+        return;
+    }
+    const char delim = layout->format == PLAN_FORMAT_CSV ? layout->delimiter : ',';
+    for (size_t i = 0; i < sizeof(k_columns) / sizeof(k_columns[0]); ++i) {
+        if (i) {
+            put_char(cursor, delim);
+        }
+        put_str(cursor, k_columns[i]);
+    }
+    put_char(cursor, '\n');
+}
+
+typedef struct {
+    char **cursor;
+    plan_format_t format;
+    char delim;
+    bool decimal_comma;
+    size_t column;
+} row_writer_t;
+
+// Ouvre la colonne suivante : séparateur CSV, ou clé JSON
+static void next_column(row_writer_t *w)
+{
+    const char *name = k_columns[w->column];
+    if (w->format == PLAN_FORMAT_JSON) {
+        put_str(w->cursor, w->column ? ",\"" : "{\"");
+        put_str(w->cursor, name);
+        put_str(w->cursor, "\":");
+    } else if (w->column) {
+        put_char(w->cursor, w->delim);
+    }
+    w->column++;
+}
+
+static void put_null(row_writer_t *w)
+{
+    if (w->format == PLAN_FORMAT_JSON) {
+        put_str(w->cursor, "null");
+    }
+}
+
+static void col_fixed(row_writer_t *w, bool ok, float v, int decimals)
+{
+    next_column(w);
+    if (ok) {
+        put_fixed(w->cursor, v, decimals, w->decimal_comma);
+    } else {
+        put_null(w);
+    }
+}
+
+static void col_uint(row_writer_t *w, bool ok, uint32_t v)
+{
+    next_column(w);
+    if (ok) {
+        put_uint(w->cursor, v);
+    } else {
+        put_null(w);
+    }
+}
+
+static void end_row(row_writer_t *w)
+{
+    if (w->format == PLAN_FORMAT_JSON) {
+        put_char(w->cursor, '}');
+    }
+    put_char(w->cursor, '\n');
+}
+
+static row_writer_t row_writer(const plan_layout_t *layout, plan_format_t out_format, char **cursor)
+{
+    const char delim = layout->format == PLAN_FORMAT_CSV ? layout->delimiter : ',';
+    return (row_writer_t){
+        .cursor = cursor,
+        .format = out_format,
+        .delim = delim,
+        .decimal_comma = out_format == PLAN_FORMAT_CSV && delim == ';',
+        .column = 0,
+    };
+}
+
+static void put_warning(char **cursor, bool *first, bool flag, const char *code)
+{
+    if (!flag) {
+        return;
+    }
+    if (!*first) {
+        put_char(cursor, '+');
+    }
+    put_str(cursor, code);
+    *first = false;
+}
+
+void plan_write_result(const plan_layout_t *layout,
+                       plan_format_t out_format,
+                       const plan_record_t *rec,
+                       const plan_result_t *res,
+                       char **cursor)
+{
+    row_writer_t w = row_writer(layout, out_format, cursor);
+
+    next_column(&w);
+    if (rec->id) {
+        put_text(cursor, rec->id, rec->id_len, rec->id_escaped, layout->format, out_format);
+    } else {
+        put_null(&w);
+    }
+
+    const int ok_count = res->pad_ok + res->cable_ok + res->lighting_ok + res->substrate_ok + res->misting_ok;
+    next_column(&w);
+    put_str(cursor,
+            ok_count == PLAN_EVALUATIONS_PER_RECORD ? "\"ok\"" : (ok_count ? "\"partiel\"" : "\"invalide\""));
+
+    next_column(&w);
+    if (rec->species) {
+        put_char(cursor, '"');
+        put_str(cursor, rec->species->latin_name);
+        put_char(cursor, '"');
+    } else {
+        put_null(&w);
+    }
+
+    col_fixed(&w, res->pad_ok, res->pad.power_w, 1);
+    col_fixed(&w, res->pad_ok, res->pad.power_density_w_per_cm2, 4);
+    col_fixed(&w, res->cable_ok, res->cable.recommended_length_m, 2);
+    col_fixed(&w, res->cable_ok, res->cable.target_power_w, 1);
+    col_uint(&w, res->lighting_ok, res->lighting.led.led_count);
+    col_fixed(&w, res->lighting_ok, res->lighting.led.total_power_w, 1);
+    col_uint(&w, res->lighting_ok, res->lighting.uvb.module_count);
+    col_uint(&w, res->lighting_ok, res->lighting.uva.module_count);
+    col_fixed(&w, res->substrate_ok, res->substrate.volume_l, 1);
+    col_fixed(&w, res->substrate_ok, res->substrate.mass_kg, 1);
+    col_uint(&w, res->misting_ok, res->misting.nozzle_count);
+    col_fixed(&w, res->misting_ok, res->misting.tank_volume_l, 2);
+
+    next_column(&w);
+    put_char(cursor, '"');
+    bool first = true;
+    put_warning(cursor, &first, res->pad_ok && res->pad.warning_density_over, "tapis_densite_max");
+    put_warning(cursor, &first, res->pad_ok && res->pad.warning_density_high, "tapis_densite");
+    put_warning(cursor, &first, res->cable_ok && res->cable.warning_density_over, "cable_densite_max");
+    put_warning(cursor, &first, res->cable_ok && res->cable.warning_spacing_too_tight, "cable_pas");
+    put_warning(cursor, &first, res->cable_ok && res->cable.warning_high_voltage, "cable_tension");
+    put_warning(cursor, &first, res->lighting_ok && res->lighting.uvb.warning_high, "uvb_fort");
+    put_warning(cursor, &first, res->lighting_ok && res->lighting.uvb.warning_low, "uvb_faible");
+    put_warning(cursor, &first, res->substrate_ok && res->substrate.warning_height_low, "substrat_mince");
+    put_warning(cursor, &first, res->misting_ok && res->misting.warning_dense_spray, "brume_dense");
+    put_warning(cursor, &first, res->misting_ok && res->misting.warning_sparse_spray, "brume_clairsemee");
+    put_warning(cursor, &first, res->misting_ok && res->misting.warning_flow_out_of_range, "buse_debit");
+    put_char(cursor, '"');
+    end_row(&w);
+}
+
+void plan_write_error(const plan_layout_t *layout,
+                      plan_format_t out_format,
+                      const char *line,
+                      size_t len,
+                      const char *err,
+                      char **cursor)
+{
+    row_writer_t w = row_writer(layout, out_format, cursor);
+    next_column(&w);
+    put_null(&w);
+    next_column(&w);
+    put_str(cursor, "\"erreur : ");
+    put_str(cursor, err);
+    put_char(cursor, '"');
+    // Ligne fautive tronquée, dans la colonne species, pour la retrouver
+    next_column(&w);
+    const slice_t s = trim(line, len);
+    const size_t n = s.len > 96 ? 96 : s.len;
+    put_text(cursor, s.p, n, false, layout->format, out_format);
+    while (w.column < sizeof(k_columns) / sizeof(k_columns[0])) {
+        next_column(&w);
+        put_null(&w);
+    }
+    end_row(&w);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "calc_heating_cable.h"
+#include "calc_heating_pad.h"
+#include "calc_lighting.h"
+#include "calc_misting.h"
+#include "calc_species.h"
+#include "calc_substrate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PLAN_MAX_COLUMNS 48
+
+typedef enum {
+    PLAN_FORMAT_CSV = 0,
+    PLAN_FORMAT_JSON,   // un objet JSON plat par ligne (NDJSON) ; crochets et virgules de tableau tolérés
+} plan_format_t;
+
+/** Champ reconnu en entrée (en-tête CSV ou clé JSON). */
+typedef enum {
+    PLAN_FIELD_UNKNOWN = 0,
+    PLAN_FIELD_ID,
+    PLAN_FIELD_SPECIES,
+    PLAN_FIELD_LENGTH,
+    PLAN_FIELD_DEPTH,
+    PLAN_FIELD_HEIGHT,
+    PLAN_FIELD_MATERIAL,
+    PLAN_FIELD_ENVIRONMENT,
+    PLAN_FIELD_HEATED_RATIO,
+    PLAN_FIELD_CABLE_W_PER_M,
+    PLAN_FIELD_CABLE_VOLTAGE,
+    PLAN_FIELD_CABLE_DENSITY,
+    PLAN_FIELD_CABLE_SPACING,
+    PLAN_FIELD_LED_LM,
+    PLAN_FIELD_LED_W,
+    PLAN_FIELD_UVA,
+    PLAN_FIELD_UVB,
+    PLAN_FIELD_UV_DISTANCE,
+    PLAN_FIELD_SUBSTRATE,
+    PLAN_FIELD_SUBSTRATE_HEIGHT,
+    PLAN_FIELD_MIST_ENVIRONMENT,
+    PLAN_FIELD_NOZZLE_FLOW,
+    PLAN_FIELD_CYCLE_MIN,
+    PLAN_FIELD_CYCLES_PER_DAY,
+    PLAN_FIELD_AUTONOMY_DAYS,
+    PLAN_FIELD_COUNT
+} plan_field_t;
+
+/** Disposition des colonnes CSV, lue une fois dans l'en-tête et partagée (lecture seule) par les fils. */
+typedef struct {
+    plan_format_t format;
+    char delimiter;      // ',' ou ';' (dans ce cas décimales à virgule en sortie)
+    uint8_t column_count;
+    uint8_t columns[PLAN_MAX_COLUMNS]; // plan_field_t par colonne
+} plan_layout_t;
+
+/** Une ligne d'entrée : tranches pointant dans le tampon lu, pas de copie. */
+typedef struct {
+    const char *id;
+    uint16_t id_len;
+    bool id_escaped;    // "" (CSV) ou \x (JSON) à réinterpréter en sortie
+    const species_t *species;
+    heating_pad_input_t pad;
+    heating_cable_input_t cable;
+    lighting_input_t lighting;
+    substrate_input_t substrate;
+    misting_input_t misting;
+} plan_record_t;
+
+typedef struct {
+    bool pad_ok;
+    bool cable_ok;
+    bool lighting_ok;
+    bool substrate_ok;
+    bool misting_ok;
+    heating_pad_result_t pad;
+    heating_cable_result_t cable;
+    lighting_result_t lighting;
+    substrate_result_t substrate;
+    misting_result_t misting;
+} plan_result_t;
+
+/** Valeurs par défaut des onglets du firmware (textes indicatifs des champs). */
+void plan_record_defaults(plan_record_t *rec);
+/** Détecte le format sur la première ligne ; en CSV, elle est l'en-tête. */
+bool plan_layout_detect(const char *line, size_t len, plan_layout_t *layout, char *err, size_t err_len);
+/**
+ * Analyse une ligne [line, line+len) sans la modifier ni la copier. Retourne
+ * 0 pour une ligne à ignorer (vide, crochet de tableau), 1 pour un
+ * enregistrement, -1 en cas d'erreur (message dans err).
+ */
+int plan_record_parse(const plan_layout_t *layout, const char *line, size_t len, plan_record_t *rec, const char **err);
+void plan_record_evaluate(const plan_record_t *rec, plan_result_t *res);
+/** Nombre de calculs de module effectués par plan_record_evaluate(). */
+#define PLAN_EVALUATIONS_PER_RECORD 5
+
+void plan_write_header(const plan_layout_t *layout, plan_format_t out_format, char **cursor);
+/** Formate le résultat ; `cursor` avance. Place nécessaire : PLAN_OUTPUT_MAX octets au plus. */
+void plan_write_result(const plan_layout_t *layout,
+                       plan_format_t out_format,
+                       const plan_record_t *rec,
+                       const plan_result_t *res,
+                       char **cursor);
+void plan_write_error(const plan_layout_t *layout,
+                      plan_format_t out_format,
+                      const char *line,
+                      size_t len,
+                      const char *err,
+                      char **cursor);
+#define PLAN_OUTPUT_MAX 1024
+
+#ifdef __cplusplus
+}
+#endif
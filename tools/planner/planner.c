@@ -0,0 +1,477 @@
+/*
+ * terrarium_planner : planification hors ligne d'installations complètes
+ * avec les modules de calcul du firmware (main/calc_*.c, compilés tels quels).
+ *
+ * Entrée CSV (en-tête obligatoire, ',' ou ';') ou JSON (un objet par ligne)
+ * sur stdin ; sortie en flux, dans l'ordre d'entrée. Le fil principal lit des
+ * blocs de ~256 Kio coupés sur une fin de ligne, les fils de travail analysent
+ * les lignes en place (tranches, sans copie) et formatent leurs résultats
+ * dans un tampon par bloc, écrit dès que les blocs précédents sont sortis.
+ */
+#define _GNU_SOURCE // memrchr
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "arena/arena.h"
+#include "calc_airflow.h"
+#include "calc_calibration.h"
+#include "calc_floor_stack.h"
+#include "calc_misting_network.h"
+#include "calc_spectrum.h"
+#include "jobs/jobs.h"
+#include "plan_record.h"
+
+#define CHUNK_BYTES   (256u * 1024u)
+#define MAX_THREADS   64
+#define SLOTS_PER_THREAD 2
+
+typedef enum { SLOT_FREE = 0, SLOT_QUEUED, SLOT_DONE } slot_state_t;
+
+typedef struct {
+    char *in;
+    size_t in_start;   // saute l'en-tête CSV dans le premier bloc
+    size_t in_len;
+    size_t in_cap;
+    char *out;
+    size_t out_len;
+    size_t out_cap;
+    uint64_t records;
+    uint64_t errors;
+    slot_state_t state;
+} slot_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;
+    pthread_cond_t done_cv;
+    slot_t **queue;    // file circulaire de blocs à traiter
+    size_t queue_cap;
+    size_t queue_head;
+    size_t queue_count;
+    bool stop;
+    plan_layout_t layout;
+    plan_format_t out_format;
+} pool_t;
+
+typedef struct {
+    int threads;
+    bool out_format_set;
+    plan_format_t out_format;
+    const char *input_path;
+    uint64_t bench_records;
+    bool self_test;
+} options_t;
+
+static void *xrealloc(void *p, size_t size)
+{
+    void *q = realloc(p, size);
+    if (!q) {
+        fprintf(stderr, "terrarium_planner : mémoire insuffisante (%zu octets)\n", size);
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void process_slot(const pool_t *pool, slot_t *slot)
+{
+    const char *p = slot->in + slot->in_start;
+    const char *end = slot->in + slot->in_len;
+    slot->out_len = 0;
+    slot->records = 0;
+    slot->errors = 0;
+    plan_record_t rec;
+    plan_result_t res;
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        const char *line_end = nl ? nl : end;
+        if (slot->out_cap - slot->out_len < PLAN_OUTPUT_MAX) {
+            slot->out_cap = slot->out_cap ? slot->out_cap * 2 : CHUNK_BYTES * 2;
+            slot->out = xrealloc(slot->out, slot->out_cap);
+        }
+        char *cursor = slot->out + slot->out_len;
+        const char *err = NULL;
+        const int kind = plan_record_parse(&pool->layout, p, (size_t)(line_end - p), &rec, &err);
+        if (kind > 0) {
+            plan_record_evaluate(&rec, &res);
+            plan_write_result(&pool->layout, pool->out_format, &rec, &res, &cursor);
+            slot->records++;
+        } else if (kind < 0) {
+            plan_write_error(&pool->layout, pool->out_format, p, (size_t)(line_end - p), err, &cursor);
+            slot->errors++;
+        }
+        slot->out_len = (size_t)(cursor - slot->out);
+        p = line_end + 1;
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    pool_t *pool = arg;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->queue_count == 0) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        if (pool->queue_count == 0) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        slot_t *slot = pool->queue[pool->queue_head];
+        pool->queue_head = (pool->queue_head + 1) % pool->queue_cap;
+        pool->queue_count--;
+        pthread_mutex_unlock(&pool->lock);
+
+        process_slot(pool, slot);
+
+        pthread_mutex_lock(&pool->lock);
+        slot->state = SLOT_DONE;
+        pthread_cond_broadcast(&pool->done_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void submit(pool_t *pool, slot_t *slot)
+{
+    pthread_mutex_lock(&pool->lock);
+    slot->state = SLOT_QUEUED;
+    pool->queue[(pool->queue_head + pool->queue_count) % pool->queue_cap] = slot;
+    pool->queue_count++;
+    pthread_cond_signal(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Attend la fin du bloc et l'écrit : appelé dans l'ordre des blocs, la sortie suit l'entrée
+static bool drain(pool_t *pool, slot_t *slot, FILE *out, uint64_t *records, uint64_t *errors)
+{
+    pthread_mutex_lock(&pool->lock);
+    while (slot->state == SLOT_QUEUED) {
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    if (slot->state != SLOT_DONE) {
+        return true;
+    }
+    slot->state = SLOT_FREE;
+    *records += slot->records;
+    *errors += slot->errors;
+    return fwrite(slot->out, 1, slot->out_len, out) == slot->out_len;
+}
+
+/*
+ * Remplit un bloc : reliquat de la lecture précédente puis fread jusqu'à
+ * CHUNK_BYTES, coupé après le dernier '\n'. Seule la ligne incomplète de fin
+ * est recopiée (dans `carry`), jamais les lignes entières.
+ */
+static bool fill_slot(slot_t *slot, FILE *in, char **carry, size_t *carry_len, size_t *carry_cap, bool *eof)
+{
+    size_t need = *carry_len + CHUNK_BYTES;
+    if (slot->in_cap < need) {
+        slot->in_cap = need;
+        slot->in = xrealloc(slot->in, slot->in_cap);
+    }
+    memcpy(slot->in, *carry, *carry_len);
+    slot->in_len = *carry_len;
+    slot->in_start = 0;
+    *carry_len = 0;
+
+    for (;;) {
+        while (!*eof && slot->in_len < slot->in_cap) {
+            const size_t n = fread(slot->in + slot->in_len, 1, slot->in_cap - slot->in_len, in);
+            slot->in_len += n;
+            if (n == 0) {
+                if (ferror(in)) {
+                    return false;
+                }
+                *eof = true;
+            }
+        }
+        if (*eof) {
+            return true;
+        }
+        const char *last = memrchr(slot->in, '\n', slot->in_len);
+        if (last) {
+            const size_t keep = (size_t)(last - slot->in) + 1;
+            *carry_len = slot->in_len - keep;
+            if (*carry_cap < *carry_len) {
+                *carry_cap = *carry_len;
+                *carry = xrealloc(*carry, *carry_cap);
+            }
+            memcpy(*carry, slot->in + keep, *carry_len);
+            slot->in_len = keep;
+            return true;
+        }
+        // Ligne plus longue qu'un bloc : on agrandit et on continue la lecture
+        slot->in_cap *= 2;
+        slot->in = xrealloc(slot->in, slot->in_cap);
+    }
+}
+
+static int run_pipeline(const options_t *opt, FILE *in, FILE *out, uint64_t *records_out, uint64_t *errors_out)
+{
+    pool_t pool = {0};
+    const size_t slot_count = (size_t)opt->threads * SLOTS_PER_THREAD;
+    slot_t *slots = calloc(slot_count, sizeof(slot_t));
+    pool.queue = calloc(slot_count, sizeof(slot_t *));
+    pool.queue_cap = slot_count;
+    if (!slots || !pool.queue) {
+        fprintf(stderr, "terrarium_planner : mémoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.work_cv, NULL);
+    pthread_cond_init(&pool.done_cv, NULL);
+
+    char *carry = NULL;
+    size_t carry_len = 0;
+    size_t carry_cap = 0;
+    bool eof = false;
+    int status = EXIT_SUCCESS;
+    uint64_t records = 0;
+    uint64_t errors = 0;
+
+    // Premier bloc : détection du format sur la première ligne (en-tête CSV)
+    if (!fill_slot(&slots[0], in, &carry, &carry_len, &carry_cap, &eof)) {
+        fprintf(stderr, "terrarium_planner : lecture impossible : %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    const char *first_nl = memchr(slots[0].in, '\n', slots[0].in_len);
+    const size_t first_len = first_nl ? (size_t)(first_nl - slots[0].in) : slots[0].in_len;
+    char err[96];
+    if (!plan_layout_detect(slots[0].in, first_len, &pool.layout, err, sizeof(err))) {
+        fprintf(stderr, "terrarium_planner : %s\n", err);
+        return EXIT_FAILURE;
+    }
+    if (pool.layout.format == PLAN_FORMAT_CSV) {
+        slots[0].in_start = first_nl ? first_len + 1 : slots[0].in_len;
+    }
+    pool.out_format = opt->out_format_set ? opt->out_format : pool.layout.format;
+
+    char header[512];
+    char *cursor = header;
+    plan_write_header(&pool.layout, pool.out_format, &cursor);
+    fwrite(header, 1, (size_t)(cursor - header), out);
+
+    pthread_t threads[MAX_THREADS];
+    for (int i = 0; i < opt->threads; ++i) {
+        pthread_create(&threads[i], NULL, worker_main, &pool);
+    }
+
+    submit(&pool, &slots[0]);
+    size_t seq = 0;
+    while (!eof) {
+        slot_t *slot = &slots[++seq % slot_count];
+        if (!drain(&pool, slot, out, &records, &errors)) {
+            status = EXIT_FAILURE;
+            break;
+        }
+        if (!fill_slot(slot, in, &carry, &carry_len, &carry_cap, &eof)) {
+            fprintf(stderr, "terrarium_planner : lecture impossible : %s\n", strerror(errno));
+            status = EXIT_FAILURE;
+            break;
+        }
+        submit(&pool, slot);
+    }
+    // Blocs encore en vol, du plus ancien au dernier soumis
+    for (size_t k = 1; k <= slot_count; ++k) {
+        if (!drain(&pool, &slots[(seq + k) % slot_count], out, &records, &errors)) {
+            status = EXIT_FAILURE;
+        }
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = true;
+    pthread_cond_broadcast(&pool.work_cv);
+    pthread_mutex_unlock(&pool.lock);
+    for (int i = 0; i < opt->threads; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (size_t i = 0; i < slot_count; ++i) {
+        free(slots[i].in);
+        free(slots[i].out);
+    }
+    free(slots);
+    free(pool.queue);
+    free(carry);
+    *records_out = records;
+    *errors_out = errors;
+    return status;
+}
+
+// Enclos synthétiques variés (espèces, dimensions, matériel) pour --bench
+static char *make_bench_input(uint64_t count, size_t *len)
+{
+    static const char *const k_species[] = {"", "Pogona vitticeps", "Eublepharis macularius", "Python regius",
+                                            "Dendrobates", "Chamaeleo calyptratus", "Testudo hermanni"};
+    static const char *const k_materials[] = {"wood", "glass", "pvc", "acrylic"};
+    const size_t cap = (size_t)count * 128u + 256u;
+    char *buf = xrealloc(NULL, cap);
+    size_t n = (size_t)snprintf(buf, cap,
+                                "id,species,length_cm,depth_cm,height_cm,material,heated_ratio,led_lm,"
+                                "substrate_cm,nozzle_ml_min,cycles_per_day\n");
+    uint32_t rng = 12345u;
+    for (uint64_t i = 0; i < count; ++i) {
+        rng = rng * 1664525u + 1013904223u;
+        const uint32_t r = rng >> 8;
+        n += (size_t)snprintf(buf + n, cap - n,
+                              "E%llu,%s,%u,%u,%u,%s,0.%u,%u,%u.5,%u,%u\n",
+                              (unsigned long long)i,
+                              k_species[r % 7u],
+                              40u + r % 160u,
+                              30u + (r >> 3) % 70u,
+                              30u + (r >> 6) % 90u,
+                              k_materials[(r >> 9) % 4u],
+                              20u + (r >> 11) % 30u,
+                              100u + (r >> 13) % 200u,
+                              3u + (r >> 15) % 12u,
+                              60u + (r >> 17) % 60u,
+                              1u + (r >> 19) % 8u);
+    }
+    *len = n;
+    return buf;
+}
+
+static void run_self_tests(void)
+{
+    // Même réservation que le firmware avec PSRAM
+    const arena_config_t arena_cfg = {.internal_bytes = 48 * 1024, .psram_bytes = 4 * 1024 * 1024};
+    arena_init(&arena_cfg);
+    jobs_init(NULL);
+    heating_pad_run_self_test();
+    heating_cable_run_self_test();
+    floor_stack_run_self_test();
+    spectrum_run_self_test();
+    lighting_run_self_test();
+    substrate_run_self_test();
+    misting_run_self_test();
+    mist_net_run_self_test();
+    calibration_run_self_test();
+    species_run_self_test();
+    airflow_run_self_test();
+    arena_log_stats();
+    jobs_deinit();
+    arena_deinit();
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage : terrarium_planner [-j fils] [-o csv|json] [-i fichier] [--bench N] [--self-test]\n"
+            "  Lit une liste d'enclos (CSV avec en-tête ou un objet JSON par ligne) sur stdin\n"
+            "  et écrit un résultat par ligne, dans l'ordre d'entrée.\n"
+            "  Colonnes : id, species, length_cm, depth_cm, height_cm, material, environment,\n"
+            "  heated_ratio, cable_w_per_m, cable_voltage_v, cable_density_w_cm2, cable_spacing_cm,\n"
+            "  led_lm, led_w, uva_mw_cm2, uvb_uvi, uv_distance_cm, substrate, substrate_cm,\n"
+            "  mist_environment, nozzle_ml_min, cycle_min, cycles_per_day, autonomy_days.\n");
+}
+
+static bool parse_options(int argc, char **argv, options_t *opt)
+{
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    opt->threads = cpus > 0 ? (int)(cpus > MAX_THREADS ? MAX_THREADS : cpus) : 1;
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        const char *next = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if ((!strcmp(a, "-j") || !strcmp(a, "--threads")) && next) {
+            const int n = atoi(next);
+            opt->threads = n < 1 ? 1 : (n > MAX_THREADS ? MAX_THREADS : n);
+            ++i;
+        } else if ((!strcmp(a, "-o") || !strcmp(a, "--output")) && next) {
+            if (!strcmp(next, "csv")) {
+                opt->out_format = PLAN_FORMAT_CSV;
+            } else if (!strcmp(next, "json")) {
+                opt->out_format = PLAN_FORMAT_JSON;
+            } else {
+                return false;
+            }
+            opt->out_format_set = true;
+            ++i;
+        } else if ((!strcmp(a, "-i") || !strcmp(a, "--input")) && next) {
+            opt->input_path = next;
+            ++i;
+        } else if (!strcmp(a, "--bench") && next) {
+            opt->bench_records = strtoull(next, NULL, 10);
+            ++i;
+        } else if (!strcmp(a, "--self-test")) {
+            opt->self_test = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    options_t opt = {0};
+    if (!parse_options(argc, argv, &opt)) {
+        usage();
+        return EXIT_FAILURE;
+    }
+    if (opt.self_test) {
+        run_self_tests();
+        return EXIT_SUCCESS;
+    }
+
+    // Tables de spectre remplies avant de lancer les fils
+    spectrum_init();
+
+    uint64_t records = 0;
+    uint64_t errors = 0;
+    int status;
+    if (opt.bench_records) {
+        size_t len;
+        char *data = make_bench_input(opt.bench_records, &len);
+        FILE *in = fmemopen(data, len, "r");
+        FILE *out = fopen("/dev/null", "w");
+        if (!in || !out) {
+            fprintf(stderr, "terrarium_planner : flux de mesure indisponibles\n");
+            return EXIT_FAILURE;
+        }
+        const double t0 = now_s();
+        status = run_pipeline(&opt, in, out, &records, &errors);
+        const double dt = now_s() - t0;
+        fclose(in);
+        fclose(out);
+        free(data);
+        fprintf(stderr,
+                "%llu enclos (%llu erreurs) en %.3f s sur %d fil(s) : %.2f M enclos/s, %.2f M éval/s\n",
+                (unsigned long long)records,
+                (unsigned long long)errors,
+                dt,
+                opt.threads,
+                (double)records / dt * 1e-6,
+                (double)records * PLAN_EVALUATIONS_PER_RECORD / dt * 1e-6);
+        return status;
+    }
+
+    FILE *in = stdin;
+    if (opt.input_path && !(in = fopen(opt.input_path, "r"))) {
+        fprintf(stderr, "terrarium_planner : %s : %s\n", opt.input_path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+    status = run_pipeline(&opt, in, stdout, &records, &errors);
+    if (in != stdin) {
+        fclose(in);
+    }
+    fflush(stdout);
+    if (errors) {
+        fprintf(stderr, "terrarium_planner : %llu ligne(s) en erreur\n", (unsigned long long)errors);
+    }
+    return status;
+}